@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+
+#include "kalix/base/aligned_allocator.h"
+
+TEST(AlignedAllocatorTest, DataStartsOnCacheLine)
+{
+    for (size_t size = 1; size < 200; size += 7)
+    {
+        kalix::AlignedVector<double> values(size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data()) % kalix::kDefaultAlignment, 0u);
+    }
+}
+
+TEST(AlignedAllocatorTest, KeepsAlignmentWhenGrowing)
+{
+    kalix::AlignedVector<int64_t> values;
+    for (int64_t i = 0; i < 1000; i++)
+    {
+        values.push_back(i);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(values.data()) % kalix::kDefaultAlignment, 0u);
+    }
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), int64_t{0}), 999 * 1000 / 2);
+}
+
+TEST(AlignedAllocatorTest, SupportsWiderAlignment)
+{
+    std::vector<float, kalix::AlignedAllocator<float, 256>> values(3, 1.5f);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data()) % 256, 0u);
+    EXPECT_EQ(values[2], 1.5f);
+}
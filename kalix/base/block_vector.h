@@ -0,0 +1,271 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_BLOCK_VECTOR_H_
+#define KALIX_BASE_BLOCK_VECTOR_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "kalix/base/aligned_allocator.h"
+#include "kalix/base/config.h"
+#include "kalix/base/constants.h"
+#include "kalix/base/vector.h"
+
+namespace kalix
+{
+    /// @brief @p K sparse vectors of one dimension sharing a single index list.
+    ///
+    /// Kernels that carry several vectors with overlapping sparsity patterns, such as solves with
+    /// multiple right-hand sides, or a simplex column together with its steepest edge vector,
+    /// otherwise walk one index list per vector and gather the same entries @p K times. Here the
+    /// @p K values of an index are stored next to each other, so every kernel does one gather per
+    /// index and then updates all lanes with a fixed-length loop the compiler vectorizes.
+    ///
+    /// An index is listed if any of its lanes may be non-zero. Membership is tracked exactly in
+    /// @ref index_flags, so cancelled entries are stored as exact zeros and stay listed until
+    /// @ref prune_small_values. Single lanes are exchanged with @ref Vector through @ref copy_from
+    /// and @ref export_to.
+    ///
+    /// @tparam Real The floating-point type (e.g., double).
+    /// @tparam K The number of lanes.
+    template <typename Real, int K>
+        requires AlgebraicReal<Real> && (K > 0)
+    class BlockVector
+    {
+    public:
+        /// @brief The values, @p K per index: lane @c j of index @c i is at @c i*K+j.
+        AlignedVector<Real> block_values;
+
+        /// @brief The indices with a possibly non-zero lane, in no particular order.
+        std::vector<int64_t> non_zero_indices;
+
+        /// @brief One flag per index, set exactly for the listed indices.
+        std::vector<char> index_flags;
+
+        /// @brief The dimension of every lane.
+        int64_t dimension{};
+
+        /// @brief The number of listed indices.
+        int64_t non_zero_count{};
+
+        /// @brief Allocates the vector and sets all lanes to zero.
+        /// @param new_dimension The dimension of every lane.
+        void setup(const int64_t new_dimension)
+        {
+            dimension = new_dimension;
+            non_zero_count = 0;
+            block_values.assign(new_dimension * K, Real{0});
+            // One spare slot for the branch-free append of @ref touch.
+            non_zero_indices.resize(new_dimension + 1);
+            index_flags.assign(new_dimension, 0);
+        }
+
+        /// @brief Sets all lanes to zero, touching only the listed indices unless more than
+        /// @ref Vector::kDenseFraction of them are listed.
+        void clear()
+        {
+            if (non_zero_count > dimension * Vector<Real>::kDenseFraction)
+            {
+                std::fill(block_values.begin(), block_values.end(), Real{0});
+                std::fill(index_flags.begin(), index_flags.end(), char{0});
+            }
+            else
+            {
+                for (int64_t t = 0; t < non_zero_count; t++)
+                {
+                    const int64_t index = non_zero_indices[t];
+                    std::fill_n(block_values.begin() + index * K, K, Real{0});
+                    index_flags[index] = 0;
+                }
+            }
+            non_zero_count = 0;
+        }
+
+        /// @brief Returns the @p K values of @p index.
+        [[nodiscard]] KALIX_FORCE_INLINE Real* block(const int64_t index)
+        {
+            return block_values.data() + index * K;
+        }
+
+        /// @copydoc block
+        [[nodiscard]] KALIX_FORCE_INLINE const Real* block(const int64_t index) const
+        {
+            return block_values.data() + index * K;
+        }
+
+        /// @brief Lists @p index if it is not listed yet and returns its values.
+        KALIX_FORCE_INLINE Real* touch(const int64_t index)
+        {
+            // Branch-free append: an index that is already listed is overwritten by the next one.
+            non_zero_indices[non_zero_count] = index;
+            non_zero_count += !index_flags[index];
+            index_flags[index] = 1;
+            return block(index);
+        }
+
+        /// @brief Adds @p multiplier times @p values to the @p K values of @p index, e.g. one column
+        /// entry of a triangular factor applied to all right-hand sides. Tiny results are kept; see
+        /// @ref prune_small_values.
+        template <typename RealScalar>
+        KALIX_FORCE_INLINE void add(const int64_t index, const RealScalar multiplier, const Real* values)
+        {
+            Real* target = touch(index);
+            for (int j = 0; j < K; j++)
+            {
+                target[j] += multiplier * values[j];
+            }
+        }
+
+        /// @brief Adds @c multipliers[j] times @p vector_to_add to lane @c j, for all lanes.
+        ///
+        /// Each entry of @p vector_to_add is read once for all @p K updates. @p vector_to_add may be
+        /// dense.
+        template <typename RealVector>
+        void saxpy(const std::array<Real, K>& multipliers, const Vector<RealVector>* vector_to_add)
+        {
+            const RealVector* add_values = vector_to_add->dense_values.data();
+            vector_to_add->for_each_index([&](const int64_t index)
+            {
+                if (vector_to_add->non_zero_count < 0 && !static_cast<double>(add_values[index]))
+                {
+                    return;
+                }
+                const Real value = Real(add_values[index]);
+                Real* target = touch(index);
+                for (int j = 0; j < K; j++)
+                {
+                    target[j] = flush_tiny(target[j] + multipliers[j] * value);
+                }
+            });
+        }
+
+        /// @brief Adds @p multiplier times @p vector_to_add, lane by lane.
+        template <typename RealScalar>
+        void saxpy(const RealScalar multiplier, const BlockVector* vector_to_add)
+        {
+            for (int64_t t = 0; t < vector_to_add->non_zero_count; t++)
+            {
+                const int64_t index = vector_to_add->non_zero_indices[t];
+                const Real* values = vector_to_add->block(index);
+                Real* target = touch(index);
+                for (int j = 0; j < K; j++)
+                {
+                    target[j] = flush_tiny(target[j] + multiplier * values[j]);
+                }
+            }
+        }
+
+        /// @brief Returns the squared Euclidean norm of every lane.
+        [[nodiscard]] std::array<Real, K> squared_euclidean_norms() const
+        {
+            std::array<Real, K> result{};
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                const Real* values = block(non_zero_indices[t]);
+                for (int j = 0; j < K; j++)
+                {
+                    result[j] += values[j] * values[j];
+                }
+            }
+            return result;
+        }
+
+        /// @brief Sets values smaller than @ref kTiny to zero and unlists indices whose lanes are all
+        /// zero.
+        void prune_small_values()
+        {
+            int64_t count = 0;
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                const int64_t index = non_zero_indices[t];
+                Real* values = block(index);
+                bool is_zero = true;
+                for (int j = 0; j < K; j++)
+                {
+                    values[j] = flush_tiny(values[j]);
+                    is_zero &= !static_cast<double>(values[j]);
+                }
+                non_zero_indices[count] = index;
+                count += !is_zero;
+                index_flags[index] = !is_zero;
+            }
+            non_zero_count = count;
+        }
+
+        /// @brief Overwrites lane @p lane with @p source. The other lanes are kept.
+        ///
+        /// Indices that are listed here but not in @p source keep a zero in @p lane.
+        template <typename FromReal>
+        void copy_from(const int lane, const Vector<FromReal>* source)
+        {
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                block(non_zero_indices[t])[lane] = Real{0};
+            }
+            const FromReal* source_values = source->dense_values.data();
+            source->for_each_index([&](const int64_t index)
+            {
+                if (static_cast<double>(source_values[index]))
+                {
+                    touch(index)[lane] = Real(source_values[index]);
+                }
+            });
+        }
+
+        /// @brief Stores lane @p lane in @p target, which is cleared first. Zero entries of the lane
+        /// are not listed in @p target, and its index mask is kept up to date if it has one.
+        template <typename ToReal>
+        void export_to(const int lane, Vector<ToReal>* target) const
+        {
+            target->clear();
+            char* listed = target->has_index_mask ? target->char_workspace.data() : nullptr;
+            int64_t count = 0;
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                const int64_t index = non_zero_indices[t];
+                if (const Real value = block(index)[lane]; static_cast<double>(value))
+                {
+                    target->dense_values[index] = ToReal(value);
+                    target->non_zero_indices[count++] = index;
+                    if (listed != nullptr)
+                    {
+                        listed[index] = 1;
+                    }
+                }
+            }
+            target->non_zero_count = count;
+        }
+
+    private:
+        // Replaces a value below kTiny by an exact zero; the index flags keep its index listed.
+        static KALIX_FORCE_INLINE Real flush_tiny(const Real value)
+        {
+            using std::abs;
+            return abs(value) < kTiny ? Real{0} : value;
+        }
+    };
+}
+
+#endif // KALIX_BASE_BLOCK_VECTOR_H_
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <array>
+
+#include "kalix/base/block_vector.h"
+#include "kalix/base/vector.h"
+
+class BlockVectorTest : public ::testing::Test
+{
+protected:
+    kalix::BlockVector<double, 4> block;
+    kalix::Vector<double> vec;
+    const int64_t kSize = 10;
+
+    void SetUp() override
+    {
+        block.setup(kSize);
+        vec.setup(kSize);
+    }
+};
+
+TEST_F(BlockVectorTest, Initialization)
+{
+    EXPECT_EQ(block.dimension, kSize);
+    EXPECT_EQ(block.non_zero_count, 0);
+    EXPECT_EQ(block.block_values.size(), static_cast<size_t>(4 * kSize));
+    for (const double value : block.block_values)
+    {
+        EXPECT_DOUBLE_EQ(value, 0.0);
+    }
+}
+
+TEST_F(BlockVectorTest, SaxpyWithVectorUpdatesAllLanes)
+{
+    vec.dense_values[2] = 1.0;
+    vec.dense_values[7] = -2.0;
+    vec.non_zero_indices[0] = 2;
+    vec.non_zero_indices[1] = 7;
+    vec.non_zero_count = 2;
+
+    block.saxpy({1.0, 2.0, 0.0, -1.0}, &vec);
+    block.saxpy({1.0, 0.0, 0.0, 0.0}, &vec);
+
+    ASSERT_EQ(block.non_zero_count, 2);
+    EXPECT_DOUBLE_EQ(block.block(2)[0], 2.0);
+    EXPECT_DOUBLE_EQ(block.block(2)[1], 2.0);
+    EXPECT_DOUBLE_EQ(block.block(2)[2], 0.0);
+    EXPECT_DOUBLE_EQ(block.block(7)[3], 2.0);
+
+    const std::array<double, 4> norms = block.squared_euclidean_norms();
+    EXPECT_DOUBLE_EQ(norms[0], 4.0 + 16.0);
+    EXPECT_DOUBLE_EQ(norms[2], 0.0);
+}
+
+TEST_F(BlockVectorTest, SaxpyWithDenseVector)
+{
+    vec.dense_values[5] = 3.0;
+    vec.make_dense();
+
+    block.saxpy({1.0, 1.0, 1.0, 1.0}, &vec);
+
+    ASSERT_EQ(block.non_zero_count, 1);
+    EXPECT_EQ(block.non_zero_indices[0], 5);
+}
+
+TEST_F(BlockVectorTest, CancellationStaysListedUntilPruned)
+{
+    kalix::BlockVector<double, 4> other;
+    other.setup(kSize);
+    other.add(3, 1.0, std::array<double, 4>{1.0, 0.0, 0.0, 0.0}.data());
+    other.add(4, 1.0, std::array<double, 4>{0.0, 1.0, 0.0, 0.0}.data());
+
+    block.saxpy(1.0, &other);
+    block.saxpy(-1.0, &other);
+    EXPECT_EQ(block.non_zero_count, 2);
+    EXPECT_EQ(block.block(3)[0], 0.0);
+
+    block.add(4, 1.0, std::array<double, 4>{0.0, 0.0, 5.0, 0.0}.data());
+    block.prune_small_values();
+    ASSERT_EQ(block.non_zero_count, 1);
+    EXPECT_EQ(block.non_zero_indices[0], 4);
+    EXPECT_EQ(block.index_flags[3], 0);
+}
+
+TEST_F(BlockVectorTest, CopyFromAndExportTo)
+{
+    vec.dense_values[1] = 4.0;
+    vec.dense_values[8] = 5.0;
+    vec.non_zero_indices[0] = 1;
+    vec.non_zero_indices[1] = 8;
+    vec.non_zero_count = 2;
+    block.copy_from(2, &vec);
+
+    kalix::Vector<double> second;
+    second.setup(kSize);
+    second.dense_values[8] = 6.0;
+    second.non_zero_indices[0] = 8;
+    second.non_zero_count = 1;
+    block.copy_from(0, &second);
+
+    // Overwriting a lane keeps the others.
+    second.dense_values[8] = 0.0;
+    second.dense_values[9] = 7.0;
+    second.non_zero_indices[0] = 9;
+    block.copy_from(0, &second);
+    EXPECT_EQ(block.non_zero_count, 3);
+    EXPECT_DOUBLE_EQ(block.block(8)[0], 0.0);
+    EXPECT_DOUBLE_EQ(block.block(8)[2], 5.0);
+
+    kalix::Vector<double> exported;
+    exported.setup(kSize);
+    block.export_to(2, &exported);
+    EXPECT_EQ(exported, vec);
+
+    block.export_to(0, &exported);
+    ASSERT_EQ(exported.non_zero_count, 1);
+    EXPECT_DOUBLE_EQ(exported.dense_values[9], 7.0);
+    EXPECT_DOUBLE_EQ(exported.dense_values[1], 0.0);
+}
+
+TEST_F(BlockVectorTest, ExportToKeepsIndexMask)
+{
+    vec.dense_values[1] = 4.0;
+    vec.dense_values[8] = 5.0;
+    vec.non_zero_indices[0] = 1;
+    vec.non_zero_indices[1] = 8;
+    vec.non_zero_count = 2;
+    block.copy_from(1, &vec);
+
+    kalix::Vector<double> exported;
+    exported.setup(kSize);
+    exported.dense_values[3] = 1.0;
+    exported.non_zero_indices[0] = 3;
+    exported.non_zero_count = 1;
+    exported.enable_index_mask();
+    block.export_to(1, &exported);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_EQ(exported.char_workspace[i], i == 1 || i == 8);
+    }
+
+    // The masked saxpy neither lists index 8 again nor misses index 3.
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    pivot.dense_values[3] = 2.0;
+    pivot.dense_values[8] = 1.0;
+    pivot.non_zero_indices[0] = 3;
+    pivot.non_zero_indices[1] = 8;
+    pivot.non_zero_count = 2;
+    exported.saxpy(1.0, &pivot);
+    EXPECT_EQ(exported.non_zero_count, 3);
+    EXPECT_DOUBLE_EQ(exported.squared_euclidean_norm(), 16.0 + 36.0 + 4.0);
+}
+
+TEST_F(BlockVectorTest, ClearResetsValuesAndFlags)
+{
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        block.touch(i)[1] = 1.0;
+    }
+    EXPECT_EQ(block.non_zero_count, kSize);
+
+    block.clear();
+    EXPECT_EQ(block.non_zero_count, 0);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_EQ(block.index_flags[i], 0);
+        EXPECT_DOUBLE_EQ(block.block(i)[1], 0.0);
+    }
+}
@@ -553,6 +553,9 @@ namespace kalix
         }
 
     private:
+        // Stores vectors of compensated values as separate hi and lo arrays.
+        friend class CompensatedVector;
+
         double hi;
         double lo;
     };
@@ -0,0 +1,385 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_COMPENSATED_VECTOR_H_
+#define KALIX_BASE_COMPENSATED_VECTOR_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "kalix/base/aligned_allocator.h"
+#include "kalix/base/compensated_double.h"
+#include "kalix/base/config.h"
+#include "kalix/base/vector.h"
+
+namespace kalix
+{
+    /// @brief A sparse vector of @ref CompensatedDouble values stored as separate hi and lo arrays.
+    ///
+    /// @c Vector<CompensatedDouble> stores each value as a (hi, lo) pair and runs its kernels
+    /// through the operators of @ref CompensatedDouble, one entry at a time. This type instead
+    /// keeps the high and low parts in two aligned arrays and implements the kernels used for
+    /// refinement residuals directly on them with the error-free transformations of
+    /// @ref CompensatedDouble. The dense loops and reductions are straight-line double arithmetic
+    /// over contiguous arrays, which the compiler vectorizes; reductions carry several independent
+    /// partial sums so that consecutive entries do not wait on each other.
+    ///
+    /// The index list and @ref non_zero_count follow @ref Vector: a negative count means dense.
+    /// Membership in the list is tracked exactly in @ref index_flags, so cancelled entries stay
+    /// listed as exact zeros instead of being flushed, which would lose the accuracy the
+    /// compensation provides. Values are exchanged with @ref Vector through @ref copy_from and
+    /// @ref export_to.
+    class CompensatedVector
+    {
+    public:
+        /// @brief The high parts of the values.
+        AlignedVector<double> high_values;
+
+        /// @brief The low parts of the values, i.e. the accumulated rounding errors.
+        AlignedVector<double> low_values;
+
+        /// @brief Indices of the possibly non-zero values, valid if @ref non_zero_count >= 0.
+        std::vector<int64_t> non_zero_indices;
+
+        /// @brief One flag per index, set exactly for the listed indices.
+        std::vector<char> index_flags;
+
+        /// @brief The dimension of the vector.
+        int64_t dimension{};
+
+        /// @brief The number of listed indices, or -1 if the vector is dense.
+        int64_t non_zero_count{};
+
+        /// @brief Allocates the vector and sets it to zero.
+        void setup(const int64_t new_dimension)
+        {
+            dimension = new_dimension;
+            non_zero_count = 0;
+            high_values.assign(new_dimension, 0.0);
+            low_values.assign(new_dimension, 0.0);
+            // One spare slot for the branch-free append of touch().
+            non_zero_indices.resize(new_dimension + 1);
+            index_flags.assign(new_dimension, 0);
+        }
+
+        /// @brief Sets the vector to zero, touching only the listed indices if there are few.
+        void clear()
+        {
+            if (non_zero_count < 0 || non_zero_count > dimension * Vector<double>::kDenseFraction)
+            {
+                std::fill(high_values.begin(), high_values.end(), 0.0);
+                std::fill(low_values.begin(), low_values.end(), 0.0);
+                std::fill(index_flags.begin(), index_flags.end(), char{0});
+            }
+            else
+            {
+                for (int64_t t = 0; t < non_zero_count; t++)
+                {
+                    const int64_t index = non_zero_indices[t];
+                    high_values[index] = 0.0;
+                    low_values[index] = 0.0;
+                    index_flags[index] = 0;
+                }
+            }
+            non_zero_count = 0;
+        }
+
+        /// @brief Drops the index list. The values are kept.
+        void make_dense()
+        {
+            if (non_zero_count > 0)
+            {
+                for (int64_t t = 0; t < non_zero_count; t++)
+                {
+                    index_flags[non_zero_indices[t]] = 0;
+                }
+            }
+            non_zero_count = -1;
+        }
+
+        /// @brief Returns the value at @p index.
+        [[nodiscard]] KALIX_FORCE_INLINE CompensatedDouble value(const int64_t index) const
+        {
+            return {high_values[index], low_values[index]};
+        }
+
+        /// @brief Overwrites the vector with @p source, a @c Vector<double> or
+        /// @c Vector<CompensatedDouble>.
+        template <typename FromReal>
+        void copy_from(const Vector<FromReal>* source)
+        {
+            clear();
+            if (source->non_zero_count < 0)
+            {
+                make_dense();
+            }
+            const FromReal* source_values = source->dense_values.data();
+            source->for_each_index([&](const int64_t index)
+            {
+                if constexpr (std::is_same_v<FromReal, CompensatedDouble>)
+                {
+                    high_values[index] = source_values[index].hi;
+                    low_values[index] = source_values[index].lo;
+                }
+                else
+                {
+                    high_values[index] = static_cast<double>(source_values[index]);
+                }
+                if (non_zero_count >= 0)
+                {
+                    touch(index);
+                }
+            });
+        }
+
+        /// @brief Stores the vector in @p target, a @c Vector<double> (rounded) or
+        /// @c Vector<CompensatedDouble>, which is cleared first.
+        ///
+        /// Entries that cancelled to an exact zero are not listed in @p target, whose index list
+        /// must hold only non-zeros, and its index mask is kept up to date if it has one.
+        template <typename ToReal>
+        void export_to(Vector<ToReal>* target) const
+        {
+            target->clear();
+            const auto store = [&](const int64_t index)
+            {
+                if constexpr (std::is_same_v<ToReal, CompensatedDouble>)
+                {
+                    target->dense_values[index] = value(index);
+                }
+                else
+                {
+                    target->dense_values[index] = ToReal(high_values[index] + low_values[index]);
+                }
+            };
+            if (non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < dimension; i++)
+                {
+                    store(i);
+                }
+                target->make_dense();
+                return;
+            }
+            char* listed = target->has_index_mask ? target->char_workspace.data() : nullptr;
+            int64_t count = 0;
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                const int64_t index = non_zero_indices[t];
+                store(index);
+                const bool keep = high_values[index] + low_values[index] != 0.0;
+                target->non_zero_indices[count] = index;
+                count += keep;
+                if (listed != nullptr)
+                {
+                    listed[index] = keep;
+                }
+            }
+            target->non_zero_count = count;
+        }
+
+        /// @brief Adds @p multiplier times @p vector_to_add, keeping the rounding error of every
+        /// product and sum, e.g. to accumulate @c r = b - A*x column by column.
+        ///
+        /// If either vector is dense, the result is dense and the update is one pass over the
+        /// arrays.
+        void saxpy(const double multiplier, const Vector<double>* vector_to_add)
+        {
+            const double* add_values = vector_to_add->dense_values.data();
+            double* high = high_values.data();
+            double* low = low_values.data();
+            if (non_zero_count < 0 || vector_to_add->non_zero_count < 0)
+            {
+                make_dense();
+                if (vector_to_add->non_zero_count < 0)
+                {
+                    for (int64_t i = 0; i < dimension; i++)
+                    {
+                        add_product(high[i], low[i], multiplier, add_values[i]);
+                    }
+                    return;
+                }
+            }
+            const int64_t* add_indices = vector_to_add->non_zero_indices.data();
+            for (int64_t t = 0; t < vector_to_add->non_zero_count; t++)
+            {
+                const int64_t index = add_indices[t];
+                add_product(high[index], low[index], multiplier, add_values[index]);
+            }
+            list_indices(add_indices, vector_to_add->non_zero_count);
+        }
+
+        /// @brief Adds @p multiplier times @p vector_to_add in double-double arithmetic.
+        /// @see saxpy(double, const Vector<double>*)
+        void saxpy(const CompensatedDouble& multiplier, const CompensatedVector* vector_to_add)
+        {
+            const double* add_high = vector_to_add->high_values.data();
+            const double* add_low = vector_to_add->low_values.data();
+            double* high = high_values.data();
+            double* low = low_values.data();
+            const double multiplier_high = multiplier.hi;
+            const double multiplier_low = multiplier.lo;
+            if (non_zero_count < 0 || vector_to_add->non_zero_count < 0)
+            {
+                make_dense();
+                if (vector_to_add->non_zero_count < 0)
+                {
+                    for (int64_t i = 0; i < dimension; i++)
+                    {
+                        add_product(high[i], low[i], multiplier_high, multiplier_low, add_high[i], add_low[i]);
+                    }
+                    return;
+                }
+            }
+            const int64_t* add_indices = vector_to_add->non_zero_indices.data();
+            for (int64_t t = 0; t < vector_to_add->non_zero_count; t++)
+            {
+                const int64_t index = add_indices[t];
+                add_product(high[index], low[index], multiplier_high, multiplier_low, add_high[index], add_low[index]);
+            }
+            list_indices(add_indices, vector_to_add->non_zero_count);
+        }
+
+        /// @brief Returns the dot product with @p other in double-double arithmetic.
+        [[nodiscard]] CompensatedDouble dot(const Vector<double>& other) const
+        {
+            const double* high = high_values.data();
+            const double* low = low_values.data();
+            const double* other_values = other.dense_values.data();
+            if (non_zero_count < 0 && other.non_zero_count < 0)
+            {
+                return reduce(dimension, [](const int64_t i) { return i; }, [&](double& sum_high, double& sum_low, const int64_t i)
+                {
+                    add_product(sum_high, sum_low, high[i], low[i], other_values[i], 0.0);
+                });
+            }
+            const bool iterate_this = other.non_zero_count < 0 ||
+                (non_zero_count >= 0 && non_zero_count <= other.non_zero_count);
+            const int64_t* indices = iterate_this ? non_zero_indices.data() : other.non_zero_indices.data();
+            return reduce(iterate_this ? non_zero_count : other.non_zero_count,
+                          [&](const int64_t t) { return indices[t]; },
+                          [&](double& sum_high, double& sum_low, const int64_t i)
+                          {
+                              add_product(sum_high, sum_low, high[i], low[i], other_values[i], 0.0);
+                          });
+        }
+
+        /// @brief Returns the squared Euclidean norm in double-double arithmetic.
+        [[nodiscard]] CompensatedDouble squared_euclidean_norm() const
+        {
+            const double* high = high_values.data();
+            const double* low = low_values.data();
+            const auto add_square = [&](double& sum_high, double& sum_low, const int64_t i)
+            {
+                add_product(sum_high, sum_low, high[i], low[i], high[i], low[i]);
+            };
+            if (non_zero_count < 0)
+            {
+                return reduce(dimension, [](const int64_t i) { return i; }, add_square);
+            }
+            const int64_t* indices = non_zero_indices.data();
+            return reduce(non_zero_count, [&](const int64_t t) { return indices[t]; }, add_square);
+        }
+
+    private:
+        // Number of independent partial sums of a reduction.
+        static constexpr int kLanes = 4;
+
+        // (high, low) += a * b, keeping the rounding error of the product and the sum.
+        static KALIX_FORCE_INLINE void add_product(double& high, double& low, const double a, const double b)
+        {
+            double product, product_error, sum, sum_error;
+            CompensatedDouble::two_product(product, product_error, a, b);
+            CompensatedDouble::two_sum(sum, sum_error, high, product);
+            high = sum;
+            low += sum_error + product_error;
+        }
+
+        // (high, low) += (a_high + a_low) * (b_high + b_low), dropping the product of the low parts.
+        static KALIX_FORCE_INLINE void add_product(double& high, double& low, const double a_high,
+                                                   const double a_low, const double b_high, const double b_low)
+        {
+            double product, product_error, sum, sum_error;
+            CompensatedDouble::two_product(product, product_error, a_high, b_high);
+            product_error += a_high * b_low + a_low * b_high;
+            CompensatedDouble::two_sum(sum, sum_error, high, product);
+            high = sum;
+            low += sum_error + product_error;
+        }
+
+        // Calls accumulate(sum_high, sum_low, index(t)) for t in [0, count), spreading consecutive
+        // terms over kLanes partial sums that are combined at the end.
+        template <typename Index, typename Accumulate>
+        static CompensatedDouble reduce(const int64_t count, Index&& index, Accumulate&& accumulate)
+        {
+            double sum_high[kLanes] = {};
+            double sum_low[kLanes] = {};
+            int64_t t = 0;
+            for (; t + kLanes <= count; t += kLanes)
+            {
+                for (int lane = 0; lane < kLanes; lane++)
+                {
+                    accumulate(sum_high[lane], sum_low[lane], index(t + lane));
+                }
+            }
+            for (; t < count; t++)
+            {
+                accumulate(sum_high[0], sum_low[0], index(t));
+            }
+            CompensatedDouble result(0.0);
+            for (int lane = 0; lane < kLanes; lane++)
+            {
+                result += CompensatedDouble(sum_high[lane], sum_low[lane]);
+            }
+            return result;
+        }
+
+        // Lists index without branching; an index that is already listed is overwritten next time.
+        KALIX_FORCE_INLINE void touch(const int64_t index)
+        {
+            non_zero_indices[non_zero_count] = index;
+            non_zero_count += !index_flags[index];
+            index_flags[index] = 1;
+        }
+
+        // Lists the indices the last update wrote to, unless the vector is dense, and drops the
+        // list once it exceeds the dense fraction.
+        void list_indices(const int64_t* indices, const int64_t count)
+        {
+            if (non_zero_count < 0)
+            {
+                return;
+            }
+            for (int64_t t = 0; t < count; t++)
+            {
+                touch(indices[t]);
+            }
+            if (non_zero_count > dimension * Vector<double>::kDenseFraction)
+            {
+                make_dense();
+            }
+        }
+    };
+}
+
+#endif // KALIX_BASE_COMPENSATED_VECTOR_H_
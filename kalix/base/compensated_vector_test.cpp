@@ -0,0 +1,215 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "kalix/base/compensated_double.h"
+#include "kalix/base/compensated_vector.h"
+#include "kalix/base/vector.h"
+
+class CompensatedVectorTest : public ::testing::Test
+{
+protected:
+    kalix::CompensatedVector vec;
+    kalix::Vector<double> x;
+    const int64_t kSize = 10;
+
+    void SetUp() override
+    {
+        vec.setup(kSize);
+        x.setup(kSize);
+    }
+};
+
+TEST_F(CompensatedVectorTest, Initialization)
+{
+    EXPECT_EQ(vec.dimension, kSize);
+    EXPECT_EQ(vec.non_zero_count, 0);
+    EXPECT_EQ(vec.high_values.size(), static_cast<size_t>(kSize));
+    EXPECT_EQ(vec.low_values.size(), static_cast<size_t>(kSize));
+}
+
+TEST_F(CompensatedVectorTest, SaxpyKeepsRoundingErrors)
+{
+    // 1 + 1e-20 - 1 is lost in double arithmetic but kept in the low part.
+    x.dense_values[3] = 1.0;
+    x.non_zero_indices[0] = 3;
+    x.non_zero_count = 1;
+    vec.saxpy(1.0, &x);
+    x.dense_values[3] = 1e-20;
+    vec.saxpy(1.0, &x);
+    x.dense_values[3] = 1.0;
+    vec.saxpy(-1.0, &x);
+
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.non_zero_indices[0], 3);
+    EXPECT_DOUBLE_EQ(static_cast<double>(vec.value(3)), 1e-20);
+}
+
+TEST_F(CompensatedVectorTest, ProductErrorIsKept)
+{
+    // (1 + 2^-30)^2 = 1 + 2^-29 + 2^-60; the last term does not fit in a double.
+    const double a = 1.0 + 0x1p-30;
+    x.dense_values[0] = a;
+    x.make_dense();
+    vec.saxpy(a, &x);
+    vec.saxpy(-1.0 - 0x1p-29, &x);
+
+    // a*a - (1 + 2^-29)*a = -2^-30 - 2^-60, which plain double arithmetic rounds away.
+    kalix::CompensatedDouble expected = kalix::CompensatedDouble(a) * a;
+    expected -= kalix::CompensatedDouble(1.0 + 0x1p-29) * a;
+    EXPECT_EQ(vec.non_zero_count, -1);
+    EXPECT_DOUBLE_EQ(static_cast<double>(vec.value(0)), static_cast<double>(expected));
+    EXPECT_NE(static_cast<double>(vec.value(0)), a * a - (1.0 + 0x1p-29) * a);
+}
+
+TEST_F(CompensatedVectorTest, MatchesCompensatedDoubleVector)
+{
+    kalix::Vector<kalix::CompensatedDouble> reference;
+    reference.setup(kSize);
+    for (int64_t i = 0; i < kSize; i += 2)
+    {
+        x.dense_values[i] = 1.0 / static_cast<double>(i + 3);
+        x.non_zero_indices[x.non_zero_count++] = i;
+    }
+    for (const double multiplier : {0.1, 1.0 / 3.0, -7.0})
+    {
+        vec.saxpy(multiplier, &x);
+        for (int64_t t = 0; t < x.non_zero_count; t++)
+        {
+            const int64_t i = x.non_zero_indices[t];
+            reference.dense_values[i] += kalix::CompensatedDouble(multiplier) * x.dense_values[i];
+        }
+    }
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_NEAR(static_cast<double>(vec.value(i)), static_cast<double>(reference.dense_values[i]), 1e-30);
+    }
+
+    kalix::CompensatedDouble expected_norm(0.0);
+    kalix::CompensatedDouble expected_dot(0.0);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        expected_norm += reference.dense_values[i] * reference.dense_values[i];
+        expected_dot += reference.dense_values[i] * x.dense_values[i];
+    }
+    EXPECT_NEAR(static_cast<double>(vec.squared_euclidean_norm()), static_cast<double>(expected_norm), 1e-28);
+    EXPECT_NEAR(static_cast<double>(vec.dot(x)), static_cast<double>(expected_dot), 1e-28);
+}
+
+TEST_F(CompensatedVectorTest, CompensatedSaxpyAndDensePromotion)
+{
+    kalix::CompensatedVector other;
+    other.setup(kSize);
+    for (int64_t i = 0; i < 4; i++)
+    {
+        x.dense_values[i] = 1.0;
+        x.non_zero_indices[i] = i;
+    }
+    x.non_zero_count = 4;
+    other.copy_from(&x);
+    EXPECT_EQ(other.non_zero_count, 4);
+
+    // Four of ten entries exceed the dense fraction.
+    vec.saxpy(kalix::CompensatedDouble(2.0), &other);
+    EXPECT_EQ(vec.non_zero_count, -1);
+    EXPECT_DOUBLE_EQ(static_cast<double>(vec.value(3)), 2.0);
+    EXPECT_DOUBLE_EQ(static_cast<double>(vec.squared_euclidean_norm()), 16.0);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_EQ(vec.index_flags[i], 0);
+    }
+
+    vec.clear();
+    EXPECT_EQ(vec.non_zero_count, 0);
+    EXPECT_DOUBLE_EQ(static_cast<double>(vec.value(3)), 0.0);
+}
+
+TEST_F(CompensatedVectorTest, CopyFromAndExportTo)
+{
+    kalix::Vector<kalix::CompensatedDouble> source;
+    source.setup(kSize);
+    source.dense_values[5] = kalix::CompensatedDouble(1.0) + 1e-20;
+    source.non_zero_indices[0] = 5;
+    source.non_zero_count = 1;
+
+    vec.copy_from(&source);
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_DOUBLE_EQ(vec.high_values[5], 1.0);
+    EXPECT_DOUBLE_EQ(vec.low_values[5], 1e-20);
+
+    kalix::Vector<kalix::CompensatedDouble> exported;
+    exported.setup(kSize);
+    exported.dense_values[1] = kalix::CompensatedDouble(9.0);
+    exported.non_zero_indices[0] = 1;
+    exported.non_zero_count = 1;
+    vec.export_to(&exported);
+    ASSERT_EQ(exported.non_zero_count, 1);
+    EXPECT_EQ(exported.non_zero_indices[0], 5);
+    EXPECT_DOUBLE_EQ(static_cast<double>(exported.dense_values[5] - 1.0), 1e-20);
+    EXPECT_DOUBLE_EQ(static_cast<double>(exported.dense_values[1]), 0.0);
+
+    kalix::Vector<double> rounded;
+    rounded.setup(kSize);
+    vec.export_to(&rounded);
+    EXPECT_DOUBLE_EQ(rounded.dense_values[5], 1.0);
+}
+
+TEST_F(CompensatedVectorTest, ExportSkipsCancelledEntries)
+{
+    x.dense_values[3] = 3.0;
+    x.dense_values[6] = 1.0;
+    x.non_zero_indices[0] = 3;
+    x.non_zero_indices[1] = 6;
+    x.non_zero_count = 2;
+    vec.saxpy(1.0, &x);
+    vec.saxpy(-1.0, &x);
+    ASSERT_EQ(vec.non_zero_count, 2);
+
+    kalix::Vector<double> exported;
+    exported.setup(kSize);
+    vec.export_to(&exported);
+    EXPECT_EQ(exported.non_zero_count, 0);
+
+    // A later saxpy lists every index once.
+    exported.saxpy(1.0, &x);
+    EXPECT_EQ(exported.non_zero_count, 2);
+    EXPECT_DOUBLE_EQ(exported.squared_euclidean_norm(), 10.0);
+
+    // With a mask, only the surviving entries are flagged.
+    kalix::Vector<double> masked;
+    masked.setup(kSize);
+    masked.enable_index_mask();
+    x.dense_values[6] = 0.5;
+    vec.saxpy(1.0, &x);
+    x.dense_values[3] = 0.0;
+    vec.saxpy(-1.0, &x);
+    vec.export_to(&masked);
+    ASSERT_EQ(masked.non_zero_count, 1);
+    EXPECT_EQ(masked.non_zero_indices[0], 3);
+    EXPECT_EQ(masked.char_workspace[3], 1);
+    EXPECT_EQ(masked.char_workspace[6], 0);
+    x.dense_values[3] = 1.0;
+    masked.saxpy(1.0, &x);
+    EXPECT_EQ(masked.non_zero_count, 2);
+    EXPECT_DOUBLE_EQ(masked.squared_euclidean_norm(), 16.0 + 0.25);
+}
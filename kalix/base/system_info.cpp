@@ -21,6 +21,9 @@
 
 #include "kalix/base/system_info.h"
 
+#include <thread>
+#include <utility>
+
 #if defined(_WIN32)
 #include <windows.h>
 #include <psapi.h>
@@ -31,6 +34,8 @@
 #include <mach/mach.h>
 
 #elif defined(__linux__) || defined(__linux)
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <cstdio>
 #include <sys/types.h>
@@ -120,5 +125,116 @@ namespace kalix::system
         return 0;
     }
 
+#endif
+
+    namespace
+    {
+        std::vector<std::vector<int>> single_node_topology()
+        {
+            const unsigned int cpu_count = std::thread::hardware_concurrency();
+            std::vector<int> cpus(cpu_count == 0 ? 1 : cpu_count);
+            for (size_t i = 0; i < cpus.size(); i++)
+            {
+                cpus[i] = static_cast<int>(i);
+            }
+            return {cpus};
+        }
+    }
+
+#if defined(__linux__) || defined(__linux)
+
+    std::vector<std::vector<int>> get_numa_node_cpus()
+    {
+        std::vector<std::vector<int>> nodes;
+        for (int node = 0;; node++)
+        {
+            char path[64];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            FILE* file = std::fopen(path, "r");
+            if (!file)
+            {
+                break;
+            }
+
+            // cpulist format: comma separated ranges, e.g. "0-3,8-11"
+            std::vector<int> cpus;
+            int first = 0;
+            while (std::fscanf(file, "%d", &first) == 1)
+            {
+                int last = first;
+                int separator = std::fgetc(file);
+                if (separator == '-')
+                {
+                    if (std::fscanf(file, "%d", &last) != 1)
+                    {
+                        break;
+                    }
+                    separator = std::fgetc(file);
+                }
+                for (int cpu = first; cpu <= last; cpu++)
+                {
+                    cpus.push_back(cpu);
+                }
+                if (separator != ',')
+                {
+                    break;
+                }
+            }
+            std::fclose(file);
+
+            if (!cpus.empty())
+            {
+                nodes.push_back(std::move(cpus));
+            }
+        }
+
+        if (nodes.empty())
+        {
+            return single_node_topology();
+        }
+        return nodes;
+    }
+
+    bool pin_current_thread_to_cpu(const int cpu)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+#elif defined(_WIN32)
+
+    std::vector<std::vector<int>> get_numa_node_cpus()
+    {
+        return single_node_topology();
+    }
+
+    bool pin_current_thread_to_cpu(const int cpu)
+    {
+        if (cpu < 0 || cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+        {
+            return false;
+        }
+        return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0;
+    }
+
+#else
+
+    // macOS and the BSDs expose neither NUMA nodes nor hard thread affinity uniformly.
+    std::vector<std::vector<int>> get_numa_node_cpus()
+    {
+        return single_node_topology();
+    }
+
+    bool pin_current_thread_to_cpu(int)
+    {
+        return false;
+    }
+
 #endif
 } // namespace kalix::system
@@ -23,6 +23,7 @@
 #define KALIX_BASE_SYSTEM_INFO_H_
 
 #include <cstddef>
+#include <vector>
 
 namespace kalix::system
 {
@@ -32,6 +33,24 @@ namespace kalix::system
      * @return The memory usage in bytes, or 0 if the system call fails.
      */
     [[nodiscard]] size_t get_process_memory_usage();
+
+    /**
+     * @brief Returns the logical CPUs of every NUMA node.
+     *
+     * On systems without NUMA information, a single node containing all logical CPUs
+     * reported by the standard library is returned. The result is never empty.
+     *
+     * @return One list of logical CPU ids per NUMA node.
+     */
+    [[nodiscard]] std::vector<std::vector<int>> get_numa_node_cpus();
+
+    /**
+     * @brief Restricts the calling thread to a single logical CPU.
+     *
+     * @param cpu The logical CPU id.
+     * @return True if the affinity was set, false if unsupported or the call failed.
+     */
+    bool pin_current_thread_to_cpu(int cpu);
 }
 
 #endif // KALIX_BASE_SYSTEM_INFO_H_
@@ -60,3 +60,18 @@ TEST(SystemInfoTest, DetectsMemoryIncrease) {
     EXPECT_GE(spiked_memory, initial_memory)
         << "Memory usage did not increase after allocating 10MB.";
 }
+
+TEST(SystemInfoTest, NumaTopologyIsNonEmpty) {
+    const auto nodes = kalix::system::get_numa_node_cpus();
+    ASSERT_FALSE(nodes.empty());
+    for (const auto& cpus : nodes) {
+        EXPECT_FALSE(cpus.empty());
+        for (const int cpu : cpus) {
+            EXPECT_GE(cpu, 0);
+        }
+    }
+}
+
+TEST(SystemInfoTest, PinningToInvalidCpuFails) {
+    EXPECT_FALSE(kalix::system::pin_current_thread_to_cpu(-1));
+}
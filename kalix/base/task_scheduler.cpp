@@ -0,0 +1,387 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/base/task_scheduler.h"
+
+#include <chrono>
+
+#include "kalix/base/system_info.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace kalix
+{
+    namespace
+    {
+        KALIX_FORCE_INLINE void cpu_relax()
+        {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        // xorshift64*: cheap per-worker randomness for victim selection.
+        KALIX_FORCE_INLINE uint64_t next_random(uint64_t& state)
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1DULL;
+        }
+    }
+
+    TaskScheduler::TaskScheduler(const TaskSchedulerOptions& options)
+        : options_(options)
+    {
+        int num_threads = options_.num_threads;
+        if (num_threads <= 0)
+        {
+            num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
+        // Fill NUMA nodes one after the other so that neighbouring workers share a node.
+        std::vector<int> cpu_order;
+        std::vector<int> cpu_node;
+        const auto nodes = system::get_numa_node_cpus();
+        for (size_t node = 0; node < nodes.size(); node++)
+        {
+            for (const int cpu : nodes[node])
+            {
+                cpu_order.push_back(cpu);
+                cpu_node.push_back(static_cast<int>(node));
+            }
+        }
+
+        workers_.reserve(num_threads);
+        for (int i = 0; i < num_threads; i++)
+        {
+            auto worker = std::make_unique<Worker>();
+            const size_t slot = static_cast<size_t>(i) % cpu_order.size();
+            worker->scheduler = this;
+            worker->index = i;
+            worker->node = cpu_node[slot];
+            // Slot 0 belongs to whichever external thread enters the scheduler and is never pinned.
+            worker->cpu = options_.pin_workers && i > 0 ? cpu_order[slot] : -1;
+            worker->random_state = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(i + 1);
+            workers_.push_back(std::move(worker));
+        }
+
+        for (const auto& worker : workers_)
+        {
+            for (const auto& other : workers_)
+            {
+                if (other->index != worker->index && other->node == worker->node)
+                {
+                    worker->victims.push_back(other->index);
+                }
+            }
+            worker->same_node_victims = static_cast<int>(worker->victims.size());
+            for (const auto& other : workers_)
+            {
+                if (other->node != worker->node)
+                {
+                    worker->victims.push_back(other->index);
+                }
+            }
+        }
+
+        threads_.reserve(num_threads - 1);
+        for (int i = 1; i < num_threads; i++)
+        {
+            threads_.emplace_back([this, i] { worker_loop(*workers_[i]); });
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        stop_.store(true, std::memory_order_release);
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        epoch_.notify_all();
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    void TaskScheduler::spawn(Task* task)
+    {
+        DCHECK(task->pending != nullptr);
+
+        Worker* worker = current_worker_;
+        if (worker != nullptr && worker->scheduler == this)
+        {
+            worker->deque.push(task);
+        }
+        else
+        {
+            std::lock_guard lock(injection_mutex_);
+            injection_queue_.push_back(task);
+            injected_count_.fetch_add(1, std::memory_order_release);
+        }
+        notify_work_available();
+    }
+
+    void TaskScheduler::wait(std::atomic<int64_t>& pending)
+    {
+        Worker* worker = current_worker_;
+        if (worker == nullptr || worker->scheduler != this)
+        {
+            if (external_slot_busy_.exchange(true, std::memory_order_acquire))
+            {
+                block_until_done(pending);
+                return;
+            }
+            current_worker_ = workers_[0].get();
+            wait(pending);
+            current_worker_ = worker;
+            external_slot_busy_.store(false, std::memory_order_release);
+            return;
+        }
+
+        while (pending.load(std::memory_order_acquire) != 0)
+        {
+            if (Task* task = find_task(*worker))
+            {
+                execute(worker, task);
+            }
+            else
+            {
+                cpu_relax();
+            }
+        }
+    }
+
+    void TaskScheduler::block_until_done(std::atomic<int64_t>& pending)
+    {
+        // Without a worker slot only injected tasks can be run here; anything else is left to
+        // the background workers.
+        while (pending.load(std::memory_order_acquire) != 0)
+        {
+            if (Task* task = take_injected_task())
+            {
+                execute(nullptr, task);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void TaskScheduler::execute(Worker* worker, Task* task)
+    {
+        task->run();
+        if (worker != nullptr)
+        {
+            worker->tasks_executed.store(worker->tasks_executed.load(std::memory_order_relaxed) + 1,
+                                         std::memory_order_relaxed);
+        }
+
+        // The task may live in the frame that waits on the counter, so it must not be touched
+        // after the decrement.
+        std::atomic<int64_t>* pending = task->pending;
+        if (task->owned)
+        {
+            delete task;
+        }
+        pending->fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    Task* TaskScheduler::find_task(Worker& worker)
+    {
+        if (const auto task = worker.deque.pop())
+        {
+            return *task;
+        }
+        if (Task* task = steal_task(worker))
+        {
+            return task;
+        }
+        return take_injected_task();
+    }
+
+    Task* TaskScheduler::steal_task(Worker& worker)
+    {
+        const auto victim_count = static_cast<int>(worker.victims.size());
+        if (victim_count == 0)
+        {
+            return nullptr;
+        }
+
+        // Probe the own node from a random start, then the remote nodes from a random start.
+        const auto try_range = [&](const int first, const int count) -> Task*
+        {
+            if (count == 0)
+            {
+                return nullptr;
+            }
+            const int start = static_cast<int>(next_random(worker.random_state) % static_cast<uint64_t>(count));
+            for (int k = 0; k < count; k++)
+            {
+                Worker& victim = *workers_[worker.victims[first + (start + k) % count]];
+                if (victim.deque.empty())
+                {
+                    continue;
+                }
+                if (const auto task = victim.deque.steal())
+                {
+                    worker.steals.store(worker.steals.load(std::memory_order_relaxed) + 1,
+                                        std::memory_order_relaxed);
+                    return *task;
+                }
+                worker.failed_steals.store(worker.failed_steals.load(std::memory_order_relaxed) + 1,
+                                           std::memory_order_relaxed);
+            }
+            return nullptr;
+        };
+
+        if (Task* task = try_range(0, worker.same_node_victims))
+        {
+            return task;
+        }
+        return try_range(worker.same_node_victims, victim_count - worker.same_node_victims);
+    }
+
+    Task* TaskScheduler::take_injected_task()
+    {
+        if (injected_count_.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+        std::lock_guard lock(injection_mutex_);
+        if (injection_queue_.empty())
+        {
+            return nullptr;
+        }
+        Task* task = injection_queue_.front();
+        injection_queue_.pop_front();
+        injected_count_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    bool TaskScheduler::has_visible_work() const
+    {
+        if (injected_count_.load(std::memory_order_relaxed) > 0)
+        {
+            return true;
+        }
+        return std::ranges::any_of(workers_, [](const auto& worker) { return !worker->deque.empty(); });
+    }
+
+    void TaskScheduler::notify_work_available()
+    {
+        // Pairs with the fence in worker_loop: either the sleeper sees the new work, or we see it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0)
+        {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_one();
+        }
+    }
+
+    void TaskScheduler::worker_loop(Worker& worker)
+    {
+        current_worker_ = &worker;
+        if (worker.cpu >= 0)
+        {
+            system::pin_current_thread_to_cpu(worker.cpu);
+        }
+
+        int idle_rounds = 0;
+        while (!stop_.load(std::memory_order_acquire))
+        {
+            if (Task* task = find_task(worker))
+            {
+                execute(&worker, task);
+                idle_rounds = 0;
+                continue;
+            }
+
+            if (++idle_rounds < options_.spin_rounds)
+            {
+                cpu_relax();
+                continue;
+            }
+            idle_rounds = 0;
+
+            const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            sleepers_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!stop_.load(std::memory_order_acquire) && !has_visible_work())
+            {
+                const auto start = std::chrono::steady_clock::now();
+                worker.sleeps.store(worker.sleeps.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                epoch_.wait(epoch, std::memory_order_acquire);
+                const auto idle = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                worker.idle_nanoseconds.store(worker.idle_nanoseconds.load(std::memory_order_relaxed) + idle,
+                                              std::memory_order_relaxed);
+            }
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        current_worker_ = nullptr;
+    }
+
+    std::vector<WorkerStatistics> TaskScheduler::statistics() const
+    {
+        std::vector<WorkerStatistics> result;
+        result.reserve(workers_.size());
+        for (const auto& worker : workers_)
+        {
+            result.push_back({
+                .tasks_executed = worker->tasks_executed.load(std::memory_order_relaxed),
+                .steals = worker->steals.load(std::memory_order_relaxed),
+                .failed_steals = worker->failed_steals.load(std::memory_order_relaxed),
+                .sleeps = worker->sleeps.load(std::memory_order_relaxed),
+                .idle_nanoseconds = worker->idle_nanoseconds.load(std::memory_order_relaxed),
+            });
+        }
+        return result;
+    }
+
+    WorkerStatistics TaskScheduler::total_statistics() const
+    {
+        WorkerStatistics total;
+        for (const auto& statistics : statistics())
+        {
+            total += statistics;
+        }
+        return total;
+    }
+
+    void TaskScheduler::reset_statistics()
+    {
+        for (const auto& worker : workers_)
+        {
+            worker->tasks_executed.store(0, std::memory_order_relaxed);
+            worker->steals.store(0, std::memory_order_relaxed);
+            worker->failed_steals.store(0, std::memory_order_relaxed);
+            worker->sleeps.store(0, std::memory_order_relaxed);
+            worker->idle_nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,460 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_TASK_SCHEDULER_H_
+#define KALIX_BASE_TASK_SCHEDULER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+#include "kalix/base/work_stealing_deque.h"
+
+namespace kalix
+{
+    class TaskScheduler;
+
+    /// @brief A unit of work executed by a @ref TaskScheduler.
+    ///
+    /// Tasks are intrusive: the scheduler only stores pointers, so tasks spawned by
+    /// @ref TaskScheduler::parallel_for and @ref TaskScheduler::invoke live on the stack of the
+    /// spawning frame, which waits for them before returning. No allocation happens on that path.
+    class Task
+    {
+    public:
+        virtual ~Task() = default;
+
+        /// @brief Executes the work.
+        virtual void run() = 0;
+
+        /// @brief Counter decremented once the task has finished.
+        std::atomic<int64_t>* pending = nullptr;
+
+        /// @brief Whether the task was heap allocated and must be deleted after running.
+        bool owned = false;
+    };
+
+    /// @brief Options of a @ref TaskScheduler.
+    struct TaskSchedulerOptions
+    {
+        /// @brief Total number of threads including the calling thread. 0 uses all hardware threads.
+        int num_threads = 0;
+
+        /// @brief Pin every background worker to one logical CPU, filling NUMA nodes one by one.
+        bool pin_workers = false;
+
+        /// @brief Number of failed work searches before an idle worker goes to sleep.
+        int spin_rounds = 128;
+    };
+
+    /// @brief Counters of a single worker since construction or the last reset.
+    struct WorkerStatistics
+    {
+        /// @brief Number of tasks executed by the worker.
+        int64_t tasks_executed = 0;
+
+        /// @brief Number of tasks the worker stole from other workers.
+        int64_t steals = 0;
+
+        /// @brief Number of steal attempts that found an empty deque or lost a race.
+        int64_t failed_steals = 0;
+
+        /// @brief Number of times the worker went to sleep.
+        int64_t sleeps = 0;
+
+        /// @brief Time spent sleeping, in nanoseconds.
+        int64_t idle_nanoseconds = 0;
+
+        WorkerStatistics& operator+=(const WorkerStatistics& other)
+        {
+            tasks_executed += other.tasks_executed;
+            steals += other.steals;
+            failed_steals += other.failed_steals;
+            sleeps += other.sleeps;
+            idle_nanoseconds += other.idle_nanoseconds;
+            return *this;
+        }
+    };
+
+    /// @brief A work-stealing thread pool for fine-grained fork/join parallelism.
+    ///
+    /// Every worker owns a Chase–Lev deque (@ref WorkStealingDeque). Spawned tasks are pushed to
+    /// the deque of the spawning worker and popped in LIFO order, idle workers steal in FIFO
+    /// order, preferring victims on their own NUMA node. Waiting threads help by executing
+    /// tasks instead of blocking, so nested @ref parallel_for calls do not deadlock.
+    ///
+    /// Slot 0 is reserved for an external thread: the first non-worker thread that enters the
+    /// scheduler becomes a worker for the duration of the call and participates in the work.
+    /// Concurrent external callers fall back to a locked injection queue and block.
+    ///
+    /// Idle workers spin for a short while and then sleep on an atomic epoch, so dispatching
+    /// to a busy pool costs a deque push and a fence, and only waking a sleeping pool pays for
+    /// a futex wake.
+    class TaskScheduler
+    {
+    public:
+        /// @brief Starts the background workers.
+        explicit TaskScheduler(const TaskSchedulerOptions& options = {});
+
+        /// @brief Stops and joins all background workers. No work may be pending.
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /// @brief Returns the total number of threads, including the participating caller.
+        [[nodiscard]] KALIX_FORCE_INLINE int num_threads() const
+        {
+            return static_cast<int>(workers_.size());
+        }
+
+        /// @brief Returns the worker index of the calling thread, or -1 if it is not a worker.
+        [[nodiscard]] KALIX_FORCE_INLINE int current_worker_index() const
+        {
+            const Worker* worker = current_worker_;
+            return worker != nullptr && worker->scheduler == this ? worker->index : -1;
+        }
+
+        /// @brief Calls @c body(i) for every @c i in @c [begin, end) in parallel.
+        ///
+        /// The range is split recursively in halves until pieces contain at most @p grain
+        /// indices. The calling thread executes the leftmost piece of every split and then
+        /// helps with the remaining work until the whole range is done.
+        ///
+        /// @param begin The first index.
+        /// @param end One past the last index.
+        /// @param grain Maximum number of indices per task; values <= 0 choose one automatically.
+        /// @param body Callable invoked as @c body(int64_t). Must be safe to call concurrently.
+        template <typename Body>
+        void parallel_for(const int64_t begin, const int64_t end, int64_t grain, Body&& body)
+        {
+            if (begin >= end)
+            {
+                return;
+            }
+            if (grain <= 0)
+            {
+                grain = std::max<int64_t>(1, (end - begin) / (8 * static_cast<int64_t>(num_threads())));
+            }
+            if (end - begin <= grain || num_threads() == 1)
+            {
+                for (int64_t i = begin; i < end; i++)
+                {
+                    body(i);
+                }
+                return;
+            }
+
+            run_as_worker([&]
+            {
+                split_range(begin, end, grain, body);
+            });
+        }
+
+        /// @brief Runs @p first and @p second potentially in parallel and waits for both.
+        template <typename First, typename Second>
+        void invoke(First&& first, Second&& second)
+        {
+            if (num_threads() == 1)
+            {
+                first();
+                second();
+                return;
+            }
+
+            run_as_worker([&]
+            {
+                std::atomic<int64_t> pending{1};
+                CallableTask<Second> second_task(second);
+                second_task.pending = &pending;
+                spawn(&second_task);
+                first();
+                wait(pending);
+            });
+        }
+
+        /// @brief Enqueues @p task. Its @ref Task::pending counter must already account for it.
+        void spawn(Task* task);
+
+        /// @brief Waits until @p pending drops to zero, executing other tasks in the meantime.
+        void wait(std::atomic<int64_t>& pending);
+
+        /// @brief Returns the counters of every worker.
+        [[nodiscard]] std::vector<WorkerStatistics> statistics() const;
+
+        /// @brief Returns the counters summed over all workers.
+        [[nodiscard]] WorkerStatistics total_statistics() const;
+
+        /// @brief Resets all counters to zero.
+        void reset_statistics();
+
+        /// @brief Returns the logical CPU a worker is pinned to, or -1 if it is not pinned.
+        [[nodiscard]] int worker_cpu(const int worker_index) const
+        {
+            DCHECK_GE(worker_index, 0);
+            DCHECK_LT(worker_index, num_threads());
+            return workers_[worker_index]->cpu;
+        }
+
+    private:
+        template <typename F>
+        class CallableTask final : public Task
+        {
+        public:
+            explicit CallableTask(F& callable)
+                : callable_(callable)
+            {
+            }
+
+            void run() override
+            {
+                callable_();
+            }
+
+        private:
+            F& callable_;
+        };
+
+        template <typename Body>
+        class RangeTask final : public Task
+        {
+        public:
+            void run() override
+            {
+                scheduler->split_range(begin, end, grain, *body);
+            }
+
+            TaskScheduler* scheduler = nullptr;
+            int64_t begin = 0;
+            int64_t end = 0;
+            int64_t grain = 0;
+            Body* body = nullptr;
+        };
+
+        struct alignas(kCacheLineSize) Worker
+        {
+            WorkStealingDeque<Task*> deque;
+            TaskScheduler* scheduler = nullptr;
+            int index = 0;
+            int cpu = -1;
+            int node = 0;
+            uint64_t random_state = 0;
+
+            // Victims on the same NUMA node first, then all others.
+            std::vector<int> victims;
+            int same_node_victims = 0;
+
+            std::atomic<int64_t> tasks_executed{0};
+            std::atomic<int64_t> steals{0};
+            std::atomic<int64_t> failed_steals{0};
+            std::atomic<int64_t> sleeps{0};
+            std::atomic<int64_t> idle_nanoseconds{0};
+        };
+
+        template <typename Body>
+        void split_range(const int64_t begin, int64_t end, const int64_t grain, Body& body)
+        {
+            // Every split halves the range, so 64 levels cover any int64_t range.
+            RangeTask<Body> tasks[64];
+            std::atomic<int64_t> pending{0};
+            int task_count = 0;
+
+            while (end - begin > grain)
+            {
+                const int64_t middle = begin + (end - begin) / 2;
+                RangeTask<Body>& task = tasks[task_count++];
+                task.scheduler = this;
+                task.begin = middle;
+                task.end = end;
+                task.grain = grain;
+                task.body = &body;
+                task.pending = &pending;
+                pending.fetch_add(1, std::memory_order_relaxed);
+                spawn(&task);
+                end = middle;
+            }
+
+            for (int64_t i = begin; i < end; i++)
+            {
+                body(i);
+            }
+
+            if (task_count > 0)
+            {
+                wait(pending);
+            }
+        }
+
+        /// @brief Runs @p function on a worker of this scheduler, entering slot 0 if possible.
+        template <typename F>
+        void run_as_worker(F&& function)
+        {
+            if (current_worker_index() >= 0)
+            {
+                function();
+                return;
+            }
+
+            if (!external_slot_busy_.exchange(true, std::memory_order_acquire))
+            {
+                Worker* previous = current_worker_;
+                current_worker_ = workers_[0].get();
+                function();
+                current_worker_ = previous;
+                external_slot_busy_.store(false, std::memory_order_release);
+                return;
+            }
+
+            // Another external thread occupies slot 0: hand the work to the background workers.
+            std::atomic<int64_t> pending{1};
+            CallableTask<F> task(function);
+            task.pending = &pending;
+            spawn(&task);
+            block_until_done(pending);
+        }
+
+        void block_until_done(std::atomic<int64_t>& pending);
+        void execute(Worker* worker, Task* task);
+        Task* find_task(Worker& worker);
+        Task* steal_task(Worker& worker);
+        Task* take_injected_task();
+        [[nodiscard]] bool has_visible_work() const;
+        void notify_work_available();
+        void worker_loop(Worker& worker);
+
+        inline static thread_local Worker* current_worker_ = nullptr;
+
+        TaskSchedulerOptions options_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+
+        std::mutex injection_mutex_;
+        std::deque<Task*> injection_queue_;
+        std::atomic<int64_t> injected_count_{0};
+
+        alignas(kCacheLineSize) std::atomic<bool> external_slot_busy_{false};
+        alignas(kCacheLineSize) std::atomic<uint32_t> epoch_{0};
+        alignas(kCacheLineSize) std::atomic<int> sleepers_{0};
+        std::atomic<bool> stop_{false};
+    };
+
+    /// @brief Calls @c body(i) for every @c i in @c [begin, end), in parallel on @p scheduler, or
+    /// serially on the calling thread if @p scheduler is @c nullptr.
+    ///
+    /// For solvers whose scheduler is optional; see @ref TaskScheduler::parallel_for for
+    /// @p grain and the requirements on @p body.
+    template <typename Body>
+    void parallel_for(TaskScheduler* scheduler, const int64_t begin, const int64_t end, const int64_t grain,
+                      Body&& body)
+    {
+        if (scheduler != nullptr)
+        {
+            scheduler->parallel_for(begin, end, grain, body);
+            return;
+        }
+        for (int64_t i = begin; i < end; i++)
+        {
+            body(i);
+        }
+    }
+
+    /// @brief A set of heap-allocated tasks that can be joined together (fork/join).
+    ///
+    /// Use for irregular task trees where stack allocation is inconvenient; for loops prefer
+    /// @ref TaskScheduler::parallel_for, which does not allocate.
+    class TaskGroup
+    {
+    public:
+        /// @brief Creates an empty group on @p scheduler.
+        explicit TaskGroup(TaskScheduler& scheduler)
+            : scheduler_(scheduler)
+        {
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /// @brief Waits for all outstanding tasks.
+        ~TaskGroup()
+        {
+            wait();
+        }
+
+        /// @brief Spawns @p function as a new task of this group.
+        template <typename F>
+        void run(F&& function)
+        {
+            auto* task = new OwnedTask<std::decay_t<F>>(std::forward<F>(function));
+            task->pending = &pending_;
+            task->owned = true;
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            scheduler_.spawn(task);
+        }
+
+        /// @brief Waits until every task spawned so far has finished.
+        void wait()
+        {
+            if (pending_.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+            scheduler_.wait(pending_);
+        }
+
+    private:
+        template <typename F>
+        class OwnedTask final : public Task
+        {
+        public:
+            explicit OwnedTask(F&& function)
+                : function_(std::move(function))
+            {
+            }
+
+            explicit OwnedTask(const F& function)
+                : function_(function)
+            {
+            }
+
+            void run() override
+            {
+                function_();
+            }
+
+        private:
+            F function_;
+        };
+
+        TaskScheduler& scheduler_;
+        std::atomic<int64_t> pending_{0};
+    };
+}
+
+#endif // KALIX_BASE_TASK_SCHEDULER_H_
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+
+namespace
+{
+    int64_t fibonacci(kalix::TaskScheduler& scheduler, const int64_t n)
+    {
+        if (n < 2)
+        {
+            return n;
+        }
+        int64_t a = 0;
+        int64_t b = 0;
+        scheduler.invoke([&] { a = fibonacci(scheduler, n - 1); }, [&] { b = fibonacci(scheduler, n - 2); });
+        return a + b;
+    }
+}
+
+class TaskSchedulerTest : public ::testing::TestWithParam<int>
+{
+};
+
+TEST_P(TaskSchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    constexpr int64_t kSize = 100000;
+    std::vector<std::atomic<int>> visits(kSize);
+
+    scheduler.parallel_for(0, kSize, 64, [&](const int64_t i) { visits[i].fetch_add(1, std::memory_order_relaxed); });
+
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST_P(TaskSchedulerTest, AutomaticGrainAndEmptyRange)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    std::atomic<int64_t> sum{0};
+
+    scheduler.parallel_for(10, 10, 0, [&](const int64_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), 0);
+
+    scheduler.parallel_for(0, 1000, 0, [&](const int64_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), 999 * 1000 / 2);
+}
+
+TEST_P(TaskSchedulerTest, NestedParallelFor)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    constexpr int64_t kOuter = 32;
+    constexpr int64_t kInner = 512;
+    std::vector<int64_t> sums(kOuter, 0);
+
+    scheduler.parallel_for(0, kOuter, 1, [&](const int64_t i)
+    {
+        std::atomic<int64_t> inner_sum{0};
+        scheduler.parallel_for(0, kInner, 16, [&](const int64_t j) { inner_sum += j; });
+        sums[i] = inner_sum.load();
+    });
+
+    for (const int64_t sum : sums)
+    {
+        EXPECT_EQ(sum, kInner * (kInner - 1) / 2);
+    }
+}
+
+TEST_P(TaskSchedulerTest, ForkJoinRecursion)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    EXPECT_EQ(fibonacci(scheduler, 20), 6765);
+}
+
+TEST_P(TaskSchedulerTest, TaskGroupJoinsHeapTasks)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    std::atomic<int64_t> counter{0};
+    {
+        kalix::TaskGroup group(scheduler);
+        for (int i = 0; i < 100; i++)
+        {
+            group.run([&counter] { counter.fetch_add(1); });
+        }
+        group.wait();
+        EXPECT_EQ(counter.load(), 100);
+
+        group.run([&counter] { counter.fetch_add(1); });
+    }
+    EXPECT_EQ(counter.load(), 101);
+}
+
+TEST_P(TaskSchedulerTest, ConcurrentExternalCallers)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    constexpr int kCallers = 4;
+    std::vector<int64_t> sums(kCallers, 0);
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < kCallers; c++)
+    {
+        callers.emplace_back([&, c]
+        {
+            for (int round = 0; round < 20; round++)
+            {
+                std::atomic<int64_t> sum{0};
+                scheduler.parallel_for(0, 1000, 8, [&](const int64_t i) { sum += i; });
+                sums[c] += sum.load();
+            }
+        });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+
+    for (const int64_t sum : sums)
+    {
+        EXPECT_EQ(sum, 20 * 999 * 1000 / 2);
+    }
+}
+
+TEST_P(TaskSchedulerTest, StatisticsCountExecutedTasks)
+{
+    kalix::TaskScheduler scheduler({.num_threads = GetParam()});
+    scheduler.parallel_for(0, 1024, 1, [](int64_t) {});
+
+    const auto statistics = scheduler.statistics();
+    EXPECT_EQ(static_cast<int>(statistics.size()), GetParam());
+    // 1024 leaves with grain 1 need 1023 spawned range tasks; a single thread runs the loop inline.
+    EXPECT_EQ(scheduler.total_statistics().tasks_executed, GetParam() == 1 ? 0 : 1023);
+
+    scheduler.reset_statistics();
+    EXPECT_EQ(scheduler.total_statistics().tasks_executed, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadCounts, TaskSchedulerTest, ::testing::Values(1, 2, 4));
+
+TEST(TaskSchedulerPinningTest, PinnedWorkersReportTheirCpu)
+{
+    kalix::TaskScheduler scheduler({.num_threads = 2, .pin_workers = true});
+    EXPECT_EQ(scheduler.worker_cpu(0), -1);
+    EXPECT_GE(scheduler.worker_cpu(1), 0);
+
+    std::atomic<int64_t> sum{0};
+    scheduler.parallel_for(0, 100, 1, [&](const int64_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), 4950);
+}
+
+TEST(TaskSchedulerWorkerIndexTest, OnlyInsideTasks)
+{
+    kalix::TaskScheduler scheduler({.num_threads = 2});
+    EXPECT_EQ(scheduler.current_worker_index(), -1);
+
+    std::atomic<bool> all_workers{true};
+    scheduler.parallel_for(0, 64, 1, [&](int64_t)
+    {
+        if (scheduler.current_worker_index() < 0)
+        {
+            all_workers = false;
+        }
+    });
+    EXPECT_TRUE(all_workers.load());
+}
@@ -22,18 +22,23 @@
 #ifndef KALIX_BASE_VECTOR_H_
 #define KALIX_BASE_VECTOR_H_
 
+#include <algorithm>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <iostream>
 #include <utility>
 
+#include "absl/log/check.h"
 #include "compensated_double.h"
 #include "kalix/base/config.h"
 #include "kalix/base/constants.h"
 
 namespace kalix
 {
+    class TaskScheduler;
+
     /// @brief Concept checking if T is a floating-point type or behaves like a real number field.
     ///
     /// Requires standard arithmetic (+, -, *, /), comparisons, and construction from double.
@@ -68,6 +73,21 @@ namespace kalix
         T(0);
     };
 
+    /// @brief How the non-zeros of a @ref Vector are tracked, see @ref Vector::representation.
+    enum class VectorRepresentation : int8_t
+    {
+        /// @brief The index list is valid and short. Kernels touch only the listed entries.
+        kHyperSparse,
+
+        /// @brief The index list is valid, but long enough that bulk operations such as clearing
+        /// may prefer the dense array.
+        kSparse,
+
+        /// @brief There is no index list; every entry of the dense array may be non-zero. Marked by a
+        /// negative @ref Vector::non_zero_count.
+        kDense,
+    };
+
     /// @brief A hyper-sparse vector implementation for high-performance linear algebra.
     ///
     /// This class maintains both a dense array of values and a list of indices for non-zero entries,
@@ -75,6 +95,12 @@ namespace kalix
     /// where the vector may be extremely sparse (hyper-sparse), common in linear programming (LP)
     /// and simplex algorithms.
     ///
+    /// The vector is in one of the states of @ref VectorRepresentation, determined by
+    /// @ref non_zero_count. Kernels branch on the state once and then run a loop without per-entry
+    /// checks. Once more than @ref kDenseFraction of the entries are non-zero, keeping the index list
+    /// costs more than scanning the dense array, so @ref saxpy drops it, and
+    /// @ref update_representation picks the state from the measured number of non-zeros.
+    ///
     /// @tparam Real The floating-point type (e.g., double).
     template <typename Real>
         requires AlgebraicReal<Real>
@@ -123,6 +149,39 @@ namespace kalix
         /// @brief Flag indicating if the packed arrays need to be updated.
         bool should_update_packed_storage{};
 
+        /// @brief Whether the first @ref dimension entries of @ref char_workspace flag the listed
+        /// indices, see @ref enable_index_mask.
+        bool has_index_mask{};
+
+        /// @brief Whether the packed arrays are sorted by index, as required by @ref packed_saxpy
+        /// and @ref packed_dot. Set by @ref create_sorted_packed_storage and kept by the packed
+        /// kernels and @ref scatter_packed_storage; every other member that changes the vector
+        /// resets it. Code that writes the arrays directly must call @ref clear first or reset it.
+        bool packed_storage_is_sorted{};
+
+        /// @brief The @ref non_zero_count the packed arrays were last copied from, or -1 if they
+        /// hold something else, e.g. the result of @ref packed_saxpy. See
+        /// @ref packed_storage_mirrors_vector.
+        int64_t packed_source_count{-1};
+
+        /// @brief The storage of @ref dense_values the packed arrays were last copied from, so that
+        /// swapping in other storage, as a basis solve does, is noticed.
+        const Real* packed_source_values{};
+
+        /// @brief Vectors with at most this fraction of non-zeros are hyper-sparse.
+        static constexpr double kHyperSparseFraction = 0.1;
+
+        /// @brief Vectors with more than this fraction of non-zeros are better kept dense.
+        static constexpr double kDenseFraction = 0.3;
+
+        /// @brief Dense arrays up to this size are assumed to stay in cache, see
+        /// @ref prefers_packed_kernels.
+        static constexpr int64_t kPackedKernelCacheBytes = int64_t{1} << 20;
+
+        /// @brief The packed kernels are preferred while the longer operand has at most this many
+        /// times the entries of the shorter one; beyond that, gathering the shorter one wins.
+        static constexpr int64_t kMaxPackedMergeRatio = 16;
+
         /// @brief Default constructor.
         Vector() = default;
 
@@ -154,17 +213,25 @@ namespace kalix
                 packed_element_count = other.packed_element_count;
                 synthetic_clock_tick = other.synthetic_clock_tick;
                 should_update_packed_storage = other.should_update_packed_storage;
+                has_index_mask = other.has_index_mask;
+                packed_storage_is_sorted = other.packed_storage_is_sorted;
+                packed_source_count = other.packed_source_count;
+                packed_source_values = other.packed_source_values;
                 next_link = other.next_link;
 
                 // Reset other to safe "empty" state
                 other.dimension = 0;
                 other.non_zero_count = 0;
+                other.has_index_mask = false;
+                other.packed_storage_is_sorted = false;
+                other.packed_source_count = -1;
                 other.next_link = nullptr;
             }
             return *this;
         }
 
-        /// @brief Copy constructor.
+        /// @brief Copy constructor. Copies all arrays, including the workspaces; see
+        /// @ref UniqueVector for a type that only copies on request.
         KALIX_FORCE_INLINE Vector(const Vector&) = default;
 
         /// @brief Copy assignment operator.
@@ -224,6 +291,7 @@ namespace kalix
         /// @param new_dimension The dimension of the vector space.
         KALIX_FORCE_INLINE void setup(const int64_t new_dimension)
         {
+            packed_storage_is_sorted = false;
             dimension = new_dimension;
             non_zero_count = 0;
             non_zero_indices.resize(new_dimension);
@@ -236,10 +304,180 @@ namespace kalix
             packed_values.resize(new_dimension);
 
             should_update_packed_storage = false;
+            has_index_mask = false;
             synthetic_clock_tick = 0;
             next_link = nullptr;
         }
 
+        /// @brief Changes the dimension to @p new_dimension and sets the vector to zero, reusing the
+        /// existing storage.
+        ///
+        /// Unlike @ref setup, which rewrites every array, this zeroes only the entries the current
+        /// non-zeros occupy (see @ref clear) and the entries a larger dimension adds to
+        /// @ref dense_values. Every array gets the size @ref setup gives it, so the packed scratch
+        /// array that a basis solve swaps into @ref dense_values has the right size as well.
+        /// Shrinking keeps the capacity, so memory is allocated only if @p new_dimension exceeds it;
+        /// see @ref shrink_to_fit for the opposite. The vector must have been set up, or be empty.
+        /// The workspaces keep unspecified contents, except for the index mask.
+        void reshape(const int64_t new_dimension)
+        {
+            clear();
+            const int64_t old_dimension = dimension;
+            dimension = new_dimension;
+            non_zero_indices.resize(new_dimension);
+            dense_values.resize(new_dimension, Real{0});
+            char_workspace.resize(new_dimension + 6400);
+            integer_workspace.resize(new_dimension * 4);
+            packed_element_count = 0;
+            packed_indices.resize(new_dimension);
+            packed_values.resize(new_dimension);
+            if (has_index_mask && new_dimension > old_dimension)
+            {
+                // The mask only keeps the flags below the old dimension zero.
+                std::fill(char_workspace.begin() + old_dimension, char_workspace.begin() + new_dimension, char{0});
+            }
+        }
+
+        /// @brief Gives the workspaces and packed arrays the sizes @ref setup gives them, e.g. for a
+        /// vector from @ref UniqueVector::clone_structure. The dense array and index list must
+        /// already have the current dimension. Existing contents are kept.
+        void allocate_workspaces()
+        {
+            char_workspace.resize(dimension + 6400);
+            integer_workspace.resize(dimension * 4);
+            packed_indices.resize(dimension);
+            packed_values.resize(dimension);
+        }
+
+        /// @brief Releases the capacity beyond what the current dimension needs, e.g. after
+        /// @ref reshape to a much smaller dimension.
+        void shrink_to_fit()
+        {
+            // std::vector::shrink_to_fit does nothing in libstdc++ without exceptions, so every
+            // array is copied into exactly sized storage instead.
+            const auto shrink = [](auto& array, const int64_t size)
+            {
+                array.resize(size);
+                if (array.capacity() > array.size())
+                {
+                    std::remove_reference_t<decltype(array)>(array.begin(), array.end()).swap(array);
+                }
+            };
+            shrink(non_zero_indices, dimension);
+            shrink(dense_values, dimension);
+            shrink(char_workspace, dimension + 6400);
+            shrink(integer_workspace, dimension * 4);
+            shrink(packed_indices, dimension);
+            shrink(packed_values, dimension);
+        }
+
+        /// @brief Returns the current representation, derived from @ref non_zero_count.
+        [[nodiscard]] KALIX_FORCE_INLINE VectorRepresentation representation() const
+        {
+            if (non_zero_count < 0)
+            {
+                return VectorRepresentation::kDense;
+            }
+            return non_zero_count <= dimension * kHyperSparseFraction ? VectorRepresentation::kHyperSparse
+                                                                      : VectorRepresentation::kSparse;
+        }
+
+        /// @brief Drops the index list. The values are kept.
+        KALIX_FORCE_INLINE void make_dense()
+        {
+            packed_storage_is_sorted = false;
+            if (has_index_mask)
+            {
+                unmark_indices();
+            }
+            non_zero_count = -1;
+        }
+
+        /// @brief Starts flagging the listed indices in @ref char_workspace.
+        ///
+        /// With the mask, membership in the index list is exact: @ref saxpy needs no symbolic zeros
+        /// and appends new indices without branching, and cancelled entries become exact zeros that
+        /// stay listed until @ref prune_small_values or @ref disable_index_mask. The mask is kept up
+        /// to date by the members of this class; after writing @ref non_zero_indices directly, call
+        /// this again to rebuild it.
+        KALIX_FORCE_INLINE void enable_index_mask()
+        {
+            std::fill_n(char_workspace.begin(), dimension, char{0});
+            has_index_mask = true;
+            mark_indices();
+        }
+
+        /// @brief Stops flagging the listed indices and clears the flags.
+        ///
+        /// Listed exact zeros left by cancellation are dropped from the index list, since without
+        /// the mask @ref saxpy takes an exact zero for an unlisted entry and would list it again.
+        KALIX_FORCE_INLINE void disable_index_mask()
+        {
+            if (!has_index_mask)
+            {
+                return;
+            }
+            unmark_indices();
+            has_index_mask = false;
+            if (non_zero_count < 0)
+            {
+                return;
+            }
+            const Real* values = dense_values.data();
+            int64_t* indices = non_zero_indices.data();
+            int64_t count = 0;
+            for (int64_t t = 0; t < non_zero_count; t++)
+            {
+                const int64_t index = indices[t];
+                indices[count] = index;
+                count += !(values[index] == Real(0));
+            }
+            non_zero_count = count;
+        }
+
+        /// @brief Calls @p function with every index that may hold a non-zero: the listed indices of
+        /// an indexed vector, all indices of a dense one.
+        template <typename Function>
+        KALIX_FORCE_INLINE void for_each_index(Function&& function) const
+        {
+            if (non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < dimension; i++)
+                {
+                    function(i);
+                }
+                return;
+            }
+            for (int64_t k = 0; k < non_zero_count; k++)
+            {
+                function(non_zero_indices[k]);
+            }
+        }
+
+        /// @brief Chooses the representation from the measured number of non-zeros.
+        ///
+        /// A dense vector is scanned once and keeps the resulting index list unless more than
+        /// @ref kDenseFraction of its entries are non-zero. An indexed vector above that fraction
+        /// drops its list. Hyper-sparse and sparse vectors are not scanned.
+        KALIX_FORCE_INLINE void update_representation()
+        {
+            packed_storage_is_sorted = false;
+            if (non_zero_count >= 0)
+            {
+                if (non_zero_count > dimension * kDenseFraction)
+                {
+                    make_dense();
+                }
+                return;
+            }
+
+            non_zero_count = emit_indices(0, dimension, non_zero_indices.data(), dimension);
+            if (non_zero_count > dimension * kDenseFraction)
+            {
+                make_dense();
+            }
+        }
+
         /// @brief Resets the vector to zero.
         ///
         /// Uses a heuristic to determine the most efficient clearing method. If the vector
@@ -247,7 +485,7 @@ namespace kalix
         /// it performs a full memset/assign on the dense array.
         KALIX_FORCE_INLINE void clear()
         {
-            if (non_zero_count < 0 || non_zero_count > dimension * 0.3)
+            if (non_zero_count < 0 || non_zero_count > dimension * kDenseFraction)
             {
                 dense_values.assign(dimension, Real{0});
             }
@@ -258,6 +496,10 @@ namespace kalix
                     dense_values[non_zero_indices[i]] = Real(0);
                 }
             }
+            if (has_index_mask)
+            {
+                unmark_indices();
+            }
 
             clear_scalars();
         }
@@ -266,46 +508,66 @@ namespace kalix
         KALIX_FORCE_INLINE void clear_scalars()
         {
             should_update_packed_storage = false;
+            packed_storage_is_sorted = false;
             non_zero_count = 0;
             synthetic_clock_tick = 0;
             next_link = 0;
         }
 
-        /// @brief Filters out values smaller than @ref kTiny and repacks indices.
+        /// @brief Filters out values smaller than @p tolerance and repacks indices.
         ///
         /// If @ref non_zero_count is negative, it scans the entire dense array to rebuild
-        /// the index list, treating values < kTiny as zero.
-        KALIX_FORCE_INLINE void prune_small_values()
+        /// the index list, treating values < @p tolerance as zero. The list is kept unless more
+        /// than @ref kDenseFraction of the entries survive.
+        ///
+        /// Neither scan branches on the data: every value is overwritten with itself or zero, and
+        /// every index is written while the position only advances past survivors.
+        ///
+        /// @param tolerance Values of smaller magnitude are dropped. Must be positive.
+        KALIX_FORCE_INLINE void prune_small_values(const double tolerance = kTiny)
         {
+            packed_storage_is_sorted = false;
             using std::abs;
+            DCHECK_GT(tolerance, 0.0);
 
+            Real* values = dense_values.data();
+            int64_t* indices = non_zero_indices.data();
+            char* listed = has_index_mask ? char_workspace.data() : nullptr;
+            int64_t count = 0;
             if (non_zero_count < 0)
             {
-                for (auto& val : dense_values)
+                for (int64_t i = 0; i < dimension; i++)
                 {
-                    if (abs(val) < kTiny)
+                    const bool keep = abs(values[i]) >= tolerance;
+                    values[i] = keep ? values[i] : Real{0};
+                    indices[count] = i;
+                    count += keep;
+                    if (listed != nullptr)
                     {
-                        val = Real(0);
+                        listed[i] = keep;
                     }
                 }
+                non_zero_count = count;
+                if (non_zero_count > dimension * kDenseFraction)
+                {
+                    make_dense();
+                }
+                return;
             }
-            else
+
+            for (int64_t t = 0; t < non_zero_count; t++)
             {
-                int64_t current_count = 0;
-                for (int64_t i = 0; i < non_zero_count; i++)
+                const int64_t index = indices[t];
+                const bool keep = abs(values[index]) >= tolerance;
+                values[index] = keep ? values[index] : Real{0};
+                indices[count] = index;
+                count += keep;
+                if (listed != nullptr)
                 {
-                    const int64_t index = non_zero_indices[i];
-                    if (const Real& value = dense_values[index]; abs(value) >= kTiny)
-                    {
-                        non_zero_indices[current_count++] = index;
-                    }
-                    else
-                    {
-                        dense_values[index] = Real{0};
-                    }
+                    listed[index] = keep;
                 }
-                non_zero_count = current_count;
             }
+            non_zero_count = count;
         }
 
         /// @brief Packs the current non-zero values into contiguous memory.
@@ -320,8 +582,24 @@ namespace kalix
             }
 
             should_update_packed_storage = false;
+            packed_storage_is_sorted = false;
+            packed_source_count = non_zero_count;
+            packed_source_values = dense_values.data();
             packed_element_count = 0;
 
+            if (non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < dimension; i++)
+                {
+                    if (static_cast<double>(dense_values[i]))
+                    {
+                        packed_indices[packed_element_count] = i;
+                        packed_values[packed_element_count] = dense_values[i];
+                        packed_element_count++;
+                    }
+                }
+                return;
+            }
             for (int64_t i = 0; i < non_zero_count; i++)
             {
                 const int64_t index = non_zero_indices[i];
@@ -331,25 +609,218 @@ namespace kalix
             }
         }
 
+        /// @brief Packs the non-zeros into the packed arrays sorted by index, regardless of
+        /// @ref should_update_packed_storage, and sets @ref packed_storage_is_sorted.
+        ///
+        /// A dense vector is scanned in order; the index list of an indexed vector is sorted first.
+        void create_sorted_packed_storage()
+        {
+            should_update_packed_storage = true;
+            create_packed_storage();
+            if (non_zero_count >= 0)
+            {
+                std::sort(packed_indices.begin(), packed_indices.begin() + packed_element_count);
+                for (int64_t k = 0; k < packed_element_count; k++)
+                {
+                    packed_values[k] = dense_values[packed_indices[k]];
+                }
+            }
+            packed_storage_is_sorted = true;
+        }
+
+        /// @brief Replaces the dense array and index list by the contents of the packed arrays, e.g.
+        /// after @ref packed_saxpy.
+        void scatter_packed_storage()
+        {
+            const bool is_sorted = packed_storage_is_sorted;
+            clear();
+            for (int64_t k = 0; k < packed_element_count; k++)
+            {
+                const int64_t index = packed_indices[k];
+                dense_values[index] = packed_values[k];
+                non_zero_indices[k] = index;
+            }
+            non_zero_count = packed_element_count;
+            if (has_index_mask)
+            {
+                mark_indices();
+            }
+            update_representation();
+            packed_storage_is_sorted = is_sorted;
+            packed_source_count = non_zero_count;
+            packed_source_values = dense_values.data();
+        }
+
+        /// @brief Returns whether the packed arrays are a sorted copy of the listed non-zeros, which
+        /// @ref dot checks before it merges them.
+        ///
+        /// Besides @ref packed_storage_is_sorted, this checks that the vector is indexed and that
+        /// @ref non_zero_count and the storage of @ref dense_values are those the packed arrays were
+        /// copied from. Direct writes that keep both, such as changing a listed value in place, go
+        /// unnoticed; code that writes the arrays directly must call @ref clear first or reset
+        /// @ref packed_storage_is_sorted.
+        [[nodiscard]] bool packed_storage_mirrors_vector() const
+        {
+            return packed_storage_is_sorted && non_zero_count >= 0 && packed_source_count == non_zero_count &&
+                packed_source_values == dense_values.data();
+        }
+
+        /// @brief Returns whether @ref dot with @p other runs on the sorted packed arrays.
+        ///
+        /// That is the case when the packed arrays of both vectors mirror their non-zeros (see
+        /// @ref packed_storage_mirrors_vector), their dense arrays do not fit in
+        /// @ref kPackedKernelCacheBytes, both are hyper-sparse, and their lengths differ by at most
+        /// @ref kMaxPackedMergeRatio. A merge then streams two short arrays instead of gathering
+        /// from a dense array that would miss the cache on every access.
+        template <typename RealVector>
+        [[nodiscard]] bool prefers_packed_kernels(const Vector<RealVector>& other) const
+        {
+            if (!packed_storage_mirrors_vector() || !other.packed_storage_mirrors_vector() ||
+                dimension * static_cast<int64_t>(sizeof(Real)) <= kPackedKernelCacheBytes)
+            {
+                return false;
+            }
+            const int64_t shorter = std::min(packed_element_count, other.packed_element_count);
+            const int64_t longer = std::max(packed_element_count, other.packed_element_count);
+            return longer <= dimension * kHyperSparseFraction &&
+                longer <= kMaxPackedMergeRatio * std::max<int64_t>(shorter, 1);
+        }
+
+        /// @brief Adds @p multiplier times @p vector_to_add to the packed arrays only.
+        ///
+        /// Both vectors must have sorted packed storage. The two sorted lists are merged in place
+        /// from the back, after one pass that counts the merged length, and values below
+        /// @ref kTiny are dropped, so the result is again packed and sorted. The dense array and
+        /// index list are not touched, and @ref dot ignores the packed arrays until
+        /// @ref scatter_packed_storage writes them back.
+        ///
+        /// @param multiplier The scalar alpha multiplier.
+        /// @param vector_to_add The vector x to add, distinct from this vector.
+        template <typename RealScalar, typename RealVector>
+        void packed_saxpy(const RealScalar multiplier, const Vector<RealVector>* vector_to_add)
+        {
+            using std::abs;
+            DCHECK(packed_storage_is_sorted && vector_to_add->packed_storage_is_sorted);
+
+            int64_t* indices = packed_indices.data();
+            Real* values = packed_values.data();
+            const int64_t add_count = vector_to_add->packed_element_count;
+            const int64_t* add_indices = vector_to_add->packed_indices.data();
+            const RealVector* add_values = vector_to_add->packed_values.data();
+
+            int64_t merged_count = packed_element_count + add_count;
+            for (int64_t a = 0, b = 0; a < packed_element_count && b < add_count;)
+            {
+                const int64_t difference = indices[a] - add_indices[b];
+                merged_count -= difference == 0;
+                a += difference <= 0;
+                b += difference >= 0;
+            }
+
+            // The write position stays ahead of the unread entries of this vector, and meets them
+            // once all entries of vector_to_add are placed.
+            int64_t a = packed_element_count;
+            int64_t b = add_count;
+            int64_t write = merged_count;
+            while (b > 0)
+            {
+                write--;
+                if (a > 0 && indices[a - 1] >= add_indices[b - 1])
+                {
+                    const bool is_shared = indices[a - 1] == add_indices[b - 1];
+                    indices[write] = indices[a - 1];
+                    values[write] = is_shared ? Real(values[a - 1] + multiplier * add_values[b - 1])
+                                              : values[a - 1];
+                    a--;
+                    b -= is_shared;
+                }
+                else
+                {
+                    indices[write] = add_indices[b - 1];
+                    values[write] = Real(multiplier * add_values[b - 1]);
+                    b--;
+                }
+            }
+
+            int64_t count = 0;
+            for (int64_t k = 0; k < merged_count; k++)
+            {
+                indices[count] = indices[k];
+                values[count] = values[k];
+                count += !(abs(values[k]) < kTiny);
+            }
+            packed_element_count = count;
+            packed_source_count = -1;
+        }
+
+        /// @brief Returns the dot product of the packed arrays of both vectors, which must be sorted,
+        /// by merging them.
+        template <typename RealVector>
+        [[nodiscard]] Real packed_dot(const Vector<RealVector>& other) const
+        {
+            DCHECK(packed_storage_is_sorted && other.packed_storage_is_sorted);
+            Real result = Real{0};
+            const int64_t count = packed_element_count;
+            const int64_t other_count = other.packed_element_count;
+            for (int64_t a = 0, b = 0; a < count && b < other_count;)
+            {
+                const int64_t difference = packed_indices[a] - other.packed_indices[b];
+                if (difference == 0)
+                {
+                    result += packed_values[a] * Real(other.packed_values[b]);
+                }
+                a += difference <= 0;
+                b += difference >= 0;
+            }
+            return result;
+        }
+
+        /// @brief Returns the dot product with @p other.
+        ///
+        /// Runs @ref packed_dot if @ref prefers_packed_kernels says so. Otherwise the entries of the
+        /// vector with the shorter index list are multiplied with the dense array of the other.
+        template <typename RealVector>
+        [[nodiscard]] Real dot(const Vector<RealVector>& other) const
+        {
+            if (prefers_packed_kernels(other))
+            {
+                return packed_dot(other);
+            }
+
+            Real result = Real{0};
+            const bool iterate_this = other.non_zero_count < 0 ||
+                (non_zero_count >= 0 && non_zero_count <= other.non_zero_count);
+            const RealVector* other_values = other.dense_values.data();
+            if (iterate_this)
+            {
+                for_each_index([&](const int64_t index)
+                {
+                    result += dense_values[index] * Real(other_values[index]);
+                });
+            }
+            else
+            {
+                other.for_each_index([&](const int64_t index)
+                {
+                    result += dense_values[index] * Real(other_values[index]);
+                });
+            }
+            return result;
+        }
+
         /// @brief Rebuilds the sparse index list from the dense array.
         ///
         /// Typically used when the sparse structure has been invalidated or if the
         /// vector was populated via direct dense access.
         KALIX_FORCE_INLINE void rebuild_indices_from_dense()
         {
-            if (non_zero_count >= 0 && non_zero_count <= dimension * 0.1)
+            packed_storage_is_sorted = false;
+            if (non_zero_count >= 0 && non_zero_count <= dimension * kHyperSparseFraction)
             {
                 return;
             }
 
-            non_zero_count = 0;
-            for (int64_t i = 0; i < dimension; i++)
-            {
-                if (static_cast<double>(dense_values[i]))
-                {
-                    non_zero_indices[non_zero_count++] = i;
-                }
-            }
+            non_zero_count = emit_indices(0, dimension, non_zero_indices.data(), dimension);
         }
 
         /// @brief Deep copies data from another vector, potentially casting types.
@@ -361,6 +832,15 @@ namespace kalix
             clear();
 
             synthetic_clock_tick = source->synthetic_clock_tick;
+            if (source->non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < dimension; i++)
+                {
+                    dense_values[i] = Real(source->dense_values[i]);
+                }
+                make_dense();
+                return;
+            }
             const int64_t source_count = non_zero_count = source->non_zero_count;
             const int64_t* source_indices = &source->non_zero_indices[0];
             const FromReal* source_values = &source->dense_values[0];
@@ -372,12 +852,26 @@ namespace kalix
                 non_zero_indices[i] = index;
                 dense_values[index] = Real(value);
             }
+            if (has_index_mask)
+            {
+                mark_indices();
+            }
         }
 
         /// @brief Computes the squared Euclidean norm (L2-norm squared) of the vector.
         /// @return The sum of squares of the vector elements.
         KALIX_FORCE_INLINE Real squared_euclidean_norm() const
         {
+            if (non_zero_count < 0)
+            {
+                Real result = Real{0};
+                for (const Real& value : dense_values)
+                {
+                    result += value * value;
+                }
+                return result;
+            }
+
             const int64_t count_local = non_zero_count;
             const int64_t* indices_local = &non_zero_indices[0];
             const Real* values_local = &dense_values[0];
@@ -395,6 +889,8 @@ namespace kalix
         ///
         /// This method adds a scaled version of the source vector to this vector.
         /// It efficiently handles sparsity by iterating only over the non-zeros of the source.
+        /// If either vector is dense, or the result has more than @ref kDenseFraction non-zeros,
+        /// the result is dense.
         ///
         /// @tparam RealScalar Type of the scalar alpha.
         /// @tparam RealVector Type of the source vector elements.
@@ -403,8 +899,23 @@ namespace kalix
         template <typename RealScalar, typename RealVector>
         KALIX_FORCE_INLINE void saxpy(const RealScalar multiplier, const Vector<RealVector>* vector_to_add)
         {
+            packed_storage_is_sorted = false;
             using std::abs;
 
+            if (non_zero_count < 0 || vector_to_add->non_zero_count < 0)
+            {
+                // No index list to maintain, and no symbolic zeros needed to keep one.
+                make_dense();
+                Real* values = dense_values.data();
+                const RealVector* add_values = vector_to_add->dense_values.data();
+                vector_to_add->for_each_index([&](const int64_t index)
+                {
+                    const Real new_value = Real(values[index] + multiplier * add_values[index]);
+                    values[index] = (abs(new_value) < kTiny) ? Real(0) : new_value;
+                });
+                return;
+            }
+
             int64_t current_count = non_zero_count;
             int64_t* current_indices = &non_zero_indices[0];
             Real* current_values = &dense_values[0];
@@ -413,22 +924,47 @@ namespace kalix
             const int64_t* add_indices = &vector_to_add->non_zero_indices[0];
             const RealVector* add_values = &vector_to_add->dense_values[0];
 
-            for (int64_t k = 0; k < add_count; k++)
+            if (has_index_mask)
             {
-                const int64_t row_index = add_indices[k];
-                const Real original_value = current_values[row_index];
-                const Real new_value = Real(original_value + multiplier * add_values[row_index]);
-
-                // If previous value was zero, we have a new non-zero entry
-                if (original_value == Real(0))
+                // New indices are written to the next free slot, or to a scratch slot if already
+                // listed, so the loop needs no branches.
+                char* listed = char_workspace.data();
+                int64_t discarded_index;
+                for (int64_t k = 0; k < add_count; k++)
                 {
-                    current_indices[current_count++] = row_index;
+                    const int64_t row_index = add_indices[k];
+                    const Real new_value = Real(current_values[row_index] + multiplier * add_values[row_index]);
+                    current_values[row_index] = (abs(new_value) < kTiny) ? Real(0) : new_value;
+
+                    const bool is_new = !listed[row_index];
+                    *(is_new ? current_indices + current_count : &discarded_index) = row_index;
+                    current_count += is_new;
+                    listed[row_index] = 1;
                 }
+            }
+            else
+            {
+                for (int64_t k = 0; k < add_count; k++)
+                {
+                    const int64_t row_index = add_indices[k];
+                    const Real original_value = current_values[row_index];
+                    const Real new_value = Real(original_value + multiplier * add_values[row_index]);
 
-                // Tiny values are flushed to kTiny (symbolic zero)
-                current_values[row_index] = (abs(new_value) < kTiny) ? Real(kZero) : new_value;
+                    // If previous value was zero, we have a new non-zero entry
+                    if (original_value == Real(0))
+                    {
+                        current_indices[current_count++] = row_index;
+                    }
+
+                    // Tiny values are flushed to kTiny (symbolic zero)
+                    current_values[row_index] = (abs(new_value) < kTiny) ? Real(kZero) : new_value;
+                }
             }
             non_zero_count = current_count;
+            if (non_zero_count > dimension * kDenseFraction)
+            {
+                make_dense();
+            }
         }
 
         /// @brief Checks structural equality with another vector.
@@ -444,7 +980,10 @@ namespace kalix
             {
                 return false;
             }
-            if (non_zero_indices != other.non_zero_indices)
+            // Only the listed indices; the arrays may be longer than needed after reshape().
+            if (non_zero_count > 0 &&
+                !std::equal(non_zero_indices.begin(), non_zero_indices.begin() + non_zero_count,
+                            other.non_zero_indices.begin()))
             {
                 return false;
             }
@@ -487,15 +1026,135 @@ namespace kalix
         {
             os << "Vector(dim=" << v.dimension << ", nnz=" << v.non_zero_count << ") {\n";
             os << "  Non-zeros: [";
-            for (int64_t i = 0; i < v.non_zero_count; ++i)
+            bool first = true;
+            v.for_each_index([&](const int64_t idx)
             {
-                int64_t idx = v.non_zero_indices[i];
+                if (v.non_zero_count < 0 && !static_cast<double>(v.dense_values[idx])) return;
+                if (!first) os << ", ";
                 os << "(" << idx << ": " << v.dense_values[idx] << ")";
-                if (i < v.non_zero_count - 1) os << ", ";
-            }
+                first = false;
+            });
             os << "]\n}";
             return os;
         }
+
+    private:
+        template <typename R>
+        friend void rebuild_indices_from_dense(Vector<R>& vector, TaskScheduler* scheduler);
+
+        // Writes the indices of the non-zeros in [begin, end) to output and returns their number.
+        // Every index is written and the position only advances past non-zeros, so the loop has no
+        // data-dependent branch. Writes at position capacity, which belongs to the next chunk of a
+        // parallel rebuild, go to a scratch slot instead. With the index mask, the flags of the range
+        // are overwritten as well.
+        KALIX_FORCE_INLINE int64_t emit_indices(const int64_t begin, const int64_t end, int64_t* output,
+                                                const int64_t capacity)
+        {
+            const Real* values = dense_values.data();
+            char* listed = has_index_mask ? char_workspace.data() : nullptr;
+            int64_t discarded;
+            int64_t count = 0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                const bool is_non_zero = static_cast<double>(values[i]) != 0.0;
+                *(count < capacity ? output + count : &discarded) = i;
+                count += is_non_zero;
+                if (listed != nullptr)
+                {
+                    listed[i] = is_non_zero;
+                }
+            }
+            return count;
+        }
+
+        // Sets the mask flag of every listed index.
+        KALIX_FORCE_INLINE void mark_indices()
+        {
+            for (int64_t i = 0; i < non_zero_count; i++)
+            {
+                char_workspace[non_zero_indices[i]] = 1;
+            }
+        }
+
+        // Clears the mask flags of the listed indices; a dense vector has none set.
+        KALIX_FORCE_INLINE void unmark_indices()
+        {
+            if (non_zero_count > dimension * kDenseFraction)
+            {
+                std::fill_n(char_workspace.begin(), dimension, char{0});
+                return;
+            }
+            for (int64_t i = 0; i < non_zero_count; i++)
+            {
+                char_workspace[non_zero_indices[i]] = 0;
+            }
+        }
+    };
+
+    /// @brief A @ref Vector that cannot be copied implicitly.
+    ///
+    /// Copying a @ref Vector deep-copies all of its arrays, including the workspaces of several
+    /// times its dimension, which is easy to do by accident on a hot path. This type deletes the
+    /// copy operations and is copied only through @ref clone, or @ref clone_structure, which copies
+    /// just the non-zeros into freshly set up storage. It is a @ref Vector otherwise and can be passed
+    /// wherever one is expected.
+    ///
+    /// @tparam Real The floating-point type (e.g., double).
+    template <typename Real>
+        requires AlgebraicReal<Real>
+    class UniqueVector : public Vector<Real>
+    {
+    public:
+        /// @brief Default constructor.
+        UniqueVector() = default;
+
+        /// @brief Creates a zero vector of dimension @p dimension.
+        explicit UniqueVector(const int64_t dimension)
+        {
+            this->setup(dimension);
+        }
+
+        UniqueVector(const UniqueVector&) = delete;
+        UniqueVector& operator=(const UniqueVector&) = delete;
+
+        /// @brief Move constructor.
+        UniqueVector(UniqueVector&&) noexcept = default;
+
+        /// @brief Move assignment operator.
+        UniqueVector& operator=(UniqueVector&&) noexcept = default;
+
+        /// @brief Returns a deep copy of all arrays, as the copy constructor of @ref Vector makes.
+        [[nodiscard]] UniqueVector clone() const
+        {
+            UniqueVector result;
+            static_cast<Vector<Real>&>(result) = static_cast<const Vector<Real>&>(*this);
+            return result;
+        }
+
+        /// @brief Returns a vector of the same dimension and representation holding the same
+        /// values, copying only the non-zeros.
+        ///
+        /// Only the dense array and index list are allocated, and the character workspace if the
+        /// index mask is on. The integer workspace and packed arrays stay empty; call
+        /// @ref allocate_workspaces before using members that need them, such as the packed kernels
+        /// or a basis solve.
+        [[nodiscard]] UniqueVector clone_structure() const
+        {
+            UniqueVector result;
+            result.dimension = this->dimension;
+            result.dense_values.resize(this->dimension);
+            result.non_zero_indices.resize(this->dimension);
+            if (this->has_index_mask)
+            {
+                result.char_workspace.resize(this->dimension + 6400);
+            }
+            result.copy_from(this);
+            if (this->has_index_mask)
+            {
+                result.enable_index_mask();
+            }
+            return result;
+        }
     };
 }
 
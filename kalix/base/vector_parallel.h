@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_VECTOR_PARALLEL_H_
+#define KALIX_BASE_VECTOR_PARALLEL_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+
+namespace kalix
+{
+    /// @brief Smallest dimension for which @ref rebuild_indices_from_dense scans in parallel.
+    inline constexpr int64_t kParallelRebuildDimension = int64_t{1} << 18;
+
+    /// @brief Number of entries one task of the parallel rebuild scans.
+    inline constexpr int64_t kRebuildChunkSize = int64_t{1} << 15;
+
+    /// @brief Rebuilds the index list of @p vector like @ref Vector::rebuild_indices_from_dense,
+    /// splitting the scan of vectors of at least @ref kParallelRebuildDimension entries across
+    /// @p scheduler.
+    ///
+    /// The dense array is cut into chunks of @ref kRebuildChunkSize entries. The non-zeros of every
+    /// chunk are counted in parallel, a prefix sum over the counts gives the position of every chunk
+    /// in the index list, and the chunks then write their indices in parallel. The resulting list is
+    /// sorted. The integer workspace of @p vector holds the chunk offsets.
+    ///
+    /// @param vector The vector to rebuild.
+    /// @param scheduler The scheduler to run on, or @c nullptr to scan serially.
+    template <typename Real>
+    void rebuild_indices_from_dense(Vector<Real>& vector, TaskScheduler* scheduler)
+    {
+        const int64_t dimension = vector.dimension;
+        if (scheduler == nullptr || scheduler->num_threads() == 1 || dimension < kParallelRebuildDimension)
+        {
+            vector.rebuild_indices_from_dense();
+            return;
+        }
+        vector.packed_storage_is_sorted = false;
+        if (vector.non_zero_count >= 0 && vector.non_zero_count <= dimension * Vector<Real>::kHyperSparseFraction)
+        {
+            return;
+        }
+
+        const int64_t num_chunks = (dimension + kRebuildChunkSize - 1) / kRebuildChunkSize;
+        const Real* values = vector.dense_values.data();
+        int64_t* offsets = vector.integer_workspace.data();
+        scheduler->parallel_for(0, num_chunks, 1, [&](const int64_t chunk)
+        {
+            const int64_t begin = chunk * kRebuildChunkSize;
+            const int64_t end = std::min(begin + kRebuildChunkSize, dimension);
+            int64_t count = 0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                count += static_cast<double>(values[i]) != 0.0;
+            }
+            offsets[chunk + 1] = count;
+        });
+        offsets[0] = 0;
+        for (int64_t chunk = 0; chunk < num_chunks; chunk++)
+        {
+            offsets[chunk + 1] += offsets[chunk];
+        }
+        int64_t* indices = vector.non_zero_indices.data();
+        scheduler->parallel_for(0, num_chunks, 1, [&](const int64_t chunk)
+        {
+            const int64_t begin = chunk * kRebuildChunkSize;
+            const int64_t end = std::min(begin + kRebuildChunkSize, dimension);
+            vector.emit_indices(begin, end, indices + offsets[chunk], offsets[chunk + 1] - offsets[chunk]);
+        });
+        vector.non_zero_count = offsets[num_chunks];
+    }
+}
+
+#endif // KALIX_BASE_VECTOR_PARALLEL_H_
@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/base/vector_parallel.h"
+
+TEST(VectorParallelTest, RebuildIndicesFromDenseMatchesSerial)
+{
+    const int64_t size = kalix::kParallelRebuildDimension + 12345;
+    kalix::Vector<double> parallel;
+    kalix::Vector<double> serial;
+    parallel.setup(size);
+    serial.setup(size);
+    for (int64_t i = 0; i < size; i++)
+    {
+        // An irregular pattern with empty and full stretches.
+        if ((i * 7919) % 13 < 5 || (i / 50000) % 3 == 1)
+        {
+            parallel.dense_values[i] = serial.dense_values[i] = 1.0 + static_cast<double>(i % 5);
+        }
+    }
+    parallel.make_dense();
+    serial.make_dense();
+    parallel.enable_index_mask();
+
+    kalix::TaskScheduler scheduler({.num_threads = 4});
+    kalix::rebuild_indices_from_dense(parallel, &scheduler);
+    serial.rebuild_indices_from_dense();
+
+    ASSERT_EQ(parallel.non_zero_count, serial.non_zero_count);
+    for (int64_t k = 0; k < serial.non_zero_count; k++)
+    {
+        ASSERT_EQ(parallel.non_zero_indices[k], serial.non_zero_indices[k]);
+    }
+    for (int64_t i = 0; i < size; i++)
+    {
+        ASSERT_EQ(parallel.char_workspace[i] != 0, serial.dense_values[i] != 0.0);
+    }
+}
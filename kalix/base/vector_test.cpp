@@ -20,6 +20,7 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <gtest/gtest.h>
+#include <type_traits>
 #include <vector>
 #include <utility>
 
@@ -493,6 +494,597 @@ TEST_F(VectorTest, RebuildIndicesFullyDense)
     }
 }
 
+TEST_F(VectorTest, Representation)
+{
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kHyperSparse);
+
+    vec.dense_values[0] = 1.0;
+    vec.non_zero_indices[0] = 0;
+    vec.non_zero_count = 1;
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kHyperSparse);
+
+    vec.dense_values[5] = 2.0;
+    vec.non_zero_indices[1] = 5;
+    vec.non_zero_count = 2;
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kSparse);
+
+    vec.make_dense();
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+    EXPECT_DOUBLE_EQ(vec.dense_values[5], 2.0);
+}
+
+TEST_F(VectorTest, ForEachIndex)
+{
+    vec.dense_values[4] = 1.0;
+    vec.dense_values[7] = 2.0;
+    vec.non_zero_indices[0] = 7;
+    vec.non_zero_indices[1] = 4;
+    vec.non_zero_count = 2;
+
+    std::vector<int64_t> visited;
+    vec.for_each_index([&](const int64_t i) { visited.push_back(i); });
+    EXPECT_EQ(visited, (std::vector<int64_t>{7, 4}));
+
+    visited.clear();
+    vec.make_dense();
+    vec.for_each_index([&](const int64_t i) { visited.push_back(i); });
+    EXPECT_EQ(static_cast<int64_t>(visited.size()), kSize);
+}
+
+TEST_F(VectorTest, UpdateRepresentation)
+{
+    // A dense result with few non-zeros gets its index list back.
+    vec.dense_values[2] = 1.0;
+    vec.dense_values[8] = -1.0;
+    vec.make_dense();
+    vec.update_representation();
+    ASSERT_EQ(vec.non_zero_count, 2);
+    EXPECT_EQ(vec.non_zero_indices[0], 2);
+    EXPECT_EQ(vec.non_zero_indices[1], 8);
+
+    // Past the dense fraction, the list is dropped.
+    for (int64_t i = 0; i < 4; i++)
+    {
+        vec.dense_values[i] = 3.0;
+    }
+    vec.make_dense();
+    vec.update_representation();
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+
+    vec.clear();
+    EXPECT_EQ(vec.non_zero_count, 0);
+    for (const auto& val : vec.dense_values)
+    {
+        EXPECT_DOUBLE_EQ(val, 0.0);
+    }
+}
+
+TEST_F(VectorTest, SaxpyPromotesToDense)
+{
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    for (int64_t i = 0; i < 4; i++)
+    {
+        pivot.dense_values[i] = 1.0;
+        pivot.non_zero_indices[i] = i;
+    }
+    pivot.non_zero_count = 4;
+
+    vec.saxpy(2.0, &pivot);
+
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+    for (int64_t i = 0; i < 4; i++)
+    {
+        EXPECT_DOUBLE_EQ(vec.dense_values[i], 2.0);
+    }
+}
+
+TEST_F(VectorTest, SaxpyDenseOperands)
+{
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    pivot.dense_values[1] = 1.0;
+    pivot.dense_values[6] = 4.0;
+    pivot.make_dense();
+
+    vec.dense_values[1] = -2.0;
+    vec.non_zero_indices[0] = 1;
+    vec.non_zero_count = 1;
+
+    vec.saxpy(2.0, &pivot);
+
+    // Cancellation leaves an exact zero, as there is no index list to keep consistent.
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+    EXPECT_EQ(vec.dense_values[1], 0.0);
+    EXPECT_DOUBLE_EQ(vec.dense_values[6], 8.0);
+    EXPECT_DOUBLE_EQ(vec.squared_euclidean_norm(), 64.0);
+
+    vec.update_representation();
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.non_zero_indices[0], 6);
+}
+
+TEST_F(VectorTest, DenseCopyAndPack)
+{
+    kalix::Vector<double> source;
+    source.setup(kSize);
+    source.dense_values[3] = 5.0;
+    source.dense_values[9] = 6.0;
+    source.make_dense();
+
+    vec.dense_values[0] = 1.0;
+    vec.non_zero_indices[0] = 0;
+    vec.non_zero_count = 1;
+    vec.copy_from(&source);
+
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+    EXPECT_DOUBLE_EQ(vec.dense_values[0], 0.0);
+    EXPECT_DOUBLE_EQ(vec.dense_values[9], 6.0);
+
+    vec.should_update_packed_storage = true;
+    vec.create_packed_storage();
+    ASSERT_EQ(vec.packed_element_count, 2);
+    EXPECT_EQ(vec.packed_indices[0], 3);
+    EXPECT_DOUBLE_EQ(vec.packed_values[1], 6.0);
+}
+
+TEST_F(VectorTest, IndexMaskSaxpyCancellation)
+{
+    vec.enable_index_mask();
+
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    pivot.dense_values[2] = 1.0;
+    pivot.non_zero_indices[0] = 2;
+    pivot.non_zero_count = 1;
+
+    // Cancellation leaves an exact zero that stays listed, and adding again does not duplicate it.
+    vec.saxpy(1.0, &pivot);
+    vec.saxpy(-1.0, &pivot);
+    EXPECT_EQ(vec.dense_values[2], 0.0);
+    vec.saxpy(3.0, &pivot);
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.non_zero_indices[0], 2);
+    EXPECT_DOUBLE_EQ(vec.dense_values[2], 3.0);
+    EXPECT_EQ(vec.char_workspace[2], 1);
+}
+
+TEST_F(VectorTest, DisableIndexMaskDropsCancelledEntries)
+{
+    vec.enable_index_mask();
+
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    pivot.dense_values[5] = 2.0;
+    pivot.non_zero_indices[0] = 5;
+    pivot.non_zero_count = 1;
+
+    vec.saxpy(1.0, &pivot);
+    vec.saxpy(-1.0, &pivot);
+    vec.disable_index_mask();
+    EXPECT_EQ(vec.non_zero_count, 0);
+
+    // Without the mask, the next saxpy must list index 5 once.
+    vec.saxpy(1.0, &pivot);
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.non_zero_indices[0], 5);
+    EXPECT_DOUBLE_EQ(vec.squared_euclidean_norm(), 4.0);
+}
+
+TEST_F(VectorTest, IndexMaskPruneAndClear)
+{
+    vec.dense_values[1] = 1.0;
+    vec.dense_values[4] = 1e-20;
+    vec.non_zero_indices[0] = 1;
+    vec.non_zero_indices[1] = 4;
+    vec.non_zero_count = 2;
+    vec.enable_index_mask();
+    EXPECT_EQ(vec.char_workspace[4], 1);
+
+    vec.prune_small_values();
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.char_workspace[1], 1);
+    EXPECT_EQ(vec.char_workspace[4], 0);
+
+    vec.clear();
+    EXPECT_TRUE(vec.has_index_mask);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_EQ(vec.char_workspace[i], 0);
+    }
+}
+
+TEST_F(VectorTest, IndexMaskDensePromotion)
+{
+    vec.enable_index_mask();
+
+    kalix::Vector<double> pivot;
+    pivot.setup(kSize);
+    for (int64_t i = 0; i < 5; i++)
+    {
+        pivot.dense_values[2 * i] = 1.0;
+        pivot.non_zero_indices[i] = 2 * i;
+    }
+    pivot.non_zero_count = 5;
+
+    // The dense result has no listed indices, so no flags either.
+    vec.saxpy(1.0, &pivot);
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_EQ(vec.char_workspace[i], 0);
+    }
+
+    vec.saxpy(-1.0, &pivot);
+    vec.update_representation();
+    EXPECT_EQ(vec.non_zero_count, 0);
+
+    vec.dense_values[3] = 2.0;
+    vec.make_dense();
+    vec.rebuild_indices_from_dense();
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.char_workspace[3], 1);
+
+    vec.disable_index_mask();
+    EXPECT_EQ(vec.char_workspace[3], 0);
+}
+
+TEST_F(VectorTest, PruneSmallValuesWithTolerance)
+{
+    vec.dense_values[3] = 1e-6;
+    vec.dense_values[5] = -2.0;
+    vec.dense_values[6] = 1e-9;
+    vec.non_zero_indices[0] = 6;
+    vec.non_zero_indices[1] = 3;
+    vec.non_zero_indices[2] = 5;
+    vec.non_zero_count = 3;
+
+    vec.prune_small_values(1e-8);
+    ASSERT_EQ(vec.non_zero_count, 2);
+    EXPECT_EQ(vec.non_zero_indices[0], 3);
+    EXPECT_EQ(vec.non_zero_indices[1], 5);
+    EXPECT_EQ(vec.dense_values[6], 0.0);
+
+    vec.prune_small_values(1e-3);
+    ASSERT_EQ(vec.non_zero_count, 1);
+    EXPECT_EQ(vec.non_zero_indices[0], 5);
+}
+
+TEST_F(VectorTest, PruneSmallValuesRebuildsDenseIndices)
+{
+    vec.dense_values[2] = 3.0;
+    vec.dense_values[4] = kalix::kTiny * 0.5;
+    vec.dense_values[9] = -1.0;
+    vec.make_dense();
+    vec.enable_index_mask();
+
+    vec.prune_small_values();
+    ASSERT_EQ(vec.non_zero_count, 2);
+    EXPECT_EQ(vec.non_zero_indices[0], 2);
+    EXPECT_EQ(vec.non_zero_indices[1], 9);
+    EXPECT_EQ(vec.dense_values[4], 0.0);
+    EXPECT_EQ(vec.char_workspace[9], 1);
+    EXPECT_EQ(vec.char_workspace[4], 0);
+
+    // Too many survivors to be worth listing.
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        vec.dense_values[i] = 1.0;
+    }
+    vec.make_dense();
+    vec.prune_small_values();
+    EXPECT_EQ(vec.representation(), kalix::VectorRepresentation::kDense);
+}
+
+TEST_F(VectorTest, SortedPackedSaxpyAndDot)
+{
+    vec.dense_values[7] = 1.0;
+    vec.dense_values[2] = 2.0;
+    vec.dense_values[5] = 3.0;
+    vec.non_zero_indices[0] = 7;
+    vec.non_zero_indices[1] = 2;
+    vec.non_zero_indices[2] = 5;
+    vec.non_zero_count = 3;
+    vec.create_sorted_packed_storage();
+    ASSERT_EQ(vec.packed_element_count, 3);
+    EXPECT_EQ(vec.packed_indices[0], 2);
+    EXPECT_DOUBLE_EQ(vec.packed_values[2], 1.0);
+
+    kalix::Vector<double> other;
+    other.setup(kSize);
+    other.dense_values[0] = 4.0;
+    other.dense_values[5] = 3.0;
+    other.dense_values[7] = 1.0;
+    other.make_dense();
+    other.create_sorted_packed_storage();
+
+    EXPECT_DOUBLE_EQ(vec.packed_dot(other), 10.0);
+    EXPECT_DOUBLE_EQ(vec.dot(other), 10.0);
+
+    // Indices 5 and 7 cancel and are dropped.
+    vec.packed_saxpy(-1.0, &other);
+    ASSERT_EQ(vec.packed_element_count, 2);
+    EXPECT_EQ(vec.packed_indices[0], 0);
+    EXPECT_EQ(vec.packed_indices[1], 2);
+    EXPECT_DOUBLE_EQ(vec.packed_values[0], -4.0);
+    EXPECT_DOUBLE_EQ(vec.packed_values[1], 2.0);
+
+    // The dense array is untouched until the packed result is scattered back.
+    EXPECT_DOUBLE_EQ(vec.dense_values[7], 1.0);
+    vec.scatter_packed_storage();
+    EXPECT_TRUE(vec.packed_storage_is_sorted);
+    EXPECT_DOUBLE_EQ(vec.dense_values[7], 0.0);
+    EXPECT_DOUBLE_EQ(vec.dense_values[0], -4.0);
+    EXPECT_EQ(vec.non_zero_count, 2);
+}
+
+TEST(VectorPackedTest, PackedKernelsMatchDenseKernels)
+{
+    // Large enough that the dense array leaves the cache, so dot() merges.
+    const int64_t size = kalix::Vector<double>::kPackedKernelCacheBytes;
+    kalix::Vector<double> x;
+    kalix::Vector<double> y;
+    x.setup(size);
+    y.setup(size);
+    for (int64_t k = 0; k < 1000; k++)
+    {
+        const int64_t i = (k * 7919) % size;
+        const int64_t j = (k * 104729 + 3) % size;
+        x.dense_values[i] = 1.0 + static_cast<double>(k % 7);
+        x.non_zero_indices[x.non_zero_count++] = i;
+        if (y.dense_values[j] == 0.0)
+        {
+            y.non_zero_indices[y.non_zero_count++] = j;
+        }
+        y.dense_values[j] = -0.5 * static_cast<double>(k % 5 + 1);
+    }
+    // A few shared indices, one of which cancels.
+    for (int64_t k = 0; k < 10; k++)
+    {
+        const int64_t i = x.non_zero_indices[k];
+        if (y.dense_values[i] == 0.0)
+        {
+            y.non_zero_indices[y.non_zero_count++] = i;
+        }
+        y.dense_values[i] = k == 0 ? x.dense_values[i] / 2.0 : 1.0;
+    }
+    x.create_sorted_packed_storage();
+    y.create_sorted_packed_storage();
+    ASSERT_TRUE(x.prefers_packed_kernels(y));
+
+    const double dense_dot = [&]
+    {
+        double result = 0.0;
+        for (int64_t i = 0; i < size; i++)
+        {
+            result += x.dense_values[i] * y.dense_values[i];
+        }
+        return result;
+    }();
+    EXPECT_DOUBLE_EQ(x.dot(y), dense_dot);
+
+    kalix::Vector<double> expected;
+    expected.setup(size);
+    expected.copy_from(&x);
+    expected.saxpy(-2.0, &y);
+    expected.prune_small_values();
+
+    x.packed_saxpy(-2.0, &y);
+    for (int64_t k = 1; k < x.packed_element_count; k++)
+    {
+        ASSERT_LT(x.packed_indices[k - 1], x.packed_indices[k]);
+    }
+    x.scatter_packed_storage();
+    ASSERT_EQ(x.non_zero_count, expected.non_zero_count);
+    for (int64_t i = 0; i < size; i++)
+    {
+        ASSERT_DOUBLE_EQ(x.dense_values[i], expected.dense_values[i]);
+    }
+}
+
+TEST(VectorPackedTest, MutationsDropSortedPackedStorage)
+{
+    const int64_t size = kalix::Vector<double>::kPackedKernelCacheBytes;
+    kalix::Vector<double> x;
+    kalix::Vector<double> y;
+    x.setup(size);
+    y.setup(size);
+    const auto fill = [](kalix::Vector<double>& vector, const int64_t index, const double value)
+    {
+        vector.dense_values[index] = value;
+        vector.non_zero_indices[vector.non_zero_count++] = index;
+    };
+    fill(x, 10, 1.0);
+    fill(y, 10, 2.0);
+    fill(y, 20, 3.0);
+    const auto sort_both = [&]
+    {
+        x.create_sorted_packed_storage();
+        y.create_sorted_packed_storage();
+        ASSERT_TRUE(x.prefers_packed_kernels(y));
+    };
+
+    // Each member below changes y while its packed arrays still describe y = 2 e_10 + 3 e_20.
+    sort_both();
+    kalix::Vector<double> z;
+    z.setup(size);
+    fill(z, 20, 1.0);
+    y.saxpy(1.0, &z);
+    fill(x, 20, 1.0);
+    x.create_sorted_packed_storage();
+    EXPECT_FALSE(y.packed_storage_is_sorted);
+    EXPECT_DOUBLE_EQ(x.dot(y), 6.0);
+
+    sort_both();
+    y.copy_from(&z);
+    EXPECT_DOUBLE_EQ(x.dot(y), 1.0);
+
+    sort_both();
+    y.dense_values[20] = 1e-20;
+    y.prune_small_values();
+    EXPECT_DOUBLE_EQ(x.dot(y), 0.0);
+
+    sort_both();
+    y.dense_values[10] = 5.0;
+    y.non_zero_count = -1;
+    y.rebuild_indices_from_dense();
+    EXPECT_DOUBLE_EQ(x.dot(y), 5.0);
+
+    sort_both();
+    y.setup(size);
+    EXPECT_DOUBLE_EQ(x.dot(y), 0.0);
+
+    // Direct writes that do not reset the flag: appending an index, and swapping in the packed
+    // scratch array the way a basis solve does.
+    sort_both();
+    fill(y, 10, 2.0);
+    EXPECT_FALSE(y.packed_storage_mirrors_vector());
+    EXPECT_DOUBLE_EQ(x.dot(y), 2.0);
+
+    sort_both();
+    std::swap(y.dense_values, y.packed_values);
+    y.dense_values.assign(size, 0.0);
+    y.dense_values[20] = 7.0;
+    y.non_zero_indices[0] = 20;
+    EXPECT_DOUBLE_EQ(x.dot(y), 7.0);
+
+    // A packed result is only seen by dot() once scattered back.
+    sort_both();
+    kalix::Vector<double> w;
+    w.setup(size);
+    fill(w, 30, 1.0);
+    w.create_sorted_packed_storage();
+    y.packed_saxpy(1.0, &w);
+    EXPECT_FALSE(y.packed_storage_mirrors_vector());
+    EXPECT_DOUBLE_EQ(x.dot(y), 7.0);
+    y.scatter_packed_storage();
+    EXPECT_TRUE(y.packed_storage_mirrors_vector());
+    EXPECT_DOUBLE_EQ(x.dot(y), 7.0);
+}
+
+TEST_F(VectorTest, ReshapeReusesStorage)
+{
+    vec.dense_values[3] = 1.0;
+    vec.dense_values[8] = 2.0;
+    vec.non_zero_indices[0] = 3;
+    vec.non_zero_indices[1] = 8;
+    vec.non_zero_count = 2;
+    vec.enable_index_mask();
+    const double* storage = vec.dense_values.data();
+
+    vec.reshape(6);
+    EXPECT_EQ(vec.dimension, 6);
+    EXPECT_EQ(vec.non_zero_count, 0);
+    EXPECT_EQ(vec.dense_values.size(), 6u);
+    EXPECT_EQ(vec.integer_workspace.size(), 24u);
+    EXPECT_EQ(vec.packed_values.size(), 6u);
+    EXPECT_EQ(vec.dense_values.data(), storage);
+
+    // Growing back within the capacity does not allocate, and the old entries read as zero.
+    vec.reshape(kSize);
+    EXPECT_EQ(vec.dense_values.data(), storage);
+    kalix::Vector<double> fresh;
+    fresh.setup(kSize);
+    EXPECT_EQ(vec, fresh);
+    for (int64_t i = 0; i < kSize; i++)
+    {
+        EXPECT_DOUBLE_EQ(vec.dense_values[i], 0.0);
+        EXPECT_EQ(vec.char_workspace[i], 0);
+    }
+
+    vec.reshape(3);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.dense_values.capacity(), 3u);
+    EXPECT_EQ(vec.integer_workspace.size(), 12u);
+    EXPECT_EQ(vec.char_workspace.capacity(), 3u + 6400u);
+}
+
+TEST(VectorReshapeTest, ReshapeFromEmptyAndDense)
+{
+    kalix::Vector<double> vector;
+    vector.reshape(5);
+    EXPECT_EQ(vector.dimension, 5);
+    EXPECT_EQ(vector.non_zero_count, 0);
+    EXPECT_EQ(vector.non_zero_indices.size(), 5u);
+
+    for (int64_t i = 0; i < 5; i++)
+    {
+        vector.dense_values[i] = 1.0;
+    }
+    vector.make_dense();
+    vector.reshape(20);
+    EXPECT_EQ(vector.representation(), kalix::VectorRepresentation::kHyperSparse);
+    for (int64_t i = 0; i < 20; i++)
+    {
+        EXPECT_DOUBLE_EQ(vector.dense_values[i], 0.0);
+    }
+}
+
+TEST(UniqueVectorTest, IsMoveOnly)
+{
+    static_assert(!std::is_copy_constructible_v<kalix::UniqueVector<double>>);
+    static_assert(!std::is_copy_assignable_v<kalix::UniqueVector<double>>);
+    static_assert(std::is_nothrow_move_constructible_v<kalix::UniqueVector<double>>);
+
+    kalix::UniqueVector<double> source(8);
+    source.dense_values[2] = 1.5;
+    source.non_zero_indices[0] = 2;
+    source.non_zero_count = 1;
+
+    kalix::UniqueVector<double> moved(std::move(source));
+    EXPECT_EQ(moved.dimension, 8);
+    EXPECT_DOUBLE_EQ(moved.dense_values[2], 1.5);
+}
+
+TEST(UniqueVectorTest, CloneCopiesEverything)
+{
+    kalix::UniqueVector<double> source(8);
+    source.dense_values[5] = -2.0;
+    source.non_zero_indices[0] = 5;
+    source.non_zero_count = 1;
+    source.integer_workspace[3] = 42;
+
+    const kalix::UniqueVector<double> copy = source.clone();
+    EXPECT_EQ(copy, source);
+    EXPECT_EQ(copy.integer_workspace[3], 42);
+}
+
+TEST(UniqueVectorTest, CloneStructureCopiesNonZeros)
+{
+    kalix::UniqueVector<double> source(8);
+    source.dense_values[1] = 3.0;
+    source.dense_values[6] = 4.0;
+    source.non_zero_indices[0] = 6;
+    source.non_zero_indices[1] = 1;
+    source.non_zero_count = 2;
+    source.integer_workspace[3] = 42;
+    source.enable_index_mask();
+
+    kalix::UniqueVector<double> copy = source.clone_structure();
+    EXPECT_EQ(copy, source);
+    EXPECT_TRUE(copy.has_index_mask);
+    EXPECT_EQ(copy.char_workspace[6], 1);
+
+    // Only the storage the values need is allocated.
+    EXPECT_EQ(copy.dense_values.size(), 8u);
+    EXPECT_EQ(copy.non_zero_indices.size(), 8u);
+    EXPECT_EQ(copy.char_workspace.size(), 8u + 6400u);
+    EXPECT_TRUE(copy.integer_workspace.empty());
+    EXPECT_TRUE(copy.packed_indices.empty());
+    EXPECT_TRUE(copy.packed_values.empty());
+    copy.allocate_workspaces();
+    EXPECT_EQ(copy.integer_workspace.size(), 32u);
+    EXPECT_EQ(copy.integer_workspace[3], 0);
+    EXPECT_EQ(copy.packed_values.size(), 8u);
+    copy.create_sorted_packed_storage();
+    EXPECT_EQ(copy.packed_element_count, 2);
+
+    source.make_dense();
+    const kalix::UniqueVector<double> dense_copy = source.clone_structure();
+    EXPECT_EQ(dense_copy.representation(), kalix::VectorRepresentation::kDense);
+    EXPECT_DOUBLE_EQ(dense_copy.dense_values[6], 4.0);
+}
+
 class VectorCompensatedTest : public ::testing::Test
 {
 protected:
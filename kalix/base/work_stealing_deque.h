@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_WORK_STEALING_DEQUE_H_
+#define KALIX_BASE_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+
+namespace kalix
+{
+    /// @brief Assumed size of a cache line, used to keep hot atomics on separate lines.
+    inline constexpr size_t kCacheLineSize = 64;
+
+    /// @brief Lock-free single-owner work-stealing deque (Chase–Lev).
+    ///
+    /// The owning thread pushes and pops at the bottom, any other thread may steal from the
+    /// top. The memory orderings follow Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+    /// Work-Stealing for Weak Memory Models" (PPoPP 2013).
+    ///
+    /// The ring buffer grows by doubling when full. Replaced buffers are retired, not freed,
+    /// because a concurrent thief may still read from them; they are released together with
+    /// the deque. Since the capacity only doubles, the retired memory is bounded by the
+    /// final capacity.
+    ///
+    /// @tparam T The element type. Must be trivially copyable (typically a pointer).
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class WorkStealingDeque
+    {
+        struct RingBuffer
+        {
+            explicit RingBuffer(const int64_t capacity_)
+                : capacity(capacity_), mask(capacity_ - 1), slots(new std::atomic<T>[capacity_])
+            {
+            }
+
+            [[nodiscard]] KALIX_FORCE_INLINE T load(const int64_t index) const
+            {
+                return slots[index & mask].load(std::memory_order_relaxed);
+            }
+
+            KALIX_FORCE_INLINE void store(const int64_t index, const T value)
+            {
+                slots[index & mask].store(value, std::memory_order_relaxed);
+            }
+
+            int64_t capacity;
+            int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+        };
+
+    public:
+        /// @brief Constructs an empty deque.
+        /// @param initial_capacity Initial ring buffer capacity, rounded up to a power of two.
+        explicit WorkStealingDeque(const int64_t initial_capacity = 256)
+        {
+            int64_t capacity = 1;
+            while (capacity < initial_capacity)
+            {
+                capacity <<= 1;
+            }
+            buffers_.push_back(std::make_unique<RingBuffer>(capacity));
+            buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /// @brief Pushes @p value at the bottom. Owner thread only.
+        KALIX_FORCE_INLINE void push(const T value)
+        {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const int64_t top = top_.load(std::memory_order_acquire);
+            RingBuffer* buffer = buffer_.load(std::memory_order_relaxed);
+            if (KALIX_UNLIKELY(bottom - top > buffer->capacity - 1))
+            {
+                buffer = grow(buffer, top, bottom);
+            }
+            buffer->store(bottom, value);
+            // Publishes the slot to thieves (the paper's release fence, folded into the store).
+            bottom_.store(bottom + 1, std::memory_order_release);
+        }
+
+        /// @brief Pops the most recently pushed element. Owner thread only.
+        /// @return The element, or @c std::nullopt if the deque is empty.
+        KALIX_FORCE_INLINE std::optional<T> pop()
+        {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            RingBuffer* buffer = buffer_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T value = buffer->load(bottom);
+            if (top == bottom)
+            {
+                // Last element: race against thieves for it.
+                const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                              std::memory_order_relaxed);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                if (!won)
+                {
+                    return std::nullopt;
+                }
+            }
+            return value;
+        }
+
+        /// @brief Steals the oldest element. Callable from any thread.
+        /// @return The element, or @c std::nullopt if the deque was empty or the steal lost a race.
+        KALIX_FORCE_INLINE std::optional<T> steal()
+        {
+            int64_t top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return std::nullopt;
+            }
+
+            const RingBuffer* buffer = buffer_.load(std::memory_order_acquire);
+            T value = buffer->load(top);
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        /// @brief Returns an estimate of the number of elements. Exact only on a quiescent deque.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t size() const
+        {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const int64_t top = top_.load(std::memory_order_relaxed);
+            return bottom > top ? bottom - top : 0;
+        }
+
+        /// @brief Returns whether the deque appears empty.
+        [[nodiscard]] KALIX_FORCE_INLINE bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// @brief Returns the current ring buffer capacity.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t capacity() const
+        {
+            return buffer_.load(std::memory_order_relaxed)->capacity;
+        }
+
+    private:
+        KALIX_NO_INLINE RingBuffer* grow(const RingBuffer* old_buffer, const int64_t top, const int64_t bottom)
+        {
+            auto new_buffer = std::make_unique<RingBuffer>(old_buffer->capacity * 2);
+            for (int64_t i = top; i < bottom; i++)
+            {
+                new_buffer->store(i, old_buffer->load(i));
+            }
+            RingBuffer* raw = new_buffer.get();
+            buffers_.push_back(std::move(new_buffer));
+            buffer_.store(raw, std::memory_order_release);
+            return raw;
+        }
+
+        alignas(kCacheLineSize) std::atomic<int64_t> top_{0};
+        alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};
+        alignas(kCacheLineSize) std::atomic<RingBuffer*> buffer_{nullptr};
+
+        // Owner-only: every buffer ever allocated, including retired ones.
+        std::vector<std::unique_ptr<RingBuffer>> buffers_;
+    };
+}
+
+#endif // KALIX_BASE_WORK_STEALING_DEQUE_H_
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "kalix/base/work_stealing_deque.h"
+
+TEST(WorkStealingDequeTest, PopIsLifoAndStealIsFifo)
+{
+    kalix::WorkStealingDeque<int64_t> deque;
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+
+    EXPECT_EQ(deque.size(), 3);
+    EXPECT_EQ(deque.steal(), 1);
+    EXPECT_EQ(deque.pop(), 3);
+    EXPECT_EQ(deque.pop(), 2);
+    EXPECT_FALSE(deque.pop().has_value());
+    EXPECT_FALSE(deque.steal().has_value());
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsWhenFull)
+{
+    kalix::WorkStealingDeque<int64_t> deque(4);
+    EXPECT_EQ(deque.capacity(), 4);
+
+    for (int64_t i = 0; i < 100; i++)
+    {
+        deque.push(i);
+    }
+    EXPECT_GE(deque.capacity(), 100);
+    EXPECT_EQ(deque.steal(), 0);
+    for (int64_t i = 99; i >= 1; i--)
+    {
+        EXPECT_EQ(deque.pop(), i);
+    }
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEveryElementOnce)
+{
+    constexpr int64_t kElements = 100000;
+    constexpr int kThieves = 3;
+
+    kalix::WorkStealingDeque<int64_t> deque(16);
+    std::vector<std::atomic<int>> seen(kElements);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; t++)
+    {
+        thieves.emplace_back([&]
+        {
+            while (!done.load(std::memory_order_acquire) || !deque.empty())
+            {
+                if (const auto value = deque.steal())
+                {
+                    seen[*value].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int64_t i = 0; i < kElements; i++)
+    {
+        deque.push(i);
+        if (i % 3 == 0)
+        {
+            if (const auto value = deque.pop())
+            {
+                seen[*value].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (const auto value = deque.pop())
+    {
+        seen[*value].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (int64_t i = 0; i < kElements; i++)
+    {
+        ASSERT_EQ(seen[i].load(), 1) << "element " << i;
+    }
+}
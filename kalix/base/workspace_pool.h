@@ -0,0 +1,203 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_BASE_WORKSPACE_POOL_H_
+#define KALIX_BASE_WORKSPACE_POOL_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+
+namespace kalix
+{
+    /// @brief A pool of reusable workspaces handed out to concurrently running tasks.
+    ///
+    /// Kernels such as BTRAN or PRICE need scratch vectors whose setup cost is proportional
+    /// to the problem dimension. When such kernels run as tasks, every task leases a workspace
+    /// for its duration, so the workspace is exclusive to the executing thread while it is held.
+    /// Workspaces are created lazily by the initializer and are never freed before the pool,
+    /// so after warm-up no allocation happens on the hot path.
+    ///
+    /// @tparam Workspace The workspace type. Must be default constructible.
+    template <typename Workspace>
+    class WorkspacePool
+    {
+    public:
+        /// @brief Exclusive handle to a pooled workspace. Returns the workspace on destruction.
+        class Lease
+        {
+        public:
+            /// @brief Constructs an empty lease.
+            Lease() = default;
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            /// @brief Move constructor.
+            KALIX_FORCE_INLINE Lease(Lease&& other) noexcept
+                : pool_(std::exchange(other.pool_, nullptr)), workspace_(std::exchange(other.workspace_, nullptr))
+            {
+            }
+
+            /// @brief Move assignment operator.
+            KALIX_FORCE_INLINE Lease& operator=(Lease&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    pool_ = std::exchange(other.pool_, nullptr);
+                    workspace_ = std::exchange(other.workspace_, nullptr);
+                }
+                return *this;
+            }
+
+            KALIX_FORCE_INLINE ~Lease()
+            {
+                reset();
+            }
+
+            /// @brief Returns the workspace to the pool early.
+            KALIX_FORCE_INLINE void reset()
+            {
+                if (workspace_ != nullptr)
+                {
+                    pool_->release(workspace_);
+                    workspace_ = nullptr;
+                    pool_ = nullptr;
+                }
+            }
+
+            KALIX_FORCE_INLINE Workspace& operator*() const
+            {
+                DCHECK(workspace_ != nullptr);
+                return *workspace_;
+            }
+
+            KALIX_FORCE_INLINE Workspace* operator->() const
+            {
+                DCHECK(workspace_ != nullptr);
+                return workspace_;
+            }
+
+            /// @brief Returns the leased workspace.
+            [[nodiscard]] KALIX_FORCE_INLINE Workspace* get() const
+            {
+                return workspace_;
+            }
+
+        private:
+            friend class WorkspacePool;
+
+            KALIX_FORCE_INLINE Lease(WorkspacePool* pool, Workspace* workspace)
+                : pool_(pool), workspace_(workspace)
+            {
+            }
+
+            WorkspacePool* pool_ = nullptr;
+            Workspace* workspace_ = nullptr;
+        };
+
+        /// @brief Constructs a pool whose workspaces are default constructed.
+        WorkspacePool() = default;
+
+        /// @brief Constructs a pool that runs @p initializer once on every newly created workspace.
+        /// @param initializer Callable preparing a workspace, e.g. calling @c setup(dimension).
+        explicit WorkspacePool(std::function<void(Workspace&)> initializer)
+            : initializer_(std::move(initializer))
+        {
+        }
+
+        WorkspacePool(const WorkspacePool&) = delete;
+        WorkspacePool& operator=(const WorkspacePool&) = delete;
+
+        /// @brief Leases a workspace, creating a new one if all existing workspaces are in use.
+        [[nodiscard]] Lease acquire()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                if (!free_list_.empty())
+                {
+                    Workspace* workspace = free_list_.back();
+                    free_list_.pop_back();
+                    return Lease(this, workspace);
+                }
+            }
+
+            // Initialization can be expensive, so it runs outside the lock.
+            auto workspace = std::make_unique<Workspace>();
+            if (initializer_)
+            {
+                initializer_(*workspace);
+            }
+
+            Workspace* raw = workspace.get();
+            std::lock_guard lock(mutex_);
+            workspaces_.push_back(std::move(workspace));
+            return Lease(this, raw);
+        }
+
+        /// @brief Creates workspaces until at least @p count exist.
+        /// @param count The number of workspaces to pre-allocate.
+        void reserve(const int64_t count)
+        {
+            std::vector<Lease> leases;
+            leases.reserve(count);
+            while (this->size() < count)
+            {
+                leases.push_back(acquire());
+            }
+        }
+
+        /// @brief Returns the number of workspaces created so far.
+        [[nodiscard]] int64_t size() const
+        {
+            std::lock_guard lock(mutex_);
+            return static_cast<int64_t>(workspaces_.size());
+        }
+
+        /// @brief Returns the number of workspaces currently not leased.
+        [[nodiscard]] int64_t available() const
+        {
+            std::lock_guard lock(mutex_);
+            return static_cast<int64_t>(free_list_.size());
+        }
+
+    private:
+        KALIX_FORCE_INLINE void release(Workspace* workspace)
+        {
+            std::lock_guard lock(mutex_);
+            free_list_.push_back(workspace);
+        }
+
+        std::function<void(Workspace&)> initializer_;
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<Workspace>> workspaces_;
+        std::vector<Workspace*> free_list_;
+    };
+}
+
+#endif // KALIX_BASE_WORKSPACE_POOL_H_
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "kalix/base/vector.h"
+#include "kalix/base/workspace_pool.h"
+
+TEST(WorkspacePoolTest, InitializesNewWorkspaces)
+{
+    kalix::WorkspacePool<kalix::Vector<double>> pool([](kalix::Vector<double>& v) { v.setup(16); });
+
+    const auto lease = pool.acquire();
+    EXPECT_EQ(lease->dimension, 16);
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_EQ(pool.available(), 0);
+}
+
+TEST(WorkspacePoolTest, ReusesReleasedWorkspaces)
+{
+    kalix::WorkspacePool<kalix::Vector<double>> pool([](kalix::Vector<double>& v) { v.setup(4); });
+
+    kalix::Vector<double>* first;
+    {
+        const auto lease = pool.acquire();
+        first = lease.get();
+    }
+    EXPECT_EQ(pool.available(), 1);
+
+    const auto lease = pool.acquire();
+    EXPECT_EQ(lease.get(), first);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(WorkspacePoolTest, ConcurrentLeasesAreDistinct)
+{
+    kalix::WorkspacePool<kalix::Vector<double>> pool;
+
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    EXPECT_NE(a.get(), b.get());
+
+    // Moving a lease transfers ownership without returning the workspace.
+    auto c = std::move(a);
+    EXPECT_EQ(a.get(), nullptr);
+    EXPECT_EQ(pool.available(), 0);
+
+    c.reset();
+    EXPECT_EQ(pool.available(), 1);
+}
+
+TEST(WorkspacePoolTest, ReserveAndThreadedUse)
+{
+    kalix::WorkspacePool<std::vector<int>> pool([](std::vector<int>& v) { v.assign(8, 0); });
+    pool.reserve(4);
+    EXPECT_EQ(pool.size(), 4);
+    EXPECT_EQ(pool.available(), 4);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&pool, t]
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                const auto lease = pool.acquire();
+                (*lease)[0] = t;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(pool.size(), 4);
+    EXPECT_EQ(pool.available(), pool.size());
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/binary_model.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        constexpr SectionFileMagic kMagic = {'K', 'A', 'L', 'I', 'X', 'L', 'P', '\0'};
+
+        enum SectionId : uint32_t
+        {
+            kMetadata = 1,
+            kColumnStarts = 2,
+            kRowIndices = 3,
+            kValues = 4,
+            kObjective = 5,
+            kColumnLower = 6,
+            kColumnUpper = 7,
+            kRowLower = 8,
+            kRowUpper = 9,
+            kModelName = 10,
+            kRowNameOffsets = 11,
+            kRowNameCharacters = 12,
+            kColumnNameOffsets = 13,
+            kColumnNameCharacters = 14,
+        };
+
+        struct Metadata
+        {
+            int64_t num_rows;
+            int64_t num_cols;
+            int64_t num_non_zeros;
+            double objective_offset;
+            int32_t sense;
+            uint32_t reserved;
+        };
+
+        struct StringTable
+        {
+            std::vector<uint64_t> offsets;
+            std::string characters;
+
+            explicit StringTable(const std::vector<std::string>& strings)
+            {
+                offsets.reserve(strings.size() + 1);
+                offsets.push_back(0);
+                for (const std::string& string : strings)
+                {
+                    characters += string;
+                    offsets.push_back(characters.size());
+                }
+            }
+        };
+
+        std::span<const std::byte> string_bytes(const std::string_view string)
+        {
+            return std::as_bytes(std::span<const char>(string.data(), string.size()));
+        }
+
+        std::string_view as_string(const std::span<const std::byte> bytes)
+        {
+            return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+        }
+
+        /// @brief Loads the name table stored in the two given sections, if present.
+        bool load_names(const SectionFile& file, const uint32_t offsets_id, const uint32_t characters_id,
+                        const int64_t count, StringTableView& table)
+        {
+            if (file.contains(offsets_id) != file.contains(characters_id))
+            {
+                return false;
+            }
+            if (!file.contains(offsets_id))
+            {
+                return true;
+            }
+            const std::optional<std::span<const uint64_t>> offsets = file.array<uint64_t>(offsets_id, count + 1);
+            if (!offsets)
+            {
+                return false;
+            }
+            table.offsets = *offsets;
+            table.characters = as_string(file.section(characters_id));
+            return table.offsets.front() == 0 && table.offsets.back() == table.characters.size();
+        }
+    }
+
+    absl::Status write_binary_model(const lp::LinearProgram& program, const std::string& path,
+                                    const BinaryModelWriteOptions& options)
+    {
+        const lp::CscMatrix& matrix = program.constraint_matrix;
+        const Metadata metadata = {
+            .num_rows = matrix.num_rows,
+            .num_cols = matrix.num_cols,
+            .num_non_zeros = matrix.num_non_zeros(),
+            .objective_offset = program.objective_offset,
+            .sense = static_cast<int32_t>(program.sense),
+            .reserved = 0,
+        };
+
+        SectionFileWriter writer(kMagic, kBinaryModelVersion);
+        writer.add_array(kMetadata, std::span<const Metadata>(&metadata, 1));
+        writer.add_array<int64_t>(kColumnStarts, matrix.column_starts);
+        writer.add_array<int64_t>(kRowIndices, matrix.row_indices);
+        writer.add_array<double>(kValues, matrix.values);
+        writer.add_array<double>(kObjective, program.objective);
+        writer.add_array<double>(kColumnLower, program.column_lower);
+        writer.add_array<double>(kColumnUpper, program.column_upper);
+        writer.add_array<double>(kRowLower, program.row_lower);
+        writer.add_array<double>(kRowUpper, program.row_upper);
+        writer.add(kModelName, string_bytes(program.name));
+
+        const bool row_names = options.names && !program.row_names.empty();
+        const bool column_names = options.names && !program.column_names.empty();
+        const StringTable row_table(row_names ? program.row_names : std::vector<std::string>{});
+        const StringTable column_table(column_names ? program.column_names : std::vector<std::string>{});
+        if (row_names)
+        {
+            writer.add_array<uint64_t>(kRowNameOffsets, row_table.offsets);
+            writer.add(kRowNameCharacters, string_bytes(row_table.characters));
+        }
+        if (column_names)
+        {
+            writer.add_array<uint64_t>(kColumnNameOffsets, column_table.offsets);
+            writer.add(kColumnNameCharacters, string_bytes(column_table.characters));
+        }
+        return writer.write(path, options.checksum);
+    }
+
+    absl::StatusOr<BinaryModel> BinaryModel::open(const std::string& path, const BinaryModelOpenOptions& options)
+    {
+        absl::StatusOr<SectionFile> file = SectionFile::open(path, kMagic, kBinaryModelVersion, options.verify_checksum);
+        if (!file.ok())
+        {
+            return file.status();
+        }
+
+        const auto corrupt = [&path](const std::string_view reason)
+        {
+            return absl::DataLossError(absl::StrCat("Binary model '", path, "' is corrupt: ", reason));
+        };
+
+        Metadata metadata;
+        if (!file->read_value(kMetadata, metadata) || metadata.num_rows < 0 || metadata.num_cols < 0 ||
+            metadata.num_non_zeros < 0 ||
+            (metadata.sense != static_cast<int32_t>(lp::ObjectiveSense::kMinimize) &&
+                metadata.sense != static_cast<int32_t>(lp::ObjectiveSense::kMaximize)))
+        {
+            return corrupt("bad metadata");
+        }
+
+        const int64_t rows = metadata.num_rows;
+        const int64_t cols = metadata.num_cols;
+        const int64_t nnz = metadata.num_non_zeros;
+        const auto column_starts = file->array<int64_t>(kColumnStarts, cols + 1);
+        const auto row_indices = file->array<int64_t>(kRowIndices, nnz);
+        const auto values = file->array<double>(kValues, nnz);
+        const auto objective = file->array<double>(kObjective, cols);
+        const auto column_lower = file->array<double>(kColumnLower, cols);
+        const auto column_upper = file->array<double>(kColumnUpper, cols);
+        const auto row_lower = file->array<double>(kRowLower, rows);
+        const auto row_upper = file->array<double>(kRowUpper, rows);
+        if (!column_starts || !row_indices || !values || !objective || !column_lower || !column_upper || !row_lower ||
+            !row_upper)
+        {
+            return corrupt("missing or mis-sized array section");
+        }
+        if (column_starts->front() != 0 || column_starts->back() != nnz)
+        {
+            return corrupt("inconsistent column starts");
+        }
+
+        BinaryModel model;
+        model.matrix_ = {*column_starts, *row_indices, *values, rows, cols};
+        model.objective_ = *objective;
+        model.column_lower_ = *column_lower;
+        model.column_upper_ = *column_upper;
+        model.row_lower_ = *row_lower;
+        model.row_upper_ = *row_upper;
+        model.sense_ = static_cast<lp::ObjectiveSense>(metadata.sense);
+        model.objective_offset_ = metadata.objective_offset;
+        model.name_ = as_string(file->section(kModelName));
+        if (!load_names(*file, kRowNameOffsets, kRowNameCharacters, rows, model.row_names_) ||
+            !load_names(*file, kColumnNameOffsets, kColumnNameCharacters, cols, model.column_names_))
+        {
+            return corrupt("inconsistent name table");
+        }
+
+        model.file_ = std::move(*file);
+        return model;
+    }
+
+    lp::LinearProgram BinaryModel::to_linear_program() const
+    {
+        lp::LinearProgram program;
+        program.name = std::string(name_);
+        program.sense = sense_;
+        program.objective_offset = objective_offset_;
+        program.constraint_matrix = lp::CscMatrix::from_view(matrix_);
+        program.objective.assign(objective_.begin(), objective_.end());
+        program.column_lower.assign(column_lower_.begin(), column_lower_.end());
+        program.column_upper.assign(column_upper_.begin(), column_upper_.end());
+        program.row_lower.assign(row_lower_.begin(), row_lower_.end());
+        program.row_upper.assign(row_upper_.begin(), row_upper_.end());
+        program.row_names.reserve(row_names_.size());
+        for (int64_t i = 0; i < row_names_.size(); i++)
+        {
+            program.row_names.emplace_back(row_names_[i]);
+        }
+        program.column_names.reserve(column_names_.size());
+        for (int64_t j = 0; j < column_names_.size(); j++)
+        {
+            program.column_names.emplace_back(column_names_[j]);
+        }
+        return program;
+    }
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IO_BINARY_MODEL_H_
+#define KALIX_IO_BINARY_MODEL_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "kalix/io/section_file.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::io
+{
+    /// @brief Version of the binary model format written by @ref write_binary_model.
+    inline constexpr uint32_t kBinaryModelVersion = 1;
+
+    /// @brief Options for writing a binary model.
+    struct BinaryModelWriteOptions
+    {
+        /// @brief Whether to store a checksum for every section.
+        bool checksum = true;
+
+        /// @brief Whether to store row and column names.
+        bool names = true;
+    };
+
+    /// @brief Options for opening a binary model.
+    struct BinaryModelOpenOptions
+    {
+        /// @brief Whether to verify the section checksums. This touches every page of the file.
+        bool verify_checksum = false;
+    };
+
+    /// @brief Writes @p program to @p path in the binary model format.
+    ///
+    /// The model is stored as a @ref SectionFileWriter "section file" with one section per array:
+    /// the CSC arrays, costs, bounds, and string tables for the names. The scalar data lives in a
+    /// small metadata section.
+    ///
+    /// @param program The linear program.
+    /// @param path The destination file.
+    /// @param options The write options.
+    /// @return An error status if the file cannot be written.
+    absl::Status write_binary_model(const lp::LinearProgram& program, const std::string& path,
+                                    const BinaryModelWriteOptions& options = {});
+
+    /// @brief A non-owning view of a table of strings stored as offsets into a character block.
+    struct StringTableView
+    {
+        /// @brief Start offset of every string, plus one trailing entry holding the total length.
+        std::span<const uint64_t> offsets;
+
+        /// @brief The concatenated characters.
+        std::string_view characters;
+
+        /// @brief Returns the number of strings.
+        [[nodiscard]] int64_t size() const
+        {
+            return offsets.empty() ? 0 : static_cast<int64_t>(offsets.size()) - 1;
+        }
+
+        /// @brief Returns string @p index.
+        [[nodiscard]] std::string_view operator[](const int64_t index) const
+        {
+            DCHECK_GE(index, 0);
+            DCHECK_LT(index, size());
+            return characters.substr(offsets[index], offsets[index + 1] - offsets[index]);
+        }
+    };
+
+    /// @brief A linear program read from a memory-mapped binary model file.
+    ///
+    /// Opening only validates the header, the section table and the array sizes, so it takes
+    /// constant time independent of the model size. All accessors return views into the mapping, which stay
+    /// valid as long as this object lives, also across moves.
+    class BinaryModel
+    {
+    public:
+        /// @brief Memory maps and validates the binary model at @p path.
+        /// @param path The file to open.
+        /// @param options The open options.
+        /// @return The model, or an error status if the file is missing, truncated or corrupt.
+        static absl::StatusOr<BinaryModel> open(const std::string& path, const BinaryModelOpenOptions& options = {});
+
+        /// @brief Returns the name of the problem.
+        [[nodiscard]] std::string_view name() const
+        {
+            return name_;
+        }
+
+        /// @brief Returns the direction of optimization.
+        [[nodiscard]] lp::ObjectiveSense sense() const
+        {
+            return sense_;
+        }
+
+        /// @brief Returns the constant term of the objective.
+        [[nodiscard]] double objective_offset() const
+        {
+            return objective_offset_;
+        }
+
+        /// @brief Returns the number of rows.
+        [[nodiscard]] int64_t num_rows() const
+        {
+            return matrix_.num_rows;
+        }
+
+        /// @brief Returns the number of columns.
+        [[nodiscard]] int64_t num_cols() const
+        {
+            return matrix_.num_cols;
+        }
+
+        /// @brief Returns the constraint matrix.
+        [[nodiscard]] const lp::CscMatrixView& constraint_matrix() const
+        {
+            return matrix_;
+        }
+
+        /// @brief Returns the objective coefficients.
+        [[nodiscard]] std::span<const double> objective() const
+        {
+            return objective_;
+        }
+
+        /// @brief Returns the column lower bounds.
+        [[nodiscard]] std::span<const double> column_lower() const
+        {
+            return column_lower_;
+        }
+
+        /// @brief Returns the column upper bounds.
+        [[nodiscard]] std::span<const double> column_upper() const
+        {
+            return column_upper_;
+        }
+
+        /// @brief Returns the row lower bounds.
+        [[nodiscard]] std::span<const double> row_lower() const
+        {
+            return row_lower_;
+        }
+
+        /// @brief Returns the row upper bounds.
+        [[nodiscard]] std::span<const double> row_upper() const
+        {
+            return row_upper_;
+        }
+
+        /// @brief Returns the row names, or an empty table if the file has none.
+        [[nodiscard]] const StringTableView& row_names() const
+        {
+            return row_names_;
+        }
+
+        /// @brief Returns the column names, or an empty table if the file has none.
+        [[nodiscard]] const StringTableView& column_names() const
+        {
+            return column_names_;
+        }
+
+        /// @brief Copies the model into an owning @ref lp::LinearProgram.
+        [[nodiscard]] lp::LinearProgram to_linear_program() const;
+
+    private:
+        SectionFile file_;
+        std::string_view name_;
+        lp::ObjectiveSense sense_ = lp::ObjectiveSense::kMinimize;
+        double objective_offset_ = 0.0;
+        lp::CscMatrixView matrix_;
+        std::span<const double> objective_;
+        std::span<const double> column_lower_;
+        std::span<const double> column_upper_;
+        std::span<const double> row_lower_;
+        std::span<const double> row_upper_;
+        StringTableView row_names_;
+        StringTableView column_names_;
+    };
+}
+
+#endif // KALIX_IO_BINARY_MODEL_H_
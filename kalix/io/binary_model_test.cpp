@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/binary_model.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        lp::LinearProgram make_program()
+        {
+            lp::LinearProgram program;
+            program.name = "tiny";
+            program.sense = lp::ObjectiveSense::kMaximize;
+            program.objective_offset = 1.5;
+            program.constraint_matrix.num_rows = 2;
+            program.constraint_matrix.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{1.0, -2.0});
+            program.constraint_matrix.append_column(std::vector<int64_t>{1}, std::vector<double>{3.0});
+            program.constraint_matrix.append_column(std::vector<int64_t>{}, std::vector<double>{});
+            program.objective = {1.0, 2.0, 3.0};
+            program.column_lower = {0.0, -std::numeric_limits<double>::infinity(), 1.0};
+            program.column_upper = {4.0, 5.0, std::numeric_limits<double>::infinity()};
+            program.row_lower = {-1.0, 2.0};
+            program.row_upper = {1.0, 2.0};
+            program.row_names = {"r0", "row_one"};
+            program.column_names = {"x", "", "z_long_name"};
+            return program;
+        }
+
+        std::string temp_path(const std::string& name)
+        {
+            return ::testing::TempDir() + "/" + name;
+        }
+
+        void corrupt_byte(const std::string& path, const std::streamoff offset)
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekg(offset);
+            char c;
+            file.get(c);
+            file.seekp(offset);
+            file.put(static_cast<char>(c ^ 0x5A));
+        }
+    }
+
+    TEST(BinaryModelTest, RoundTrip)
+    {
+        const std::string path = temp_path("kalix_binary_model_roundtrip.klp");
+        const lp::LinearProgram program = make_program();
+        ASSERT_TRUE(write_binary_model(program, path).ok());
+
+        absl::StatusOr<BinaryModel> model = BinaryModel::open(path, {.verify_checksum = true});
+        ASSERT_TRUE(model.ok()) << model.status();
+        EXPECT_EQ(model->name(), "tiny");
+        EXPECT_EQ(model->sense(), lp::ObjectiveSense::kMaximize);
+        EXPECT_DOUBLE_EQ(model->objective_offset(), 1.5);
+        EXPECT_EQ(model->num_rows(), 2);
+        EXPECT_EQ(model->num_cols(), 3);
+        EXPECT_EQ(model->constraint_matrix().num_non_zeros(), 3);
+        EXPECT_EQ(model->constraint_matrix().column_length(2), 0);
+        EXPECT_DOUBLE_EQ(model->constraint_matrix().column_values(0)[1], -2.0);
+        EXPECT_EQ(model->row_names()[1], "row_one");
+        EXPECT_EQ(model->column_names()[1], "");
+        EXPECT_EQ(model->column_names()[2], "z_long_name");
+
+        const auto address = reinterpret_cast<uintptr_t>(model->constraint_matrix().values.data());
+        EXPECT_EQ(address % kSectionAlignment, 0u);
+
+        const lp::LinearProgram copy = model->to_linear_program();
+        EXPECT_EQ(copy.constraint_matrix, program.constraint_matrix);
+        EXPECT_EQ(copy.objective, program.objective);
+        EXPECT_EQ(copy.column_lower, program.column_lower);
+        EXPECT_EQ(copy.column_upper, program.column_upper);
+        EXPECT_EQ(copy.row_lower, program.row_lower);
+        EXPECT_EQ(copy.row_upper, program.row_upper);
+        EXPECT_EQ(copy.row_names, program.row_names);
+        EXPECT_EQ(copy.column_names, program.column_names);
+
+        // Views stay valid when the model is moved.
+        const BinaryModel moved = std::move(*model);
+        EXPECT_EQ(moved.objective()[2], 3.0);
+        std::remove(path.c_str());
+    }
+
+    TEST(BinaryModelTest, WritesWithoutNames)
+    {
+        const std::string path = temp_path("kalix_binary_model_nonames.klp");
+        ASSERT_TRUE(write_binary_model(make_program(), path, {.checksum = false, .names = false}).ok());
+
+        absl::StatusOr<BinaryModel> model = BinaryModel::open(path, {.verify_checksum = true});
+        ASSERT_TRUE(model.ok()) << model.status();
+        EXPECT_EQ(model->row_names().size(), 0);
+        EXPECT_EQ(model->column_names().size(), 0);
+        EXPECT_TRUE(model->to_linear_program().column_names.empty());
+        std::remove(path.c_str());
+    }
+
+    TEST(BinaryModelTest, WritesEmptyProgram)
+    {
+        const std::string path = temp_path("kalix_binary_model_empty.klp");
+        ASSERT_TRUE(write_binary_model(lp::LinearProgram{}, path).ok());
+        absl::StatusOr<BinaryModel> model = BinaryModel::open(path);
+        ASSERT_TRUE(model.ok()) << model.status();
+        EXPECT_EQ(model->num_cols(), 0);
+        EXPECT_EQ(model->constraint_matrix().num_non_zeros(), 0);
+        std::remove(path.c_str());
+    }
+
+    TEST(BinaryModelTest, ChecksumDetectsCorruption)
+    {
+        const std::string path = temp_path("kalix_binary_model_corrupt.klp");
+        ASSERT_TRUE(write_binary_model(make_program(), path).ok());
+
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        const std::streamoff size = in.tellg();
+        in.close();
+        // The last section holds column name characters; flip one of them.
+        corrupt_byte(path, size - kSectionAlignment);
+
+        EXPECT_TRUE(BinaryModel::open(path).ok());
+        const absl::StatusOr<BinaryModel> verified = BinaryModel::open(path, {.verify_checksum = true});
+        ASSERT_FALSE(verified.ok());
+        EXPECT_EQ(verified.status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+    }
+
+    TEST(BinaryModelTest, RejectsInvalidFiles)
+    {
+        const std::string path = temp_path("kalix_binary_model_invalid.klp");
+        ASSERT_TRUE(write_binary_model(make_program(), path).ok());
+        corrupt_byte(path, 0);
+        EXPECT_EQ(BinaryModel::open(path).status().code(), absl::StatusCode::kDataLoss);
+
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << "KALIX";
+        }
+        EXPECT_EQ(BinaryModel::open(path).status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+
+        EXPECT_FALSE(BinaryModel::open(path).ok());
+    }
+}
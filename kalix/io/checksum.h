@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IO_CHECKSUM_H_
+#define KALIX_IO_CHECKSUM_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "kalix/base/config.h"
+
+namespace kalix::io
+{
+    namespace detail
+    {
+        inline constexpr uint64_t kChecksumPrime1 = 0x9E3779B185EBCA87ull;
+        inline constexpr uint64_t kChecksumPrime2 = 0xC2B2AE3D27D4EB4Full;
+        inline constexpr uint64_t kChecksumPrime3 = 0x165667B19E3779F9ull;
+
+        KALIX_FORCE_INLINE uint64_t load_word(const std::byte* bytes)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        KALIX_FORCE_INLINE uint64_t checksum_round(const uint64_t accumulator, const uint64_t word)
+        {
+            return std::rotl(accumulator + word * kChecksumPrime2, 31) * kChecksumPrime1;
+        }
+    }
+
+    /// @brief Computes a 64-bit checksum of @p bytes.
+    ///
+    /// Processes 32 bytes per step in four independent lanes, so large sections are hashed at close
+    /// to memory bandwidth. The checksum detects corruption; it is not cryptographically secure.
+    ///
+    /// @param bytes The data to hash.
+    /// @param seed An optional seed.
+    /// @return The checksum.
+    inline uint64_t compute_checksum(const std::span<const std::byte> bytes, const uint64_t seed = 0)
+    {
+        using namespace detail;
+
+        const std::byte* data = bytes.data();
+        const size_t size = bytes.size();
+        size_t position = 0;
+
+        uint64_t lanes[4] = {
+            seed + kChecksumPrime1 + kChecksumPrime2,
+            seed + kChecksumPrime2,
+            seed,
+            seed - kChecksumPrime1,
+        };
+        for (; position + 32 <= size; position += 32)
+        {
+            lanes[0] = checksum_round(lanes[0], load_word(data + position));
+            lanes[1] = checksum_round(lanes[1], load_word(data + position + 8));
+            lanes[2] = checksum_round(lanes[2], load_word(data + position + 16));
+            lanes[3] = checksum_round(lanes[3], load_word(data + position + 24));
+        }
+
+        uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) +
+            std::rotl(lanes[3], 18) + static_cast<uint64_t>(size);
+        for (; position + 8 <= size; position += 8)
+        {
+            hash = std::rotl(hash ^ checksum_round(0, load_word(data + position)), 27) * kChecksumPrime1 +
+                kChecksumPrime3;
+        }
+        for (; position < size; position++)
+        {
+            hash = std::rotl(hash ^ (static_cast<uint64_t>(data[position]) * kChecksumPrime3), 11) * kChecksumPrime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= kChecksumPrime2;
+        hash ^= hash >> 29;
+        hash *= kChecksumPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
+
+#endif // KALIX_IO_CHECKSUM_H_
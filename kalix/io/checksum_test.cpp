@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/checksum.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::io
+{
+    TEST(ChecksumTest, IsDeterministicAndSensitive)
+    {
+        std::vector<std::byte> data(1000);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<std::byte>(i * 7);
+        }
+        const uint64_t reference = compute_checksum(data);
+        EXPECT_EQ(compute_checksum(data), reference);
+        EXPECT_NE(compute_checksum(data, 1), reference);
+
+        // Changes in the block part, the word tail and the byte tail are all detected.
+        for (const size_t position : {size_t{5}, size_t{990}, size_t{999}})
+        {
+            std::vector<std::byte> changed = data;
+            changed[position] ^= std::byte{1};
+            EXPECT_NE(compute_checksum(changed), reference);
+        }
+    }
+
+    TEST(ChecksumTest, DependsOnLength)
+    {
+        const std::vector<std::byte> zeros(64);
+        EXPECT_NE(compute_checksum(std::span(zeros).first(32)), compute_checksum(zeros));
+        EXPECT_NE(compute_checksum(std::span(zeros).first(0)), compute_checksum(std::span(zeros).first(1)));
+    }
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/memory_mapped_file.h"
+
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace kalix::io
+{
+#if defined(_WIN32)
+
+    absl::StatusOr<MemoryMappedFile> MemoryMappedFile::open(const std::string& path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return absl::NotFoundError(absl::StrCat("Cannot open file: ", path));
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return absl::InternalError(absl::StrCat("Cannot determine size of file: ", path));
+        }
+
+        MemoryMappedFile result;
+        result.file_handle_ = file;
+        result.size_ = static_cast<size_t>(size.QuadPart);
+        if (result.size_ == 0)
+        {
+            return result;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            return absl::InternalError(absl::StrCat("Cannot map file: ", path));
+        }
+        result.mapping_handle_ = mapping;
+        result.address_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (result.address_ == nullptr)
+        {
+            return absl::InternalError(absl::StrCat("Cannot map file: ", path));
+        }
+        return result;
+    }
+
+    void MemoryMappedFile::release()
+    {
+        if (address_ != nullptr)
+        {
+            UnmapViewOfFile(address_);
+        }
+        if (mapping_handle_ != nullptr)
+        {
+            CloseHandle(mapping_handle_);
+        }
+        if (file_handle_ != nullptr)
+        {
+            CloseHandle(file_handle_);
+        }
+        address_ = nullptr;
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+        size_ = 0;
+    }
+
+#else
+
+    absl::StatusOr<MemoryMappedFile> MemoryMappedFile::open(const std::string& path)
+    {
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            return absl::NotFoundError(absl::StrCat("Cannot open file: ", path, ": ", std::strerror(errno)));
+        }
+
+        struct stat info{};
+        if (fstat(descriptor, &info) != 0)
+        {
+            ::close(descriptor);
+            return absl::InternalError(absl::StrCat("Cannot determine size of file: ", path));
+        }
+
+        MemoryMappedFile result;
+        result.size_ = static_cast<size_t>(info.st_size);
+        if (result.size_ > 0)
+        {
+            void* address = mmap(nullptr, result.size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED)
+            {
+                ::close(descriptor);
+                return absl::InternalError(absl::StrCat("Cannot map file: ", path, ": ", std::strerror(errno)));
+            }
+            // The file is read front to back by the parsers, let the kernel read ahead aggressively.
+            madvise(address, result.size_, MADV_SEQUENTIAL);
+            result.address_ = address;
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        ::close(descriptor);
+        return result;
+    }
+
+    void MemoryMappedFile::release()
+    {
+        if (address_ != nullptr)
+        {
+            munmap(const_cast<void*>(address_), size_);
+        }
+        address_ = nullptr;
+        size_ = 0;
+    }
+
+#endif
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            address_ = std::exchange(other.address_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+            file_handle_ = std::exchange(other.file_handle_, nullptr);
+            mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        release();
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IO_MEMORY_MAPPED_FILE_H_
+#define KALIX_IO_MEMORY_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "absl/status/statusor.h"
+
+namespace kalix::io
+{
+    /// @brief A read-only memory mapping of a whole file.
+    ///
+    /// The mapping is released when the object is destroyed. Views into @ref data() must not
+    /// outlive the object. Empty files yield an empty mapping.
+    class MemoryMappedFile
+    {
+    public:
+        /// @brief Maps the file at @p path into memory.
+        /// @param path The file to map.
+        /// @return The mapping, or an error status if the file cannot be opened or mapped.
+        static absl::StatusOr<MemoryMappedFile> open(const std::string& path);
+
+        MemoryMappedFile() = default;
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+        MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+        MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+        ~MemoryMappedFile();
+
+        /// @brief Returns the mapped bytes.
+        [[nodiscard]] std::span<const std::byte> data() const
+        {
+            return {static_cast<const std::byte*>(address_), size_};
+        }
+
+        /// @brief Returns the mapped bytes as characters.
+        [[nodiscard]] std::string_view text() const
+        {
+            return {static_cast<const char*>(address_), size_};
+        }
+
+        /// @brief Returns the size of the mapping in bytes.
+        [[nodiscard]] size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        void release();
+
+        const void* address_ = nullptr;
+        size_t size_ = 0;
+#if defined(_WIN32)
+        void* file_handle_ = nullptr;
+        void* mapping_handle_ = nullptr;
+#endif
+    };
+}
+
+#endif // KALIX_IO_MEMORY_MAPPED_FILE_H_
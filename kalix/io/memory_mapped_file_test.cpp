@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/memory_mapped_file.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        std::string write_temp_file(const std::string& name, const std::string& contents)
+        {
+            const std::string path = ::testing::TempDir() + "/" + name;
+            std::ofstream out(path, std::ios::binary);
+            out << contents;
+            return path;
+        }
+    }
+
+    TEST(MemoryMappedFileTest, MapsFileContents)
+    {
+        const std::string path = write_temp_file("kalix_mmap_test.txt", "hello mapped world");
+        absl::StatusOr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+        ASSERT_TRUE(file.ok()) << file.status();
+        EXPECT_EQ(file->size(), 18u);
+        EXPECT_EQ(file->text(), "hello mapped world");
+        EXPECT_EQ(file->data()[0], std::byte{'h'});
+
+        MemoryMappedFile moved = std::move(*file);
+        EXPECT_EQ(moved.text(), "hello mapped world");
+        EXPECT_EQ(file->size(), 0u);
+        std::remove(path.c_str());
+    }
+
+    TEST(MemoryMappedFileTest, MapsEmptyFile)
+    {
+        const std::string path = write_temp_file("kalix_mmap_empty.txt", "");
+        absl::StatusOr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+        ASSERT_TRUE(file.ok()) << file.status();
+        EXPECT_EQ(file->size(), 0u);
+        EXPECT_TRUE(file->text().empty());
+        std::remove(path.c_str());
+    }
+
+    TEST(MemoryMappedFileTest, MissingFileIsAnError)
+    {
+        EXPECT_FALSE(MemoryMappedFile::open(::testing::TempDir() + "/kalix_no_such_file").ok());
+    }
+}
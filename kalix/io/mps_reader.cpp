@@ -0,0 +1,784 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/mps_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "kalix/base/config.h"
+#include "kalix/io/memory_mapped_file.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        // Enough for the longest data line (COLUMNS with two pairs) plus one to detect extra fields.
+        constexpr int kMaxTokens = 6;
+
+        enum class Section : int8_t
+        {
+            kNone,
+            kName,
+            kObjSense,
+            kRows,
+            kColumns,
+            kRhs,
+            kRanges,
+            kBounds,
+            kEndData,
+        };
+
+        using NameMap = absl::flat_hash_map<std::string_view, int64_t>;
+
+        KALIX_FORCE_INLINE bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        /// @brief Returns the line starting at @p position without its terminator and advances past it.
+        KALIX_FORCE_INLINE std::string_view next_line(const std::string_view text, size_t& position)
+        {
+            size_t end = text.find('\n', position);
+            if (end == std::string_view::npos)
+            {
+                end = text.size();
+            }
+            std::string_view line = text.substr(position, end - position);
+            position = end < text.size() ? end + 1 : text.size();
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            return line;
+        }
+
+        /// @brief Splits @p line at whitespace into at most @ref kMaxTokens tokens.
+        KALIX_FORCE_INLINE int split_tokens(const std::string_view line, std::string_view* tokens)
+        {
+            int count = 0;
+            size_t i = 0;
+            const size_t size = line.size();
+            while (count < kMaxTokens)
+            {
+                while (i < size && is_space(line[i]))
+                {
+                    i++;
+                }
+                if (i == size)
+                {
+                    break;
+                }
+                const size_t start = i;
+                while (i < size && !is_space(line[i]))
+                {
+                    i++;
+                }
+                tokens[count++] = line.substr(start, i - start);
+            }
+            return count;
+        }
+
+        KALIX_FORCE_INLINE bool is_blank_or_comment(const std::string_view line)
+        {
+            for (const char c : line)
+            {
+                if (!is_space(c))
+                {
+                    return c == '*';
+                }
+            }
+            return true;
+        }
+
+        KALIX_FORCE_INLINE bool is_marker(const std::string_view* tokens, const int count)
+        {
+            return count >= 3 && tokens[1] == "'MARKER'";
+        }
+
+        /// @brief Classifies a section header. Data lines start with whitespace and yield kNone.
+        Section header_section(const std::string_view line, std::string_view& keyword)
+        {
+            if (line.empty() || is_space(line[0]))
+            {
+                return Section::kNone;
+            }
+            std::string_view tokens[kMaxTokens];
+            if (split_tokens(line, tokens) == 0)
+            {
+                return Section::kNone;
+            }
+            keyword = tokens[0];
+            if (keyword == "NAME") return Section::kName;
+            if (keyword == "OBJSENSE") return Section::kObjSense;
+            if (keyword == "ROWS") return Section::kRows;
+            if (keyword == "COLUMNS") return Section::kColumns;
+            if (keyword == "RHS") return Section::kRhs;
+            if (keyword == "RANGES") return Section::kRanges;
+            if (keyword == "BOUNDS") return Section::kBounds;
+            if (keyword == "ENDATA") return Section::kEndData;
+            return Section::kNone;
+        }
+
+        absl::Status parse_number(std::string_view token, double& value)
+        {
+            if (!token.empty() && token.front() == '+')
+            {
+                token.remove_prefix(1);
+            }
+            const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+            if (error != std::errc() || end != token.data() + token.size())
+            {
+                return absl::InvalidArgumentError(absl::StrCat("Invalid number in MPS file: '", token, "'"));
+            }
+            return absl::OkStatus();
+        }
+
+        KALIX_FORCE_INLINE double clamp_infinity(const double value, const double infinity)
+        {
+            if (value >= infinity)
+            {
+                return kInfinity;
+            }
+            if (value <= -infinity)
+            {
+                return -kInfinity;
+            }
+            return value;
+        }
+
+        /// @brief Returns the offset of the first section header after the COLUMNS data starting at @p from.
+        size_t find_columns_end(const std::string_view text, const size_t from)
+        {
+            size_t end = text.size();
+            for (const std::string_view keyword : {"\nRHS", "\nRANGES", "\nBOUNDS", "\nENDATA"})
+            {
+                size_t position = from == 0 ? 0 : from - 1;
+                while ((position = text.find(keyword, position)) != std::string_view::npos && position < end)
+                {
+                    const size_t after = position + keyword.size();
+                    if (after == text.size() || is_space(text[after]) || text[after] == '\n')
+                    {
+                        end = position + 1;
+                        break;
+                    }
+                    position = after;
+                }
+            }
+            return end;
+        }
+
+        /// @brief Counts of one COLUMNS chunk gathered in the first pass.
+        struct ColumnChunk
+        {
+            size_t begin = 0;
+            size_t end = 0;
+            std::string_view previous_name;
+            int64_t entry_count = 0;
+            int64_t column_count = 0;
+            int64_t entry_offset = 0;
+            int64_t column_offset = 0;
+            absl::Status status;
+        };
+
+        /// @brief Returns the column name of the last data line that ends before @p position.
+        std::string_view previous_column_name(const std::string_view section, size_t position)
+        {
+            std::string_view tokens[kMaxTokens];
+            while (position > 0)
+            {
+                // position is a line start; find the start of the previous line.
+                const size_t line_end = position - 1;
+                const size_t newline = line_end == 0 ? std::string_view::npos : section.rfind('\n', line_end - 1);
+                const size_t line_start = newline == std::string_view::npos ? 0 : newline + 1;
+                size_t cursor = line_start;
+                const std::string_view line = next_line(section.substr(0, line_end + 1), cursor);
+                position = line_start;
+
+                if (is_blank_or_comment(line))
+                {
+                    continue;
+                }
+                const int count = split_tokens(line, tokens);
+                if (count == 0 || is_marker(tokens, count))
+                {
+                    continue;
+                }
+                return tokens[0];
+            }
+            return {};
+        }
+
+        class ColumnsParser
+        {
+        public:
+            ColumnsParser(const std::string_view section,
+                          const std::string_view objective_name,
+                          const NameMap& rows,
+                          const MpsReaderOptions& options)
+                : section_(section), objective_name_(objective_name), rows_(rows), options_(options)
+            {
+            }
+
+            absl::Status parse(lp::LinearProgram& program, std::vector<std::string_view>& column_names)
+            {
+                split_into_chunks();
+
+                for_each_chunk([this](const int64_t k) { count_chunk(chunks_[k]); });
+                int64_t entry_total = 0;
+                int64_t column_total = 0;
+                for (ColumnChunk& chunk : chunks_)
+                {
+                    if (!chunk.status.ok())
+                    {
+                        return chunk.status;
+                    }
+                    chunk.entry_offset = entry_total;
+                    chunk.column_offset = column_total;
+                    entry_total += chunk.entry_count;
+                    column_total += chunk.column_count;
+                }
+
+                lp::CscMatrix& matrix = program.constraint_matrix;
+                matrix.setup(static_cast<int64_t>(rows_.size()), column_total, entry_total);
+                program.objective.assign(column_total, 0.0);
+                column_names.resize(column_total);
+
+                for_each_chunk([&](const int64_t k) { fill_chunk(chunks_[k], program, column_names); });
+                for (const ColumnChunk& chunk : chunks_)
+                {
+                    if (!chunk.status.ok())
+                    {
+                        return chunk.status;
+                    }
+                }
+                matrix.column_starts[column_total] = entry_total;
+                return absl::OkStatus();
+            }
+
+        private:
+            template <typename Body>
+            void for_each_chunk(Body&& body)
+            {
+                parallel_for(options_.scheduler, 0, static_cast<int64_t>(chunks_.size()), 1, body);
+            }
+
+            void split_into_chunks()
+            {
+                const auto size = static_cast<int64_t>(section_.size());
+                int64_t chunk_count = 1;
+                if (options_.scheduler != nullptr)
+                {
+                    const int64_t max_chunks = 8 * static_cast<int64_t>(options_.scheduler->num_threads());
+                    chunk_count = std::clamp<int64_t>(size / std::max<int64_t>(1, options_.min_chunk_bytes), 1, max_chunks);
+                }
+
+                size_t begin = 0;
+                for (int64_t k = 1; k <= chunk_count; k++)
+                {
+                    size_t end = section_.size();
+                    if (k < chunk_count)
+                    {
+                        // Advance the nominal boundary to the next line start.
+                        end = std::max(begin, static_cast<size_t>(size * k / chunk_count));
+                        if (end > 0 && section_[end - 1] != '\n')
+                        {
+                            const size_t newline = section_.find('\n', end);
+                            end = newline == std::string_view::npos ? section_.size() : newline + 1;
+                        }
+                    }
+                    if (end > begin || k == chunk_count)
+                    {
+                        ColumnChunk& chunk = chunks_.emplace_back();
+                        chunk.begin = begin;
+                        chunk.end = end;
+                    }
+                    begin = end;
+                }
+            }
+
+            void count_chunk(ColumnChunk& chunk) const
+            {
+                chunk.previous_name = previous_column_name(section_, chunk.begin);
+                std::string_view previous = chunk.previous_name;
+                std::string_view tokens[kMaxTokens];
+
+                size_t position = chunk.begin;
+                while (position < chunk.end)
+                {
+                    const std::string_view line = next_line(section_.substr(0, chunk.end), position);
+                    if (is_blank_or_comment(line))
+                    {
+                        continue;
+                    }
+                    const int count = split_tokens(line, tokens);
+                    if (is_marker(tokens, count))
+                    {
+                        continue;
+                    }
+                    if (count != 3 && count != 5)
+                    {
+                        chunk.status = absl::InvalidArgumentError(absl::StrCat("Malformed COLUMNS line: '", line, "'"));
+                        return;
+                    }
+                    if (tokens[0] != previous)
+                    {
+                        chunk.column_count++;
+                        previous = tokens[0];
+                    }
+                    for (int pair = 1; pair < count; pair += 2)
+                    {
+                        if (tokens[pair] != objective_name_)
+                        {
+                            chunk.entry_count++;
+                        }
+                    }
+                }
+            }
+
+            void fill_chunk(ColumnChunk& chunk, lp::LinearProgram& program, std::vector<std::string_view>& names) const
+            {
+                lp::CscMatrix& matrix = program.constraint_matrix;
+                int64_t* row_indices = matrix.row_indices.data();
+                double* values = matrix.values.data();
+                int64_t* column_starts = matrix.column_starts.data();
+                double* objective = program.objective.data();
+
+                std::string_view previous = chunk.previous_name;
+                int64_t column = chunk.column_offset - 1;
+                int64_t entry = chunk.entry_offset;
+                std::string_view tokens[kMaxTokens];
+
+                size_t position = chunk.begin;
+                while (position < chunk.end)
+                {
+                    const std::string_view line = next_line(section_.substr(0, chunk.end), position);
+                    if (is_blank_or_comment(line))
+                    {
+                        continue;
+                    }
+                    const int count = split_tokens(line, tokens);
+                    if (is_marker(tokens, count))
+                    {
+                        continue;
+                    }
+                    if (tokens[0] != previous)
+                    {
+                        column++;
+                        column_starts[column] = entry;
+                        names[column] = tokens[0];
+                        previous = tokens[0];
+                    }
+                    for (int pair = 1; pair < count; pair += 2)
+                    {
+                        double value;
+                        if (absl::Status status = parse_number(tokens[pair + 1], value); !status.ok())
+                        {
+                            chunk.status = std::move(status);
+                            return;
+                        }
+                        if (tokens[pair] == objective_name_)
+                        {
+                            objective[column] += value;
+                            continue;
+                        }
+                        const auto row = rows_.find(tokens[pair]);
+                        if (row == rows_.end())
+                        {
+                            chunk.status = absl::InvalidArgumentError(
+                                absl::StrCat("Unknown row '", tokens[pair], "' in COLUMNS section"));
+                            return;
+                        }
+                        row_indices[entry] = row->second;
+                        values[entry] = value;
+                        entry++;
+                    }
+                }
+            }
+
+            std::string_view section_;
+            std::string_view objective_name_;
+            const NameMap& rows_;
+            const MpsReaderOptions& options_;
+            std::vector<ColumnChunk> chunks_;
+        };
+
+        /// @brief Parses the optional set name and the (row, value) pairs of an RHS or RANGES line.
+        template <typename Apply>
+        absl::Status parse_row_values(const std::string_view line, const std::string_view* tokens, const int count,
+                                      Apply&& apply)
+        {
+            if (count < 2 || count > 5)
+            {
+                return absl::InvalidArgumentError(absl::StrCat("Malformed line: '", line, "'"));
+            }
+            // An even field count means the set name was omitted.
+            for (int pair = count % 2 == 0 ? 0 : 1; pair + 1 < count; pair += 2)
+            {
+                double value;
+                if (absl::Status status = parse_number(tokens[pair + 1], value); !status.ok())
+                {
+                    return status;
+                }
+                if (absl::Status status = apply(tokens[pair], value); !status.ok())
+                {
+                    return status;
+                }
+            }
+            return absl::OkStatus();
+        }
+    }
+
+    absl::StatusOr<lp::LinearProgram> parse_mps(const std::string_view contents, const MpsReaderOptions& options)
+    {
+        lp::LinearProgram program;
+
+        std::string_view objective_name;
+        NameMap rows;
+        NameMap columns;
+        std::vector<std::string_view> row_names;
+        std::vector<std::string_view> column_names;
+        std::vector<char> row_types;
+        std::vector<double> rhs;
+        std::vector<double> ranges;
+        std::vector<char> has_range;
+
+        const auto find_row = [&](const std::string_view name, int64_t& row) -> absl::Status
+        {
+            const auto it = rows.find(name);
+            if (it == rows.end())
+            {
+                return absl::InvalidArgumentError(absl::StrCat("Unknown row '", name, "'"));
+            }
+            row = it->second;
+            return absl::OkStatus();
+        };
+
+        Section section = Section::kNone;
+        bool has_columns = false;
+        std::string_view tokens[kMaxTokens];
+        size_t position = 0;
+        while (position < contents.size() && section != Section::kEndData)
+        {
+            const std::string_view line = next_line(contents, position);
+            if (is_blank_or_comment(line))
+            {
+                continue;
+            }
+            const int count = split_tokens(line, tokens);
+
+            std::string_view keyword;
+            if (const Section header = header_section(line, keyword); header != Section::kNone)
+            {
+                section = header;
+                if (header == Section::kName)
+                {
+                    const size_t start = line.find_first_not_of(" \t", keyword.size());
+                    program.name = start == std::string_view::npos ? "" : std::string(line.substr(start));
+                }
+                else if (header == Section::kObjSense && count > 1)
+                {
+                    program.sense = tokens[1].starts_with("MAX") ? lp::ObjectiveSense::kMaximize
+                                                                 : lp::ObjectiveSense::kMinimize;
+                }
+                else if (header == Section::kColumns)
+                {
+                    const size_t end = find_columns_end(contents, position);
+                    ColumnsParser parser(contents.substr(position, end - position), objective_name, rows, options);
+                    if (absl::Status status = parser.parse(program, column_names); !status.ok())
+                    {
+                        return status;
+                    }
+                    has_columns = true;
+                    position = end;
+
+                    columns.reserve(column_names.size());
+                    for (size_t j = 0; j < column_names.size(); j++)
+                    {
+                        if (!columns.emplace(column_names[j], static_cast<int64_t>(j)).second)
+                        {
+                            return absl::InvalidArgumentError(absl::StrCat(
+                                "Column '", column_names[j], "' appears in non-contiguous COLUMNS lines"));
+                        }
+                    }
+                }
+                continue;
+            }
+
+            switch (section)
+            {
+            case Section::kObjSense:
+                program.sense = tokens[0].starts_with("MAX") ? lp::ObjectiveSense::kMaximize
+                                                             : lp::ObjectiveSense::kMinimize;
+                break;
+
+            case Section::kRows:
+            {
+                if (count != 2 || tokens[0].size() != 1)
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Malformed ROWS line: '", line, "'"));
+                }
+                const char type = tokens[0][0];
+                if (type != 'N' && type != 'E' && type != 'L' && type != 'G')
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Unknown row type in line: '", line, "'"));
+                }
+                if (type == 'N' && objective_name.empty())
+                {
+                    objective_name = tokens[1];
+                    break;
+                }
+                if (!rows.emplace(tokens[1], static_cast<int64_t>(row_types.size())).second)
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Duplicate row '", tokens[1], "'"));
+                }
+                row_types.push_back(type);
+                row_names.push_back(tokens[1]);
+                break;
+            }
+
+            case Section::kRhs:
+            {
+                rhs.resize(row_types.size(), 0.0);
+                absl::Status status = parse_row_values(line, tokens, count, [&](const std::string_view name, const double value)
+                {
+                    if (name == objective_name)
+                    {
+                        program.objective_offset = -value;
+                        return absl::OkStatus();
+                    }
+                    int64_t row = 0;
+                    absl::Status found = find_row(name, row);
+                    if (found.ok())
+                    {
+                        rhs[row] = clamp_infinity(value, options.infinity);
+                    }
+                    return found;
+                });
+                if (!status.ok())
+                {
+                    return status;
+                }
+                break;
+            }
+
+            case Section::kRanges:
+            {
+                ranges.resize(row_types.size(), 0.0);
+                has_range.resize(row_types.size(), 0);
+                absl::Status status = parse_row_values(line, tokens, count, [&](const std::string_view name, const double value)
+                {
+                    int64_t row = 0;
+                    absl::Status found = find_row(name, row);
+                    if (found.ok())
+                    {
+                        ranges[row] = value;
+                        has_range[row] = 1;
+                    }
+                    return found;
+                });
+                if (!status.ok())
+                {
+                    return status;
+                }
+                break;
+            }
+
+            case Section::kBounds:
+            {
+                if (program.column_lower.empty())
+                {
+                    program.column_lower.assign(column_names.size(), 0.0);
+                    program.column_upper.assign(column_names.size(), kInfinity);
+                }
+                if (count < 2 || count > 4)
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Malformed BOUNDS line: '", line, "'"));
+                }
+
+                const std::string_view type = tokens[0];
+                const bool has_value = type == "UP" || type == "LO" || type == "FX" || type == "LI" || type == "UI";
+                std::string_view column_name;
+                double value = 0.0;
+                if (has_value)
+                {
+                    if (count < 3)
+                    {
+                        return absl::InvalidArgumentError(absl::StrCat("Malformed BOUNDS line: '", line, "'"));
+                    }
+                    column_name = tokens[count - 2];
+                    if (absl::Status status = parse_number(tokens[count - 1], value); !status.ok())
+                    {
+                        return status;
+                    }
+                    value = clamp_infinity(value, options.infinity);
+                }
+                else
+                {
+                    // The set name and a trailing value (seen with BV) are both optional.
+                    column_name = count >= 3 && columns.contains(tokens[2]) ? tokens[2] : tokens[1];
+                }
+
+                const auto it = columns.find(column_name);
+                if (it == columns.end())
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Unknown column '", column_name, "' in BOUNDS"));
+                }
+                const int64_t column = it->second;
+                double& lower = program.column_lower[column];
+                double& upper = program.column_upper[column];
+
+                if (type == "UP" || type == "UI")
+                {
+                    upper = value;
+                    // Historical convention: a negative upper bound on a default lower bound frees the column.
+                    if (value < 0.0 && lower == 0.0)
+                    {
+                        lower = -kInfinity;
+                    }
+                }
+                else if (type == "LO" || type == "LI")
+                {
+                    lower = value;
+                }
+                else if (type == "FX")
+                {
+                    lower = value;
+                    upper = value;
+                }
+                else if (type == "FR")
+                {
+                    lower = -kInfinity;
+                    upper = kInfinity;
+                }
+                else if (type == "MI")
+                {
+                    lower = -kInfinity;
+                }
+                else if (type == "PL")
+                {
+                    upper = kInfinity;
+                }
+                else if (type == "BV")
+                {
+                    lower = 0.0;
+                    upper = 1.0;
+                }
+                else
+                {
+                    return absl::UnimplementedError(absl::StrCat("Unsupported bound type '", type, "'"));
+                }
+                break;
+            }
+
+            case Section::kName:
+            case Section::kColumns:
+            case Section::kEndData:
+            case Section::kNone:
+                return absl::InvalidArgumentError(absl::StrCat("Unexpected line in MPS file: '", line, "'"));
+            }
+        }
+
+        const auto num_rows = static_cast<int64_t>(row_types.size());
+        if (!has_columns)
+        {
+            program.constraint_matrix.setup(num_rows, 0, 0);
+        }
+        program.constraint_matrix.num_rows = num_rows;
+
+        const auto num_cols = program.num_cols();
+        if (program.column_lower.empty())
+        {
+            program.column_lower.assign(num_cols, 0.0);
+            program.column_upper.assign(num_cols, kInfinity);
+        }
+
+        rhs.resize(num_rows, 0.0);
+        ranges.resize(num_rows, 0.0);
+        has_range.resize(num_rows, 0);
+        program.row_lower.resize(num_rows);
+        program.row_upper.resize(num_rows);
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            double lower = -kInfinity;
+            double upper = kInfinity;
+            const double range = std::abs(ranges[i]);
+            switch (row_types[i])
+            {
+            case 'E':
+                lower = rhs[i];
+                upper = rhs[i];
+                if (has_range[i])
+                {
+                    (ranges[i] > 0.0 ? upper : lower) = rhs[i] + ranges[i];
+                }
+                break;
+            case 'L':
+                upper = rhs[i];
+                if (has_range[i])
+                {
+                    lower = rhs[i] - range;
+                }
+                break;
+            case 'G':
+                lower = rhs[i];
+                if (has_range[i])
+                {
+                    upper = rhs[i] + range;
+                }
+                break;
+            default:
+                break;
+            }
+            program.row_lower[i] = lower;
+            program.row_upper[i] = upper;
+        }
+
+        if (options.keep_names)
+        {
+            program.row_names.assign(row_names.begin(), row_names.end());
+            program.column_names.resize(num_cols);
+            parallel_for(options.scheduler, 0, num_cols, 0,
+                         [&](const int64_t j) { program.column_names[j] = std::string(column_names[j]); });
+        }
+
+        return program;
+    }
+
+    absl::StatusOr<lp::LinearProgram> read_mps_file(const std::string& path, const MpsReaderOptions& options)
+    {
+        absl::StatusOr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+        if (!file.ok())
+        {
+            return file.status();
+        }
+        return parse_mps(file->text(), options);
+    }
+}
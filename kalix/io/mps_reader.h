@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IO_MPS_READER_H_
+#define KALIX_IO_MPS_READER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "absl/status/statusor.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/linear_program.h"
+
+namespace kalix::io
+{
+    /// @brief Options of the MPS reader.
+    struct MpsReaderOptions
+    {
+        /// @brief Scheduler used to parse the COLUMNS section in parallel. Parsing is serial if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Lower limit on the size of a COLUMNS chunk, in bytes.
+        int64_t min_chunk_bytes = int64_t{1} << 20;
+
+        /// @brief Whether row and column names are stored in the linear program.
+        bool keep_names = true;
+
+        /// @brief Values with at least this magnitude in RHS, RANGES and BOUNDS are treated as infinite.
+        double infinity = 1e30;
+    };
+
+    /// @brief Parses a linear program in free or fixed MPS format.
+    ///
+    /// Fields are separated by whitespace, so fixed MPS is accepted as long as names do not
+    /// contain spaces. Supported sections are NAME, OBJSENSE, ROWS, COLUMNS, RHS, RANGES, BOUNDS
+    /// and ENDATA. Integrality markers in COLUMNS are skipped and integer bound types (BV, LI, UI)
+    /// only contribute their bounds. Only the first N row is used as objective, further N rows
+    /// are kept as free rows.
+    ///
+    /// The COLUMNS section, which holds almost all of the bytes, is split into chunks at line
+    /// boundaries. A first parallel pass counts entries and columns per chunk; after a prefix sum
+    /// a second parallel pass parses every chunk straight into its slice of the CSC arrays.
+    ///
+    /// @param contents The complete MPS text.
+    /// @param options The reader options.
+    /// @return The linear program, or an error status describing the first problem found.
+    absl::StatusOr<lp::LinearProgram> parse_mps(std::string_view contents, const MpsReaderOptions& options = {});
+
+    /// @brief Memory maps the file at @p path and parses it with @ref parse_mps.
+    absl::StatusOr<lp::LinearProgram> read_mps_file(const std::string& path, const MpsReaderOptions& options = {});
+}
+
+#endif // KALIX_IO_MPS_READER_H_
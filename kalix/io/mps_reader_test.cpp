@@ -0,0 +1,230 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/mps_reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        constexpr double kInf = std::numeric_limits<double>::infinity();
+
+        constexpr std::string_view kSmallModel = R"(NAME          TESTLP
+* A comment line
+ROWS
+ N  COST
+ L  LIM1
+ G  LIM2
+ E  MYEQN
+ N  FREE
+COLUMNS
+    X1        COST         1.0   LIM1         1.0
+    X1        LIM2         1.0
+    MARKER                 'MARKER'                 'INTORG'
+    X2        COST         2.0   LIM1         1.0
+    X2        MYEQN       -1.0
+    MARKER                 'MARKER'                 'INTEND'
+    X3        COST        -1.0   MYEQN        1.0
+    X3        FREE         3.0
+RHS
+    RHS       COST        -5.0
+    RHS       LIM1         4.0   LIM2         1.0
+    RHS       MYEQN        7.0
+RANGES
+    RNG       LIM1         2.5   MYEQN       -3.0
+BOUNDS
+ UP BND       X1           4.0
+ MI BND       X2
+ UP BND       X2           1.0
+ FX BND       X3           2.5
+ENDATA
+)";
+
+        std::string make_large_model(const int columns)
+        {
+            std::string text = "NAME LARGE\nROWS\n N obj\n";
+            for (int i = 0; i < 7; i++)
+            {
+                text += " L r" + std::to_string(i) + "\n";
+            }
+            text += "COLUMNS\n";
+            for (int j = 0; j < columns; j++)
+            {
+                const std::string name = " c" + std::to_string(j);
+                text += name + " obj " + std::to_string(j % 5 + 1) + " r" + std::to_string(j % 7) + " 1.5\n";
+                if (j % 3 == 0)
+                {
+                    text += "* comment inside COLUMNS\n";
+                }
+                text += name + " r" + std::to_string((j + 3) % 7) + " -2\n";
+            }
+            text += "RHS\n rhs r0 10\nENDATA\n";
+            return text;
+        }
+    }
+
+    TEST(MpsReaderTest, ParsesSmallModel)
+    {
+        const absl::StatusOr<lp::LinearProgram> result = parse_mps(kSmallModel);
+        ASSERT_TRUE(result.ok()) << result.status();
+        const lp::LinearProgram& program = *result;
+
+        EXPECT_EQ(program.name, "TESTLP");
+        EXPECT_EQ(program.sense, lp::ObjectiveSense::kMinimize);
+        EXPECT_DOUBLE_EQ(program.objective_offset, 5.0);
+        ASSERT_EQ(program.num_rows(), 4);
+        ASSERT_EQ(program.num_cols(), 3);
+
+        EXPECT_EQ(program.row_names, (std::vector<std::string>{"LIM1", "LIM2", "MYEQN", "FREE"}));
+        EXPECT_EQ(program.column_names, (std::vector<std::string>{"X1", "X2", "X3"}));
+        EXPECT_EQ(program.objective, (std::vector<double>{1.0, 2.0, -1.0}));
+
+        const lp::CscMatrix& matrix = program.constraint_matrix;
+        EXPECT_EQ(matrix.column_starts, (std::vector<int64_t>{0, 2, 4, 6}));
+        EXPECT_EQ(matrix.row_indices, (std::vector<int64_t>{0, 1, 0, 2, 2, 3}));
+        EXPECT_EQ(matrix.values, (std::vector<double>{1.0, 1.0, 1.0, -1.0, 1.0, 3.0}));
+
+        EXPECT_EQ(program.row_lower, (std::vector<double>{1.5, 1.0, 4.0, -kInf}));
+        EXPECT_EQ(program.row_upper, (std::vector<double>{4.0, kInf, 7.0, kInf}));
+
+        EXPECT_EQ(program.column_lower, (std::vector<double>{0.0, -kInf, 2.5}));
+        EXPECT_EQ(program.column_upper, (std::vector<double>{4.0, 1.0, 2.5}));
+    }
+
+    TEST(MpsReaderTest, ParsesFreeFormatWithoutSetNames)
+    {
+        constexpr std::string_view text = "NAME\nOBJSENSE\n    MAX\nROWS\n N z\n G c\nCOLUMNS\n x z 1 c 1\n"
+                                          " y z +2e0 c 1\nRHS\n c 1e31\nBOUNDS\n UP x -1\n FR y\n PL y\n"
+                                          " BV x\nENDATA\n";
+        const absl::StatusOr<lp::LinearProgram> result = parse_mps(text);
+        ASSERT_TRUE(result.ok()) << result.status();
+
+        EXPECT_EQ(result->sense, lp::ObjectiveSense::kMaximize);
+        EXPECT_EQ(result->objective, (std::vector<double>{1.0, 2.0}));
+        EXPECT_EQ(result->row_lower, (std::vector<double>{kInf}));
+        EXPECT_EQ(result->column_lower, (std::vector<double>{0.0, -kInf}));
+        EXPECT_EQ(result->column_upper, (std::vector<double>{1.0, kInf}));
+    }
+
+    TEST(MpsReaderTest, NegativeUpperBoundFreesLowerBound)
+    {
+        constexpr std::string_view text = "ROWS\n N z\nCOLUMNS\n x z 1\nBOUNDS\n UP b x -1\nENDATA\n";
+        const absl::StatusOr<lp::LinearProgram> result = parse_mps(text);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(result->column_lower[0], -kInf);
+        EXPECT_EQ(result->column_upper[0], -1.0);
+        EXPECT_EQ(result->num_rows(), 0);
+    }
+
+    TEST(MpsReaderTest, ObjectiveSenseOnHeaderLineAndCrLf)
+    {
+        constexpr std::string_view text = "OBJSENSE MAXIMIZE\r\nROWS\r\n N z\r\n E e\r\nCOLUMNS\r\n x z 3 e 1\r\n"
+                                          "RHS\r\n rhs e 2\r\nENDATA\r\n";
+        const absl::StatusOr<lp::LinearProgram> result = parse_mps(text);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(result->sense, lp::ObjectiveSense::kMaximize);
+        EXPECT_EQ(result->column_names, (std::vector<std::string>{"x"}));
+        EXPECT_EQ(result->row_lower, (std::vector<double>{2.0}));
+        EXPECT_EQ(result->row_upper, (std::vector<double>{2.0}));
+    }
+
+    TEST(MpsReaderTest, ReportsErrors)
+    {
+        EXPECT_FALSE(parse_mps("ROWS\n N z\nCOLUMNS\n x q 1\nENDATA\n").ok());
+        EXPECT_FALSE(parse_mps("ROWS\n N z\n L r\nCOLUMNS\n x r abc\nENDATA\n").ok());
+        EXPECT_FALSE(parse_mps("ROWS\n N z\n L r\nCOLUMNS\n x r 1\n y r 1\n x z 1\nENDATA\n").ok());
+        EXPECT_FALSE(parse_mps("ROWS\n N z\n L r\n L r\nENDATA\n").ok());
+        EXPECT_FALSE(parse_mps("ROWS\n X z\nENDATA\n").ok());
+        EXPECT_FALSE(parse_mps("ROWS\n N z\nCOLUMNS\n x z 1\nBOUNDS\n UP b y 1\nENDATA\n").ok());
+
+        const absl::StatusOr<lp::LinearProgram> semi = parse_mps("ROWS\n N z\nCOLUMNS\n x z 1\nBOUNDS\n SC b x 1\nENDATA\n");
+        ASSERT_FALSE(semi.ok());
+        EXPECT_EQ(semi.status().code(), absl::StatusCode::kUnimplemented);
+    }
+
+    TEST(MpsReaderTest, ParallelParseMatchesSerialParse)
+    {
+        const std::string text = make_large_model(5000);
+        const absl::StatusOr<lp::LinearProgram> serial = parse_mps(text);
+        ASSERT_TRUE(serial.ok()) << serial.status();
+        EXPECT_EQ(serial->num_cols(), 5000);
+        EXPECT_EQ(serial->constraint_matrix.num_non_zeros(), 10000);
+
+        TaskScheduler scheduler({.num_threads = 4});
+        for (const int64_t chunk_bytes : {1, 64, 1000, 1 << 20})
+        {
+            MpsReaderOptions options;
+            options.scheduler = &scheduler;
+            options.min_chunk_bytes = chunk_bytes;
+            const absl::StatusOr<lp::LinearProgram> parallel = parse_mps(text, options);
+            ASSERT_TRUE(parallel.ok()) << parallel.status();
+            EXPECT_EQ(parallel->constraint_matrix, serial->constraint_matrix);
+            EXPECT_EQ(parallel->objective, serial->objective);
+            EXPECT_EQ(parallel->column_names, serial->column_names);
+            EXPECT_EQ(parallel->row_upper, serial->row_upper);
+        }
+    }
+
+    TEST(MpsReaderTest, ParallelParseReportsErrors)
+    {
+        std::string text = make_large_model(2000);
+        text.insert(text.find("COLUMNS\n") + 8, " c0 nosuchrow 1\n");
+        TaskScheduler scheduler({.num_threads = 4});
+        MpsReaderOptions options;
+        options.scheduler = &scheduler;
+        options.min_chunk_bytes = 128;
+        EXPECT_FALSE(parse_mps(text, options).ok());
+    }
+
+    TEST(MpsReaderTest, DropsNamesOnRequest)
+    {
+        MpsReaderOptions options;
+        options.keep_names = false;
+        const absl::StatusOr<lp::LinearProgram> result = parse_mps(kSmallModel, options);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_TRUE(result->row_names.empty());
+        EXPECT_TRUE(result->column_names.empty());
+        EXPECT_EQ(result->num_cols(), 3);
+    }
+
+    TEST(MpsReaderTest, ReadsFile)
+    {
+        const std::string path = ::testing::TempDir() + "/kalix_mps_reader_test.mps";
+        {
+            std::ofstream out(path);
+            out << kSmallModel;
+        }
+        const absl::StatusOr<lp::LinearProgram> result = read_mps_file(path);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(result->num_cols(), 3);
+        std::remove(path.c_str());
+
+        EXPECT_FALSE(read_mps_file(path).ok());
+    }
+}
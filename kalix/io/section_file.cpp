@@ -0,0 +1,267 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/section_file.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "absl/strings/str_cat.h"
+#include "kalix/base/config.h"
+#include "kalix/io/checksum.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace kalix::io
+{
+    namespace
+    {
+        constexpr uint32_t kEndianTag = 0x01020304;
+        constexpr uint32_t kFlagChecksum = 1u << 0;
+
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t flags;
+            uint32_t endian_tag;
+            uint32_t section_count;
+            uint8_t reserved[40];
+        };
+        static_assert(sizeof(FileHeader) == kSectionAlignment);
+
+        struct SectionEntry
+        {
+            uint32_t id;
+            uint32_t reserved;
+            uint64_t offset;
+            uint64_t size;
+            uint64_t checksum;
+        };
+        static_assert(sizeof(SectionEntry) == 32);
+
+        KALIX_FORCE_INLINE uint64_t align_up(const uint64_t value)
+        {
+            return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+        }
+
+        /// @brief Renames @p from to @p to, replacing an existing file at @p to.
+        bool replace_file(const std::string& from, const std::string& to)
+        {
+#if defined(_WIN32)
+            // std::rename fails on Windows if the target exists.
+            return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+            return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+        }
+
+        class FileWriter
+        {
+        public:
+            explicit FileWriter(const std::string& path)
+                : file_(std::fopen(path.c_str(), "wb"))
+            {
+            }
+
+            FileWriter(const FileWriter&) = delete;
+            FileWriter& operator=(const FileWriter&) = delete;
+
+            ~FileWriter()
+            {
+                if (file_ != nullptr)
+                {
+                    std::fclose(file_);
+                }
+            }
+
+            [[nodiscard]] bool is_open() const
+            {
+                return file_ != nullptr;
+            }
+
+            bool write(const void* data, const size_t size)
+            {
+                if (size != 0 && std::fwrite(data, 1, size, file_) != size)
+                {
+                    return false;
+                }
+                position_ += size;
+                return true;
+            }
+
+            bool pad_to(const uint64_t position)
+            {
+                static constexpr char kZeros[kSectionAlignment] = {};
+                return write(kZeros, position - position_);
+            }
+
+            bool close()
+            {
+                const bool ok = std::fclose(file_) == 0;
+                file_ = nullptr;
+                return ok;
+            }
+
+        private:
+            std::FILE* file_;
+            uint64_t position_ = 0;
+        };
+    }
+
+    absl::Status SectionFileWriter::write(const std::string& path, const bool checksum) const
+    {
+        FileHeader header{};
+        std::memcpy(header.magic, magic_.data(), magic_.size());
+        header.version = version_;
+        header.flags = checksum ? kFlagChecksum : 0;
+        header.endian_tag = kEndianTag;
+        header.section_count = static_cast<uint32_t>(sections_.size());
+
+        std::vector<SectionEntry> entries(sections_.size());
+        uint64_t offset = align_up(sizeof(FileHeader) + sections_.size() * sizeof(SectionEntry));
+        for (size_t s = 0; s < sections_.size(); s++)
+        {
+            const auto& [id, bytes] = sections_[s];
+            entries[s] = {
+                .id = id,
+                .reserved = 0,
+                .offset = offset,
+                .size = bytes.size(),
+                .checksum = checksum ? compute_checksum(bytes) : 0,
+            };
+            offset = align_up(offset + bytes.size());
+        }
+
+        const std::string temporary_path = path + ".tmp";
+        bool ok;
+        {
+            FileWriter writer(temporary_path);
+            if (!writer.is_open())
+            {
+                return absl::UnavailableError(absl::StrCat("Cannot create '", temporary_path, "'"));
+            }
+            ok = writer.write(&header, sizeof(header)) &&
+                writer.write(entries.data(), entries.size() * sizeof(SectionEntry));
+            for (size_t s = 0; ok && s < sections_.size(); s++)
+            {
+                ok = writer.pad_to(entries[s].offset) &&
+                    writer.write(sections_[s].second.data(), sections_[s].second.size());
+            }
+            ok = ok && writer.pad_to(offset);
+            ok = writer.close() && ok;
+        }
+        if (!ok || !replace_file(temporary_path, path))
+        {
+            std::remove(temporary_path.c_str());
+            return absl::DataLossError(absl::StrCat("Failed to write '", path, "'"));
+        }
+        return absl::OkStatus();
+    }
+
+    absl::StatusOr<SectionFile> SectionFile::open(const std::string& path, const SectionFileMagic& magic,
+                                                  const uint32_t version, const bool verify_checksum)
+    {
+        absl::StatusOr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+        if (!file.ok())
+        {
+            return file.status();
+        }
+
+        const auto corrupt = [&path](const std::string_view reason)
+        {
+            return absl::DataLossError(absl::StrCat("File '", path, "' is corrupt: ", reason));
+        };
+
+        const std::span<const std::byte> bytes = file->data();
+        FileHeader header;
+        if (bytes.size() < sizeof(header))
+        {
+            return corrupt("truncated header");
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, magic.data(), magic.size()) != 0)
+        {
+            return corrupt("unexpected file kind");
+        }
+        if (header.endian_tag != kEndianTag)
+        {
+            return absl::UnimplementedError(absl::StrCat("File '", path, "' uses a different byte order"));
+        }
+        if (header.version != version)
+        {
+            return absl::UnimplementedError(absl::StrCat("File '", path, "' has unsupported version ", header.version));
+        }
+        if (sizeof(FileHeader) + uint64_t{header.section_count} * sizeof(SectionEntry) > bytes.size())
+        {
+            return corrupt("truncated section table");
+        }
+
+        SectionFile result;
+        result.sections_.reserve(header.section_count);
+        for (uint32_t s = 0; s < header.section_count; s++)
+        {
+            SectionEntry entry;
+            std::memcpy(&entry, bytes.data() + sizeof(FileHeader) + s * sizeof(SectionEntry), sizeof(entry));
+            if (entry.offset % kSectionAlignment != 0 || entry.offset > bytes.size() ||
+                entry.size > bytes.size() - entry.offset)
+            {
+                return corrupt(absl::StrCat("section ", entry.id, " is out of bounds"));
+            }
+            const std::span<const std::byte> section = bytes.subspan(entry.offset, entry.size);
+            if (verify_checksum && (header.flags & kFlagChecksum) != 0 && compute_checksum(section) != entry.checksum)
+            {
+                return corrupt(absl::StrCat("checksum mismatch in section ", entry.id));
+            }
+            result.sections_.push_back({entry.id, section});
+        }
+
+        result.file_ = std::move(*file);
+        result.path_ = path;
+        return result;
+    }
+
+    bool SectionFile::contains(const uint32_t id) const
+    {
+        for (const Section& section : sections_)
+        {
+            if (section.id == id)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::span<const std::byte> SectionFile::section(const uint32_t id) const
+    {
+        for (const Section& section : sections_)
+        {
+            if (section.id == id)
+            {
+                return section.bytes;
+            }
+        }
+        return {};
+    }
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IO_SECTION_FILE_H_
+#define KALIX_IO_SECTION_FILE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "kalix/io/memory_mapped_file.h"
+
+namespace kalix::io
+{
+    /// @brief Alignment of every section in a section file, in bytes.
+    inline constexpr uint64_t kSectionAlignment = 64;
+
+    /// @brief Eight characters identifying the kind of a section file.
+    using SectionFileMagic = std::array<char, 8>;
+
+    /// @brief Writes a file made of a 64 byte header, a section table and 64-byte-aligned sections.
+    ///
+    /// Section files are the common container of the binary model and checkpoint formats. Every
+    /// section is an untyped byte block identified by a numeric id, so arrays can be used in place
+    /// after memory mapping the file with @ref SectionFile. Numbers are stored in the byte order of
+    /// the writing machine, which the header records.
+    class SectionFileWriter
+    {
+    public:
+        /// @brief Constructs a writer for files of the given kind and version.
+        SectionFileWriter(const SectionFileMagic& magic, const uint32_t version)
+            : magic_(magic), version_(version)
+        {
+        }
+
+        /// @brief Adds a section. The bytes are referenced, not copied, and must outlive @ref write.
+        /// @param id The section id.
+        /// @param bytes The section contents.
+        void add(const uint32_t id, const std::span<const std::byte> bytes)
+        {
+            sections_.emplace_back(id, bytes);
+        }
+
+        /// @brief Adds an array section. The values must outlive @ref write.
+        template <typename T>
+        void add_array(const uint32_t id, const std::span<const T> values)
+        {
+            add(id, std::as_bytes(values));
+        }
+
+        /// @brief Writes all sections to @p path.
+        ///
+        /// The data goes to a temporary file first, which is renamed on success, so readers never
+        /// observe a partially written file.
+        ///
+        /// @param path The destination file.
+        /// @param checksum Whether to store a checksum for every section.
+        /// @return An error status if the file cannot be written.
+        absl::Status write(const std::string& path, bool checksum) const;
+
+    private:
+        SectionFileMagic magic_;
+        uint32_t version_;
+        std::vector<std::pair<uint32_t, std::span<const std::byte>>> sections_;
+    };
+
+    /// @brief A memory-mapped section file written by @ref SectionFileWriter.
+    ///
+    /// Opening validates the header and the bounds of every section, which takes time
+    /// proportional to the number of sections but not to their size. Sections are returned as
+    /// views into the mapping that stay valid as long as this object lives, also across moves.
+    class SectionFile
+    {
+    public:
+        /// @brief Memory maps and validates the section file at @p path.
+        /// @param path The file to open.
+        /// @param magic The expected kind of the file.
+        /// @param version The expected version of the file.
+        /// @param verify_checksum Whether to verify the section checksums, which touches every page.
+        /// @return The file, or an error status if it is missing, of the wrong kind, or corrupt.
+        static absl::StatusOr<SectionFile> open(const std::string& path, const SectionFileMagic& magic,
+                                                uint32_t version, bool verify_checksum);
+
+        /// @brief Returns whether section @p id exists.
+        [[nodiscard]] bool contains(uint32_t id) const;
+
+        /// @brief Returns section @p id, or an empty span if it does not exist.
+        [[nodiscard]] std::span<const std::byte> section(uint32_t id) const;
+
+        /// @brief Returns section @p id as an array of @p count elements.
+        /// @return The array, or nothing if the section does not exist or has a different size.
+        template <typename T>
+        [[nodiscard]] std::optional<std::span<const T>> array(const uint32_t id, const int64_t count) const
+        {
+            if (!contains(id) || count < 0)
+            {
+                return std::nullopt;
+            }
+            const std::span<const std::byte> bytes = section(id);
+            if (bytes.size() != static_cast<uint64_t>(count) * sizeof(T))
+            {
+                return std::nullopt;
+            }
+            return std::span<const T>(reinterpret_cast<const T*>(bytes.data()), static_cast<size_t>(count));
+        }
+
+        /// @brief Copies section @p id into @p value if it has exactly the size of @p value.
+        template <typename T>
+        [[nodiscard]] bool read_value(const uint32_t id, T& value) const
+        {
+            const std::optional<std::span<const T>> values = array<T>(id, 1);
+            if (!values)
+            {
+                return false;
+            }
+            value = values->front();
+            return true;
+        }
+
+        /// @brief Returns the path the file was opened from.
+        [[nodiscard]] const std::string& path() const
+        {
+            return path_;
+        }
+
+    private:
+        struct Section
+        {
+            uint32_t id;
+            std::span<const std::byte> bytes;
+        };
+
+        MemoryMappedFile file_;
+        std::string path_;
+        std::vector<Section> sections_;
+    };
+}
+
+#endif // KALIX_IO_SECTION_FILE_H_
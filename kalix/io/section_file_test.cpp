@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/io/section_file.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::io
+{
+    namespace
+    {
+        constexpr SectionFileMagic kTestMagic = {'K', 'X', 'T', 'E', 'S', 'T', '\0', '\0'};
+
+        std::string temp_path(const std::string& name)
+        {
+            return ::testing::TempDir() + "/" + name;
+        }
+    }
+
+    TEST(SectionFileTest, RoundTripsAlignedSections)
+    {
+        const std::string path = temp_path("kalix_section_file_roundtrip");
+        const std::vector<int64_t> integers = {1, 2, 3};
+        const std::vector<double> doubles = {0.5, -1.5};
+        const std::string text = "abc";
+
+        SectionFileWriter writer(kTestMagic, 3);
+        writer.add_array<int64_t>(7, integers);
+        writer.add(9, std::as_bytes(std::span<const char>(text.data(), text.size())));
+        writer.add_array<double>(8, doubles);
+        ASSERT_TRUE(writer.write(path, true).ok());
+
+        absl::StatusOr<SectionFile> file = SectionFile::open(path, kTestMagic, 3, true);
+        ASSERT_TRUE(file.ok()) << file.status();
+        EXPECT_TRUE(file->contains(7));
+        EXPECT_FALSE(file->contains(1));
+        EXPECT_TRUE(file->section(1).empty());
+
+        const auto read_integers = file->array<int64_t>(7, 3);
+        ASSERT_TRUE(read_integers.has_value());
+        EXPECT_EQ(std::vector<int64_t>(read_integers->begin(), read_integers->end()), integers);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(read_integers->data()) % kSectionAlignment, 0u);
+
+        const auto read_doubles = file->array<double>(8, 2);
+        ASSERT_TRUE(read_doubles.has_value());
+        EXPECT_EQ((*read_doubles)[1], -1.5);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(read_doubles->data()) % kSectionAlignment, 0u);
+
+        EXPECT_EQ(file->section(9).size(), 3u);
+        EXPECT_FALSE(file->array<double>(8, 3).has_value());
+
+        double value;
+        EXPECT_FALSE(file->read_value(8, value));
+        std::remove(path.c_str());
+    }
+
+    TEST(SectionFileTest, RejectsWrongKindAndVersion)
+    {
+        const std::string path = temp_path("kalix_section_file_kind");
+        SectionFileWriter writer(kTestMagic, 1);
+        ASSERT_TRUE(writer.write(path, false).ok());
+
+        EXPECT_TRUE(SectionFile::open(path, kTestMagic, 1, true).ok());
+        EXPECT_EQ(SectionFile::open(path, kTestMagic, 2, false).status().code(), absl::StatusCode::kUnimplemented);
+        constexpr SectionFileMagic other = {'O', 'T', 'H', 'E', 'R', '\0', '\0', '\0'};
+        EXPECT_EQ(SectionFile::open(path, other, 1, false).status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+    }
+
+    TEST(SectionFileTest, DetectsTruncation)
+    {
+        const std::string path = temp_path("kalix_section_file_truncated");
+        const std::vector<double> doubles(100, 1.0);
+        SectionFileWriter writer(kTestMagic, 1);
+        writer.add_array<double>(1, doubles);
+        ASSERT_TRUE(writer.write(path, false).ok());
+
+        std::string contents;
+        {
+            std::ifstream in(path, std::ios::binary);
+            contents.assign(std::istreambuf_iterator<char>(in), {});
+        }
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(contents.data(), static_cast<std::streamsize>(contents.size() / 2));
+        }
+        EXPECT_EQ(SectionFile::open(path, kTestMagic, 1, false).status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+    }
+
+    TEST(SectionFileTest, WriteReplacesExistingFile)
+    {
+        const std::string path = temp_path("kalix_section_file_replace");
+        const std::vector<int64_t> first = {1, 2};
+        const std::vector<int64_t> second = {3, 4, 5};
+        SectionFileWriter first_writer(kTestMagic, 1);
+        first_writer.add_array<int64_t>(1, first);
+        ASSERT_TRUE(first_writer.write(path, false).ok());
+        SectionFileWriter second_writer(kTestMagic, 1);
+        second_writer.add_array<int64_t>(1, second);
+        ASSERT_TRUE(second_writer.write(path, false).ok());
+
+        absl::StatusOr<SectionFile> file = SectionFile::open(path, kTestMagic, 1, false);
+        ASSERT_TRUE(file.ok()) << file.status();
+        const auto values = file->array<int64_t>(1, 3);
+        ASSERT_TRUE(values.has_value());
+        EXPECT_EQ(std::vector<int64_t>(values->begin(), values->end()), second);
+        std::remove(path.c_str());
+    }
+
+    TEST(SectionFileTest, WriteFailsForMissingDirectory)
+    {
+        SectionFileWriter writer(kTestMagic, 1);
+        EXPECT_FALSE(writer.write(temp_path("no_such_directory/file"), false).ok());
+    }
+}
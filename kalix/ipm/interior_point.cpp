@@ -0,0 +1,580 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/ipm/interior_point.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+
+#include "absl/log/check.h"
+#include "kalix/base/compensated_double.h"
+
+namespace kalix::ipm
+{
+    namespace
+    {
+        // Number of normal-matrix columns formed per task, so that one workspace lease is
+        // amortized over many columns.
+        constexpr int64_t kColumnsPerTask = 64;
+
+        void setup_dense(Vector<double>& vector, const int64_t dimension)
+        {
+            vector.setup(dimension);
+            vector.non_zero_count = -1;
+        }
+
+        /// Returns the largest magnitude, or NaN if any value is NaN.
+        double infinity_norm(const std::span<const double> values)
+        {
+            double norm = 0.0;
+            for (const double value : values)
+            {
+                if (std::isnan(value))
+                {
+                    return value;
+                }
+                norm = std::max(norm, std::abs(value));
+            }
+            return norm;
+        }
+    }
+
+    InteriorPointSolver::InteriorPointSolver(const lp::LinearProgram& program, const InteriorPointOptions& options)
+        : options_(options), program_(program),
+          cholesky_({.ordering = options.ordering, .scheduler = options.scheduler, .pivot_tolerance = 1e-30,
+                     .min_parallel_work = int64_t{1} << 16}),
+          workspaces_([this](std::vector<double>& workspace) { workspace.assign(num_rows_, 0.0); })
+    {
+        sense_ = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+        num_rows_ = program.num_rows();
+        const lp::CscMatrix& original = program.constraint_matrix;
+
+        // Fixed columns move to the right-hand side, equality rows need no slack.
+        rhs_.assign(num_rows_, 0.0);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            if (program.row_lower[i] == program.row_upper[i])
+            {
+                rhs_[i] = program.row_lower[i];
+            }
+        }
+        matrix_.num_rows = num_rows_;
+        std::vector<int64_t> indices;
+        std::vector<double> values;
+        for (int64_t j = 0; j < program.num_cols(); j++)
+        {
+            const double lower = program.column_lower[j];
+            const double upper = program.column_upper[j];
+            if (lower == upper)
+            {
+                for (int64_t k = original.column_starts[j]; k < original.column_starts[j + 1]; k++)
+                {
+                    rhs_[original.row_indices[k]] -= original.values[k] * lower;
+                }
+                continue;
+            }
+            indices.clear();
+            values.clear();
+            for (int64_t k = original.column_starts[j]; k < original.column_starts[j + 1]; k++)
+            {
+                if (original.values[k] != 0.0)
+                {
+                    indices.push_back(original.row_indices[k]);
+                    values.push_back(original.values[k]);
+                }
+            }
+            matrix_.append_column(indices, values);
+            variable_column_.push_back(j);
+            cost_.push_back(sense_ * program.objective[j]);
+            lower_.push_back(lower);
+            upper_.push_back(upper);
+        }
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            if (program.row_lower[i] != program.row_upper[i])
+            {
+                const int64_t row[] = {i};
+                const double minus_one[] = {-1.0};
+                matrix_.append_column(row, minus_one);
+                slack_row_.push_back(i);
+                cost_.push_back(0.0);
+                lower_.push_back(program.row_lower[i]);
+                upper_.push_back(program.row_upper[i]);
+            }
+        }
+        num_variables_ = matrix_.num_cols;
+        rows_ = matrix_.transpose();
+
+        has_lower_.resize(num_variables_);
+        has_upper_.resize(num_variables_);
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            has_lower_[j] = !std::isinf(lower_[j]);
+            has_upper_[j] = !std::isinf(upper_[j]);
+            num_complementarity_ += has_lower_[j] + has_upper_[j];
+        }
+
+        // Lower triangle of the pattern of A*A^T, including the full diagonal.
+        normal_.num_rows = num_rows_;
+        std::vector<int64_t> marker(num_rows_, -1);
+        for (int64_t k = 0; k < num_rows_; k++)
+        {
+            indices.assign(1, k);
+            marker[k] = k;
+            for (const int64_t j : rows_.column_indices(k))
+            {
+                for (const int64_t i : matrix_.column_indices(j))
+                {
+                    if (i > k && marker[i] != k)
+                    {
+                        marker[i] = k;
+                        indices.push_back(i);
+                    }
+                }
+            }
+            std::ranges::sort(indices);
+            values.assign(indices.size(), 0.0);
+            normal_.append_column(indices, values);
+        }
+        cholesky_.analyze(normal_);
+
+        for (Vector<double>* vector : {&x_, &z_, &t_, &dx_, &dz_, &dt_, &dual_residual_, &theta_, &scratch_variables_,
+                                       &lower_complementarity_, &upper_complementarity_})
+        {
+            setup_dense(*vector, num_variables_);
+        }
+        for (Vector<double>* vector : {&y_, &dy_, &primal_residual_, &scratch_rows_})
+        {
+            setup_dense(*vector, num_rows_);
+        }
+    }
+
+    void InteriorPointSolver::initialize()
+    {
+        // Start at the point of the box closest to zero, at least one unit (or half the width)
+        // away from every finite bound, with duals that make the dual equations hold for y = 0
+        // wherever the bounds allow it.
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            const double lower = lower_[j];
+            const double upper = upper_[j];
+            const double margin = has_lower_[j] && has_upper_[j] ? std::min(1.0, 0.5 * (upper - lower)) : 1.0;
+            double value = 0.0;
+            if (has_lower_[j])
+            {
+                value = std::max(value, lower + margin);
+            }
+            if (has_upper_[j])
+            {
+                value = std::min(value, upper - margin);
+            }
+            x_.dense_values[j] = value;
+
+            const double cost = cost_[j];
+            z_.dense_values[j] = has_lower_[j] ? 1.0 + std::max(cost, 0.0) : 0.0;
+            t_.dense_values[j] = has_upper_[j] ? 1.0 + std::max(-cost, 0.0) : 0.0;
+        }
+        std::ranges::fill(y_.dense_values, 0.0);
+    }
+
+    void InteriorPointSolver::multiply(const Vector<double>& x, Vector<double>& result) const
+    {
+        parallel_for(options_.scheduler, 0, num_rows_, 0, [&](const int64_t i)
+        {
+            CompensatedDouble sum(0.0);
+            const auto indices = rows_.column_indices(i);
+            const auto values = rows_.column_values(i);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                sum += values[t] * x.dense_values[indices[t]];
+            }
+            result.dense_values[i] = static_cast<double>(sum);
+        });
+    }
+
+    void InteriorPointSolver::multiply_transposed(const Vector<double>& y, Vector<double>& result) const
+    {
+        parallel_for(options_.scheduler, 0, num_variables_, 0, [&](const int64_t j)
+        {
+            CompensatedDouble sum(0.0);
+            const auto indices = matrix_.column_indices(j);
+            const auto values = matrix_.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                sum += values[t] * y.dense_values[indices[t]];
+            }
+            result.dense_values[j] = static_cast<double>(sum);
+        });
+    }
+
+    void InteriorPointSolver::compute_residuals()
+    {
+        multiply(x_, primal_residual_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            primal_residual_.dense_values[i] = rhs_[i] - primal_residual_.dense_values[i];
+        }
+        parallel_for(options_.scheduler, 0, num_variables_, 0, [this](const int64_t j)
+        {
+            CompensatedDouble sum(cost_[j]);
+            const auto indices = matrix_.column_indices(j);
+            const auto values = matrix_.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                sum -= values[t] * y_.dense_values[indices[t]];
+            }
+            sum -= z_.dense_values[j];
+            sum += t_.dense_values[j];
+            dual_residual_.dense_values[j] = static_cast<double>(sum);
+        });
+    }
+
+    void InteriorPointSolver::form_normal_matrix()
+    {
+        parallel_for(options_.scheduler, 0, num_variables_, 0, [this](const int64_t j)
+        {
+            double inverse = options_.primal_regularization;
+            const double x = x_.dense_values[j];
+            if (has_lower_[j])
+            {
+                inverse += z_.dense_values[j] / (x - lower_[j]);
+            }
+            if (has_upper_[j])
+            {
+                inverse += t_.dense_values[j] / (upper_[j] - x);
+            }
+            theta_.dense_values[j] = 1.0 / inverse;
+        });
+
+        // Column k of the lower triangle is sum(theta_j * a_kj * a_j) over the columns j of row k.
+        const int64_t num_tasks = (num_rows_ + kColumnsPerTask - 1) / kColumnsPerTask;
+        parallel_for(options_.scheduler, 0, num_tasks, 0, [this](const int64_t task)
+        {
+            auto lease = workspaces_.acquire();
+            std::vector<double>& accumulator = *lease;
+            const int64_t end = std::min(num_rows_, (task + 1) * kColumnsPerTask);
+            for (int64_t k = task * kColumnsPerTask; k < end; k++)
+            {
+                const auto row_indices = rows_.column_indices(k);
+                const auto row_values = rows_.column_values(k);
+                for (size_t t = 0; t < row_indices.size(); t++)
+                {
+                    const int64_t j = row_indices[t];
+                    const double weight = theta_.dense_values[j] * row_values[t];
+                    const auto indices = matrix_.column_indices(j);
+                    const auto values = matrix_.column_values(j);
+                    for (size_t s = 0; s < indices.size(); s++)
+                    {
+                        if (indices[s] >= k)
+                        {
+                            accumulator[indices[s]] += weight * values[s];
+                        }
+                    }
+                }
+                for (int64_t e = normal_.column_starts[k]; e < normal_.column_starts[k + 1]; e++)
+                {
+                    const int64_t i = normal_.row_indices[e];
+                    normal_.values[e] = accumulator[i];
+                    accumulator[i] = 0.0;
+                }
+                normal_.values[normal_.column_starts[k]] += options_.dual_regularization;
+            }
+        });
+    }
+
+    void InteriorPointSolver::solve_direction(const Vector<double>& lower_complementarity,
+                                              const Vector<double>& upper_complementarity)
+    {
+        // r = rd - W^-1 r_l + V^-1 r_u, then A*Theta*A^T dy = rp + A*Theta*r.
+        Vector<double>& scaled = scratch_variables_;
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            double r = dual_residual_.dense_values[j];
+            const double x = x_.dense_values[j];
+            if (has_lower_[j])
+            {
+                r -= lower_complementarity.dense_values[j] / (x - lower_[j]);
+            }
+            if (has_upper_[j])
+            {
+                r += upper_complementarity.dense_values[j] / (upper_[j] - x);
+            }
+            dx_.dense_values[j] = r;
+            scaled.dense_values[j] = theta_.dense_values[j] * r;
+        }
+        multiply(scaled, dy_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            dy_.dense_values[i] += primal_residual_.dense_values[i];
+        }
+        cholesky_.solve(dy_);
+
+        // dx = Theta (A^T dy - r), dz = W^-1 (r_l - Z dx), dt = V^-1 (r_u + T dx).
+        multiply_transposed(dy_, scaled);
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            const double dx = theta_.dense_values[j] * (scaled.dense_values[j] - dx_.dense_values[j]);
+            dx_.dense_values[j] = dx;
+            const double x = x_.dense_values[j];
+            dz_.dense_values[j] =
+                has_lower_[j]
+                    ? (lower_complementarity.dense_values[j] - z_.dense_values[j] * dx) / (x - lower_[j])
+                    : 0.0;
+            dt_.dense_values[j] =
+                has_upper_[j]
+                    ? (upper_complementarity.dense_values[j] + t_.dense_values[j] * dx) / (upper_[j] - x)
+                    : 0.0;
+        }
+    }
+
+    void InteriorPointSolver::step_lengths(double& primal_step, double& dual_step) const
+    {
+        primal_step = 1.0;
+        dual_step = 1.0;
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            const double x = x_.dense_values[j];
+            const double dx = dx_.dense_values[j];
+            if (has_lower_[j])
+            {
+                if (dx < 0.0)
+                {
+                    primal_step = std::min(primal_step, (lower_[j] - x) / dx);
+                }
+                if (const double dz = dz_.dense_values[j]; dz < 0.0)
+                {
+                    dual_step = std::min(dual_step, -z_.dense_values[j] / dz);
+                }
+            }
+            if (has_upper_[j])
+            {
+                if (dx > 0.0)
+                {
+                    primal_step = std::min(primal_step, (upper_[j] - x) / dx);
+                }
+                if (const double dt = dt_.dense_values[j]; dt < 0.0)
+                {
+                    dual_step = std::min(dual_step, -t_.dense_values[j] / dt);
+                }
+            }
+        }
+    }
+
+    InteriorPointResult InteriorPointSolver::solve()
+    {
+        initialize();
+        const double rhs_norm = infinity_norm(rhs_);
+        const double cost_norm = infinity_norm(cost_);
+
+        for (int iteration = 0;; iteration++)
+        {
+            compute_residuals();
+            CompensatedDouble complementarity(0.0);
+            CompensatedDouble primal_objective(0.0);
+            CompensatedDouble dual_objective(0.0);
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                const double x = x_.dense_values[j];
+                primal_objective += cost_[j] * x;
+                if (has_lower_[j])
+                {
+                    complementarity += (x - lower_[j]) * z_.dense_values[j];
+                    dual_objective += lower_[j] * z_.dense_values[j];
+                }
+                if (has_upper_[j])
+                {
+                    complementarity += (upper_[j] - x) * t_.dense_values[j];
+                    dual_objective -= upper_[j] * t_.dense_values[j];
+                }
+            }
+            for (int64_t i = 0; i < num_rows_; i++)
+            {
+                dual_objective += rhs_[i] * y_.dense_values[i];
+            }
+
+            const double primal_infeasibility = infinity_norm(primal_residual_.dense_values) / (1.0 + rhs_norm);
+            const double dual_infeasibility = infinity_norm(dual_residual_.dense_values) / (1.0 + cost_norm);
+            const double gap = std::abs(static_cast<double>(primal_objective - dual_objective)) /
+                (1.0 + std::abs(static_cast<double>(primal_objective)));
+            if (!std::isfinite(primal_infeasibility + dual_infeasibility + gap))
+            {
+                return extract_result(InteriorPointStatus::kNumericalFailure, iteration);
+            }
+            if (primal_infeasibility <= options_.optimality_tolerance &&
+                dual_infeasibility <= options_.optimality_tolerance && gap <= options_.optimality_tolerance)
+            {
+                return extract_result(InteriorPointStatus::kOptimal, iteration);
+            }
+            if (iteration >= options_.max_iterations)
+            {
+                return extract_result(InteriorPointStatus::kIterationLimit, iteration);
+            }
+
+            form_normal_matrix();
+            if (!cholesky_.factorize(normal_).ok())
+            {
+                return extract_result(InteriorPointStatus::kNumericalFailure, iteration);
+            }
+            const double mu = num_complementarity_ > 0
+                                  ? static_cast<double>(complementarity) / static_cast<double>(num_complementarity_)
+                                  : 0.0;
+
+            // Predictor: the affine scaling direction aims at zero complementarity.
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                const double x = x_.dense_values[j];
+                lower_complementarity_.dense_values[j] =
+                    has_lower_[j] ? -(x - lower_[j]) * z_.dense_values[j] : 0.0;
+                upper_complementarity_.dense_values[j] =
+                    has_upper_[j] ? -(upper_[j] - x) * t_.dense_values[j] : 0.0;
+            }
+            solve_direction(lower_complementarity_, upper_complementarity_);
+            double primal_step;
+            double dual_step;
+            step_lengths(primal_step, dual_step);
+
+            double affine_complementarity = 0.0;
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                const double x = x_.dense_values[j] + primal_step * dx_.dense_values[j];
+                if (has_lower_[j])
+                {
+                    affine_complementarity +=
+                        (x - lower_[j]) * (z_.dense_values[j] + dual_step * dz_.dense_values[j]);
+                }
+                if (has_upper_[j])
+                {
+                    affine_complementarity +=
+                        (upper_[j] - x) * (t_.dense_values[j] + dual_step * dt_.dense_values[j]);
+                }
+            }
+            const double affine_mu =
+                num_complementarity_ > 0 ? affine_complementarity / static_cast<double>(num_complementarity_) : 0.0;
+            const double sigma = mu > 0.0 ? std::pow(affine_mu / mu, 3.0) : 0.0;
+
+            // Corrector: centering plus the second-order term of the predictor.
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                const double dx = dx_.dense_values[j];
+                if (has_lower_[j])
+                {
+                    lower_complementarity_.dense_values[j] += sigma * mu - dx * dz_.dense_values[j];
+                }
+                if (has_upper_[j])
+                {
+                    upper_complementarity_.dense_values[j] += sigma * mu + dx * dt_.dense_values[j];
+                }
+            }
+            solve_direction(lower_complementarity_, upper_complementarity_);
+            step_lengths(primal_step, dual_step);
+            primal_step *= options_.step_fraction;
+            dual_step *= options_.step_fraction;
+
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                x_.dense_values[j] += primal_step * dx_.dense_values[j];
+                z_.dense_values[j] += dual_step * dz_.dense_values[j];
+                t_.dense_values[j] += dual_step * dt_.dense_values[j];
+            }
+            for (int64_t i = 0; i < num_rows_; i++)
+            {
+                y_.dense_values[i] += dual_step * dy_.dense_values[i];
+            }
+        }
+    }
+
+    InteriorPointResult InteriorPointSolver::extract_result(const InteriorPointStatus status,
+                                                            const int iterations) const
+    {
+        InteriorPointResult result;
+        result.status = status;
+        result.iterations = iterations;
+
+        const int64_t num_cols = program_.num_cols();
+        const lp::CscMatrix& original = program_.constraint_matrix;
+        result.primal.resize(num_cols);
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            result.primal[j] = program_.column_lower[j];
+        }
+        for (size_t k = 0; k < variable_column_.size(); k++)
+        {
+            result.primal[variable_column_[k]] = x_.dense_values[k];
+        }
+
+        result.dual.resize(num_rows_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            result.dual[i] = sense_ * y_.dense_values[i];
+        }
+
+        std::vector<CompensatedDouble> activity(num_rows_, CompensatedDouble(0.0));
+        CompensatedDouble objective(program_.objective_offset);
+        result.reduced_costs.resize(num_cols);
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            CompensatedDouble reduced_cost(program_.objective[j]);
+            for (int64_t k = original.column_starts[j]; k < original.column_starts[j + 1]; k++)
+            {
+                const int64_t i = original.row_indices[k];
+                activity[i] += original.values[k] * result.primal[j];
+                reduced_cost -= original.values[k] * result.dual[i];
+            }
+            result.reduced_costs[j] = static_cast<double>(reduced_cost);
+            objective += program_.objective[j] * result.primal[j];
+        }
+        result.row_activity.resize(num_rows_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            result.row_activity[i] = static_cast<double>(activity[i]);
+        }
+        result.objective = static_cast<double>(objective);
+
+        // The measures of the final iterate, as used by the termination test.
+        const double rhs_norm = infinity_norm(rhs_);
+        const double cost_norm = infinity_norm(cost_);
+        result.primal_infeasibility = infinity_norm(primal_residual_.dense_values) / (1.0 + rhs_norm);
+        result.dual_infeasibility = infinity_norm(dual_residual_.dense_values) / (1.0 + cost_norm);
+        CompensatedDouble primal_objective(0.0);
+        CompensatedDouble dual_objective(0.0);
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            primal_objective += cost_[j] * x_.dense_values[j];
+            if (has_lower_[j])
+            {
+                dual_objective += lower_[j] * z_.dense_values[j];
+            }
+            if (has_upper_[j])
+            {
+                dual_objective -= upper_[j] * t_.dense_values[j];
+            }
+        }
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            dual_objective += rhs_[i] * y_.dense_values[i];
+        }
+        result.relative_gap = std::abs(static_cast<double>(primal_objective - dual_objective)) /
+            (1.0 + std::abs(static_cast<double>(primal_objective)));
+        return result;
+    }
+}
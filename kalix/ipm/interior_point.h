@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IPM_INTERIOR_POINT_H_
+#define KALIX_IPM_INTERIOR_POINT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/base/workspace_pool.h"
+#include "kalix/ipm/supernodal_cholesky.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::ipm
+{
+    /// @brief Options of @ref InteriorPointSolver.
+    struct InteriorPointOptions
+    {
+        /// @brief Scheduler used for the matrix kernels and the factorization. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Fill-reducing ordering of the normal equations.
+        CholeskyOrdering ordering = CholeskyOrdering::kApproximateMinimumDegree;
+
+        /// @brief Maximum number of iterations.
+        int max_iterations = 100;
+
+        /// @brief Bound on the relative primal infeasibility, dual infeasibility and duality gap
+        /// at which the solution is optimal.
+        double optimality_tolerance = 1e-8;
+
+        /// @brief Fraction of the step to the boundary that is taken.
+        double step_fraction = 0.9995;
+
+        /// @brief Primal regularization, added to the diagonal scaling of every variable so that
+        /// free variables stay well defined.
+        double primal_regularization = 1e-10;
+
+        /// @brief Dual regularization, added to the diagonal of the normal equations.
+        double dual_regularization = 1e-10;
+    };
+
+    /// @brief Termination status of @ref InteriorPointSolver::solve.
+    enum class InteriorPointStatus : int8_t
+    {
+        /// @brief All optimality measures are within the tolerance.
+        kOptimal,
+
+        /// @brief The iteration limit was reached. Infeasible and unbounded programs end here or in
+        /// @ref kNumericalFailure, as the iterates diverge.
+        kIterationLimit,
+
+        /// @brief The factorization or the iterates broke down.
+        kNumericalFailure,
+    };
+
+    /// @brief Solution computed by @ref InteriorPointSolver.
+    struct InteriorPointResult
+    {
+        /// @brief Why the solver stopped.
+        InteriorPointStatus status = InteriorPointStatus::kIterationLimit;
+
+        /// @brief Number of iterations performed.
+        int iterations = 0;
+
+        /// @brief Value of every column.
+        std::vector<double> primal;
+
+        /// @brief Activity @c Ax of every row.
+        std::vector<double> row_activity;
+
+        /// @brief Dual value of every row.
+        std::vector<double> dual;
+
+        /// @brief Reduced cost @c c - A^T y of every column.
+        std::vector<double> reduced_costs;
+
+        /// @brief Objective value of @ref primal, including the offset.
+        double objective = 0.0;
+
+        /// @brief Largest violation of @c Ax = b, relative to the right-hand side.
+        double primal_infeasibility = 0.0;
+
+        /// @brief Largest violation of the dual equations, relative to the cost.
+        double dual_infeasibility = 0.0;
+
+        /// @brief Difference between primal and dual objective, relative to the primal objective.
+        double relative_gap = 0.0;
+    };
+
+    /// @brief Primal-dual interior point method with Mehrotra's predictor-corrector.
+    ///
+    /// The program is brought into the form @c min c^T x with @c Ax = b and @c l <= x <= u: every
+    /// row that is not an equality gets a slack variable carrying its bounds, and fixed columns
+    /// are moved to the right-hand side. Each iteration solves the normal equations
+    /// @c A*Theta*A^T dy = r with a @ref SupernodalCholesky whose pattern is analyzed once, and
+    /// reuses the factorization for the predictor and the corrector direction.
+    ///
+    /// Residuals are accumulated in @ref CompensatedDouble, so that the optimality measures stay
+    /// reliable when the iterates approach the boundary and the terms of a row cancel.
+    class InteriorPointSolver
+    {
+    public:
+        /// @brief Prepares the solver. The program is copied.
+        explicit InteriorPointSolver(const lp::LinearProgram& program, const InteriorPointOptions& options = {});
+
+        /// @brief Runs the method.
+        InteriorPointResult solve();
+
+    private:
+        void initialize();
+        void compute_residuals();
+        void form_normal_matrix();
+        void solve_direction(const Vector<double>& lower_complementarity, const Vector<double>& upper_complementarity);
+        void step_lengths(double& primal_step, double& dual_step) const;
+        void multiply(const Vector<double>& x, Vector<double>& result) const;
+        void multiply_transposed(const Vector<double>& y, Vector<double>& result) const;
+        [[nodiscard]] InteriorPointResult extract_result(InteriorPointStatus status, int iterations) const;
+
+        InteriorPointOptions options_;
+        const lp::LinearProgram program_;
+        double sense_ = 1.0;
+
+        // The internal program over the variables: non-fixed columns, then slacks.
+        int64_t num_rows_ = 0;
+        int64_t num_variables_ = 0;
+        std::vector<int64_t> variable_column_;
+        std::vector<int64_t> slack_row_;
+        lp::CscMatrix matrix_;
+        lp::CscMatrix rows_;
+        std::vector<double> rhs_;
+        std::vector<double> cost_;
+        std::vector<double> lower_;
+        std::vector<double> upper_;
+        std::vector<char> has_lower_;
+        std::vector<char> has_upper_;
+        int64_t num_complementarity_ = 0;
+
+        // Iterates and directions.
+        Vector<double> x_;
+        Vector<double> y_;
+        Vector<double> z_;
+        Vector<double> t_;
+        Vector<double> dx_;
+        Vector<double> dy_;
+        Vector<double> dz_;
+        Vector<double> dt_;
+
+        // Residuals b - Ax and c - A^T y - z + t.
+        Vector<double> primal_residual_;
+        Vector<double> dual_residual_;
+
+        // Diagonal scaling Theta and scratch vectors of the direction solve.
+        Vector<double> theta_;
+        Vector<double> scratch_variables_;
+        Vector<double> scratch_rows_;
+        Vector<double> lower_complementarity_;
+        Vector<double> upper_complementarity_;
+
+        lp::CscMatrix normal_;
+        SupernodalCholesky cholesky_;
+        WorkspacePool<std::vector<double>> workspaces_;
+    };
+}
+
+#endif // KALIX_IPM_INTERIOR_POINT_H_
@@ -0,0 +1,135 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/ipm/interior_point.h"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/test_programs.h"
+
+namespace kalix::ipm
+{
+    namespace
+    {
+        constexpr double kTolerance = 1e-6;
+
+        void expect_optimal(const lp::LinearProgram& program, const InteriorPointResult& result)
+        {
+            ASSERT_EQ(result.status, InteriorPointStatus::kOptimal);
+            lp::expect_optimal_primal_dual_pair(program, result, kTolerance);
+        }
+    }
+
+    TEST(InteriorPointTest, SolvesSmallMinimization)
+    {
+        const lp::LinearProgram program = lp::small_minimization_program();
+        const InteriorPointResult result = InteriorPointSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 1.6, kTolerance);
+        EXPECT_NEAR(result.primal[1], 1.2, kTolerance);
+        EXPECT_NEAR(result.objective, -2.8, kTolerance);
+        EXPECT_NEAR(result.dual[0], -0.4, kTolerance);
+        EXPECT_NEAR(result.dual[1], -0.2, kTolerance);
+    }
+
+    TEST(InteriorPointTest, SolvesMaximizationWithOffset)
+    {
+        const lp::LinearProgram program = lp::small_maximization_program();
+        const InteriorPointResult result = InteriorPointSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.objective, 12.8, kTolerance);
+        EXPECT_NEAR(result.dual[0], 0.4, kTolerance);
+        EXPECT_NEAR(result.dual[1], 0.2, kTolerance);
+    }
+
+    TEST(InteriorPointTest, HandlesEqualityAndRangedRows)
+    {
+        const lp::LinearProgram program = lp::equality_and_ranged_program();
+        const InteriorPointResult result = InteriorPointSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 3.0, kTolerance);
+        EXPECT_NEAR(result.primal[1], 2.5, kTolerance);
+        EXPECT_NEAR(result.primal[2], 0.5, kTolerance);
+        EXPECT_NEAR(result.objective, 9.5, kTolerance);
+    }
+
+    TEST(InteriorPointTest, HandlesFreeAndFixedColumns)
+    {
+        const lp::LinearProgram program = lp::free_and_fixed_program();
+        const InteriorPointResult result = InteriorPointSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 1.0, kTolerance);
+        EXPECT_NEAR(result.primal[1], 0.0, kTolerance);
+        EXPECT_EQ(result.primal[2], 2.0);
+        EXPECT_NEAR(result.row_activity[2], 3.0, kTolerance);
+    }
+
+    TEST(InteriorPointTest, HandlesProgramWithoutRows)
+    {
+        const lp::LinearProgram program = lp::make_program({}, {1.0, -2.0}, {-1.0, 0.0}, {1.0, 3.0}, {}, {});
+        const InteriorPointResult result = InteriorPointSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.objective, -7.0, kTolerance);
+    }
+
+    TEST(InteriorPointTest, DoesNotReportInfeasibleProgramAsOptimal)
+    {
+        const lp::LinearProgram program = lp::infeasible_program();
+        InteriorPointOptions options;
+        options.max_iterations = 30;
+        const InteriorPointResult result = InteriorPointSolver(program, options).solve();
+        EXPECT_NE(result.status, InteriorPointStatus::kOptimal);
+        EXPECT_LE(result.iterations, 30);
+    }
+
+    TEST(InteriorPointTest, SolvesRandomPrograms)
+    {
+        std::mt19937 rng(7);
+        for (int trial = 0; trial < 50; trial++)
+        {
+            const lp::LinearProgram program = lp::random_program(rng, 8, 12);
+            const InteriorPointResult result = InteriorPointSolver(program).solve();
+            expect_optimal(program, result);
+        }
+    }
+
+    TEST(InteriorPointTest, ParallelMatchesSerial)
+    {
+        TaskScheduler scheduler({.num_threads = 4});
+        std::mt19937 rng(11);
+        for (const CholeskyOrdering ordering : {CholeskyOrdering::kNatural, CholeskyOrdering::kApproximateMinimumDegree,
+                                                 CholeskyOrdering::kNestedDissection})
+        {
+            const lp::LinearProgram program = lp::random_program(rng, 300, 500);
+            InteriorPointOptions options;
+            options.ordering = ordering;
+            const InteriorPointResult serial = InteriorPointSolver(program, options).solve();
+            options.scheduler = &scheduler;
+            const InteriorPointResult parallel = InteriorPointSolver(program, options).solve();
+            expect_optimal(program, parallel);
+            EXPECT_EQ(serial.iterations, parallel.iterations);
+            EXPECT_NEAR(serial.objective, parallel.objective, kTolerance * (1.0 + std::abs(serial.objective)));
+        }
+    }
+}
@@ -0,0 +1,559 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/ipm/supernodal_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+
+namespace kalix::ipm
+{
+    namespace
+    {
+        // Replacement for pivots treated as zero. The square root is large enough to make the
+        // rest of the column vanish, yet its square is still representable.
+        constexpr double kHugePivot = 1e128;
+
+        /// @brief For every column k of the permuted matrix, the rows i < k with a non-zero.
+        std::vector<std::vector<int64_t>> upper_structure(const lp::AdjacencyGraph& graph,
+                                                          const std::vector<int64_t>& permutation,
+                                                          const std::vector<int64_t>& inverse)
+        {
+            const int64_t n = graph.num_vertices();
+            std::vector<std::vector<int64_t>> upper(n);
+            for (int64_t k = 0; k < n; k++)
+            {
+                for (const int32_t u : graph.adjacent(static_cast<int32_t>(permutation[k])))
+                {
+                    if (inverse[u] < k)
+                    {
+                        upper[k].push_back(inverse[u]);
+                    }
+                }
+            }
+            return upper;
+        }
+
+        /// @brief Computes the elimination tree with Liu's algorithm.
+        std::vector<int64_t> elimination_tree(const std::vector<std::vector<int64_t>>& upper)
+        {
+            const auto n = static_cast<int64_t>(upper.size());
+            std::vector<int64_t> parent(n, -1);
+            std::vector<int64_t> ancestor(n, -1);
+            for (int64_t k = 0; k < n; k++)
+            {
+                for (int64_t i : upper[k])
+                {
+                    // Walk to the root of the current subtree of i, compressing the path to k.
+                    while (i != -1 && i < k)
+                    {
+                        const int64_t next = ancestor[i];
+                        ancestor[i] = k;
+                        if (next == -1)
+                        {
+                            parent[i] = k;
+                        }
+                        i = next;
+                    }
+                }
+            }
+            return parent;
+        }
+
+        /// @brief Returns the vertices of a forest in postorder.
+        std::vector<int64_t> postorder(const std::vector<int64_t>& parent)
+        {
+            const auto n = static_cast<int64_t>(parent.size());
+            std::vector<int64_t> head(n, -1);
+            std::vector<int64_t> next(n, -1);
+            for (int64_t v = n - 1; v >= 0; v--)
+            {
+                if (parent[v] != -1)
+                {
+                    next[v] = head[parent[v]];
+                    head[parent[v]] = v;
+                }
+            }
+
+            std::vector<int64_t> order;
+            order.reserve(n);
+            std::vector<int64_t> stack;
+            for (int64_t root = 0; root < n; root++)
+            {
+                if (parent[root] != -1)
+                {
+                    continue;
+                }
+                stack.push_back(root);
+                while (!stack.empty())
+                {
+                    const int64_t v = stack.back();
+                    if (const int64_t child = head[v]; child != -1)
+                    {
+                        head[v] = next[child];
+                        stack.push_back(child);
+                    }
+                    else
+                    {
+                        stack.pop_back();
+                        order.push_back(v);
+                    }
+                }
+            }
+            return order;
+        }
+
+        std::vector<int64_t> invert(const std::vector<int64_t>& permutation)
+        {
+            std::vector<int64_t> inverse(permutation.size());
+            for (size_t k = 0; k < permutation.size(); k++)
+            {
+                inverse[permutation[k]] = static_cast<int64_t>(k);
+            }
+            return inverse;
+        }
+    }
+
+    SupernodalCholesky::SupernodalCholesky(const CholeskyOptions& options)
+        : options_(options)
+    {
+    }
+
+    void SupernodalCholesky::analyze(const lp::CscMatrix& lower)
+    {
+        CHECK_EQ(lower.num_rows, lower.num_cols);
+        const int64_t n = lower.num_cols;
+        input_non_zeros_ = lower.num_non_zeros();
+
+        const lp::AdjacencyGraph graph = lp::AdjacencyGraph::from_symmetric_pattern(lower.view());
+        switch (options_.ordering)
+        {
+        case CholeskyOrdering::kNatural:
+            permutation_.resize(n);
+            std::iota(permutation_.begin(), permutation_.end(), 0);
+            break;
+
+        case CholeskyOrdering::kApproximateMinimumDegree:
+        {
+            const std::vector<int32_t> order = lp::approximate_minimum_degree(graph);
+            permutation_.assign(order.begin(), order.end());
+            break;
+        }
+
+        case CholeskyOrdering::kNestedDissection:
+        {
+            lp::NestedDissectionOptions dissection;
+            dissection.scheduler = options_.scheduler;
+            const std::vector<int32_t> order = lp::nested_dissection(graph, dissection);
+            permutation_.assign(order.begin(), order.end());
+            break;
+        }
+        }
+
+        // Postordering the elimination tree keeps the fill but makes every subtree a contiguous
+        // range of columns, which is what lets chains of columns form supernodes.
+        {
+            const std::vector<int64_t> inverse = invert(permutation_);
+            const std::vector<int64_t> order = postorder(elimination_tree(upper_structure(graph, permutation_, inverse)));
+            std::vector<int64_t> composed(n);
+            for (int64_t k = 0; k < n; k++)
+            {
+                composed[k] = permutation_[order[k]];
+            }
+            permutation_ = std::move(composed);
+        }
+        const std::vector<int64_t> inverse = invert(permutation_);
+        const std::vector<std::vector<int64_t>> upper = upper_structure(graph, permutation_, inverse);
+        const std::vector<int64_t> parent = elimination_tree(upper);
+
+        // The structure of row i of L is the union of the paths from every j in row i of the
+        // matrix up to i in the elimination tree.
+        std::vector<int64_t> counts(n, 1);
+        std::vector<int64_t> marker(n, -1);
+        const auto for_each_row_entry = [&](const int64_t i, auto&& function)
+        {
+            marker[i] = i;
+            for (int64_t j : upper[i])
+            {
+                while (marker[j] != i)
+                {
+                    function(j);
+                    marker[j] = i;
+                    j = parent[j];
+                }
+            }
+        };
+        for (int64_t i = 0; i < n; i++)
+        {
+            for_each_row_entry(i, [&counts](const int64_t j) { counts[j]++; });
+        }
+
+        // Column j extends the supernode of j - 1 if it is its parent and the structures match.
+        std::vector<int64_t> supernode_of(n);
+        supernodes_.clear();
+        for (int64_t j = 0; j < n; j++)
+        {
+            if (j == 0 || parent[j - 1] != j || counts[j - 1] != counts[j] + 1)
+            {
+                supernodes_.push_back({.first_column = j, .end_column = j + 1, .row_begin = 0, .row_end = 0,
+                                       .value_begin = 0, .parent = -1});
+            }
+            else
+            {
+                supernodes_.back().end_column = j + 1;
+            }
+            supernode_of[j] = static_cast<int64_t>(supernodes_.size()) - 1;
+        }
+
+        const auto num_supernodes = static_cast<int64_t>(supernodes_.size());
+        int64_t row_offset = 0;
+        int64_t value_offset = 0;
+        factor_non_zeros_ = 0;
+        for (Supernode& node : supernodes_)
+        {
+            const int64_t width = node.end_column - node.first_column;
+            const int64_t length = counts[node.first_column];
+            node.row_begin = row_offset;
+            node.row_end = row_offset + length;
+            node.value_begin = value_offset;
+            const int64_t last = node.end_column - 1;
+            node.parent = parent[last] == -1 ? -1 : supernode_of[parent[last]];
+            row_offset += length;
+            value_offset += length * width;
+            factor_non_zeros_ += length * width - width * (width - 1) / 2;
+        }
+
+        // The rows of a supernode are those of its first column. They arrive in increasing order.
+        rows_.assign(row_offset, 0);
+        std::vector<int64_t> fill(num_supernodes);
+        for (int64_t s = 0; s < num_supernodes; s++)
+        {
+            rows_[supernodes_[s].row_begin] = supernodes_[s].first_column;
+            fill[s] = supernodes_[s].row_begin + 1;
+        }
+        std::ranges::fill(marker, -1);
+        for (int64_t i = 0; i < n; i++)
+        {
+            for_each_row_entry(i, [&](const int64_t j)
+            {
+                const int64_t s = supernode_of[j];
+                if (supernodes_[s].first_column == j)
+                {
+                    rows_[fill[s]++] = i;
+                }
+            });
+        }
+
+        children_.assign(num_supernodes, {});
+        first_descendant_.resize(num_supernodes);
+        std::vector<int64_t> subtree_work(num_supernodes, 0);
+        for (int64_t s = 0; s < num_supernodes; s++)
+        {
+            const Supernode& node = supernodes_[s];
+            const int64_t width = node.end_column - node.first_column;
+            const int64_t length = node.row_end - node.row_begin;
+            for (int64_t k = 0; k < width; k++)
+            {
+                subtree_work[s] += (length - k) * (length - k);
+            }
+            first_descendant_[s] = children_[s].empty() ? s : first_descendant_[children_[s].front()];
+            if (node.parent != -1)
+            {
+                children_[node.parent].push_back(s);
+                subtree_work[node.parent] += subtree_work[s];
+            }
+        }
+
+        levels_.assign(1, {});
+        std::vector<int64_t> level(num_supernodes, 0);
+        for (int64_t s = 0; s < num_supernodes; s++)
+        {
+            const int64_t parent_supernode = supernodes_[s].parent;
+            if (subtree_work[s] < options_.min_parallel_work)
+            {
+                if (parent_supernode == -1 || subtree_work[parent_supernode] >= options_.min_parallel_work)
+                {
+                    levels_[0].push_back(s);
+                }
+                continue;
+            }
+            for (const int64_t child : children_[s])
+            {
+                level[s] = std::max(level[s], level[child] + 1);
+            }
+            level[s] = std::max<int64_t>(level[s], 1);
+            if (level[s] >= static_cast<int64_t>(levels_.size()))
+            {
+                levels_.resize(level[s] + 1);
+            }
+            levels_[level[s]].push_back(s);
+        }
+
+        // Map every input entry to its position in the factor.
+        assembly_.resize(input_non_zeros_);
+        for (int64_t j = 0; j < n; j++)
+        {
+            for (int64_t e = lower.column_starts[j]; e < lower.column_starts[j + 1]; e++)
+            {
+                const int64_t a = inverse[lower.row_indices[e]];
+                const int64_t b = inverse[j];
+                const int64_t row = std::max(a, b);
+                const int64_t column = std::min(a, b);
+                const Supernode& node = supernodes_[supernode_of[column]];
+                const auto begin = rows_.begin() + node.row_begin;
+                const auto position = std::lower_bound(begin, rows_.begin() + node.row_end, row) - begin;
+                const int64_t length = node.row_end - node.row_begin;
+                assembly_[e] = node.value_begin + (column - node.first_column) * length + position;
+            }
+        }
+        diagonal_positions_.resize(n);
+        for (const Supernode& node : supernodes_)
+        {
+            const int64_t length = node.row_end - node.row_begin;
+            for (int64_t k = 0; k < node.end_column - node.first_column; k++)
+            {
+                diagonal_positions_[node.first_column + k] = node.value_begin + k * length + k;
+            }
+        }
+        values_.assign(value_offset, 0.0);
+    }
+
+    absl::Status SupernodalCholesky::factorize(const lp::CscMatrix& lower)
+    {
+        if (lower.num_cols != dimension() || lower.num_non_zeros() != input_non_zeros_)
+        {
+            return absl::FailedPreconditionError(
+                absl::StrCat("Matrix with ", lower.num_non_zeros(), " entries does not match the analyzed pattern"));
+        }
+        std::ranges::fill(values_, 0.0);
+        for (int64_t e = 0; e < input_non_zeros_; e++)
+        {
+            const double value = lower.values[e];
+            if (!std::isfinite(value))
+            {
+                return absl::InvalidArgumentError(absl::StrCat("Entry ", e, " is not finite"));
+            }
+            values_[assembly_[e]] += value;
+        }
+
+        double max_diagonal = 0.0;
+        for (const int64_t position : diagonal_positions_)
+        {
+            max_diagonal = std::max(max_diagonal, values_[position]);
+        }
+        const double pivot_limit = options_.pivot_tolerance * max_diagonal;
+
+        updates_.assign(supernodes_.size(), {});
+        dropped_.assign(dimension(), 0);
+        if (options_.scheduler == nullptr)
+        {
+            for (int64_t s = 0; s < num_supernodes(); s++)
+            {
+                factorize_supernode(s, pivot_limit);
+            }
+        }
+        else
+        {
+            for (const std::vector<int64_t>& level : levels_)
+            {
+                const bool serial_subtrees = &level == &levels_.front();
+                options_.scheduler->parallel_for(0, static_cast<int64_t>(level.size()), 1, [&](const int64_t k)
+                {
+                    const int64_t root = level[k];
+                    const int64_t begin = serial_subtrees ? first_descendant_[root] : root;
+                    for (int64_t s = begin; s <= root; s++)
+                    {
+                        factorize_supernode(s, pivot_limit);
+                    }
+                });
+            }
+        }
+        dropped_pivots_ = std::reduce(dropped_.begin(), dropped_.end(), int64_t{0});
+        return absl::OkStatus();
+    }
+
+    void SupernodalCholesky::factorize_supernode(const int64_t supernode, const double pivot_limit)
+    {
+        const Supernode& node = supernodes_[supernode];
+        const int64_t width = node.end_column - node.first_column;
+        const int64_t length = node.row_end - node.row_begin;
+        const int64_t update_size = length - width;
+        const int64_t* rows = &rows_[node.row_begin];
+        double* block = &values_[node.value_begin];
+        std::vector<double> update(update_size * update_size, 0.0);
+
+        // Extend-add the update matrices of the children. Their rows are a sorted subset of ours.
+        std::vector<int64_t> relative;
+        for (const int64_t child : children_[supernode])
+        {
+            const Supernode& child_node = supernodes_[child];
+            const int64_t child_width = child_node.end_column - child_node.first_column;
+            const int64_t child_size = child_node.row_end - child_node.row_begin - child_width;
+            relative.resize(child_size);
+            int64_t position = 0;
+            for (int64_t t = 0; t < child_size; t++)
+            {
+                const int64_t row = rows_[child_node.row_begin + child_width + t];
+                while (rows[position] != row)
+                {
+                    position++;
+                }
+                relative[t] = position;
+            }
+
+            const std::vector<double>& child_update = updates_[child];
+            for (int64_t b = 0; b < child_size; b++)
+            {
+                const int64_t column = relative[b];
+                const double* source = &child_update[b * child_size];
+                if (column < width)
+                {
+                    double* target = block + column * length;
+                    for (int64_t a = b; a < child_size; a++)
+                    {
+                        target[relative[a]] += source[a];
+                    }
+                }
+                else
+                {
+                    double* target = &update[(column - width) * update_size];
+                    for (int64_t a = b; a < child_size; a++)
+                    {
+                        target[relative[a] - width] += source[a];
+                    }
+                }
+            }
+            std::vector<double>().swap(updates_[child]);
+        }
+
+        // Dense Cholesky of the pivot columns, updating the rest of the supernode right-looking.
+        for (int64_t k = 0; k < width; k++)
+        {
+            double* column = block + k * length;
+            double diagonal = column[k];
+            if (!(diagonal > pivot_limit))
+            {
+                diagonal = kHugePivot;
+                dropped_[node.first_column + k] = 1;
+            }
+            const double pivot = std::sqrt(diagonal);
+            column[k] = pivot;
+            const double inverse = 1.0 / pivot;
+            for (int64_t i = k + 1; i < length; i++)
+            {
+                column[i] *= inverse;
+            }
+            for (int64_t j = k + 1; j < width; j++)
+            {
+                const double multiplier = column[j];
+                if (multiplier == 0.0)
+                {
+                    continue;
+                }
+                double* target = block + j * length;
+                for (int64_t i = j; i < length; i++)
+                {
+                    target[i] -= multiplier * column[i];
+                }
+            }
+        }
+
+        // Schur complement for the parent: update -= L21 * L21^T.
+        for (int64_t j = 0; j < update_size; j++)
+        {
+            double* target = &update[j * update_size];
+            for (int64_t k = 0; k < width; k++)
+            {
+                const double* source = block + k * length + width;
+                const double multiplier = source[j];
+                if (multiplier == 0.0)
+                {
+                    continue;
+                }
+                for (int64_t i = j; i < update_size; i++)
+                {
+                    target[i] -= multiplier * source[i];
+                }
+            }
+        }
+        updates_[supernode] = std::move(update);
+    }
+
+    void SupernodalCholesky::solve(const std::span<double> rhs) const
+    {
+        CHECK_EQ(static_cast<int64_t>(rhs.size()), dimension());
+        const int64_t n = dimension();
+        std::vector<double> y(n);
+        for (int64_t k = 0; k < n; k++)
+        {
+            y[k] = rhs[permutation_[k]];
+        }
+
+        for (const Supernode& node : supernodes_)
+        {
+            const int64_t length = node.row_end - node.row_begin;
+            const int64_t* rows = &rows_[node.row_begin];
+            const double* block = &values_[node.value_begin];
+            for (int64_t k = 0; k < node.end_column - node.first_column; k++)
+            {
+                const double* column = block + k * length;
+                const double value = y[node.first_column + k] /= column[k];
+                for (int64_t i = k + 1; i < length; i++)
+                {
+                    y[rows[i]] -= column[i] * value;
+                }
+            }
+        }
+
+        for (auto node = supernodes_.rbegin(); node != supernodes_.rend(); ++node)
+        {
+            const int64_t length = node->row_end - node->row_begin;
+            const int64_t* rows = &rows_[node->row_begin];
+            const double* block = &values_[node->value_begin];
+            for (int64_t k = node->end_column - node->first_column - 1; k >= 0; k--)
+            {
+                const double* column = block + k * length;
+                double sum = y[node->first_column + k];
+                for (int64_t i = k + 1; i < length; i++)
+                {
+                    sum -= column[i] * y[rows[i]];
+                }
+                y[node->first_column + k] = sum / column[k];
+            }
+        }
+
+        for (int64_t k = 0; k < n; k++)
+        {
+            rhs[permutation_[k]] = y[k];
+        }
+    }
+
+    void SupernodalCholesky::solve(Vector<double>& rhs) const
+    {
+        solve(std::span<double>(rhs.dense_values.data(), rhs.dimension));
+        rhs.non_zero_count = -1;
+    }
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_IPM_SUPERNODAL_CHOLESKY_H_
+#define KALIX_IPM_SUPERNODAL_CHOLESKY_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/lp/ordering.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::ipm
+{
+    /// @brief The fill-reducing ordering used by @ref SupernodalCholesky::analyze.
+    enum class CholeskyOrdering : int8_t
+    {
+        /// @brief Factorizes the matrix as given.
+        kNatural,
+
+        /// @brief Approximate minimum degree, see @ref lp::approximate_minimum_degree.
+        kApproximateMinimumDegree,
+
+        /// @brief Nested dissection, see @ref lp::nested_dissection. Uses the scheduler.
+        kNestedDissection,
+    };
+
+    /// @brief Options of @ref SupernodalCholesky.
+    struct CholeskyOptions
+    {
+        /// @brief The fill-reducing ordering.
+        CholeskyOrdering ordering = CholeskyOrdering::kApproximateMinimumDegree;
+
+        /// @brief Scheduler used to factorize independent subtrees in parallel. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Pivots not larger than this times the largest diagonal entry are treated as zero.
+        ///
+        /// Such a pivot is replaced by a huge value, which effectively removes its row and column
+        /// from the system. Normal equations of interior point methods become singular near the
+        /// optimum, and this keeps the factorization usable.
+        double pivot_tolerance = 1e-30;
+
+        /// @brief Subtrees with fewer estimated floating-point operations are factorized on the
+        /// calling thread.
+        int64_t min_parallel_work = int64_t{1} << 16;
+    };
+
+    /// @brief A sparse Cholesky factorization @c P*M*P^T = L*L^T of a symmetric positive
+    /// (semi-)definite matrix.
+    ///
+    /// @ref analyze computes the ordering, the elimination tree and the supernodes: groups of
+    /// consecutive columns of @c L with identical structure below the diagonal block. The numeric
+    /// factorization is multifrontal: every supernode assembles its dense frontal matrix from the
+    /// original entries and the update matrices of its children, factorizes its pivot columns with
+    /// dense kernels and passes the Schur complement to its parent. Disjoint subtrees of the
+    /// supernodal elimination tree are independent and are factorized as parallel tasks.
+    ///
+    /// The pattern is analyzed once, and @ref factorize can then be called repeatedly for matrices
+    /// with the same pattern but different values, as needed by interior point methods.
+    class SupernodalCholesky
+    {
+    public:
+        /// @brief Constructs an empty factorization.
+        explicit SupernodalCholesky(const CholeskyOptions& options = {});
+
+        /// @brief Computes the symbolic factorization of a matrix.
+        ///
+        /// @param lower The lower triangle of the matrix in CSC format, including the diagonal.
+        /// Only the pattern is used.
+        void analyze(const lp::CscMatrix& lower);
+
+        /// @brief Computes the numeric factorization.
+        ///
+        /// @param lower The lower triangle of the matrix with the pattern passed to @ref analyze.
+        /// @return An error if the pattern does not match or a value is not finite.
+        absl::Status factorize(const lp::CscMatrix& lower);
+
+        /// @brief Solves @c M*x = rhs in place.
+        void solve(std::span<double> rhs) const;
+
+        /// @brief Solves @c M*x = rhs in place. The result is stored densely.
+        void solve(Vector<double>& rhs) const;
+
+        /// @brief Returns the dimension of the matrix.
+        [[nodiscard]] int64_t dimension() const
+        {
+            return static_cast<int64_t>(permutation_.size());
+        }
+
+        /// @brief Returns the ordering: pivot @c k is row and column @c permutation()[k] of the matrix.
+        [[nodiscard]] std::span<const int64_t> permutation() const
+        {
+            return permutation_;
+        }
+
+        /// @brief Returns the number of supernodes.
+        [[nodiscard]] int64_t num_supernodes() const
+        {
+            return static_cast<int64_t>(supernodes_.size());
+        }
+
+        /// @brief Returns the number of entries of @c L, including the diagonal.
+        [[nodiscard]] int64_t factor_non_zeros() const
+        {
+            return factor_non_zeros_;
+        }
+
+        /// @brief Returns the number of pivots treated as zero by the last factorization.
+        [[nodiscard]] int64_t dropped_pivots() const
+        {
+            return dropped_pivots_;
+        }
+
+    private:
+        /// @brief A group of consecutive columns of @c L with identical structure.
+        struct Supernode
+        {
+            /// @brief First column.
+            int64_t first_column;
+
+            /// @brief One past the last column.
+            int64_t end_column;
+
+            /// @brief Offset of the row structure in @ref rows_. The first rows are the columns of
+            /// the supernode itself.
+            int64_t row_begin;
+
+            /// @brief One past the end of the row structure.
+            int64_t row_end;
+
+            /// @brief Offset of the dense column-major block in @ref values_.
+            int64_t value_begin;
+
+            /// @brief The parent supernode, or -1 for a root.
+            int64_t parent;
+        };
+
+        void factorize_supernode(int64_t supernode, double pivot_limit);
+
+        CholeskyOptions options_;
+
+        std::vector<int64_t> permutation_;
+        std::vector<Supernode> supernodes_;
+        std::vector<std::vector<int64_t>> children_;
+        std::vector<int64_t> rows_;
+
+        // Supernodes are numbered in postorder, so the subtree of s is [first_descendant_[s], s].
+        std::vector<int64_t> first_descendant_;
+
+        // Parallel schedule: level 0 holds the roots of small subtrees, which are factorized
+        // serially as a whole; every further level holds single supernodes whose children all
+        // belong to lower levels.
+        std::vector<std::vector<int64_t>> levels_;
+
+        // Position in values_ of every entry of the analyzed lower triangle, in CSC order.
+        std::vector<int64_t> assembly_;
+        std::vector<int64_t> diagonal_positions_;
+        int64_t input_non_zeros_ = 0;
+
+        std::vector<double> values_;
+        std::vector<std::vector<double>> updates_;
+        std::vector<char> dropped_;
+        int64_t factor_non_zeros_ = 0;
+        int64_t dropped_pivots_ = 0;
+    };
+}
+
+#endif // KALIX_IPM_SUPERNODAL_CHOLESKY_H_
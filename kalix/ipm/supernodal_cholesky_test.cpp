@@ -0,0 +1,300 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/ipm/supernodal_cholesky.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::ipm
+{
+    namespace
+    {
+        using DenseMatrix = std::vector<std::vector<double>>;
+
+        lp::CscMatrix lower_triangle(const DenseMatrix& matrix)
+        {
+            lp::CscMatrix lower;
+            const auto n = static_cast<int64_t>(matrix.size());
+            lower.num_rows = n;
+            for (int64_t j = 0; j < n; j++)
+            {
+                std::vector<int64_t> indices;
+                std::vector<double> values;
+                for (int64_t i = j; i < n; i++)
+                {
+                    if (matrix[i][j] != 0.0 || i == j)
+                    {
+                        indices.push_back(i);
+                        values.push_back(matrix[i][j]);
+                    }
+                }
+                lower.append_column(indices, values);
+            }
+            return lower;
+        }
+
+        /// A random sparse symmetric positive definite matrix B*B^T + I.
+        DenseMatrix random_spd(std::mt19937& rng, const int64_t n, const double density)
+        {
+            std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+            std::bernoulli_distribution keep(density);
+            DenseMatrix factor(n, std::vector<double>(n, 0.0));
+            for (int64_t i = 0; i < n; i++)
+            {
+                for (int64_t j = 0; j < n; j++)
+                {
+                    if (keep(rng))
+                    {
+                        factor[i][j] = uniform(rng);
+                    }
+                }
+            }
+            DenseMatrix matrix(n, std::vector<double>(n, 0.0));
+            for (int64_t i = 0; i < n; i++)
+            {
+                matrix[i][i] = 1.0;
+                for (int64_t j = 0; j < n; j++)
+                {
+                    for (int64_t k = 0; k < n; k++)
+                    {
+                        matrix[i][j] += factor[i][k] * factor[j][k];
+                    }
+                }
+            }
+            return matrix;
+        }
+
+        void expect_solves(const DenseMatrix& matrix, const SupernodalCholesky& cholesky, std::mt19937& rng)
+        {
+            const auto n = static_cast<int64_t>(matrix.size());
+            std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+            std::vector<double> solution(n);
+            for (double& value : solution)
+            {
+                value = uniform(rng);
+            }
+            std::vector<double> rhs(n, 0.0);
+            for (int64_t i = 0; i < n; i++)
+            {
+                for (int64_t j = 0; j < n; j++)
+                {
+                    rhs[i] += matrix[i][j] * solution[j];
+                }
+            }
+            cholesky.solve(rhs);
+            for (int64_t i = 0; i < n; i++)
+            {
+                EXPECT_NEAR(rhs[i], solution[i], 1e-8);
+            }
+        }
+    }
+
+    TEST(SupernodalCholeskyTest, SolvesTridiagonalSystem)
+    {
+        constexpr int64_t n = 50;
+        DenseMatrix matrix(n, std::vector<double>(n, 0.0));
+        for (int64_t i = 0; i < n; i++)
+        {
+            matrix[i][i] = 4.0;
+            if (i + 1 < n)
+            {
+                matrix[i][i + 1] = matrix[i + 1][i] = -1.0;
+            }
+        }
+        SupernodalCholesky cholesky;
+        const lp::CscMatrix lower = lower_triangle(matrix);
+        cholesky.analyze(lower);
+        ASSERT_TRUE(cholesky.factorize(lower).ok());
+        // A tridiagonal matrix factors without fill.
+        EXPECT_EQ(cholesky.factor_non_zeros(), 2 * n - 1);
+        std::mt19937 rng(1);
+        expect_solves(matrix, cholesky, rng);
+    }
+
+    TEST(SupernodalCholeskyTest, DenseMatrixIsOneSupernode)
+    {
+        std::mt19937 rng(2);
+        const DenseMatrix matrix = random_spd(rng, 12, 1.0);
+        SupernodalCholesky cholesky;
+        const lp::CscMatrix lower = lower_triangle(matrix);
+        cholesky.analyze(lower);
+        ASSERT_TRUE(cholesky.factorize(lower).ok());
+        EXPECT_EQ(cholesky.num_supernodes(), 1);
+        expect_solves(matrix, cholesky, rng);
+    }
+
+    TEST(SupernodalCholeskyTest, ApproximateMinimumDegreeAvoidsArrowheadFill)
+    {
+        // An arrowhead with the dense row first fills completely in the natural order.
+        constexpr int64_t n = 30;
+        DenseMatrix matrix(n, std::vector<double>(n, 0.0));
+        for (int64_t i = 0; i < n; i++)
+        {
+            matrix[i][i] = static_cast<double>(n);
+            matrix[0][i] = matrix[i][0] = i == 0 ? static_cast<double>(n) : 1.0;
+        }
+        const lp::CscMatrix lower = lower_triangle(matrix);
+
+        CholeskyOptions natural_options;
+        natural_options.ordering = CholeskyOrdering::kNatural;
+        SupernodalCholesky natural(natural_options);
+        natural.analyze(lower);
+        SupernodalCholesky minimum_degree;
+        minimum_degree.analyze(lower);
+        EXPECT_EQ(natural.factor_non_zeros(), n * (n + 1) / 2);
+        EXPECT_EQ(minimum_degree.factor_non_zeros(), 2 * n - 1);
+
+        ASSERT_TRUE(minimum_degree.factorize(lower).ok());
+        std::mt19937 rng(3);
+        expect_solves(matrix, minimum_degree, rng);
+    }
+
+    TEST(SupernodalCholeskyTest, RefactorizesWithNewValues)
+    {
+        std::mt19937 rng(4);
+        DenseMatrix matrix = random_spd(rng, 40, 0.05);
+        lp::CscMatrix lower = lower_triangle(matrix);
+        SupernodalCholesky cholesky;
+        cholesky.analyze(lower);
+        ASSERT_TRUE(cholesky.factorize(lower).ok());
+        expect_solves(matrix, cholesky, rng);
+
+        for (int64_t i = 0; i < 40; i++)
+        {
+            matrix[i][i] += 10.0 * i;
+        }
+        ASSERT_TRUE(cholesky.factorize(lower_triangle(matrix)).ok());
+        expect_solves(matrix, cholesky, rng);
+    }
+
+    TEST(SupernodalCholeskyTest, DropsZeroPivots)
+    {
+        // Row and column 1 are zero; the remaining system is still solved.
+        const DenseMatrix matrix = {{2.0, 0.0, 1.0}, {0.0, 0.0, 0.0}, {1.0, 0.0, 3.0}};
+        SupernodalCholesky cholesky;
+        const lp::CscMatrix lower = lower_triangle(matrix);
+        cholesky.analyze(lower);
+        ASSERT_TRUE(cholesky.factorize(lower).ok());
+        EXPECT_EQ(cholesky.dropped_pivots(), 1);
+        std::vector<double> rhs = {3.0, 0.0, 4.0};
+        cholesky.solve(rhs);
+        EXPECT_NEAR(rhs[0], 1.0, 1e-12);
+        EXPECT_NEAR(rhs[1], 0.0, 1e-12);
+        EXPECT_NEAR(rhs[2], 1.0, 1e-12);
+    }
+
+    TEST(SupernodalCholeskyTest, RejectsMismatchedPattern)
+    {
+        const DenseMatrix matrix = {{2.0, 1.0}, {1.0, 2.0}};
+        SupernodalCholesky cholesky;
+        cholesky.analyze(lower_triangle(matrix));
+        EXPECT_EQ(cholesky.factorize(lower_triangle({{2.0, 0.0}, {0.0, 2.0}})).code(),
+                  absl::StatusCode::kFailedPrecondition);
+    }
+
+    TEST(SupernodalCholeskyTest, SolvesKalixVector)
+    {
+        const DenseMatrix matrix = {{4.0, 2.0}, {2.0, 3.0}};
+        SupernodalCholesky cholesky;
+        const lp::CscMatrix lower = lower_triangle(matrix);
+        cholesky.analyze(lower);
+        ASSERT_TRUE(cholesky.factorize(lower).ok());
+        Vector<double> rhs;
+        rhs.setup(2);
+        rhs.dense_values = {6.0, 5.0};
+        cholesky.solve(rhs);
+        EXPECT_EQ(rhs.non_zero_count, -1);
+        EXPECT_NEAR(rhs.dense_values[0], 1.0, 1e-12);
+        EXPECT_NEAR(rhs.dense_values[1], 1.0, 1e-12);
+    }
+
+    TEST(SupernodalCholeskyTest, NestedDissectionSolvesGridLaplacian)
+    {
+        // The 5-point Laplacian of a 25x25 grid, shifted to be positive definite.
+        constexpr int64_t width = 25;
+        constexpr int64_t n = width * width;
+        DenseMatrix matrix(n, std::vector<double>(n, 0.0));
+        for (int64_t v = 0; v < n; v++)
+        {
+            matrix[v][v] = 4.5;
+            if (v % width + 1 < width)
+            {
+                matrix[v][v + 1] = matrix[v + 1][v] = -1.0;
+            }
+            if (v + width < n)
+            {
+                matrix[v][v + width] = matrix[v + width][v] = -1.0;
+            }
+        }
+        const lp::CscMatrix lower = lower_triangle(matrix);
+
+        CholeskyOptions natural_options;
+        natural_options.ordering = CholeskyOrdering::kNatural;
+        SupernodalCholesky natural(natural_options);
+        natural.analyze(lower);
+        TaskScheduler scheduler({.num_threads = 4});
+        CholeskyOptions options;
+        options.ordering = CholeskyOrdering::kNestedDissection;
+        options.scheduler = &scheduler;
+        SupernodalCholesky dissection(options);
+        dissection.analyze(lower);
+        EXPECT_LT(dissection.factor_non_zeros(), natural.factor_non_zeros());
+
+        ASSERT_TRUE(dissection.factorize(lower).ok());
+        std::mt19937 rng(9);
+        expect_solves(matrix, dissection, rng);
+    }
+
+    class SupernodalCholeskyParallelTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(SupernodalCholeskyParallelTest, MatchesSerialFactorization)
+    {
+        std::mt19937 rng(5);
+        const DenseMatrix matrix = random_spd(rng, 150, 0.01);
+        const lp::CscMatrix lower = lower_triangle(matrix);
+
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        CholeskyOptions options;
+        options.scheduler = &scheduler;
+        options.min_parallel_work = 16;
+        SupernodalCholesky parallel(options);
+        parallel.analyze(lower);
+        ASSERT_TRUE(parallel.factorize(lower).ok());
+        expect_solves(matrix, parallel, rng);
+
+        SupernodalCholesky serial;
+        serial.analyze(lower);
+        ASSERT_TRUE(serial.factorize(lower).ok());
+        std::vector<double> first(150, 1.0);
+        std::vector<double> second(150, 1.0);
+        parallel.solve(first);
+        serial.solve(second);
+        EXPECT_EQ(first, second);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, SupernodalCholeskyParallelTest, ::testing::Values(1, 4));
+}
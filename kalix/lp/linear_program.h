@@ -0,0 +1,94 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_LINEAR_PROGRAM_H_
+#define KALIX_LP_LINEAR_PROGRAM_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::lp
+{
+    /// @brief Direction of optimization.
+    enum class ObjectiveSense : int8_t
+    {
+        kMinimize,
+        kMaximize,
+    };
+
+    /// @brief A linear program in bounded row form.
+    ///
+    /// \f[ \min / \max \; c^T x + c_0 \quad \text{s.t.} \quad r_l \le A x \le r_u, \; x_l \le x \le x_u \f]
+    ///
+    /// Infinite bounds are represented by @c std::numeric_limits<double>::infinity().
+    struct LinearProgram
+    {
+        /// @brief Name of the problem.
+        std::string name;
+
+        /// @brief Direction of optimization.
+        ObjectiveSense sense = ObjectiveSense::kMinimize;
+
+        /// @brief Constant term \f$ c_0 \f$ of the objective.
+        double objective_offset = 0.0;
+
+        /// @brief The constraint matrix \f$ A \f$.
+        CscMatrix constraint_matrix;
+
+        /// @brief Objective coefficients \f$ c \f$, one per column.
+        std::vector<double> objective;
+
+        /// @brief Column lower bounds.
+        std::vector<double> column_lower;
+
+        /// @brief Column upper bounds.
+        std::vector<double> column_upper;
+
+        /// @brief Row lower bounds.
+        std::vector<double> row_lower;
+
+        /// @brief Row upper bounds.
+        std::vector<double> row_upper;
+
+        /// @brief Row names. Either empty or one per row.
+        std::vector<std::string> row_names;
+
+        /// @brief Column names. Either empty or one per column.
+        std::vector<std::string> column_names;
+
+        /// @brief Returns the number of rows.
+        [[nodiscard]] int64_t num_rows() const
+        {
+            return constraint_matrix.num_rows;
+        }
+
+        /// @brief Returns the number of columns.
+        [[nodiscard]] int64_t num_cols() const
+        {
+            return constraint_matrix.num_cols;
+        }
+    };
+}
+
+#endif // KALIX_LP_LINEAR_PROGRAM_H_
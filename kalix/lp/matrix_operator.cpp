@@ -0,0 +1,386 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/matrix_operator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "absl/log/check.h"
+
+namespace kalix::lp
+{
+    namespace
+    {
+        // Lines per slice of the sliced format. Eight doubles fill one cache line and one AVX-512
+        // register, or two AVX2 registers.
+        constexpr int64_t kSliceHeight = 8;
+
+        // The lines in the order they are stored in slices: by decreasing length within every
+        // window of consecutive lines, ties in their original order.
+        std::vector<int64_t> slice_order(const CscMatrix& lines, int64_t window)
+        {
+            window = std::max<int64_t>(1, (window + kSliceHeight - 1) / kSliceHeight) * kSliceHeight;
+            std::vector<int64_t> order(lines.num_cols);
+            for (int64_t j = 0; j < lines.num_cols; j++)
+            {
+                order[j] = j;
+            }
+            const auto length = [&](const int64_t j)
+            {
+                return lines.column_starts[j + 1] - lines.column_starts[j];
+            };
+            for (int64_t begin = 0; begin < lines.num_cols; begin += window)
+            {
+                const int64_t end = std::min(begin + window, lines.num_cols);
+                std::stable_sort(order.begin() + begin, order.begin() + end,
+                                 [&](const int64_t a, const int64_t b) { return length(a) > length(b); });
+            }
+            return order;
+        }
+
+        // The number of entries of the slices built from @p order, padding included.
+        int64_t padded_size(const CscMatrix& lines, const std::span<const int64_t> order)
+        {
+            int64_t result = 0;
+            for (size_t begin = 0; begin < order.size(); begin += kSliceHeight)
+            {
+                // The first lane is the longest within the window, but a slice can straddle two.
+                int64_t width = 0;
+                for (size_t lane = begin; lane < std::min(begin + kSliceHeight, order.size()); lane++)
+                {
+                    width = std::max(width, lines.column_starts[order[lane] + 1] - lines.column_starts[order[lane]]);
+                }
+                result += width * kSliceHeight;
+            }
+            return result;
+        }
+    }
+
+    MatrixOperator::MatrixOperator(CscMatrix matrix, const MatrixOperatorOptions& options)
+        : options_(options), num_rows_(matrix.num_rows), num_cols_(matrix.num_cols)
+    {
+        for (const double value : matrix.values)
+        {
+            max_abs_value_ = std::max(max_abs_value_, std::abs(value));
+        }
+        // The row-wise copy is built and, if sliced, freed before the column-wise one is touched.
+        row_kernel_ = build_kernel(matrix.transpose());
+        column_kernel_ = build_kernel(std::move(matrix));
+    }
+
+    MatrixFormat MatrixOperator::choose_format(const CscMatrix& lines) const
+    {
+        if (options_.format != MatrixFormat::kAutomatic)
+        {
+            return options_.format;
+        }
+        const int64_t non_zeros = lines.num_non_zeros();
+        if (non_zeros == 0)
+        {
+            return MatrixFormat::kCompressed;
+        }
+
+        int64_t max_length = 0;
+        for (int64_t j = 0; j < lines.num_cols; j++)
+        {
+            max_length = std::max(max_length, lines.column_starts[j + 1] - lines.column_starts[j]);
+        }
+        if (max_length > std::max<int64_t>(1, options_.min_block_non_zeros))
+        {
+            return MatrixFormat::kMergePath;
+        }
+
+        const std::vector<int64_t> order = slice_order(lines, options_.sorting_window);
+        const auto efficiency = static_cast<double>(non_zeros) / static_cast<double>(padded_size(lines, order));
+        return efficiency >= options_.min_slice_efficiency ? MatrixFormat::kSlicedEllpack : MatrixFormat::kCompressed;
+    }
+
+    MatrixOperator::Kernel MatrixOperator::build_kernel(CscMatrix lines) const
+    {
+        Kernel kernel;
+        kernel.format = choose_format(lines);
+        switch (kernel.format)
+        {
+        case MatrixFormat::kSlicedEllpack:
+            {
+                build_slices(lines, kernel);
+                break;
+            }
+
+        case MatrixFormat::kMergePath:
+            {
+                // Every piece of the path covers at least a block worth of line ends and non-zeros.
+                // The pieces depend only on the matrix, so that partial sums are always added alike.
+                const int64_t path_length = lines.num_cols + lines.num_non_zeros();
+                const int64_t piece = std::max<int64_t>(1, options_.min_block_non_zeros);
+                kernel.num_chunks = std::max<int64_t>(1, (path_length + piece - 1) / piece);
+                kernel.lines = std::move(lines);
+                break;
+            }
+
+        default:
+            {
+                kernel.format = MatrixFormat::kCompressed;
+                kernel.blocks = partition(lines.column_starts, lines.num_cols);
+                kernel.lines = std::move(lines);
+                break;
+            }
+        }
+        return kernel;
+    }
+
+    void MatrixOperator::build_slices(const CscMatrix& lines, Kernel& kernel) const
+    {
+        const std::vector<int64_t> order = slice_order(lines, options_.sorting_window);
+        const int64_t num_slices = (lines.num_cols + kSliceHeight - 1) / kSliceHeight;
+        kernel.lane_lines.assign(num_slices * kSliceHeight, -1);
+        std::ranges::copy(order, kernel.lane_lines.begin());
+
+        kernel.slice_starts.assign(num_slices + 1, 0);
+        for (int64_t s = 0; s < num_slices; s++)
+        {
+            int64_t width = 0;
+            for (int64_t lane = s * kSliceHeight; lane < std::min((s + 1) * kSliceHeight, lines.num_cols); lane++)
+            {
+                const int64_t line = order[lane];
+                width = std::max(width, lines.column_starts[line + 1] - lines.column_starts[line]);
+            }
+            kernel.slice_starts[s + 1] = kernel.slice_starts[s] + width * kSliceHeight;
+        }
+
+        // Padding multiplies zero with the first input entry, which keeps the loads in bounds.
+        kernel.slice_indices.assign(kernel.slice_starts[num_slices], 0);
+        kernel.slice_values.assign(kernel.slice_starts[num_slices], 0.0);
+        for (int64_t lane = 0; lane < lines.num_cols; lane++)
+        {
+            const int64_t line = order[lane];
+            const int64_t base = kernel.slice_starts[lane / kSliceHeight] + lane % kSliceHeight;
+            for (int64_t k = lines.column_starts[line]; k < lines.column_starts[line + 1]; k++)
+            {
+                const int64_t position = base + (k - lines.column_starts[line]) * kSliceHeight;
+                kernel.slice_indices[position] = lines.row_indices[k];
+                kernel.slice_values[position] = lines.values[k];
+            }
+        }
+        kernel.blocks = partition(kernel.slice_starts, num_slices);
+    }
+
+    std::vector<int64_t> MatrixOperator::partition(const std::span<const int64_t> starts, const int64_t count) const
+    {
+        const int64_t non_zeros = starts[count];
+        int64_t num_blocks = 1;
+        if (options_.scheduler != nullptr)
+        {
+            // A few blocks per thread, so that stealing can even out lines of different cost.
+            num_blocks = std::min<int64_t>(4 * static_cast<int64_t>(options_.scheduler->num_threads()),
+                                           non_zeros / std::max<int64_t>(1, options_.min_block_non_zeros));
+            num_blocks = std::max<int64_t>(1, num_blocks);
+        }
+
+        std::vector<int64_t> blocks = {0};
+        for (int64_t b = 1; b < num_blocks; b++)
+        {
+            // The first line that starts at or after the b-th share of the non-zeros.
+            const int64_t target = non_zeros * b / num_blocks;
+            const auto it = std::lower_bound(starts.begin() + blocks.back(), starts.begin() + count, target);
+            const auto line = static_cast<int64_t>(it - starts.begin());
+            if (line > blocks.back())
+            {
+                blocks.push_back(line);
+            }
+        }
+        if (count > blocks.back() || blocks.size() == 1)
+        {
+            blocks.push_back(count);
+        }
+        return blocks;
+    }
+
+    template <typename Body>
+    void MatrixOperator::run_blocks(const int64_t num_blocks, const Body& body) const
+    {
+        parallel_for(options_.scheduler, 0, num_blocks, 1, body);
+    }
+
+    void MatrixOperator::multiply_lines(const Kernel& kernel, const std::span<const double> x,
+                                        const std::span<double> result) const
+    {
+        switch (kernel.format)
+        {
+        case MatrixFormat::kSlicedEllpack:
+            {
+                multiply_sliced(kernel, x.data(), result.data());
+                break;
+            }
+
+        case MatrixFormat::kMergePath:
+            {
+                multiply_merge_path(kernel, x.data(), result.data());
+                break;
+            }
+
+        default:
+            {
+                multiply_compressed(kernel, x.data(), result.data());
+                break;
+            }
+        }
+    }
+
+    void MatrixOperator::multiply_compressed(const Kernel& kernel, const double* input, double* output) const
+    {
+        const CscMatrix& lines = kernel.lines;
+        const int64_t* starts = lines.column_starts.data();
+        const int64_t* indices = lines.row_indices.data();
+        const double* values = lines.values.data();
+        const int64_t* blocks = kernel.blocks.data();
+        run_blocks(static_cast<int64_t>(kernel.blocks.size()) - 1, [&](const int64_t b)
+        {
+            for (int64_t line = blocks[b]; line < blocks[b + 1]; line++)
+            {
+                double sum = 0.0;
+                for (int64_t k = starts[line]; k < starts[line + 1]; k++)
+                {
+                    sum += values[k] * input[indices[k]];
+                }
+                output[line] = sum;
+            }
+        });
+    }
+
+    void MatrixOperator::multiply_sliced(const Kernel& kernel, const double* input, double* output) const
+    {
+        const int64_t* starts = kernel.slice_starts.data();
+        const int64_t* lane_lines = kernel.lane_lines.data();
+        const int64_t* blocks = kernel.blocks.data();
+        run_blocks(static_cast<int64_t>(kernel.blocks.size()) - 1, [&](const int64_t b)
+        {
+            for (int64_t s = blocks[b]; s < blocks[b + 1]; s++)
+            {
+                const int64_t* indices = kernel.slice_indices.data() + starts[s];
+                const double* values = kernel.slice_values.data() + starts[s];
+                const int64_t width = (starts[s + 1] - starts[s]) / kSliceHeight;
+
+                // The lanes are independent, so the inner loop becomes one gather and one
+                // multiply-add per vector register. Every lane still sums in storage order.
+                double sums[kSliceHeight] = {};
+                for (int64_t k = 0; k < width; k++)
+                {
+                    for (int64_t lane = 0; lane < kSliceHeight; lane++)
+                    {
+                        sums[lane] += values[k * kSliceHeight + lane] * input[indices[k * kSliceHeight + lane]];
+                    }
+                }
+                for (int64_t lane = 0; lane < kSliceHeight; lane++)
+                {
+                    const int64_t line = lane_lines[s * kSliceHeight + lane];
+                    if (line >= 0)
+                    {
+                        output[line] = sums[lane];
+                    }
+                }
+            }
+        });
+    }
+
+    void MatrixOperator::multiply_merge_path(const Kernel& kernel, const double* input, double* output) const
+    {
+        const CscMatrix& lines = kernel.lines;
+        const int64_t num_lines = lines.num_cols;
+        const int64_t non_zeros = lines.num_non_zeros();
+        const int64_t* ends = lines.column_starts.data() + 1;
+        const int64_t* indices = lines.row_indices.data();
+        const double* values = lines.values.data();
+        const int64_t path_length = num_lines + non_zeros;
+        const int64_t chunk = (path_length + kernel.num_chunks - 1) / kernel.num_chunks;
+
+        // The path consumes line ends and non-zeros in merged order. Returns the number of lines
+        // and non-zeros consumed after @p diagonal steps.
+        const auto search = [&](const int64_t diagonal)
+        {
+            int64_t low = std::max<int64_t>(0, diagonal - non_zeros);
+            int64_t high = std::min(diagonal, num_lines);
+            while (low < high)
+            {
+                const int64_t middle = low + (high - low) / 2;
+                if (ends[middle] <= diagonal - middle - 1)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return std::pair{low, diagonal - low};
+        };
+
+        // Each chunk writes the lines that end within it, and leaves the head of the line it
+        // stops in as a carry.
+        std::vector<int64_t> carry_lines(kernel.num_chunks);
+        std::vector<double> carry_values(kernel.num_chunks);
+        run_blocks(kernel.num_chunks, [&](const int64_t t)
+        {
+            auto [line, k] = search(std::min(t * chunk, path_length));
+            const auto [end_line, end_k] = search(std::min((t + 1) * chunk, path_length));
+            for (; line < end_line; line++)
+            {
+                double sum = 0.0;
+                for (; k < ends[line]; k++)
+                {
+                    sum += values[k] * input[indices[k]];
+                }
+                output[line] = sum;
+            }
+            double sum = 0.0;
+            for (; k < end_k; k++)
+            {
+                sum += values[k] * input[indices[k]];
+            }
+            carry_lines[t] = end_line;
+            carry_values[t] = sum;
+        });
+
+        for (int64_t t = 0; t < kernel.num_chunks; t++)
+        {
+            if (carry_lines[t] < num_lines)
+            {
+                output[carry_lines[t]] += carry_values[t];
+            }
+        }
+    }
+
+    void MatrixOperator::multiply(const std::span<const double> x, const std::span<double> result) const
+    {
+        DCHECK_EQ(static_cast<int64_t>(x.size()), num_cols_);
+        DCHECK_EQ(static_cast<int64_t>(result.size()), num_rows_);
+        multiply_lines(row_kernel_, x, result);
+    }
+
+    void MatrixOperator::multiply_transposed(const std::span<const double> y, const std::span<double> result) const
+    {
+        DCHECK_EQ(static_cast<int64_t>(y.size()), num_rows_);
+        DCHECK_EQ(static_cast<int64_t>(result.size()), num_cols_);
+        multiply_lines(column_kernel_, y, result);
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_MATRIX_OPERATOR_H_
+#define KALIX_LP_MATRIX_OPERATOR_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/base/aligned_allocator.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::lp
+{
+    /// @brief Storage format used by one product of a @ref MatrixOperator.
+    enum class MatrixFormat : int8_t
+    {
+        /// @brief Chosen from the line lengths when the operator is built.
+        kAutomatic,
+
+        /// @brief Compressed lines, split into blocks of about equal numbers of non-zeros.
+        kCompressed,
+
+        /// @brief SELL-C-σ: slices of eight lines, sorted by length within windows and padded to
+        /// the longest line of the slice, stored lane by lane so that the eight dot products run in
+        /// lockstep.
+        kSlicedEllpack,
+
+        /// @brief Compressed lines, split along the merge path of line ends and non-zeros, so that
+        /// every task gets the same amount of work even if a single line holds most non-zeros.
+        kMergePath,
+    };
+
+    /// @brief Options of @ref MatrixOperator.
+    struct MatrixOperatorOptions
+    {
+        /// @brief Scheduler used for the products. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Every parallel task covers at least this many non-zeros.
+        int64_t min_block_non_zeros = int64_t{1} << 14;
+
+        /// @brief Storage format of both products. @ref MatrixFormat::kAutomatic picks one per product.
+        MatrixFormat format = MatrixFormat::kAutomatic;
+
+        /// @brief Number of consecutive lines sorted by length before they are cut into slices.
+        /// Larger windows waste less padding but scatter the results further. Rounded up to a
+        /// multiple of the slice height.
+        int64_t sorting_window = 256;
+
+        /// @brief The automatic choice takes sliced storage only if at least this fraction of the
+        /// padded entries are non-zeros.
+        double min_slice_efficiency = 0.8;
+    };
+
+    /// @brief Parallel sparse matrix-vector products with a matrix and its transpose.
+    ///
+    /// First-order methods spend almost all of their time in @c A*x and @c A^T*y. The operator keeps
+    /// the matrix row-wise for @c A*x and column-wise for @c A^T*y, so that both products are
+    /// computed as one dot product per line of the respective copy. Every result entry is written
+    /// by exactly one task, except for lines cut by the merge path, whose partial sums are added in
+    /// a short serial pass.
+    ///
+    /// Each product picks its own format from the lengths of its lines. If a single line is longer
+    /// than a block, no split along lines can balance the tasks and the merge path is used. If the
+    /// lines are regular enough that sliced storage pads little, the slices let the compiler
+    /// vectorize across eight lines at once. Otherwise, the compressed lines are split into blocks
+    /// of about equal numbers of non-zeros. The choice depends only on the matrix and
+    /// @ref MatrixOperatorOptions::min_block_non_zeros, and every line is summed in an order fixed
+    /// when the operator is built, so the results do not depend on the number of threads.
+    ///
+    /// Every product stores its lines once, in the format it uses: a sliced product keeps only its
+    /// slices and frees the compressed lines they were built from. The operator thus holds two
+    /// copies of the matrix, at 16 bytes per stored entry plus one index per line, and sliced
+    /// storage adds its padding of at most @c 1/min_slice_efficiency - 1 of the non-zeros under
+    /// the automatic choice. While a product is built, its compressed lines and its slices exist
+    /// at the same time, so the peak during construction is one copy higher.
+    ///
+    /// Sliced storage pads with zeros that multiply the first input entry, so the input vectors of
+    /// a sliced product must be finite.
+    class MatrixOperator
+    {
+    public:
+        /// @brief Takes ownership of @p matrix and builds the storage of both products from it.
+        explicit MatrixOperator(CscMatrix matrix, const MatrixOperatorOptions& options = {});
+
+        /// @brief Returns the number of rows.
+        [[nodiscard]] int64_t num_rows() const
+        {
+            return num_rows_;
+        }
+
+        /// @brief Returns the number of columns.
+        [[nodiscard]] int64_t num_cols() const
+        {
+            return num_cols_;
+        }
+
+        /// @brief Returns the largest absolute value of an entry of the matrix.
+        [[nodiscard]] double max_abs_value() const
+        {
+            return max_abs_value_;
+        }
+
+        /// @brief Returns the number of entries stored by both products together, padding of the
+        /// slices included.
+        [[nodiscard]] int64_t num_stored_entries() const
+        {
+            return row_kernel_.num_stored_entries() + column_kernel_.num_stored_entries();
+        }
+
+        /// @brief Returns the format used by @ref multiply.
+        [[nodiscard]] MatrixFormat row_format() const
+        {
+            return row_kernel_.format;
+        }
+
+        /// @brief Returns the format used by @ref multiply_transposed.
+        [[nodiscard]] MatrixFormat column_format() const
+        {
+            return column_kernel_.format;
+        }
+
+        /// @brief Computes @c result = A*x.
+        void multiply(std::span<const double> x, std::span<double> result) const;
+
+        /// @brief Computes @c result = A^T*y.
+        void multiply_transposed(std::span<const double> y, std::span<double> result) const;
+
+    private:
+        // Everything one product needs.
+        struct Kernel
+        {
+            MatrixFormat format = MatrixFormat::kCompressed;
+
+            // Compressed and merge path: the lines whose dot products form the result. Empty for
+            // sliced storage, which replaces them.
+            CscMatrix lines;
+
+            // Compressed: block b covers the lines [blocks[b], blocks[b + 1]).
+            // Sliced: block b covers the slices [blocks[b], blocks[b + 1]).
+            std::vector<int64_t> blocks;
+
+            // Merge path: number of equally long pieces of the path.
+            int64_t num_chunks = 0;
+
+            // Sliced: the line stored in every lane, -1 for lanes past the last line, and the
+            // lane-major entries of slice s in [slice_starts[s], slice_starts[s + 1]).
+            std::vector<int64_t> lane_lines;
+            std::vector<int64_t> slice_starts;
+            AlignedVector<int64_t> slice_indices;
+            AlignedVector<double> slice_values;
+
+            [[nodiscard]] int64_t num_stored_entries() const
+            {
+                return lines.num_non_zeros() + static_cast<int64_t>(slice_values.size());
+            }
+        };
+
+        [[nodiscard]] Kernel build_kernel(CscMatrix lines) const;
+        [[nodiscard]] MatrixFormat choose_format(const CscMatrix& lines) const;
+        [[nodiscard]] std::vector<int64_t> partition(std::span<const int64_t> starts, int64_t count) const;
+        void build_slices(const CscMatrix& lines, Kernel& kernel) const;
+
+        template <typename Body>
+        void run_blocks(int64_t num_blocks, const Body& body) const;
+
+        void multiply_lines(const Kernel& kernel, std::span<const double> x, std::span<double> result) const;
+        void multiply_compressed(const Kernel& kernel, const double* input, double* output) const;
+        void multiply_sliced(const Kernel& kernel, const double* input, double* output) const;
+        void multiply_merge_path(const Kernel& kernel, const double* input, double* output) const;
+
+        MatrixOperatorOptions options_;
+        int64_t num_rows_ = 0;
+        int64_t num_cols_ = 0;
+        double max_abs_value_ = 0.0;
+        Kernel row_kernel_;
+        Kernel column_kernel_;
+    };
+}
+
+#endif // KALIX_LP_MATRIX_OPERATOR_H_
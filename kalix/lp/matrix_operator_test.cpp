@@ -0,0 +1,277 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/matrix_operator.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::lp
+{
+    namespace
+    {
+        /// A random matrix with one dense row and one dense column, so that the lines differ in
+        /// length by orders of magnitude.
+        CscMatrix skewed_matrix(std::mt19937& rng, const int64_t num_rows, const int64_t num_cols)
+        {
+            std::uniform_real_distribution<double> value(-1.0, 1.0);
+            std::bernoulli_distribution keep(0.02);
+            CscMatrix matrix;
+            matrix.num_rows = num_rows;
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                std::vector<int64_t> indices;
+                std::vector<double> values;
+                for (int64_t i = 0; i < num_rows; i++)
+                {
+                    if (i == 0 || j == 0 || keep(rng))
+                    {
+                        indices.push_back(i);
+                        values.push_back(value(rng));
+                    }
+                }
+                matrix.append_column(indices, values);
+            }
+            return matrix;
+        }
+
+        /// A matrix whose column j has the given number of entries in consecutive rows.
+        CscMatrix matrix_with_lengths(const std::vector<int64_t>& lengths, const int64_t num_rows)
+        {
+            CscMatrix matrix;
+            matrix.num_rows = num_rows;
+            for (size_t j = 0; j < lengths.size(); j++)
+            {
+                std::vector<int64_t> indices;
+                std::vector<double> values;
+                for (int64_t t = 0; t < lengths[j]; t++)
+                {
+                    indices.push_back((static_cast<int64_t>(j) + t) % num_rows);
+                    values.push_back(1.0 + static_cast<double>(t));
+                }
+                matrix.append_column(indices, values);
+            }
+            return matrix;
+        }
+
+        std::vector<double> random_vector(std::mt19937& rng, const int64_t size)
+        {
+            std::uniform_real_distribution<double> value(-1.0, 1.0);
+            std::vector<double> result(size);
+            for (double& entry : result)
+            {
+                entry = value(rng);
+            }
+            return result;
+        }
+    }
+
+    TEST(MatrixOperatorTest, MatchesColumnWiseProducts)
+    {
+        std::mt19937 rng(1);
+        const CscMatrix matrix = skewed_matrix(rng, 70, 90);
+        const MatrixOperator op(matrix);
+        EXPECT_EQ(op.num_rows(), 70);
+        EXPECT_EQ(op.num_cols(), 90);
+
+        const std::vector<double> x = random_vector(rng, 90);
+        const std::vector<double> y = random_vector(rng, 70);
+        std::vector<double> expected_ax(70, 0.0);
+        std::vector<double> expected_aty(90, 0.0);
+        for (int64_t j = 0; j < 90; j++)
+        {
+            const auto indices = matrix.column_indices(j);
+            const auto values = matrix.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                expected_ax[indices[t]] += values[t] * x[j];
+                expected_aty[j] += values[t] * y[indices[t]];
+            }
+        }
+
+        std::vector<double> ax(70, -1.0);
+        std::vector<double> aty(90, -1.0);
+        op.multiply(x, ax);
+        op.multiply_transposed(y, aty);
+        for (int64_t i = 0; i < 70; i++)
+        {
+            EXPECT_NEAR(ax[i], expected_ax[i], 1e-12);
+        }
+        for (int64_t j = 0; j < 90; j++)
+        {
+            EXPECT_EQ(aty[j], expected_aty[j]);
+        }
+    }
+
+    TEST(MatrixOperatorTest, HandlesEmptyLines)
+    {
+        CscMatrix matrix;
+        matrix.num_rows = 3;
+        matrix.append_column(std::vector<int64_t>{}, std::vector<double>{});
+        matrix.append_column(std::vector<int64_t>{2}, std::vector<double>{4.0});
+        const MatrixOperator op(matrix);
+
+        std::vector<double> ax(3, -1.0);
+        op.multiply(std::vector<double>{5.0, 0.5}, ax);
+        EXPECT_EQ(ax, (std::vector<double>{0.0, 0.0, 2.0}));
+        std::vector<double> aty(2, -1.0);
+        op.multiply_transposed(std::vector<double>{1.0, 1.0, 1.0}, aty);
+        EXPECT_EQ(aty, (std::vector<double>{0.0, 4.0}));
+
+        const MatrixOperator empty{CscMatrix()};
+        std::vector<double> none;
+        empty.multiply(none, none);
+        empty.multiply_transposed(none, none);
+    }
+
+    TEST(MatrixOperatorTest, EveryFormatMatchesReference)
+    {
+        std::mt19937 rng(3);
+        const CscMatrix matrix = skewed_matrix(rng, 150, 230);
+        const std::vector<double> x = random_vector(rng, 230);
+        const std::vector<double> y = random_vector(rng, 150);
+        const MatrixOperator reference(matrix, {.format = MatrixFormat::kCompressed});
+        std::vector<double> expected_ax(150);
+        std::vector<double> expected_aty(230);
+        reference.multiply(x, expected_ax);
+        reference.multiply_transposed(y, expected_aty);
+
+        TaskScheduler scheduler({.num_threads = 4});
+        for (const MatrixFormat format : {MatrixFormat::kSlicedEllpack, MatrixFormat::kMergePath})
+        {
+            // Small blocks cut the dense row and column into many pieces of the merge path.
+            const MatrixOperator op(matrix, {.scheduler = &scheduler, .min_block_non_zeros = 16, .format = format});
+            EXPECT_EQ(op.row_format(), format);
+            EXPECT_EQ(op.column_format(), format);
+
+            std::vector<double> ax(150, -1.0);
+            std::vector<double> aty(230, -1.0);
+            op.multiply(x, ax);
+            op.multiply_transposed(y, aty);
+            for (int64_t i = 0; i < 150; i++)
+            {
+                EXPECT_NEAR(ax[i], expected_ax[i], 1e-12);
+            }
+            for (int64_t j = 0; j < 230; j++)
+            {
+                EXPECT_NEAR(aty[j], expected_aty[j], 1e-12);
+            }
+        }
+    }
+
+    TEST(MatrixOperatorTest, SlicedProductsEqualCompressedProducts)
+    {
+        // Every lane sums its line in storage order, so slicing does not change a single bit.
+        std::mt19937 rng(4);
+        const CscMatrix matrix = skewed_matrix(rng, 61, 77);
+        const MatrixOperator compressed(matrix, {.format = MatrixFormat::kCompressed});
+        const MatrixOperator sliced(matrix, {.format = MatrixFormat::kSlicedEllpack, .sorting_window = 16});
+
+        const std::vector<double> x = random_vector(rng, 77);
+        std::vector<double> compressed_ax(61);
+        std::vector<double> sliced_ax(61);
+        compressed.multiply(x, compressed_ax);
+        sliced.multiply(x, sliced_ax);
+        EXPECT_EQ(sliced_ax, compressed_ax);
+    }
+
+    TEST(MatrixOperatorTest, ChoosesFormatFromLineLengths)
+    {
+        // Five entries per column and row: slices need no padding.
+        const MatrixOperator regular(matrix_with_lengths(std::vector<int64_t>(100, 5), 100));
+        EXPECT_EQ(regular.row_format(), MatrixFormat::kSlicedEllpack);
+        EXPECT_EQ(regular.column_format(), MatrixFormat::kSlicedEllpack);
+
+        // A column longer than a block cannot be balanced by whole lines.
+        std::vector<int64_t> lengths(100, 2);
+        lengths[7] = 100;
+        const MatrixOperator skewed(matrix_with_lengths(lengths, 100), {.min_block_non_zeros = 64});
+        EXPECT_EQ(skewed.column_format(), MatrixFormat::kMergePath);
+        EXPECT_EQ(skewed.row_format(), MatrixFormat::kSlicedEllpack);
+
+        // Alternating short and long columns pad a lot unless sorting may group them.
+        std::vector<int64_t> alternating(96);
+        for (size_t j = 0; j < alternating.size(); j++)
+        {
+            alternating[j] = j % 2 == 0 ? 1 : 40;
+        }
+        const MatrixOperator unsorted(matrix_with_lengths(alternating, 100), {.sorting_window = 8});
+        EXPECT_EQ(unsorted.column_format(), MatrixFormat::kCompressed);
+        const MatrixOperator sorted(matrix_with_lengths(alternating, 100), {.sorting_window = 16});
+        EXPECT_EQ(sorted.column_format(), MatrixFormat::kSlicedEllpack);
+
+        const MatrixOperator empty{CscMatrix()};
+        EXPECT_EQ(empty.row_format(), MatrixFormat::kCompressed);
+    }
+
+    TEST(MatrixOperatorTest, StoresEveryProductOnce)
+    {
+        // Without padding, sliced storage replaces the compressed lines entry for entry.
+        const CscMatrix regular = matrix_with_lengths(std::vector<int64_t>(96, 5), 96);
+        const MatrixOperator sliced(regular, {.format = MatrixFormat::kSlicedEllpack});
+        EXPECT_EQ(sliced.num_stored_entries(), 2 * regular.num_non_zeros());
+        const MatrixOperator compressed(regular, {.format = MatrixFormat::kCompressed});
+        EXPECT_EQ(compressed.num_stored_entries(), 2 * regular.num_non_zeros());
+        EXPECT_EQ(sliced.max_abs_value(), 5.0);
+
+        std::mt19937 rng(5);
+        const CscMatrix skewed = skewed_matrix(rng, 40, 60);
+        const MatrixOperator padded(skewed, {.format = MatrixFormat::kSlicedEllpack});
+        EXPECT_GT(padded.num_stored_entries(), 2 * skewed.num_non_zeros());
+        EXPECT_LE(padded.num_stored_entries(), 2 * 40 * 64);
+    }
+
+    class MatrixOperatorThreadTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(MatrixOperatorThreadTest, MatchesSerialProducts)
+    {
+        std::mt19937 rng(2);
+        const CscMatrix matrix = skewed_matrix(rng, 300, 500);
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        MatrixOperatorOptions options;
+        options.scheduler = &scheduler;
+        options.min_block_non_zeros = 64;
+        const MatrixOperator parallel(matrix, options);
+        MatrixOperatorOptions serial_options = options;
+        serial_options.scheduler = nullptr;
+        const MatrixOperator serial(matrix, serial_options);
+
+        const std::vector<double> x = random_vector(rng, 500);
+        const std::vector<double> y = random_vector(rng, 300);
+        std::vector<double> parallel_ax(300);
+        std::vector<double> serial_ax(300);
+        parallel.multiply(x, parallel_ax);
+        serial.multiply(x, serial_ax);
+        EXPECT_EQ(parallel_ax, serial_ax);
+
+        std::vector<double> parallel_aty(500);
+        std::vector<double> serial_aty(500);
+        parallel.multiply_transposed(y, parallel_aty);
+        serial.multiply_transposed(y, serial_aty);
+        EXPECT_EQ(parallel_aty, serial_aty);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, MatrixOperatorThreadTest, ::testing::Values(1, 4));
+}
@@ -0,0 +1,1080 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/ordering.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+namespace kalix::lp
+{
+    namespace
+    {
+        constexpr int32_t kMaxIndex = std::numeric_limits<int32_t>::max();
+
+        /// @brief Sorts the neighbors of every vertex, removes duplicates and compacts the arrays.
+        void normalize(AdjacencyGraph& graph)
+        {
+            const int32_t n = graph.num_vertices();
+            int32_t position = 0;
+            int32_t begin = 0;
+            for (int32_t v = 0; v < n; v++)
+            {
+                const int32_t end = graph.offsets[v + 1];
+                std::sort(graph.neighbors.begin() + begin, graph.neighbors.begin() + end);
+                graph.offsets[v] = position;
+                for (int32_t p = begin; p < end; p++)
+                {
+                    if (p == begin || graph.neighbors[p] != graph.neighbors[p - 1])
+                    {
+                        graph.neighbors[position++] = graph.neighbors[p];
+                    }
+                }
+                begin = end;
+            }
+            graph.offsets[n] = position;
+            graph.neighbors.resize(position);
+        }
+
+        /// @brief Encodes a node index as a negative number and back. The minimum degree ordering
+        /// uses this to store the parent of absorbed elements and merged variables in place.
+        KALIX_FORCE_INLINE int32_t flip(const int32_t i)
+        {
+            return -i - 2;
+        }
+
+        /// @brief Resets the marks if @p mark + @p max_element could overflow. Returns the new mark.
+        int32_t clear_marks(const int64_t mark, const int32_t max_element, std::vector<int32_t>& marks)
+        {
+            if (mark < 2 || mark + max_element >= kMaxIndex)
+            {
+                for (int32_t& value : marks)
+                {
+                    if (value != 0)
+                    {
+                        value = 1;
+                    }
+                }
+                return 2;
+            }
+            return static_cast<int32_t>(mark);
+        }
+
+        /// @brief Appends the nodes of the tree rooted at @p root in postorder to @p order, given
+        /// the children as linked lists. Consumes the lists.
+        void append_postorder(const int32_t root, std::vector<int32_t>& head, const std::vector<int32_t>& next,
+                              std::vector<int32_t>& stack, std::vector<int32_t>& order)
+        {
+            stack.assign(1, root);
+            while (!stack.empty())
+            {
+                const int32_t node = stack.back();
+                if (const int32_t child = head[node]; child != -1)
+                {
+                    head[node] = next[child];
+                    stack.push_back(child);
+                }
+                else
+                {
+                    stack.pop_back();
+                    order.push_back(node);
+                }
+            }
+        }
+
+        /// @brief A graph with vertex and edge weights, as produced by coarsening.
+        struct WeightedGraph
+        {
+            /// @brief The graph.
+            AdjacencyGraph graph;
+
+            /// @brief Weight of every vertex: the number of original vertices it represents.
+            std::vector<int32_t> vertex_weights;
+
+            /// @brief Weight of every neighbor entry: the number of original edges it represents.
+            std::vector<int32_t> edge_weights;
+
+            /// @brief Sum of the vertex weights.
+            int64_t total_weight = 0;
+        };
+
+        /// @brief Returns the vertices sorted by increasing degree, ties by index.
+        std::vector<int32_t> by_degree(const AdjacencyGraph& graph)
+        {
+            const int32_t n = graph.num_vertices();
+            std::vector<int32_t> starts(n + 1, 0);
+            for (int32_t v = 0; v < n; v++)
+            {
+                starts[graph.degree(v)]++;
+            }
+            std::exclusive_scan(starts.begin(), starts.end(), starts.begin(), 0);
+            std::vector<int32_t> order(n);
+            for (int32_t v = 0; v < n; v++)
+            {
+                order[starts[graph.degree(v)]++] = v;
+            }
+            return order;
+        }
+
+        /// @brief Contracts a heavy-edge matching of @p fine.
+        ///
+        /// @param fine The graph to coarsen.
+        /// @param coarse_map Receives the coarse vertex of every fine vertex.
+        /// @return The coarse graph.
+        WeightedGraph coarsen(const WeightedGraph& fine, std::vector<int32_t>& coarse_map)
+        {
+            const AdjacencyGraph& graph = fine.graph;
+            const int32_t n = graph.num_vertices();
+
+            // Low-degree vertices are matched first, they have the fewest candidates.
+            const std::vector<int32_t> order = by_degree(graph);
+            std::vector<int32_t> match(n, -1);
+            for (const int32_t v : order)
+            {
+                if (match[v] != -1)
+                {
+                    continue;
+                }
+                int32_t best = v;
+                int32_t best_weight = -1;
+                for (int32_t p = graph.offsets[v]; p < graph.offsets[v + 1]; p++)
+                {
+                    const int32_t u = graph.neighbors[p];
+                    if (match[u] == -1 && fine.edge_weights[p] > best_weight)
+                    {
+                        best = u;
+                        best_weight = fine.edge_weights[p];
+                    }
+                }
+                match[v] = best;
+                match[best] = v;
+            }
+
+            coarse_map.assign(n, -1);
+            std::vector<int32_t> representatives;
+            for (const int32_t v : order)
+            {
+                if (coarse_map[v] == -1)
+                {
+                    coarse_map[v] = static_cast<int32_t>(representatives.size());
+                    coarse_map[match[v]] = coarse_map[v];
+                    representatives.push_back(v);
+                }
+            }
+
+            const auto num_coarse = static_cast<int32_t>(representatives.size());
+            WeightedGraph coarse;
+            coarse.total_weight = fine.total_weight;
+            coarse.vertex_weights.resize(num_coarse);
+            coarse.graph.offsets.reserve(num_coarse + 1);
+            std::vector<int32_t> slot(num_coarse, -1);
+            std::vector<std::pair<int32_t, int32_t>> entries;
+            for (int32_t c = 0; c < num_coarse; c++)
+            {
+                const int32_t v = representatives[c];
+                const int32_t members[] = {v, match[v]};
+                entries.clear();
+                coarse.vertex_weights[c] = fine.vertex_weights[v];
+                if (match[v] != v)
+                {
+                    coarse.vertex_weights[c] += fine.vertex_weights[match[v]];
+                }
+                for (int32_t m = 0; m < (match[v] == v ? 1 : 2); m++)
+                {
+                    const int32_t member = members[m];
+                    for (int32_t p = graph.offsets[member]; p < graph.offsets[member + 1]; p++)
+                    {
+                        const int32_t target = coarse_map[graph.neighbors[p]];
+                        if (target == c)
+                        {
+                            continue;
+                        }
+                        if (slot[target] == -1)
+                        {
+                            slot[target] = static_cast<int32_t>(entries.size());
+                            entries.emplace_back(target, 0);
+                        }
+                        entries[slot[target]].second += fine.edge_weights[p];
+                    }
+                }
+                std::ranges::sort(entries);
+                for (const auto& [target, weight] : entries)
+                {
+                    slot[target] = -1;
+                    coarse.graph.neighbors.push_back(target);
+                    coarse.edge_weights.push_back(weight);
+                }
+                coarse.graph.offsets.push_back(static_cast<int32_t>(coarse.graph.neighbors.size()));
+            }
+            return coarse;
+        }
+
+        /// @brief Returns the total weight of the edges between the two sides.
+        int64_t cut_weight(const WeightedGraph& weighted, const std::vector<int8_t>& side)
+        {
+            const AdjacencyGraph& graph = weighted.graph;
+            int64_t cut = 0;
+            for (int32_t v = 0; v < graph.num_vertices(); v++)
+            {
+                for (int32_t p = graph.offsets[v]; p < graph.offsets[v + 1]; p++)
+                {
+                    if (side[graph.neighbors[p]] != side[v])
+                    {
+                        cut += weighted.edge_weights[p];
+                    }
+                }
+            }
+            return cut / 2;
+        }
+
+        /// @brief Returns the vertex visited last by a breadth-first search from @p source, a cheap
+        /// approximation of a vertex far away from it.
+        int32_t farthest_vertex(const AdjacencyGraph& graph, const int32_t source)
+        {
+            std::vector<int32_t> queue = {source};
+            std::vector<bool> visited(graph.num_vertices(), false);
+            visited[source] = true;
+            for (size_t head = 0; head < queue.size(); head++)
+            {
+                for (const int32_t u : graph.adjacent(queue[head]))
+                {
+                    if (!visited[u])
+                    {
+                        visited[u] = true;
+                        queue.push_back(u);
+                    }
+                }
+            }
+            return queue.back();
+        }
+
+        /// @brief Grows side 0 by breadth-first search from @p seed until it holds half the weight.
+        std::vector<int8_t> grow_bisection(const WeightedGraph& weighted, const int32_t seed)
+        {
+            const AdjacencyGraph& graph = weighted.graph;
+            const int32_t n = graph.num_vertices();
+            std::vector<int8_t> side(n, 1);
+            std::vector<bool> visited(n, false);
+            std::vector<int32_t> queue = {seed};
+            visited[seed] = true;
+            size_t head = 0;
+            int32_t next_unvisited = 0;
+            int64_t weight = 0;
+            while (2 * weight < weighted.total_weight)
+            {
+                if (head == queue.size())
+                {
+                    // The component is exhausted, continue with another one.
+                    while (next_unvisited < n && visited[next_unvisited])
+                    {
+                        next_unvisited++;
+                    }
+                    if (next_unvisited == n)
+                    {
+                        break;
+                    }
+                    visited[next_unvisited] = true;
+                    queue.push_back(next_unvisited);
+                }
+                const int32_t v = queue[head++];
+                side[v] = 0;
+                weight += weighted.vertex_weights[v];
+                for (const int32_t u : graph.adjacent(v))
+                {
+                    if (!visited[u])
+                    {
+                        visited[u] = true;
+                        queue.push_back(u);
+                    }
+                }
+            }
+            return side;
+        }
+
+        /// @brief Improves a bisection with Fiduccia-Mattheyses passes.
+        ///
+        /// Every pass moves boundary vertices one at a time, highest gain first and each vertex at
+        /// most once, even if the cut gets worse, and then rolls back to the best state seen. States
+        /// are compared by the overweight of the heavier side, then by the cut, then by the balance.
+        void refine(const WeightedGraph& weighted, std::vector<int8_t>& side, const int64_t max_part_weight)
+        {
+            constexpr int kMaxPasses = 8;
+            const AdjacencyGraph& graph = weighted.graph;
+            const int32_t n = graph.num_vertices();
+            // Number of moves without improvement after which a pass gives up.
+            const int32_t max_fruitless_moves = std::max(25, n / 100);
+
+            int64_t part_weights[2] = {0, 0};
+            for (int32_t v = 0; v < n; v++)
+            {
+                part_weights[side[v]] += weighted.vertex_weights[v];
+            }
+            const auto score = [&](const int64_t cut)
+            {
+                const int64_t heavier = std::max(part_weights[0], part_weights[1]);
+                return std::tuple(std::max<int64_t>(0, heavier - max_part_weight), cut,
+                                  std::abs(part_weights[0] - part_weights[1]));
+            };
+
+            std::vector<int64_t> gains(n);
+            std::vector<bool> locked(n);
+            std::vector<int32_t> moves;
+            std::priority_queue<std::pair<int64_t, int32_t>> queue;
+            for (int pass = 0; pass < kMaxPasses; pass++)
+            {
+                for (int32_t v = 0; v < n; v++)
+                {
+                    int64_t gain = 0;
+                    bool boundary = false;
+                    for (int32_t p = graph.offsets[v]; p < graph.offsets[v + 1]; p++)
+                    {
+                        const bool external = side[graph.neighbors[p]] != side[v];
+                        gain += external ? weighted.edge_weights[p] : -weighted.edge_weights[p];
+                        boundary |= external;
+                    }
+                    gains[v] = gain;
+                    if (boundary)
+                    {
+                        queue.emplace(gain, v);
+                    }
+                }
+                std::fill(locked.begin(), locked.end(), false);
+                moves.clear();
+
+                int64_t cut_change = 0;
+                auto best = score(0);
+                size_t best_moves = 0;
+                while (!queue.empty() && moves.size() - best_moves < static_cast<size_t>(max_fruitless_moves))
+                {
+                    const auto [gain, v] = queue.top();
+                    queue.pop();
+                    const int from = side[v];
+                    const int to = 1 - from;
+                    const int32_t weight = weighted.vertex_weights[v];
+                    if (locked[v] || gain != gains[v] || part_weights[to] + weight > max_part_weight)
+                    {
+                        continue;
+                    }
+                    side[v] = static_cast<int8_t>(to);
+                    locked[v] = true;
+                    part_weights[from] -= weight;
+                    part_weights[to] += weight;
+                    cut_change -= gain;
+                    moves.push_back(v);
+                    for (int32_t p = graph.offsets[v]; p < graph.offsets[v + 1]; p++)
+                    {
+                        const int32_t u = graph.neighbors[p];
+                        gains[u] += side[u] == to ? -2 * weighted.edge_weights[p] : 2 * weighted.edge_weights[p];
+                        if (!locked[u])
+                        {
+                            queue.emplace(gains[u], u);
+                        }
+                    }
+                    if (const auto current = score(cut_change); current < best)
+                    {
+                        best = current;
+                        best_moves = moves.size();
+                    }
+                }
+                queue = {};
+
+                for (size_t m = moves.size(); m-- > best_moves;)
+                {
+                    const int32_t v = moves[m];
+                    part_weights[side[v]] -= weighted.vertex_weights[v];
+                    side[v] = static_cast<int8_t>(1 - side[v]);
+                    part_weights[side[v]] += weighted.vertex_weights[v];
+                }
+                if (best_moves == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        /// @brief Bisects the coarsest graph: grows from a few seeds and keeps the best refined cut.
+        std::vector<int8_t> initial_bisection(const WeightedGraph& weighted, const int64_t max_part_weight)
+        {
+            const int32_t n = weighted.graph.num_vertices();
+            const int32_t seeds[] = {farthest_vertex(weighted.graph, 0), 0, n / 3, 2 * n / 3};
+            std::vector<int8_t> best;
+            int64_t best_cut = std::numeric_limits<int64_t>::max();
+            for (const int32_t seed : seeds)
+            {
+                std::vector<int8_t> side = grow_bisection(weighted, seed);
+                refine(weighted, side, max_part_weight);
+                if (const int64_t cut = cut_weight(weighted, side); cut < best_cut)
+                {
+                    best_cut = cut;
+                    best = std::move(side);
+                }
+            }
+            return best;
+        }
+
+        /// @brief Computes a vertex separator. Returns 0 or 1 for the two halves and 2 for the
+        /// separator of every vertex.
+        std::vector<int8_t> vertex_separator(const AdjacencyGraph& graph, const NestedDissectionOptions& options)
+        {
+            const int32_t n = graph.num_vertices();
+            std::vector<WeightedGraph> levels(1);
+            levels[0].graph = graph;
+            levels[0].vertex_weights.assign(n, 1);
+            levels[0].edge_weights.assign(graph.neighbors.size(), 1);
+            levels[0].total_weight = n;
+            std::vector<std::vector<int32_t>> coarse_maps;
+
+            // Coarsen until the graph is small or matching stops making progress.
+            while (levels.back().graph.num_vertices() > options.coarsest_size)
+            {
+                std::vector<int32_t> coarse_map;
+                WeightedGraph coarse = coarsen(levels.back(), coarse_map);
+                if (10 * static_cast<int64_t>(coarse.graph.num_vertices()) >
+                    9 * static_cast<int64_t>(levels.back().graph.num_vertices()))
+                {
+                    break;
+                }
+                levels.push_back(std::move(coarse));
+                coarse_maps.push_back(std::move(coarse_map));
+            }
+
+            const auto max_part_weight = static_cast<int64_t>(std::ceil(0.5 * (1.0 + options.imbalance) * n));
+            std::vector<int8_t> side = initial_bisection(levels.back(), max_part_weight);
+            for (size_t level = coarse_maps.size(); level-- > 0;)
+            {
+                const std::vector<int32_t>& coarse_map = coarse_maps[level];
+                std::vector<int8_t> fine(coarse_map.size());
+                for (size_t v = 0; v < coarse_map.size(); v++)
+                {
+                    fine[v] = side[coarse_map[v]];
+                }
+                side = std::move(fine);
+                levels.pop_back();
+                refine(levels.back(), side, max_part_weight);
+            }
+
+            // Every cut edge has an end point on the boundary of either side, so the smaller of
+            // the two boundaries separates the halves.
+            std::vector<int32_t> boundaries[2];
+            for (int32_t v = 0; v < n; v++)
+            {
+                for (const int32_t u : graph.adjacent(v))
+                {
+                    if (side[u] != side[v])
+                    {
+                        boundaries[side[v]].push_back(v);
+                        break;
+                    }
+                }
+            }
+            const int separator_side = boundaries[0].size() <= boundaries[1].size() ? 0 : 1;
+            for (const int32_t v : boundaries[separator_side])
+            {
+                side[v] = 2;
+            }
+            return side;
+        }
+
+        /// @brief Orders @p graph into @p order, writing @c labels[v] for vertex @c v.
+        void dissect(const AdjacencyGraph& graph, const std::span<const int32_t> labels, const std::span<int32_t> order,
+                     const NestedDissectionOptions& options)
+        {
+            const int32_t n = graph.num_vertices();
+            const auto order_leaf = [&]
+            {
+                const std::vector<int32_t> leaf = approximate_minimum_degree(graph);
+                for (int32_t k = 0; k < n; k++)
+                {
+                    order[k] = labels[leaf[k]];
+                }
+            };
+            if (n <= options.leaf_size)
+            {
+                order_leaf();
+                return;
+            }
+
+            const std::vector<int8_t> side = vertex_separator(graph, options);
+            int32_t sizes[3] = {0, 0, 0};
+            std::vector<int32_t> local(n);
+            for (int32_t v = 0; v < n; v++)
+            {
+                local[v] = sizes[side[v]]++;
+            }
+            if (sizes[0] == 0 || sizes[1] == 0)
+            {
+                order_leaf();
+                return;
+            }
+
+            // The induced subgraphs of the two halves. Their vertices keep their relative order,
+            // so the neighbor lists stay sorted.
+            AdjacencyGraph parts[2];
+            std::vector<int32_t> part_labels[2];
+            for (int32_t v = 0; v < n; v++)
+            {
+                const int s = side[v];
+                if (s == 2)
+                {
+                    order[sizes[0] + sizes[1] + local[v]] = labels[v];
+                    continue;
+                }
+                for (const int32_t u : graph.adjacent(v))
+                {
+                    if (side[u] == s)
+                    {
+                        parts[s].neighbors.push_back(local[u]);
+                    }
+                }
+                parts[s].offsets.push_back(static_cast<int32_t>(parts[s].neighbors.size()));
+                part_labels[s].push_back(labels[v]);
+            }
+
+            const auto first = [&]
+            {
+                dissect(parts[0], part_labels[0], order.subspan(0, sizes[0]), options);
+            };
+            const auto second = [&]
+            {
+                dissect(parts[1], part_labels[1], order.subspan(sizes[0], sizes[1]), options);
+            };
+            if (options.scheduler != nullptr && n >= options.min_parallel_size)
+            {
+                options.scheduler->invoke(first, second);
+            }
+            else
+            {
+                first();
+                second();
+            }
+        }
+    }
+
+    AdjacencyGraph AdjacencyGraph::from_symmetric_pattern(const CscMatrixView& matrix)
+    {
+        CHECK_EQ(matrix.num_rows, matrix.num_cols);
+        CHECK_LE(matrix.num_cols, kMaxIndex);
+        CHECK_LE(2 * matrix.num_non_zeros(), kMaxIndex);
+        const auto n = static_cast<int32_t>(matrix.num_cols);
+
+        AdjacencyGraph graph;
+        graph.offsets.assign(n + 1, 0);
+        for (int32_t j = 0; j < n; j++)
+        {
+            for (const int64_t i : matrix.column_indices(j))
+            {
+                if (i != j)
+                {
+                    graph.offsets[i + 1]++;
+                    graph.offsets[j + 1]++;
+                }
+            }
+        }
+        std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+        graph.neighbors.resize(graph.offsets[n]);
+        std::vector<int32_t> next(graph.offsets.begin(), graph.offsets.end() - 1);
+        for (int32_t j = 0; j < n; j++)
+        {
+            for (const int64_t i : matrix.column_indices(j))
+            {
+                if (i != j)
+                {
+                    graph.neighbors[next[i]++] = j;
+                    graph.neighbors[next[j]++] = static_cast<int32_t>(i);
+                }
+            }
+        }
+        normalize(graph);
+        return graph;
+    }
+
+    AdjacencyGraph AdjacencyGraph::from_column_intersections(const CscMatrixView& matrix,
+                                                             const int64_t max_row_length)
+    {
+        CHECK_LE(matrix.num_rows, kMaxIndex);
+        CHECK_LE(matrix.num_cols, kMaxIndex);
+        const auto num_rows = static_cast<int32_t>(matrix.num_rows);
+        const auto n = static_cast<int32_t>(matrix.num_cols);
+
+        // Row-wise copy of the pattern.
+        std::vector<int64_t> row_starts(num_rows + 1, 0);
+        for (int64_t k = 0; k < matrix.num_non_zeros(); k++)
+        {
+            row_starts[matrix.row_indices[k] + 1]++;
+        }
+        std::partial_sum(row_starts.begin(), row_starts.end(), row_starts.begin());
+        std::vector<int32_t> row_columns(matrix.num_non_zeros());
+        std::vector<int64_t> next(row_starts.begin(), row_starts.end() - 1);
+        for (int32_t j = 0; j < n; j++)
+        {
+            for (const int64_t i : matrix.column_indices(j))
+            {
+                row_columns[next[i]++] = j;
+            }
+        }
+
+        AdjacencyGraph graph;
+        graph.offsets.reserve(n + 1);
+        std::vector<int32_t> marker(n, -1);
+        for (int32_t j = 0; j < n; j++)
+        {
+            marker[j] = j;
+            const size_t begin = graph.neighbors.size();
+            for (const int64_t i : matrix.column_indices(j))
+            {
+                if (row_starts[i + 1] - row_starts[i] > max_row_length)
+                {
+                    continue;
+                }
+                for (int64_t k = row_starts[i]; k < row_starts[i + 1]; k++)
+                {
+                    if (const int32_t column = row_columns[k]; marker[column] != j)
+                    {
+                        marker[column] = j;
+                        graph.neighbors.push_back(column);
+                    }
+                }
+            }
+            std::sort(graph.neighbors.begin() + static_cast<int64_t>(begin), graph.neighbors.end());
+            CHECK_LE(graph.neighbors.size(), static_cast<size_t>(kMaxIndex));
+            graph.offsets.push_back(static_cast<int32_t>(graph.neighbors.size()));
+        }
+        return graph;
+    }
+
+    std::vector<int32_t> approximate_minimum_degree(const AdjacencyGraph& graph, const AmdOptions& options)
+    {
+        const int32_t n = graph.num_vertices();
+        if (n == 0)
+        {
+            return {};
+        }
+
+        // The quotient graph lives in one array with elbow room. The list of node i starts at
+        // start[i] and holds length[i] entries: first num_elements[i] elements, then variables.
+        // Node n is a dummy element that absorbs the dense vertices.
+        int32_t used = graph.offsets[n];
+        const int64_t capacity = static_cast<int64_t>(used) + used / 5 + 2 * static_cast<int64_t>(n);
+        CHECK_LE(capacity, kMaxIndex);
+        std::vector<int32_t> index(capacity);
+        std::ranges::copy(graph.neighbors, index.begin());
+        std::vector<int32_t> start(graph.offsets);
+
+        std::vector<int32_t> length(n + 1, 0);
+        for (int32_t i = 0; i < n; i++)
+        {
+            length[i] = graph.degree(i);
+        }
+        // Number of original vertices of a supervariable, negated while it is in the new element.
+        std::vector<int32_t> weight(n + 1, 1);
+        // Doubly linked degree lists, reused as hash buckets during supervariable detection.
+        std::vector<int32_t> next(n + 1, -1);
+        std::vector<int32_t> last(n + 1, -1);
+        std::vector<int32_t> head(n + 1, -1);
+        std::vector<int32_t> hash_head(n + 1, -1);
+        // Number of elements in the list of a variable, -1 for merged variables, -2 for elements.
+        std::vector<int32_t> num_elements(n + 1, 0);
+        // Upper bound on the external degree of a variable, or the size of an element.
+        std::vector<int32_t> degree(length);
+        // Work marks, 0 for dead elements.
+        std::vector<int32_t> marks(n + 1, 1);
+
+        const double dense_threshold = std::max(16.0, options.dense_factor * std::sqrt(static_cast<double>(n)));
+        const auto dense = static_cast<int32_t>(std::min(static_cast<double>(n - 2), dense_threshold));
+        int32_t mark = clear_marks(0, 0, marks);
+        num_elements[n] = -2;
+        start[n] = -1;
+        marks[n] = 0;
+
+        int32_t eliminated = 0;
+        for (int32_t i = 0; i < n; i++)
+        {
+            const int32_t d = degree[i];
+            if (d == 0)
+            {
+                // An isolated vertex is eliminated right away.
+                num_elements[i] = -2;
+                eliminated++;
+                start[i] = -1;
+                marks[i] = 0;
+            }
+            else if (d > dense)
+            {
+                weight[i] = 0;
+                num_elements[i] = -1;
+                eliminated++;
+                start[i] = flip(n);
+                weight[n]++;
+            }
+            else
+            {
+                if (head[d] != -1)
+                {
+                    last[head[d]] = i;
+                }
+                next[i] = head[d];
+                head[d] = i;
+            }
+        }
+
+        int32_t min_degree = 0;
+        int32_t max_element = 0;
+        while (eliminated < n)
+        {
+            // Select a variable of minimum approximate degree.
+            int32_t k = -1;
+            for (; min_degree < n && (k = head[min_degree]) == -1; min_degree++)
+            {
+            }
+            if (next[k] != -1)
+            {
+                last[next[k]] = -1;
+            }
+            head[min_degree] = next[k];
+            const int32_t elements_of_k = num_elements[k];
+            int32_t weight_of_k = weight[k];
+            eliminated += weight_of_k;
+
+            // Compact the lists if the new element might not fit.
+            if (elements_of_k > 0 && static_cast<int64_t>(used) + min_degree >= capacity)
+            {
+                for (int32_t j = 0; j < n; j++)
+                {
+                    if (const int32_t p = start[j]; p >= 0)
+                    {
+                        start[j] = index[p];
+                        index[p] = flip(j);
+                    }
+                }
+                int32_t q = 0;
+                for (int32_t p = 0; p < used;)
+                {
+                    if (const int32_t j = flip(index[p++]); j >= 0)
+                    {
+                        index[q] = start[j];
+                        start[j] = q++;
+                        for (int32_t t = 0; t < length[j] - 1; t++)
+                        {
+                            index[q++] = index[p++];
+                        }
+                    }
+                }
+                used = q;
+            }
+
+            // Construct the new element k from the union of its elements and variables, and
+            // absorb the elements.
+            int32_t element_size = 0;
+            weight[k] = -weight_of_k;
+            int32_t p = start[k];
+            const int32_t element_begin = elements_of_k == 0 ? p : used;
+            int32_t element_end = element_begin;
+            for (int32_t k1 = 1; k1 <= elements_of_k + 1; k1++)
+            {
+                int32_t e;
+                int32_t pj;
+                int32_t list_length;
+                if (k1 > elements_of_k)
+                {
+                    e = k;
+                    pj = p;
+                    list_length = length[k] - elements_of_k;
+                }
+                else
+                {
+                    e = index[p++];
+                    pj = start[e];
+                    list_length = length[e];
+                }
+                for (int32_t k2 = 1; k2 <= list_length; k2++)
+                {
+                    const int32_t i = index[pj++];
+                    const int32_t weight_of_i = weight[i];
+                    if (weight_of_i <= 0)
+                    {
+                        continue;
+                    }
+                    element_size += weight_of_i;
+                    weight[i] = -weight_of_i;
+                    index[element_end++] = i;
+                    if (next[i] != -1)
+                    {
+                        last[next[i]] = last[i];
+                    }
+                    if (last[i] != -1)
+                    {
+                        next[last[i]] = next[i];
+                    }
+                    else
+                    {
+                        head[degree[i]] = next[i];
+                    }
+                }
+                if (e != k)
+                {
+                    start[e] = flip(k);
+                    marks[e] = 0;
+                }
+            }
+            if (elements_of_k != 0)
+            {
+                used = element_end;
+            }
+            degree[k] = element_size;
+            start[k] = element_begin;
+            length[k] = element_end - element_begin;
+            num_elements[k] = -2;
+
+            // For every element e adjacent to a variable of k, compute |Le \ Lk| as
+            // marks[e] - mark.
+            mark = clear_marks(mark, max_element, marks);
+            for (int32_t pk = element_begin; pk < element_end; pk++)
+            {
+                const int32_t i = index[pk];
+                const int32_t elements_of_i = num_elements[i];
+                if (elements_of_i <= 0)
+                {
+                    continue;
+                }
+                const int32_t weight_of_i = -weight[i];
+                const int32_t offset = mark - weight_of_i;
+                for (p = start[i]; p <= start[i] + elements_of_i - 1; p++)
+                {
+                    const int32_t e = index[p];
+                    if (marks[e] >= mark)
+                    {
+                        marks[e] -= weight_of_i;
+                    }
+                    else if (marks[e] != 0)
+                    {
+                        marks[e] = degree[e] + offset;
+                    }
+                }
+            }
+
+            // Update the degree bounds of the variables of k, absorb elements contained in k and
+            // hash the variables by their lists.
+            for (int32_t pk = element_begin; pk < element_end; pk++)
+            {
+                const int32_t i = index[pk];
+                const int32_t p1 = start[i];
+                const int32_t p2 = p1 + num_elements[i] - 1;
+                int32_t pn = p1;
+                int64_t hash = 0;
+                int32_t d = 0;
+                for (p = p1; p <= p2; p++)
+                {
+                    const int32_t e = index[p];
+                    if (marks[e] == 0)
+                    {
+                        continue;
+                    }
+                    if (const int32_t external = marks[e] - mark; external > 0)
+                    {
+                        d += external;
+                        index[pn++] = e;
+                        hash += e;
+                    }
+                    else
+                    {
+                        // Aggressive absorption: e is a subset of k.
+                        start[e] = flip(k);
+                        marks[e] = 0;
+                    }
+                }
+                num_elements[i] = pn - p1 + 1;
+                const int32_t p3 = pn;
+                const int32_t p4 = p1 + length[i];
+                for (p = p2 + 1; p < p4; p++)
+                {
+                    const int32_t j = index[p];
+                    if (const int32_t weight_of_j = weight[j]; weight_of_j > 0)
+                    {
+                        d += weight_of_j;
+                        index[pn++] = j;
+                        hash += j;
+                    }
+                }
+                if (d == 0)
+                {
+                    // Mass elimination: i is adjacent to nothing but k.
+                    start[i] = flip(k);
+                    const int32_t weight_of_i = -weight[i];
+                    element_size -= weight_of_i;
+                    weight_of_k += weight_of_i;
+                    eliminated += weight_of_i;
+                    weight[i] = 0;
+                    num_elements[i] = -1;
+                }
+                else
+                {
+                    degree[i] = std::min(degree[i], d);
+                    // Move the first variable to the end, the first element to the place of the
+                    // variables and put k first.
+                    index[pn] = index[p3];
+                    index[p3] = index[p1];
+                    index[p1] = k;
+                    length[i] = pn - p1 + 1;
+                    const auto bucket = static_cast<int32_t>(hash % n);
+                    next[i] = hash_head[bucket];
+                    hash_head[bucket] = i;
+                    last[i] = bucket;
+                }
+            }
+            degree[k] = element_size;
+            max_element = std::max(max_element, element_size);
+            mark = clear_marks(static_cast<int64_t>(mark) + max_element, max_element, marks);
+
+            // Merge indistinguishable variables: those with identical lists.
+            for (int32_t pk = element_begin; pk < element_end; pk++)
+            {
+                int32_t i = index[pk];
+                if (weight[i] >= 0)
+                {
+                    continue;
+                }
+                const int32_t bucket = last[i];
+                i = hash_head[bucket];
+                hash_head[bucket] = -1;
+                for (; i != -1 && next[i] != -1; i = next[i], mark++)
+                {
+                    const int32_t list_length = length[i];
+                    const int32_t elements_of_i = num_elements[i];
+                    for (p = start[i] + 1; p <= start[i] + list_length - 1; p++)
+                    {
+                        marks[index[p]] = mark;
+                    }
+                    int32_t previous = i;
+                    for (int32_t j = next[i]; j != -1;)
+                    {
+                        bool same = length[j] == list_length && num_elements[j] == elements_of_i;
+                        for (p = start[j] + 1; same && p <= start[j] + list_length - 1; p++)
+                        {
+                            same = marks[index[p]] == mark;
+                        }
+                        if (same)
+                        {
+                            start[j] = flip(i);
+                            weight[i] += weight[j];
+                            weight[j] = 0;
+                            num_elements[j] = -1;
+                            j = next[j];
+                            next[previous] = j;
+                        }
+                        else
+                        {
+                            previous = j;
+                            j = next[j];
+                        }
+                    }
+                }
+            }
+
+            // Finalize the new element and put its variables back into the degree lists.
+            p = element_begin;
+            for (int32_t pk = element_begin; pk < element_end; pk++)
+            {
+                const int32_t i = index[pk];
+                const int32_t weight_of_i = -weight[i];
+                if (weight_of_i <= 0)
+                {
+                    continue;
+                }
+                weight[i] = weight_of_i;
+                const int32_t d = std::min(degree[i] + element_size - weight_of_i, n - eliminated - weight_of_i);
+                if (head[d] != -1)
+                {
+                    last[head[d]] = i;
+                }
+                next[i] = head[d];
+                last[i] = -1;
+                head[d] = i;
+                min_degree = std::min(min_degree, d);
+                degree[i] = d;
+                index[p++] = i;
+            }
+            weight[k] = weight_of_k;
+            length[k] = p - element_begin;
+            if (length[k] == 0)
+            {
+                start[k] = -1;
+                marks[k] = 0;
+            }
+            if (elements_of_k != 0)
+            {
+                used = p;
+            }
+        }
+
+        // Every node now stores its parent in the assembly tree. Order the tree in postorder,
+        // every variable right after the supervariable or element that absorbed it.
+        for (int32_t i = 0; i < n; i++)
+        {
+            start[i] = flip(start[i]);
+        }
+        std::ranges::fill(head, -1);
+        for (int32_t j = n; j >= 0; j--)
+        {
+            if (weight[j] <= 0)
+            {
+                next[j] = head[start[j]];
+                head[start[j]] = j;
+            }
+        }
+        for (int32_t e = n; e >= 0; e--)
+        {
+            if (weight[e] > 0 && start[e] != -1)
+            {
+                next[e] = head[start[e]];
+                head[start[e]] = e;
+            }
+        }
+        std::vector<int32_t> order;
+        order.reserve(n + 1);
+        std::vector<int32_t> stack;
+        for (int32_t i = 0; i <= n; i++)
+        {
+            if (start[i] == -1)
+            {
+                append_postorder(i, head, next, stack, order);
+            }
+        }
+        DCHECK_EQ(order.back(), n);
+        order.pop_back();
+        return order;
+    }
+
+    std::vector<int32_t> nested_dissection(const AdjacencyGraph& graph, const NestedDissectionOptions& options)
+    {
+        const int32_t n = graph.num_vertices();
+        std::vector<int32_t> labels(n);
+        std::iota(labels.begin(), labels.end(), 0);
+        std::vector<int32_t> order(n);
+        dissect(graph, labels, order, options);
+        return order;
+    }
+}
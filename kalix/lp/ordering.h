@@ -0,0 +1,146 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_ORDERING_H_
+#define KALIX_LP_ORDERING_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::lp
+{
+    /// @brief An undirected graph in compressed adjacency form, without self loops.
+    ///
+    /// Orderings work on this structure rather than on @ref CscMatrix: all indices are 32-bit,
+    /// which halves the memory traffic of the graph algorithms. The number of vertices and the
+    /// number of stored neighbor entries must both fit into an @c int32_t.
+    struct AdjacencyGraph
+    {
+        /// @brief Start offset of the neighbors of every vertex, plus one trailing entry holding
+        /// the total number of neighbor entries.
+        std::vector<int32_t> offsets = {0};
+
+        /// @brief Neighbors of every vertex, sorted and without duplicates.
+        std::vector<int32_t> neighbors;
+
+        /// @brief Returns the number of vertices.
+        [[nodiscard]] KALIX_FORCE_INLINE int32_t num_vertices() const
+        {
+            return static_cast<int32_t>(offsets.size()) - 1;
+        }
+
+        /// @brief Returns the number of neighbors of vertex @p vertex.
+        [[nodiscard]] KALIX_FORCE_INLINE int32_t degree(const int32_t vertex) const
+        {
+            DCHECK_GE(vertex, 0);
+            DCHECK_LT(vertex, num_vertices());
+            return offsets[vertex + 1] - offsets[vertex];
+        }
+
+        /// @brief Returns the neighbors of vertex @p vertex.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const int32_t> adjacent(const int32_t vertex) const
+        {
+            return {neighbors.data() + offsets[vertex], static_cast<size_t>(degree(vertex))};
+        }
+
+        /// @brief Builds the graph of the pattern of @c M + M^T for a square matrix @p matrix.
+        ///
+        /// Any of the lower triangle, the upper triangle or the full pattern of a symmetric
+        /// matrix gives the same graph. Diagonal entries are ignored.
+        [[nodiscard]] static AdjacencyGraph from_symmetric_pattern(const CscMatrixView& matrix);
+
+        /// @brief Builds the graph of the pattern of @c A^T*A: two columns are adjacent if they
+        /// share a row.
+        ///
+        /// Ordering this graph gives a fill-reducing column ordering for an LU factorization of
+        /// @p matrix. Rows with more than @p max_row_length entries are skipped, since a dense
+        /// row makes the graph complete without telling anything about the fill.
+        [[nodiscard]] static AdjacencyGraph from_column_intersections(const CscMatrixView& matrix,
+                                                                      int64_t max_row_length);
+    };
+
+    /// @brief Options of @ref approximate_minimum_degree.
+    struct AmdOptions
+    {
+        /// @brief Vertices with more than @c max(16, dense_factor*sqrt(n)) neighbors are treated
+        /// as dense: they are removed from the graph and ordered last.
+        double dense_factor = 10.0;
+    };
+
+    /// @brief Computes an approximate minimum degree (AMD) ordering.
+    ///
+    /// The elimination is simulated on the quotient graph, where every eliminated vertex becomes
+    /// an element that represents the clique formed by its neighbors, so the graph never grows
+    /// beyond its initial size. Degrees are bounded from above instead of computed exactly,
+    /// indistinguishable vertices are merged into supervariables, and elements contained in
+    /// newer ones are absorbed. The ordering is postordered on its assembly tree.
+    ///
+    /// @param graph The graph to order.
+    /// @param options The options.
+    /// @return The ordering: vertex @c order[k] is eliminated in step @c k.
+    [[nodiscard]] std::vector<int32_t> approximate_minimum_degree(const AdjacencyGraph& graph,
+                                                                  const AmdOptions& options = {});
+
+    /// @brief Options of @ref nested_dissection.
+    struct NestedDissectionOptions
+    {
+        /// @brief Scheduler used to order the two halves of every dissection in parallel. Runs
+        /// serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Subgraphs with at most this many vertices are ordered by
+        /// @ref approximate_minimum_degree instead of being dissected further.
+        int32_t leaf_size = 200;
+
+        /// @brief Coarsening stops once the graph has at most this many vertices.
+        int32_t coarsest_size = 100;
+
+        /// @brief Each half of a bisection may exceed half of the total vertex weight by this
+        /// fraction.
+        double imbalance = 0.1;
+
+        /// @brief Subgraphs with fewer vertices are dissected on the calling thread.
+        int32_t min_parallel_size = 4096;
+    };
+
+    /// @brief Computes a multilevel nested dissection ordering.
+    ///
+    /// Every graph is split by a small vertex separator into two halves, which are ordered
+    /// recursively before the separator. The separator is derived from an edge bisection
+    /// computed on a hierarchy of coarsened graphs: heavy-edge matching shrinks the graph, the
+    /// coarsest graph is bisected by greedy graph growing, and the bisection is projected back
+    /// and refined at every level. The two halves are independent and are ordered as parallel
+    /// tasks. The result does not depend on the scheduler.
+    ///
+    /// @param graph The graph to order.
+    /// @param options The options.
+    /// @return The ordering: vertex @c order[k] is eliminated in step @c k.
+    [[nodiscard]] std::vector<int32_t> nested_dissection(const AdjacencyGraph& graph,
+                                                         const NestedDissectionOptions& options = {});
+}
+
+#endif // KALIX_LP_ORDERING_H_
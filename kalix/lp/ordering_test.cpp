@@ -0,0 +1,272 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/ordering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+
+namespace kalix::lp
+{
+    namespace
+    {
+        AdjacencyGraph graph_from_edges(const int32_t n, const std::vector<std::pair<int32_t, int32_t>>& edges)
+        {
+            CscMatrix matrix;
+            matrix.num_rows = n;
+            std::vector<std::vector<int64_t>> columns(n);
+            for (const auto& [i, j] : edges)
+            {
+                columns[std::min(i, j)].push_back(std::max(i, j));
+            }
+            for (int32_t j = 0; j < n; j++)
+            {
+                matrix.append_column(columns[j], std::vector<double>(columns[j].size(), 1.0));
+            }
+            return AdjacencyGraph::from_symmetric_pattern(matrix.view());
+        }
+
+        AdjacencyGraph grid(const int32_t width, const int32_t height)
+        {
+            std::vector<std::pair<int32_t, int32_t>> edges;
+            for (int32_t y = 0; y < height; y++)
+            {
+                for (int32_t x = 0; x < width; x++)
+                {
+                    const int32_t v = y * width + x;
+                    if (x + 1 < width)
+                    {
+                        edges.emplace_back(v, v + 1);
+                    }
+                    if (y + 1 < height)
+                    {
+                        edges.emplace_back(v, v + width);
+                    }
+                }
+            }
+            return graph_from_edges(width * height, edges);
+        }
+
+        AdjacencyGraph random_graph(std::mt19937& rng, const int32_t n, const int32_t num_edges)
+        {
+            std::uniform_int_distribution<int32_t> vertex(0, n - 1);
+            std::vector<std::pair<int32_t, int32_t>> edges;
+            for (int32_t e = 0; e < num_edges; e++)
+            {
+                edges.emplace_back(vertex(rng), vertex(rng));
+            }
+            return graph_from_edges(n, edges);
+        }
+
+        bool is_permutation(const std::vector<int32_t>& order, const int32_t n)
+        {
+            std::vector<int32_t> sorted = order;
+            std::ranges::sort(sorted);
+            for (int32_t k = 0; k < static_cast<int32_t>(sorted.size()); k++)
+            {
+                if (sorted[k] != k)
+                {
+                    return false;
+                }
+            }
+            return static_cast<int32_t>(order.size()) == n;
+        }
+
+        /// Number of off-diagonal entries of the Cholesky factor, by explicit elimination.
+        int64_t fill(const AdjacencyGraph& graph, const std::vector<int32_t>& order)
+        {
+            const int32_t n = graph.num_vertices();
+            std::vector<std::set<int32_t>> adjacency(n);
+            for (int32_t v = 0; v < n; v++)
+            {
+                adjacency[v].insert(graph.adjacent(v).begin(), graph.adjacent(v).end());
+            }
+            int64_t total = 0;
+            for (const int32_t v : order)
+            {
+                const std::set<int32_t> neighbors = std::move(adjacency[v]);
+                total += static_cast<int64_t>(neighbors.size());
+                for (const int32_t u : neighbors)
+                {
+                    adjacency[u].erase(v);
+                    adjacency[u].insert(neighbors.begin(), neighbors.end());
+                    adjacency[u].erase(u);
+                }
+            }
+            return total;
+        }
+
+        std::vector<int32_t> natural(const int32_t n)
+        {
+            std::vector<int32_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            return order;
+        }
+    }
+
+    TEST(AdjacencyGraphTest, SymmetricPatternIgnoresTriangleAndDiagonal)
+    {
+        // Full pattern of a 3x3 matrix with entries (0,1), (1,2) and the diagonal.
+        CscMatrix full;
+        full.num_rows = 3;
+        full.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{4.0, 1.0});
+        full.append_column(std::vector<int64_t>{2, 0, 1}, std::vector<double>{1.0, 1.0, 4.0});
+        full.append_column(std::vector<int64_t>{1, 2}, std::vector<double>{1.0, 4.0});
+        const AdjacencyGraph graph = AdjacencyGraph::from_symmetric_pattern(full.view());
+
+        EXPECT_EQ(graph.num_vertices(), 3);
+        EXPECT_EQ(graph.offsets, (std::vector<int32_t>{0, 1, 3, 4}));
+        EXPECT_EQ(graph.neighbors, (std::vector<int32_t>{1, 0, 2, 1}));
+        EXPECT_EQ(graph_from_edges(3, {{1, 0}, {2, 1}}).neighbors, graph.neighbors);
+    }
+
+    TEST(AdjacencyGraphTest, ColumnIntersectionsSkipDenseRows)
+    {
+        // Rows: {0, 1}, {1, 2}, {0, 1, 2, 3}.
+        CscMatrix matrix;
+        matrix.num_rows = 3;
+        matrix.append_column(std::vector<int64_t>{0, 2}, std::vector<double>{1.0, 1.0});
+        matrix.append_column(std::vector<int64_t>{0, 1, 2}, std::vector<double>{1.0, 1.0, 1.0});
+        matrix.append_column(std::vector<int64_t>{1, 2}, std::vector<double>{1.0, 1.0});
+        matrix.append_column(std::vector<int64_t>{2}, std::vector<double>{1.0});
+
+        const AdjacencyGraph all = AdjacencyGraph::from_column_intersections(matrix.view(), 10);
+        EXPECT_EQ(all.offsets, (std::vector<int32_t>{0, 3, 6, 9, 12}));
+        EXPECT_EQ(all.neighbors, (std::vector<int32_t>{1, 2, 3, 0, 2, 3, 0, 1, 3, 0, 1, 2}));
+
+        const AdjacencyGraph sparse = AdjacencyGraph::from_column_intersections(matrix.view(), 3);
+        EXPECT_EQ(sparse.offsets, (std::vector<int32_t>{0, 1, 3, 4, 4}));
+        EXPECT_EQ(sparse.neighbors, (std::vector<int32_t>{1, 0, 2, 1}));
+    }
+
+    TEST(ApproximateMinimumDegreeTest, OrdersTrivialGraphs)
+    {
+        EXPECT_TRUE(approximate_minimum_degree(AdjacencyGraph{}).empty());
+        EXPECT_EQ(approximate_minimum_degree(graph_from_edges(1, {})), (std::vector<int32_t>{0}));
+        EXPECT_TRUE(is_permutation(approximate_minimum_degree(graph_from_edges(5, {})), 5));
+        EXPECT_TRUE(is_permutation(approximate_minimum_degree(graph_from_edges(2, {{0, 1}})), 2));
+    }
+
+    TEST(ApproximateMinimumDegreeTest, OrdersHubOfStarLast)
+    {
+        std::vector<std::pair<int32_t, int32_t>> edges;
+        for (int32_t v = 1; v < 50; v++)
+        {
+            edges.emplace_back(0, v);
+        }
+        const AdjacencyGraph star = graph_from_edges(50, edges);
+        const std::vector<int32_t> order = approximate_minimum_degree(star);
+        ASSERT_TRUE(is_permutation(order, 50));
+        EXPECT_EQ(order.back(), 0);
+        EXPECT_EQ(fill(star, order), 49);
+    }
+
+    TEST(ApproximateMinimumDegreeTest, OrdersDenseVertexLast)
+    {
+        // A path plus one vertex adjacent to all others, far above the dense threshold.
+        constexpr int32_t n = 1000;
+        std::vector<std::pair<int32_t, int32_t>> edges;
+        for (int32_t v = 0; v + 2 < n; v++)
+        {
+            edges.emplace_back(v, v + 1);
+        }
+        for (int32_t v = 0; v + 1 < n; v++)
+        {
+            edges.emplace_back(v, n - 1);
+        }
+        const std::vector<int32_t> order = approximate_minimum_degree(graph_from_edges(n, edges));
+        ASSERT_TRUE(is_permutation(order, n));
+        EXPECT_EQ(order.back(), n - 1);
+    }
+
+    TEST(ApproximateMinimumDegreeTest, ReducesFillOfGrid)
+    {
+        const AdjacencyGraph graph = grid(30, 30);
+        const std::vector<int32_t> order = approximate_minimum_degree(graph);
+        ASSERT_TRUE(is_permutation(order, 900));
+        EXPECT_LT(2 * fill(graph, order), fill(graph, natural(900)));
+    }
+
+    TEST(ApproximateMinimumDegreeTest, OrdersRandomGraphs)
+    {
+        std::mt19937 rng(3);
+        for (int trial = 0; trial < 200; trial++)
+        {
+            const int32_t n = std::uniform_int_distribution<int32_t>(1, 120)(rng);
+            const int32_t num_edges = std::uniform_int_distribution<int32_t>(0, 4 * n)(rng);
+            const AdjacencyGraph graph = random_graph(rng, n, num_edges);
+            const std::vector<int32_t> order = approximate_minimum_degree(graph);
+            ASSERT_TRUE(is_permutation(order, n));
+            EXPECT_LE(fill(graph, order), fill(graph, natural(n)));
+        }
+    }
+
+    TEST(NestedDissectionTest, OrdersSmallGraphsLikeAmd)
+    {
+        const AdjacencyGraph graph = grid(10, 10);
+        EXPECT_EQ(nested_dissection(graph), approximate_minimum_degree(graph));
+    }
+
+    TEST(NestedDissectionTest, ReducesFillOfGrid)
+    {
+        const AdjacencyGraph graph = grid(60, 60);
+        NestedDissectionOptions options;
+        options.leaf_size = 64;
+        const std::vector<int32_t> order = nested_dissection(graph, options);
+        ASSERT_TRUE(is_permutation(order, 3600));
+        const int64_t dissection_fill = fill(graph, order);
+        EXPECT_LT(2 * dissection_fill, fill(graph, natural(3600)));
+        EXPECT_LT(dissection_fill, 2 * fill(graph, approximate_minimum_degree(graph)));
+    }
+
+    TEST(NestedDissectionTest, OrdersDisconnectedAndRandomGraphs)
+    {
+        std::mt19937 rng(5);
+        NestedDissectionOptions options;
+        options.leaf_size = 16;
+        options.coarsest_size = 8;
+        for (int trial = 0; trial < 50; trial++)
+        {
+            const int32_t n = std::uniform_int_distribution<int32_t>(1, 400)(rng);
+            const int32_t num_edges = std::uniform_int_distribution<int32_t>(0, 3 * n)(rng);
+            const AdjacencyGraph graph = random_graph(rng, n, num_edges);
+            ASSERT_TRUE(is_permutation(nested_dissection(graph, options), n));
+        }
+    }
+
+    TEST(NestedDissectionTest, ParallelMatchesSerial)
+    {
+        TaskScheduler scheduler({.num_threads = 4});
+        const AdjacencyGraph graph = grid(80, 70);
+        NestedDissectionOptions options;
+        options.leaf_size = 32;
+        const std::vector<int32_t> serial = nested_dissection(graph, options);
+        options.scheduler = &scheduler;
+        options.min_parallel_size = 64;
+        EXPECT_EQ(nested_dissection(graph, options), serial);
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/scaling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace kalix::lp
+{
+    namespace
+    {
+        /// @brief Largest and smallest absolute value of a line after scaling by the factors of
+        /// the crossing lines.
+        struct LineRange
+        {
+            double max = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+        };
+
+        KALIX_FORCE_INLINE LineRange line_range(const std::span<const int64_t> indices,
+                                                const std::span<const double> values,
+                                                const std::vector<double>& crossing_scales)
+        {
+            LineRange range;
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                const double value = std::abs(values[t]) * crossing_scales[indices[t]];
+                if (value != 0.0)
+                {
+                    range.max = std::max(range.max, value);
+                    range.min = std::min(range.min, value);
+                }
+            }
+            return range;
+        }
+
+        /// @brief Sets every line scale from its range. Returns the ratio between the largest
+        /// and smallest scaled entry before this pass.
+        template <typename Factor>
+        double scale_lines(const CscMatrix& lines, const std::vector<double>& crossing_scales,
+                           std::vector<double>& scales, TaskScheduler* scheduler, Factor&& factor)
+        {
+            std::vector<LineRange> ranges(lines.num_cols);
+            parallel_for(scheduler, 0, lines.num_cols, 0, [&](const int64_t line)
+            {
+                const LineRange range =
+                    line_range(lines.column_indices(line), lines.column_values(line), crossing_scales);
+                ranges[line] = range;
+                scales[line] = range.max > 0.0 ? factor(range) : 1.0;
+            });
+
+            double max = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            for (const LineRange& range : ranges)
+            {
+                if (range.max > 0.0)
+                {
+                    max = std::max(max, range.max);
+                    min = std::min(min, range.min);
+                }
+            }
+            return max > 0.0 ? max / min : 1.0;
+        }
+
+        double geometric_mean_factor(const LineRange& range)
+        {
+            return 1.0 / std::sqrt(range.max * range.min);
+        }
+
+        double equilibration_factor(const LineRange& range)
+        {
+            return 1.0 / range.max;
+        }
+
+        /// @brief Rounds a positive factor to the nearest power of two within the clamp range.
+        KALIX_FORCE_INLINE double round_to_power_of_two(const double factor, const int max_exponent)
+        {
+            const int exponent = static_cast<int>(std::lround(std::log2(factor)));
+            return std::ldexp(1.0, std::clamp(exponent, -max_exponent, max_exponent));
+        }
+    }
+
+    Scaling Scaling::identity(const int64_t num_rows, const int64_t num_cols)
+    {
+        Scaling scaling;
+        scaling.row_scales_.assign(num_rows, 1.0);
+        scaling.column_scales_.assign(num_cols, 1.0);
+        scaling.set_inverses();
+        return scaling;
+    }
+
+    Scaling Scaling::compute(const CscMatrix& matrix, const ScalingOptions& options)
+    {
+        Scaling scaling = identity(matrix.num_rows, matrix.num_cols);
+        const CscMatrix rows = matrix.transpose();
+        std::vector<double>& row_scales = scaling.row_scales_;
+        std::vector<double>& column_scales = scaling.column_scales_;
+        TaskScheduler* scheduler = options.scheduler;
+
+        if (options.method != ScalingMethod::kEquilibration)
+        {
+            double previous_ratio = std::numeric_limits<double>::infinity();
+            for (int pass = 0; pass < options.max_geometric_passes; pass++)
+            {
+                // The ratio is measured before the row pass, i.e. after the previous column pass.
+                const double ratio = scale_lines(rows, column_scales, row_scales, scheduler, geometric_mean_factor);
+                scale_lines(matrix, row_scales, column_scales, scheduler, geometric_mean_factor);
+                if (ratio > options.geometric_improvement * previous_ratio)
+                {
+                    break;
+                }
+                previous_ratio = ratio;
+            }
+        }
+        if (options.method != ScalingMethod::kGeometricMean)
+        {
+            scale_lines(rows, column_scales, row_scales, scheduler, equilibration_factor);
+            scale_lines(matrix, row_scales, column_scales, scheduler, equilibration_factor);
+        }
+
+        // Row factors are rounded first and the column factors recomputed against them, so that
+        // rounding the rows does not undo the column pass.
+        for (double& scale : row_scales)
+        {
+            scale = round_to_power_of_two(scale, options.max_exponent);
+        }
+        const auto final_factor = options.method == ScalingMethod::kGeometricMean ? geometric_mean_factor
+                                                                                  : equilibration_factor;
+        scale_lines(matrix, row_scales, column_scales, scheduler, final_factor);
+        for (double& scale : column_scales)
+        {
+            scale = round_to_power_of_two(scale, options.max_exponent);
+        }
+        scaling.set_inverses();
+        return scaling;
+    }
+
+    void Scaling::set_inverses()
+    {
+        inverse_row_scales_.resize(row_scales_.size());
+        inverse_column_scales_.resize(column_scales_.size());
+        for (size_t i = 0; i < row_scales_.size(); i++)
+        {
+            inverse_row_scales_[i] = 1.0 / row_scales_[i];
+        }
+        for (size_t j = 0; j < column_scales_.size(); j++)
+        {
+            inverse_column_scales_[j] = 1.0 / column_scales_[j];
+        }
+    }
+
+    void Scaling::scale_matrix(CscMatrix& matrix) const
+    {
+        CHECK_EQ(matrix.num_rows, num_rows());
+        CHECK_EQ(matrix.num_cols, num_cols());
+        for (int64_t j = 0; j < matrix.num_cols; j++)
+        {
+            const double column_scale = column_scales_[j];
+            for (int64_t k = matrix.column_starts[j]; k < matrix.column_starts[j + 1]; k++)
+            {
+                matrix.values[k] *= row_scales_[matrix.row_indices[k]] * column_scale;
+            }
+        }
+    }
+
+    void Scaling::apply(LinearProgram& program) const
+    {
+        scale_matrix(program.constraint_matrix);
+        // Infinite bounds stay infinite, since all factors are finite and positive.
+        for (int64_t j = 0; j < num_cols(); j++)
+        {
+            program.objective[j] *= column_scales_[j];
+            program.column_lower[j] *= inverse_column_scales_[j];
+            program.column_upper[j] *= inverse_column_scales_[j];
+        }
+        for (int64_t i = 0; i < num_rows(); i++)
+        {
+            program.row_lower[i] *= row_scales_[i];
+            program.row_upper[i] *= row_scales_[i];
+        }
+    }
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_SCALING_H_
+#define KALIX_LP_SCALING_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::lp
+{
+    /// @brief The algorithm used to compute the scale factors.
+    enum class ScalingMethod : int8_t
+    {
+        /// @brief Alternately divides rows and columns by the geometric mean of their largest
+        /// and smallest absolute entry.
+        kGeometricMean,
+
+        /// @brief Divides every row, then every column, by its largest absolute entry.
+        kEquilibration,
+
+        /// @brief Geometric-mean passes followed by one equilibration pass.
+        kGeometricMeanThenEquilibration,
+    };
+
+    /// @brief Options for @ref Scaling::compute.
+    struct ScalingOptions
+    {
+        /// @brief The scaling algorithm.
+        ScalingMethod method = ScalingMethod::kGeometricMeanThenEquilibration;
+
+        /// @brief Maximum number of geometric-mean passes, each one a row and a column pass.
+        int max_geometric_passes = 8;
+
+        /// @brief Geometric-mean passes stop once a pass reduces the ratio between the largest and
+        /// the smallest scaled entry by less than this factor.
+        double geometric_improvement = 0.9;
+
+        /// @brief Scale factors are clamped to @c [2^-max_exponent, 2^max_exponent].
+        int max_exponent = 20;
+
+        /// @brief Scheduler used for the row and column passes. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+    };
+
+    /// @brief Read access to a scaled @ref Vector in unscaled space.
+    ///
+    /// Every access multiplies the stored value by its factor, so unscaling costs nothing until
+    /// a value is actually read, and entries that are never read are never touched.
+    class UnscaledVector
+    {
+    public:
+        /// @brief Creates a view of @p scaled, where entry @c i is @c scaled[i] * factors[i].
+        UnscaledVector(const Vector<double>& scaled, const std::span<const double> factors)
+            : scaled_(scaled), factors_(factors)
+        {
+            DCHECK_EQ(scaled.dimension, static_cast<int64_t>(factors.size()));
+        }
+
+        /// @brief Returns the dimension of the vector.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t dimension() const
+        {
+            return scaled_.dimension;
+        }
+
+        /// @brief Returns the unscaled entry @p i.
+        [[nodiscard]] KALIX_FORCE_INLINE double operator[](const int64_t i) const
+        {
+            return scaled_.dense_values[i] * factors_[i];
+        }
+
+        /// @brief Calls @p function with the index and unscaled value of every non-zero entry.
+        ///
+        /// Visits only the tracked indices of a sparse vector and every entry of a dense one.
+        template <typename Function>
+        KALIX_FORCE_INLINE void for_each_non_zero(Function&& function) const
+        {
+            if (scaled_.non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < scaled_.dimension; i++)
+                {
+                    if (scaled_.dense_values[i] != 0.0)
+                    {
+                        function(i, (*this)[i]);
+                    }
+                }
+                return;
+            }
+            for (int64_t k = 0; k < scaled_.non_zero_count; k++)
+            {
+                const int64_t i = scaled_.non_zero_indices[k];
+                function(i, (*this)[i]);
+            }
+        }
+
+        /// @brief Writes the unscaled vector into @p result, keeping the sparsity pattern.
+        ///
+        /// @p result must have been set up with the same dimension.
+        void materialize(Vector<double>& result) const
+        {
+            DCHECK_EQ(result.dimension, scaled_.dimension);
+            result.clear();
+            result.non_zero_count = scaled_.non_zero_count;
+            if (scaled_.non_zero_count < 0)
+            {
+                for (int64_t i = 0; i < scaled_.dimension; i++)
+                {
+                    result.dense_values[i] = (*this)[i];
+                }
+                return;
+            }
+            for (int64_t k = 0; k < scaled_.non_zero_count; k++)
+            {
+                const int64_t i = scaled_.non_zero_indices[k];
+                result.non_zero_indices[k] = i;
+                result.dense_values[i] = (*this)[i];
+            }
+        }
+
+    private:
+        const Vector<double>& scaled_;
+        std::span<const double> factors_;
+    };
+
+    /// @brief Row and column scale factors of a constraint matrix.
+    ///
+    /// The scaled matrix is @c R*A*C with diagonal @c R (row scales) and @c C (column scales).
+    /// All factors are powers of two, so scaling and unscaling are exact. In the scaled program
+    /// the variables are @c x' = C^-1 x and the duals are @c y' = R^-1 y.
+    ///
+    /// Solvers keep working in scaled space; results are translated back lazily through the
+    /// @ref UnscaledVector views returned by @ref primal, @ref dual, @ref reduced_costs and
+    /// @ref row_activities.
+    class Scaling
+    {
+    public:
+        /// @brief Creates an empty scaling for a 0x0 matrix.
+        Scaling() = default;
+
+        /// @brief Returns the scaling that leaves every row and column unchanged.
+        [[nodiscard]] static Scaling identity(int64_t num_rows, int64_t num_cols);
+
+        /// @brief Computes scale factors for @p matrix.
+        [[nodiscard]] static Scaling compute(const CscMatrix& matrix, const ScalingOptions& options = {});
+
+        /// @brief Returns the number of rows.
+        [[nodiscard]] int64_t num_rows() const
+        {
+            return static_cast<int64_t>(row_scales_.size());
+        }
+
+        /// @brief Returns the number of columns.
+        [[nodiscard]] int64_t num_cols() const
+        {
+            return static_cast<int64_t>(column_scales_.size());
+        }
+
+        /// @brief Returns the scale factor of every row.
+        [[nodiscard]] std::span<const double> row_scales() const
+        {
+            return row_scales_;
+        }
+
+        /// @brief Returns the scale factor of every column.
+        [[nodiscard]] std::span<const double> column_scales() const
+        {
+            return column_scales_;
+        }
+
+        /// @brief Scales the entries of @p matrix in place.
+        void scale_matrix(CscMatrix& matrix) const;
+
+        /// @brief Scales the matrix, objective and bounds of @p program in place.
+        void apply(LinearProgram& program) const;
+
+        /// @brief Returns the unscaled primal values @c x = C x' of a scaled solution.
+        [[nodiscard]] UnscaledVector primal(const Vector<double>& scaled) const
+        {
+            return {scaled, column_scales_};
+        }
+
+        /// @brief Returns the unscaled duals @c y = R y' of a scaled solution.
+        [[nodiscard]] UnscaledVector dual(const Vector<double>& scaled) const
+        {
+            return {scaled, row_scales_};
+        }
+
+        /// @brief Returns the unscaled reduced costs @c d = C^-1 d' of a scaled solution.
+        [[nodiscard]] UnscaledVector reduced_costs(const Vector<double>& scaled) const
+        {
+            return {scaled, inverse_column_scales_};
+        }
+
+        /// @brief Returns the unscaled row activities @c Ax = R^-1 (A'x') of a scaled solution.
+        [[nodiscard]] UnscaledVector row_activities(const Vector<double>& scaled) const
+        {
+            return {scaled, inverse_row_scales_};
+        }
+
+    private:
+        void set_inverses();
+
+        std::vector<double> row_scales_;
+        std::vector<double> column_scales_;
+        std::vector<double> inverse_row_scales_;
+        std::vector<double> inverse_column_scales_;
+    };
+}
+
+#endif // KALIX_LP_SCALING_H_
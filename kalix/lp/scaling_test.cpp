@@ -0,0 +1,268 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/lp/scaling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::lp
+{
+    namespace
+    {
+        // A badly scaled 3x3 matrix: rows and columns differ by several orders of magnitude.
+        CscMatrix badly_scaled_matrix()
+        {
+            CscMatrix matrix;
+            matrix.num_rows = 3;
+            const std::vector<int64_t> rows = {0, 1, 2};
+            matrix.append_column(rows, std::vector<double>{1e4, 3.0, 2e-3});
+            matrix.append_column(rows, std::vector<double>{5e3, 1e-2, 7e-4});
+            matrix.append_column(std::vector<int64_t>{0, 2}, std::vector<double>{2e6, 0.5});
+            return matrix;
+        }
+
+        double entry_ratio(const CscMatrix& matrix)
+        {
+            double max = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            for (const double value : matrix.values)
+            {
+                max = std::max(max, std::abs(value));
+                min = std::min(min, std::abs(value));
+            }
+            return max / min;
+        }
+
+        bool is_power_of_two(const double value)
+        {
+            int exponent;
+            return std::frexp(value, &exponent) == 0.5;
+        }
+    }
+
+    TEST(ScalingTest, IdentityLeavesMatrixUnchanged)
+    {
+        CscMatrix matrix = badly_scaled_matrix();
+        const CscMatrix original = matrix;
+        Scaling::identity(3, 3).scale_matrix(matrix);
+        EXPECT_EQ(matrix.values, original.values);
+    }
+
+    TEST(ScalingTest, FactorsArePowersOfTwoAndReduceTheRange)
+    {
+        for (const ScalingMethod method : {ScalingMethod::kGeometricMean, ScalingMethod::kEquilibration,
+                                           ScalingMethod::kGeometricMeanThenEquilibration})
+        {
+            CscMatrix matrix = badly_scaled_matrix();
+            ScalingOptions options;
+            options.method = method;
+            const Scaling scaling = Scaling::compute(matrix, options);
+            for (const double scale : scaling.row_scales())
+            {
+                EXPECT_TRUE(is_power_of_two(scale)) << scale;
+            }
+            for (const double scale : scaling.column_scales())
+            {
+                EXPECT_TRUE(is_power_of_two(scale)) << scale;
+            }
+            const double before = entry_ratio(matrix);
+            scaling.scale_matrix(matrix);
+            EXPECT_LT(entry_ratio(matrix), before / 100.0);
+        }
+    }
+
+    TEST(ScalingTest, EquilibrationBoundsColumnMaxima)
+    {
+        CscMatrix matrix = badly_scaled_matrix();
+        ScalingOptions options;
+        options.method = ScalingMethod::kEquilibration;
+        Scaling::compute(matrix, options).scale_matrix(matrix);
+        for (int64_t j = 0; j < matrix.num_cols; j++)
+        {
+            double max = 0.0;
+            for (const double value : matrix.column_values(j))
+            {
+                max = std::max(max, std::abs(value));
+            }
+            // Rounding to powers of two leaves every maximum within a factor sqrt(2) of one.
+            EXPECT_GE(max, 1.0 / std::sqrt(2.0) - 1e-12);
+            EXPECT_LE(max, std::sqrt(2.0) + 1e-12);
+        }
+    }
+
+    TEST(ScalingTest, ClampsFactors)
+    {
+        CscMatrix matrix;
+        matrix.num_rows = 1;
+        matrix.append_column(std::vector<int64_t>{0}, std::vector<double>{1e-30});
+        ScalingOptions options;
+        options.max_exponent = 4;
+        const Scaling scaling = Scaling::compute(matrix, options);
+        EXPECT_LE(scaling.row_scales()[0], 16.0);
+        EXPECT_LE(scaling.column_scales()[0], 16.0);
+    }
+
+    TEST(ScalingTest, ApplyAndUnscaleRoundTrip)
+    {
+        LinearProgram program;
+        program.constraint_matrix = badly_scaled_matrix();
+        program.objective = {1.0, -2.0, 3e3};
+        program.column_lower = {0.0, -std::numeric_limits<double>::infinity(), 1.0};
+        program.column_upper = {10.0, 4.0, 2.0};
+        program.row_lower = {-1.0, 2.0, -std::numeric_limits<double>::infinity()};
+        program.row_upper = {1e7, 2.0, 5.0};
+
+        LinearProgram scaled = program;
+        const Scaling scaling = Scaling::compute(program.constraint_matrix);
+        scaling.apply(scaled);
+        EXPECT_TRUE(std::isinf(scaled.column_lower[1]));
+        EXPECT_TRUE(std::isinf(scaled.row_lower[2]));
+
+        // x' = C^-1 x is feasible for the scaled program with the same objective value and
+        // scaled row activities R*A*x.
+        const std::vector<double> x = {2.0, -1.5, 1.25};
+        Vector<double> scaled_x;
+        scaled_x.setup(3);
+        for (int64_t j = 0; j < 3; j++)
+        {
+            scaled_x.dense_values[j] = x[j] / scaling.column_scales()[j];
+            scaled_x.non_zero_indices[j] = j;
+        }
+        scaled_x.non_zero_count = 3;
+
+        double objective = 0.0;
+        double scaled_objective = 0.0;
+        for (int64_t j = 0; j < 3; j++)
+        {
+            objective += program.objective[j] * x[j];
+            scaled_objective += scaled.objective[j] * scaled_x.dense_values[j];
+            EXPECT_EQ(scaling.primal(scaled_x)[j], x[j]);
+        }
+        EXPECT_EQ(objective, scaled_objective);
+
+        Vector<double> activity;
+        activity.setup(3);
+        activity.non_zero_count = -1;
+        for (int64_t j = 0; j < 3; j++)
+        {
+            const auto indices = scaled.constraint_matrix.column_indices(j);
+            const auto values = scaled.constraint_matrix.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                activity.dense_values[indices[t]] += values[t] * scaled_x.dense_values[j];
+            }
+        }
+        const UnscaledVector unscaled = scaling.row_activities(activity);
+        for (int64_t i = 0; i < 3; i++)
+        {
+            double expected = 0.0;
+            for (int64_t j = 0; j < 3; j++)
+            {
+                const auto indices = program.constraint_matrix.column_indices(j);
+                const auto values = program.constraint_matrix.column_values(j);
+                for (size_t t = 0; t < indices.size(); t++)
+                {
+                    if (indices[t] == i)
+                    {
+                        expected += values[t] * x[j];
+                    }
+                }
+            }
+            EXPECT_NEAR(unscaled[i], expected, 1e-9 * std::abs(expected));
+        }
+    }
+
+    TEST(ScalingTest, UnscaledVectorVisitsSparseAndDenseEntries)
+    {
+        Scaling scaling = Scaling::compute(badly_scaled_matrix());
+        Vector<double> dual;
+        dual.setup(3);
+        dual.dense_values[2] = 4.0;
+        dual.non_zero_indices[0] = 2;
+        dual.non_zero_count = 1;
+
+        int visited = 0;
+        scaling.dual(dual).for_each_non_zero([&](const int64_t i, const double value)
+        {
+            EXPECT_EQ(i, 2);
+            EXPECT_EQ(value, 4.0 * scaling.row_scales()[2]);
+            visited++;
+        });
+        EXPECT_EQ(visited, 1);
+
+        Vector<double> result;
+        result.setup(3);
+        scaling.dual(dual).materialize(result);
+        EXPECT_EQ(result.non_zero_count, 1);
+        EXPECT_EQ(result.dense_values[2], 4.0 * scaling.row_scales()[2]);
+
+        dual.non_zero_count = -1;
+        dual.dense_values[0] = -1.0;
+        scaling.reduced_costs(dual).materialize(result);
+        EXPECT_EQ(result.non_zero_count, -1);
+        EXPECT_EQ(result.dense_values[0], -1.0 / scaling.column_scales()[0]);
+        EXPECT_EQ(result.dense_values[1], 0.0);
+    }
+
+    class ScalingThreadTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(ScalingThreadTest, MatchesSerialFactors)
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> exponent(-8.0, 8.0);
+        std::uniform_int_distribution<int64_t> row(0, 399);
+        CscMatrix matrix;
+        matrix.num_rows = 400;
+        for (int j = 0; j < 1000; j++)
+        {
+            std::vector<int64_t> indices;
+            std::vector<double> values;
+            for (int t = 0; t < 5; t++)
+            {
+                indices.push_back(row(rng));
+                values.push_back(std::exp2(exponent(rng)) * (t % 2 == 0 ? 1.0 : -1.0));
+            }
+            matrix.append_column(indices, values);
+        }
+
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        ScalingOptions options;
+        options.scheduler = &scheduler;
+        const Scaling parallel = Scaling::compute(matrix, options);
+        const Scaling serial = Scaling::compute(matrix);
+        EXPECT_TRUE(std::ranges::equal(parallel.row_scales(), serial.row_scales()));
+        EXPECT_TRUE(std::ranges::equal(parallel.column_scales(), serial.column_scales()));
+
+        const double before = entry_ratio(matrix);
+        serial.scale_matrix(matrix);
+        EXPECT_LT(entry_ratio(matrix), before);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, ScalingThreadTest, ::testing::Values(1, 4));
+}
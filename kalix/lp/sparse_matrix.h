@@ -0,0 +1,227 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_SPARSE_MATRIX_H_
+#define KALIX_LP_SPARSE_MATRIX_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+
+namespace kalix::lp
+{
+    /// @brief A non-owning view of a matrix in compressed sparse column (CSC) format.
+    ///
+    /// Has the same layout as @ref CscMatrix, but refers to arrays owned elsewhere, for example
+    /// sections of a memory-mapped model file.
+    struct CscMatrixView
+    {
+        /// @brief Start offset of every column, plus one trailing entry holding the number of non-zeros.
+        std::span<const int64_t> column_starts;
+
+        /// @brief Row index of every stored entry.
+        std::span<const int64_t> row_indices;
+
+        /// @brief Value of every stored entry.
+        std::span<const double> values;
+
+        /// @brief Number of rows.
+        int64_t num_rows{};
+
+        /// @brief Number of columns.
+        int64_t num_cols{};
+
+        /// @brief Returns the number of stored entries.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t num_non_zeros() const
+        {
+            return column_starts[num_cols];
+        }
+
+        /// @brief Returns the number of stored entries in column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t column_length(const int64_t column) const
+        {
+            DCHECK_GE(column, 0);
+            DCHECK_LT(column, num_cols);
+            return column_starts[column + 1] - column_starts[column];
+        }
+
+        /// @brief Returns the row indices of column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const int64_t> column_indices(const int64_t column) const
+        {
+            return row_indices.subspan(column_starts[column], column_length(column));
+        }
+
+        /// @brief Returns the values of column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const double> column_values(const int64_t column) const
+        {
+            return values.subspan(column_starts[column], column_length(column));
+        }
+    };
+
+    /// @brief A sparse matrix in compressed sparse column (CSC) format.
+    ///
+    /// The entries of column @c j are stored at positions
+    /// @c [column_starts[j], column_starts[j + 1]) of @ref row_indices and @ref values.
+    /// Row indices within a column are not required to be sorted.
+    class CscMatrix
+    {
+    public:
+        /// @brief Start offset of every column, plus one trailing entry holding the number of non-zeros.
+        std::vector<int64_t> column_starts;
+
+        /// @brief Row index of every stored entry.
+        std::vector<int64_t> row_indices;
+
+        /// @brief Value of every stored entry.
+        std::vector<double> values;
+
+        /// @brief Number of rows.
+        int64_t num_rows{};
+
+        /// @brief Number of columns.
+        int64_t num_cols{};
+
+        /// @brief Default constructor. Creates an empty 0x0 matrix.
+        CscMatrix()
+            : column_starts(1, 0)
+        {
+        }
+
+        /// @brief Allocates storage for a matrix of the given shape.
+        ///
+        /// Column starts are zeroed, entry arrays are sized to @p num_non_zeros but not initialized
+        /// beyond value-initialization.
+        ///
+        /// @param new_num_rows The number of rows.
+        /// @param new_num_cols The number of columns.
+        /// @param num_non_zeros The number of stored entries.
+        KALIX_FORCE_INLINE void setup(const int64_t new_num_rows, const int64_t new_num_cols, const int64_t num_non_zeros)
+        {
+            num_rows = new_num_rows;
+            num_cols = new_num_cols;
+            column_starts.assign(new_num_cols + 1, 0);
+            row_indices.resize(num_non_zeros);
+            values.resize(num_non_zeros);
+        }
+
+        /// @brief Returns the number of stored entries.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t num_non_zeros() const
+        {
+            return column_starts[num_cols];
+        }
+
+        /// @brief Returns the number of stored entries in column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t column_length(const int64_t column) const
+        {
+            DCHECK_GE(column, 0);
+            DCHECK_LT(column, num_cols);
+            return column_starts[column + 1] - column_starts[column];
+        }
+
+        /// @brief Returns the row indices of column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const int64_t> column_indices(const int64_t column) const
+        {
+            DCHECK_GE(column, 0);
+            DCHECK_LT(column, num_cols);
+            return {row_indices.data() + column_starts[column], static_cast<size_t>(column_length(column))};
+        }
+
+        /// @brief Returns the values of column @p column.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const double> column_values(const int64_t column) const
+        {
+            DCHECK_GE(column, 0);
+            DCHECK_LT(column, num_cols);
+            return {values.data() + column_starts[column], static_cast<size_t>(column_length(column))};
+        }
+
+        /// @brief Returns a non-owning view of this matrix.
+        [[nodiscard]] KALIX_FORCE_INLINE CscMatrixView view() const
+        {
+            return {column_starts, row_indices, values, num_rows, num_cols};
+        }
+
+        /// @brief Copies a view into owned storage.
+        /// @param matrix The view to copy.
+        /// @return The owning matrix.
+        [[nodiscard]] static CscMatrix from_view(const CscMatrixView& matrix)
+        {
+            CscMatrix result;
+            result.num_rows = matrix.num_rows;
+            result.num_cols = matrix.num_cols;
+            result.column_starts.assign(matrix.column_starts.begin(), matrix.column_starts.end());
+            result.row_indices.assign(matrix.row_indices.begin(), matrix.row_indices.end());
+            result.values.assign(matrix.values.begin(), matrix.values.end());
+            return result;
+        }
+
+        /// @brief Appends a column given by parallel index and value arrays.
+        /// @param indices Row indices of the new column.
+        /// @param column_entries Values of the new column.
+        KALIX_FORCE_INLINE void append_column(const std::span<const int64_t> indices,
+                                              const std::span<const double> column_entries)
+        {
+            DCHECK_EQ(indices.size(), column_entries.size());
+            row_indices.insert(row_indices.end(), indices.begin(), indices.end());
+            values.insert(values.end(), column_entries.begin(), column_entries.end());
+            column_starts.push_back(static_cast<int64_t>(row_indices.size()));
+            num_cols++;
+        }
+
+        /// @brief Returns the transpose, i.e. the row-wise (CSR) representation of this matrix.
+        ///
+        /// Uses a counting sort, so the column indices within every row of the result are sorted.
+        [[nodiscard]] CscMatrix transpose() const
+        {
+            CscMatrix result;
+            result.setup(num_cols, num_rows, num_non_zeros());
+
+            std::vector<int64_t>& starts = result.column_starts;
+            for (int64_t k = 0; k < num_non_zeros(); k++)
+            {
+                starts[row_indices[k] + 1]++;
+            }
+            for (int64_t i = 0; i < num_rows; i++)
+            {
+                starts[i + 1] += starts[i];
+            }
+
+            std::vector<int64_t> next(starts.begin(), starts.end() - 1);
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                for (int64_t k = column_starts[j]; k < column_starts[j + 1]; k++)
+                {
+                    const int64_t position = next[row_indices[k]]++;
+                    result.row_indices[position] = j;
+                    result.values[position] = values[k];
+                }
+            }
+            return result;
+        }
+
+        /// @brief Checks structural and numerical equality.
+        bool operator==(const CscMatrix& other) const = default;
+    };
+}
+
+#endif // KALIX_LP_SPARSE_MATRIX_H_
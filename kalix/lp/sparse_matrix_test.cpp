@@ -0,0 +1,92 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "kalix/lp/sparse_matrix.h"
+
+namespace
+{
+    // [ 1 0 2 ]
+    // [ 0 3 0 ]
+    kalix::lp::CscMatrix make_matrix()
+    {
+        kalix::lp::CscMatrix matrix;
+        matrix.num_rows = 2;
+        matrix.append_column(std::vector<int64_t>{0}, std::vector<double>{1.0});
+        matrix.append_column(std::vector<int64_t>{1}, std::vector<double>{3.0});
+        matrix.append_column(std::vector<int64_t>{0}, std::vector<double>{2.0});
+        return matrix;
+    }
+}
+
+TEST(CscMatrixTest, DefaultIsEmpty)
+{
+    const kalix::lp::CscMatrix matrix;
+    EXPECT_EQ(matrix.num_rows, 0);
+    EXPECT_EQ(matrix.num_cols, 0);
+    EXPECT_EQ(matrix.num_non_zeros(), 0);
+}
+
+TEST(CscMatrixTest, AppendColumnAndAccessors)
+{
+    const auto matrix = make_matrix();
+    EXPECT_EQ(matrix.num_cols, 3);
+    EXPECT_EQ(matrix.num_non_zeros(), 3);
+    EXPECT_EQ(matrix.column_length(1), 1);
+    EXPECT_EQ(matrix.column_indices(1)[0], 1);
+    EXPECT_DOUBLE_EQ(matrix.column_values(2)[0], 2.0);
+}
+
+TEST(CscMatrixTest, SetupZeroesColumnStarts)
+{
+    kalix::lp::CscMatrix matrix;
+    matrix.setup(4, 3, 5);
+    EXPECT_EQ(matrix.column_starts, (std::vector<int64_t>{0, 0, 0, 0}));
+    EXPECT_EQ(matrix.row_indices.size(), 5u);
+}
+
+TEST(CscMatrixTest, TransposeProducesSortedRows)
+{
+    const auto matrix = make_matrix();
+    const auto transposed = matrix.transpose();
+
+    EXPECT_EQ(transposed.num_rows, 3);
+    EXPECT_EQ(transposed.num_cols, 2);
+    EXPECT_EQ(transposed.column_starts, (std::vector<int64_t>{0, 2, 3}));
+    EXPECT_EQ(transposed.row_indices, (std::vector<int64_t>{0, 2, 1}));
+    EXPECT_EQ(transposed.values, (std::vector<double>{1.0, 2.0, 3.0}));
+    EXPECT_EQ(transposed.transpose(), matrix);
+}
+
+TEST(CscMatrixTest, ViewRoundTrip)
+{
+    const auto matrix = make_matrix();
+    const kalix::lp::CscMatrixView view = matrix.view();
+
+    EXPECT_EQ(view.num_non_zeros(), 3);
+    EXPECT_EQ(view.column_length(0), 1);
+    EXPECT_EQ(view.column_indices(1)[0], 1);
+    EXPECT_DOUBLE_EQ(view.column_values(2)[0], 2.0);
+    EXPECT_EQ(view.values.data(), matrix.values.data());
+    EXPECT_EQ(kalix::lp::CscMatrix::from_view(view), matrix);
+}
@@ -0,0 +1,216 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_LP_TEST_PROGRAMS_H_
+#define KALIX_LP_TEST_PROGRAMS_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kalix/lp/linear_program.h"
+
+namespace kalix::lp
+{
+    /// @brief Constraint matrix given as dense rows.
+    using DenseMatrix = std::vector<std::vector<double>>;
+
+    inline LinearProgram make_program(const DenseMatrix& rows, const std::vector<double>& objective,
+                                      const std::vector<double>& column_lower,
+                                      const std::vector<double>& column_upper,
+                                      const std::vector<double>& row_lower, const std::vector<double>& row_upper)
+    {
+        LinearProgram program;
+        const auto num_cols = static_cast<int64_t>(objective.size());
+        const auto num_rows = static_cast<int64_t>(rows.size());
+        program.constraint_matrix.num_rows = num_rows;
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            std::vector<int64_t> indices;
+            std::vector<double> values;
+            for (int64_t i = 0; i < num_rows; i++)
+            {
+                if (rows[i][j] != 0.0)
+                {
+                    indices.push_back(i);
+                    values.push_back(rows[i][j]);
+                }
+            }
+            program.constraint_matrix.append_column(indices, values);
+        }
+        program.objective = objective;
+        program.column_lower = column_lower;
+        program.column_upper = column_upper;
+        program.row_lower = row_lower;
+        program.row_upper = row_upper;
+        return program;
+    }
+
+    /// @brief min -x - y  s.t.  x + 2y <= 4, 3x + y <= 6, x, y >= 0.
+    ///
+    /// Optimum at (8/5, 6/5) with objective -14/5 and row duals (-2/5, -1/5).
+    inline LinearProgram small_minimization_program()
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        return make_program({{1.0, 2.0}, {3.0, 1.0}}, {-1.0, -1.0}, {0.0, 0.0}, {kInfinity, kInfinity},
+                            {-kInfinity, -kInfinity}, {4.0, 6.0});
+    }
+
+    /// @brief max x + y + 10 over the rows of @ref small_minimization_program.
+    ///
+    /// Optimum at (8/5, 6/5) with objective 64/5 and row duals (2/5, 1/5).
+    inline LinearProgram small_maximization_program()
+    {
+        LinearProgram program = small_minimization_program();
+        program.sense = ObjectiveSense::kMaximize;
+        program.objective = {1.0, 1.0};
+        program.objective_offset = 10.0;
+        return program;
+    }
+
+    /// @brief min x + 2y + 3z  s.t.  x + y + z = 6, 1 <= y - z <= 2, 0 <= x <= 3, y, z >= 0.
+    ///
+    /// Optimum at (3, 5/2, 1/2) with objective 19/2: x is at its upper bound and the range is at
+    /// its lower end.
+    inline LinearProgram equality_and_ranged_program()
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        return make_program({{1.0, 1.0, 1.0}, {0.0, 1.0, -1.0}}, {1.0, 2.0, 3.0}, {0.0, 0.0, 0.0},
+                            {3.0, kInfinity, kInfinity}, {6.0, 1.0}, {6.0, 2.0});
+    }
+
+    /// @brief min y  s.t.  y - x >= -1, y + x >= 1, x + w <= 5 with x free, y >= -10 and w fixed
+    /// at 2.
+    ///
+    /// Optimum at (1, 0, 2), where the last row has activity 3.
+    inline LinearProgram free_and_fixed_program()
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        return make_program({{-1.0, 1.0, 0.0}, {1.0, 1.0, 0.0}, {1.0, 0.0, 1.0}}, {0.0, 1.0, 0.0},
+                            {-kInfinity, -10.0, 2.0}, {kInfinity, kInfinity, 2.0}, {-1.0, 1.0, -kInfinity},
+                            {kInfinity, kInfinity, 5.0});
+    }
+
+    /// @brief x + y = 3 with x, y in [0, 1], which has no solution.
+    inline LinearProgram infeasible_program()
+    {
+        return make_program({{1.0, 1.0}}, {1.0, 1.0}, {0.0, 0.0}, {1.0, 1.0}, {3.0}, {3.0});
+    }
+
+    /// @brief A random feasible program with boxed columns, built around a known feasible point.
+    inline LinearProgram random_program(std::mt19937& rng, const int num_rows, const int num_cols)
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        std::uniform_real_distribution<double> coefficient(-5.0, 5.0);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::uniform_int_distribution<int> kind(0, 3);
+
+        DenseMatrix rows(num_rows, std::vector<double>(num_cols, 0.0));
+        std::vector<double> objective(num_cols);
+        std::vector<double> column_lower(num_cols);
+        std::vector<double> column_upper(num_cols);
+        std::vector<double> point(num_cols);
+        for (int j = 0; j < num_cols; j++)
+        {
+            objective[j] = coefficient(rng);
+            column_lower[j] = -1.0 - 3.0 * unit(rng);
+            column_upper[j] = 1.0 + 3.0 * unit(rng);
+            point[j] = column_lower[j] + (column_upper[j] - column_lower[j]) * unit(rng);
+        }
+        std::vector<double> row_lower(num_rows);
+        std::vector<double> row_upper(num_rows);
+        for (int i = 0; i < num_rows; i++)
+        {
+            double activity = 0.0;
+            for (int j = 0; j < num_cols; j++)
+            {
+                if (unit(rng) < 0.3)
+                {
+                    rows[i][j] = coefficient(rng);
+                    activity += rows[i][j] * point[j];
+                }
+            }
+            switch (kind(rng))
+            {
+            case 0:
+                row_lower[i] = activity;
+                row_upper[i] = activity;
+                break;
+            case 1:
+                row_lower[i] = activity - unit(rng);
+                row_upper[i] = kInfinity;
+                break;
+            case 2:
+                row_lower[i] = -kInfinity;
+                row_upper[i] = activity + unit(rng);
+                break;
+            default:
+                row_lower[i] = activity - unit(rng);
+                row_upper[i] = activity + unit(rng);
+                break;
+            }
+        }
+        return make_program(rows, objective, column_lower, column_upper, row_lower, row_upper);
+    }
+
+    /// @brief Checks that @p result holds an optimal primal-dual pair of @p program: the primal is
+    /// feasible, and the duals prove a bound on the objective that the primal attains.
+    ///
+    /// @p result needs the members @c primal, @c reduced_costs, @c row_activity, @c dual and
+    /// @c objective, as the results of the interior point and PDHG solvers have.
+    template <typename Result>
+    void expect_optimal_primal_dual_pair(const LinearProgram& program, const Result& result, const double tolerance)
+    {
+        // A multiplier on the bound pair [lower, upper] adds this to the dual objective. A
+        // multiplier pointing at an infinite bound makes the bound useless.
+        const auto bound_term = [tolerance](const double multiplier, const double lower, const double upper)
+        {
+            if (std::abs(multiplier) <= tolerance)
+            {
+                return 0.0;
+            }
+            const double bound = multiplier > 0.0 ? lower : upper;
+            return std::isinf(bound) ? -std::numeric_limits<double>::infinity() : multiplier * bound;
+        };
+
+        const double sense = program.sense == ObjectiveSense::kMaximize ? -1.0 : 1.0;
+        double dual_objective = program.objective_offset;
+        for (int64_t j = 0; j < program.num_cols(); j++)
+        {
+            EXPECT_GE(result.primal[j], program.column_lower[j] - tolerance);
+            EXPECT_LE(result.primal[j], program.column_upper[j] + tolerance);
+            dual_objective += sense * bound_term(sense * result.reduced_costs[j], program.column_lower[j],
+                                                 program.column_upper[j]);
+        }
+        for (int64_t i = 0; i < program.num_rows(); i++)
+        {
+            EXPECT_GE(result.row_activity[i], program.row_lower[i] - tolerance);
+            EXPECT_LE(result.row_activity[i], program.row_upper[i] + tolerance);
+            dual_objective += sense * bound_term(sense * result.dual[i], program.row_lower[i], program.row_upper[i]);
+        }
+        EXPECT_NEAR(result.objective, dual_objective, tolerance * (1.0 + std::abs(result.objective)));
+    }
+}
+
+#endif // KALIX_LP_TEST_PROGRAMS_H_
@@ -0,0 +1,539 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/pdlp/pdhg.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "kalix/base/compensated_double.h"
+
+namespace kalix::pdlp
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        /// @brief Number of entries per task of the dense vector loops. Fixed, so that partial sums
+        /// do not depend on the number of threads.
+        constexpr int64_t kBlockSize = 4096;
+
+        lp::CscMatrix scaled_matrix(const lp::LinearProgram& program, const lp::Scaling& scaling)
+        {
+            lp::CscMatrix matrix = program.constraint_matrix;
+            scaling.scale_matrix(matrix);
+            return matrix;
+        }
+
+        lp::MatrixOperatorOptions operator_options(const PdhgOptions& options)
+        {
+            lp::MatrixOperatorOptions result;
+            result.scheduler = options.scheduler;
+            return result;
+        }
+
+        /// @brief Returns the violation of @c lower <= value <= upper.
+        double violation(const double value, const double lower, const double upper)
+        {
+            if (value < lower)
+            {
+                return lower - value;
+            }
+            return value > upper ? value - upper : 0.0;
+        }
+    }
+
+    PdhgSolver::PdhgSolver(const lp::LinearProgram& program, const PdhgOptions& options)
+        : options_(options), objective_offset_(program.objective_offset), num_rows_(program.num_rows()),
+          num_cols_(program.num_cols()),
+          scaling_(options.scale
+                       ? lp::Scaling::compute(program.constraint_matrix, options.scaling)
+                       : lp::Scaling::identity(program.num_rows(), program.num_cols())),
+          operator_(scaled_matrix(program, scaling_), operator_options(options))
+    {
+        sense_ = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+        const std::span<const double> row_scales = scaling_.row_scales();
+        const std::span<const double> column_scales = scaling_.column_scales();
+        cost_.resize(num_cols_);
+        column_lower_.resize(num_cols_);
+        column_upper_.resize(num_cols_);
+        row_lower_.resize(num_rows_);
+        row_upper_.resize(num_rows_);
+        CompensatedDouble cost_norm(0.0);
+        CompensatedDouble bound_norm(0.0);
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            cost_[j] = sense_ * program.objective[j] * column_scales[j];
+            column_lower_[j] = program.column_lower[j] / column_scales[j];
+            column_upper_[j] = program.column_upper[j] / column_scales[j];
+            cost_norm += program.objective[j] * program.objective[j];
+        }
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            row_lower_[i] = program.row_lower[i] * row_scales[i];
+            row_upper_[i] = program.row_upper[i] * row_scales[i];
+            // The larger finite bound stands for the right-hand side of the row.
+            double bound = 0.0;
+            if (std::isfinite(program.row_lower[i]))
+            {
+                bound = std::abs(program.row_lower[i]);
+            }
+            if (std::isfinite(program.row_upper[i]))
+            {
+                bound = std::max(bound, std::abs(program.row_upper[i]));
+            }
+            bound_norm += bound * bound;
+        }
+        cost_norm_ = std::sqrt(static_cast<double>(cost_norm));
+        bound_norm_ = std::sqrt(static_cast<double>(bound_norm));
+
+        for (Iterate* iterate : {&current_, &next_, &average_, &sum_})
+        {
+            resize(*iterate);
+        }
+        last_restart_x_.assign(num_cols_, 0.0);
+        last_restart_y_.assign(num_rows_, 0.0);
+    }
+
+    template <typename Body>
+    void PdhgSolver::for_blocks(const int64_t size, Body&& body) const
+    {
+        const int64_t num_blocks = (size + kBlockSize - 1) / kBlockSize;
+        const auto block = [&](const int64_t b)
+        {
+            body(b * kBlockSize, std::min(size, (b + 1) * kBlockSize));
+        };
+        parallel_for(options_.scheduler, 0, num_blocks, 1, block);
+    }
+
+    template <typename Body>
+    double PdhgSolver::sum_blocks(const int64_t size, Body&& body) const
+    {
+        const int64_t num_blocks = (size + kBlockSize - 1) / kBlockSize;
+        partial_sums_.assign(num_blocks, 0.0);
+        for_blocks(size, [&](const int64_t begin, const int64_t end)
+        {
+            partial_sums_[begin / kBlockSize] = body(begin, end);
+        });
+        double sum = 0.0;
+        for (const double partial : partial_sums_)
+        {
+            sum += partial;
+        }
+        return sum;
+    }
+
+    void PdhgSolver::resize(Iterate& iterate) const
+    {
+        iterate.x.assign(num_cols_, 0.0);
+        iterate.y.assign(num_rows_, 0.0);
+        iterate.ax.assign(num_rows_, 0.0);
+        iterate.aty.assign(num_cols_, 0.0);
+    }
+
+    PdhgResult PdhgSolver::solve()
+    {
+        PdhgResult result;
+        iterations_ = 0;
+
+        // Start at the point of the box closest to zero.
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            current_.x[j] = std::clamp(0.0, column_lower_[j], std::max(column_lower_[j], column_upper_[j]));
+        }
+        std::ranges::fill(current_.y, 0.0);
+        operator_.multiply(current_.x, current_.ax);
+        std::ranges::fill(current_.aty, 0.0);
+
+        // The step size starts at 1 / max |a_ij|, a lower bound of 1 / ||A||_2 up to the number of
+        // entries per line, and adapts from there.
+        const double largest_entry = operator_.max_abs_value();
+        step_size_ = largest_entry > 0.0 ? 1.0 / largest_entry : 1.0;
+        primal_weight_ = cost_norm_ > 1e-10 && bound_norm_ > 1e-10 ? cost_norm_ / bound_norm_ : 1.0;
+
+        restart(current_);
+        double last_restart_error = weighted_error(evaluate(current_, false));
+        double previous_candidate_error = kInfinity;
+        int64_t last_restart_iteration = 0;
+
+        while (true)
+        {
+            const Measures current_measures = evaluate(current_, true);
+            compute_average();
+            const Measures average_measures = weight_sum_ > 0.0 ? evaluate(average_, true) : current_measures;
+            for (const Measures* measures : {&current_measures, &average_measures})
+            {
+                if (!std::isfinite(measures->primal_residual) || !std::isfinite(measures->dual_residual) ||
+                    !std::isfinite(measures->primal_objective))
+                {
+                    result.status = PdhgStatus::kNumericalFailure;
+                    extract_result(current_, result);
+                    return result;
+                }
+            }
+            if (is_optimal(current_measures) || is_optimal(average_measures))
+            {
+                result.status = PdhgStatus::kOptimal;
+                extract_result(is_optimal(current_measures) ? current_ : average_, result);
+                return result;
+            }
+            if (iterations_ >= options_.max_iterations)
+            {
+                extract_result(current_, result);
+                return result;
+            }
+
+            // Restart from the better of the two candidates once the error has dropped enough.
+            if (weight_sum_ == 0.0)
+            {
+                take_evaluation_steps();
+                continue;
+            }
+            const double current_error = weighted_error(evaluate(current_, false));
+            const double average_error = weighted_error(evaluate(average_, false));
+            const bool use_average = average_error < current_error;
+            const double candidate_error = std::min(current_error, average_error);
+            const bool sufficient = candidate_error <= options_.sufficient_restart_reduction * last_restart_error;
+            const bool necessary = candidate_error <= options_.necessary_restart_reduction * last_restart_error &&
+                candidate_error > previous_candidate_error;
+            const bool artificial = static_cast<double>(iterations_ - last_restart_iteration) >=
+                options_.artificial_restart_fraction * static_cast<double>(iterations_);
+            if (sufficient || necessary || artificial)
+            {
+                if (use_average)
+                {
+                    std::swap(current_, average_);
+                }
+                restart(current_);
+                result.restarts++;
+                last_restart_iteration = iterations_;
+                last_restart_error = weighted_error(evaluate(current_, false));
+                previous_candidate_error = kInfinity;
+            }
+            else
+            {
+                previous_candidate_error = candidate_error;
+            }
+
+            take_evaluation_steps();
+        }
+    }
+
+    void PdhgSolver::take_evaluation_steps()
+    {
+        for (int64_t k = 0; k < options_.evaluation_frequency && iterations_ < options_.max_iterations; k++)
+        {
+            while (!take_step() && iterations_ < options_.max_iterations)
+            {
+            }
+        }
+    }
+
+    bool PdhgSolver::take_step()
+    {
+        iterations_++;
+        const double primal_step = step_size_ / primal_weight_;
+        const double dual_step = step_size_ * primal_weight_;
+
+        // x' = proj(x - tau (c - A^T y))
+        const double primal_movement = sum_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t j = begin; j < end; j++)
+            {
+                const double value = current_.x[j] - primal_step * (cost_[j] - current_.aty[j]);
+                next_.x[j] = std::min(std::max(value, column_lower_[j]), column_upper_[j]);
+                const double delta = next_.x[j] - current_.x[j];
+                sum += delta * delta;
+            }
+            return sum;
+        });
+        operator_.multiply(next_.x, next_.ax);
+
+        // y' = y - sigma w + sigma proj(w - y / sigma) with the extrapolation w = A (2x' - x): the
+        // projection onto the row bounds makes y' the correct sign for every bound.
+        const double dual_movement = sum_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                const double extrapolated = 2.0 * next_.ax[i] - current_.ax[i];
+                const double shifted = extrapolated - current_.y[i] / dual_step;
+                const double projected = std::min(std::max(shifted, row_lower_[i]), row_upper_[i]);
+                next_.y[i] = dual_step * (projected - shifted);
+                const double delta = next_.y[i] - current_.y[i];
+                sum += delta * delta;
+            }
+            return sum;
+        });
+        operator_.multiply_transposed(next_.y, next_.aty);
+
+        const double interaction = std::abs(sum_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                sum += (next_.y[i] - current_.y[i]) * (next_.ax[i] - current_.ax[i]);
+            }
+            return sum;
+        }));
+
+        // The largest step size that satisfies the convergence condition for this step.
+        const double movement = primal_weight_ * primal_movement + dual_movement / primal_weight_;
+        const double step_limit = interaction > 0.0 ? movement / (2.0 * interaction) : kInfinity;
+        const auto k = static_cast<double>(iterations_);
+        const double new_step_size =
+            std::min((1.0 - std::pow(k + 1.0, -0.3)) * step_limit, (1.0 + std::pow(k + 1.0, -0.6)) * step_size_);
+        const bool accepted = step_size_ <= step_limit;
+        if (accepted)
+        {
+            std::swap(current_, next_);
+            add_to_average(step_size_);
+        }
+        step_size_ = new_step_size;
+        return accepted;
+    }
+
+    void PdhgSolver::add_to_average(const double weight)
+    {
+        weight_sum_ += weight;
+        for_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            for (int64_t j = begin; j < end; j++)
+            {
+                sum_.x[j] += weight * current_.x[j];
+                sum_.aty[j] += weight * current_.aty[j];
+            }
+        });
+        for_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            for (int64_t i = begin; i < end; i++)
+            {
+                sum_.y[i] += weight * current_.y[i];
+                sum_.ax[i] += weight * current_.ax[i];
+            }
+        });
+    }
+
+    void PdhgSolver::compute_average()
+    {
+        if (weight_sum_ <= 0.0)
+        {
+            return;
+        }
+        // Products are linear, so averaging them gives the products of the average.
+        const double scale = 1.0 / weight_sum_;
+        for_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            for (int64_t j = begin; j < end; j++)
+            {
+                average_.x[j] = scale * sum_.x[j];
+                average_.aty[j] = scale * sum_.aty[j];
+            }
+        });
+        for_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            for (int64_t i = begin; i < end; i++)
+            {
+                average_.y[i] = scale * sum_.y[i];
+                average_.ax[i] = scale * sum_.ax[i];
+            }
+        });
+    }
+
+    PdhgSolver::Measures PdhgSolver::evaluate(const Iterate& iterate, const bool unscaled) const
+    {
+        // Unscaling multiplies row quantities by 1 / R and column quantities by 1 / C, see
+        // lp::Scaling. Objective values are invariant.
+        const std::span<const double> row_scales = scaling_.row_scales();
+        const std::span<const double> column_scales = scaling_.column_scales();
+        Measures measures;
+        measures.primal_residual = std::sqrt(sum_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                double residual = violation(iterate.ax[i], row_lower_[i], row_upper_[i]);
+                if (unscaled)
+                {
+                    residual /= row_scales[i];
+                }
+                sum += residual * residual;
+            }
+            return sum;
+        }));
+        measures.dual_residual = std::sqrt(sum_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t j = begin; j < end; j++)
+            {
+                const double reduced_cost = cost_[j] - iterate.aty[j];
+                double residual = 0.0;
+                if (reduced_cost > 0.0 && column_lower_[j] == -kInfinity)
+                {
+                    residual = reduced_cost;
+                }
+                else if (reduced_cost < 0.0 && column_upper_[j] == kInfinity)
+                {
+                    residual = -reduced_cost;
+                }
+                if (unscaled)
+                {
+                    residual /= column_scales[j];
+                }
+                sum += residual * residual;
+            }
+            return sum;
+        }));
+        measures.primal_objective = objective_offset_ + sense_ * sum_blocks(num_cols_, [&](const int64_t begin,
+                                                                                         const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t j = begin; j < end; j++)
+            {
+                sum += cost_[j] * iterate.x[j];
+            }
+            return sum;
+        });
+        const double column_part = sum_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t j = begin; j < end; j++)
+            {
+                const double reduced_cost = cost_[j] - iterate.aty[j];
+                if (reduced_cost > 0.0 && column_lower_[j] > -kInfinity)
+                {
+                    sum += reduced_cost * column_lower_[j];
+                }
+                else if (reduced_cost < 0.0 && column_upper_[j] < kInfinity)
+                {
+                    sum += reduced_cost * column_upper_[j];
+                }
+            }
+            return sum;
+        });
+        // The projection in the dual update gives every dual the sign of a finite bound.
+        const double row_part = sum_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                if (iterate.y[i] > 0.0)
+                {
+                    sum += iterate.y[i] * row_lower_[i];
+                }
+                else if (iterate.y[i] < 0.0)
+                {
+                    sum += iterate.y[i] * row_upper_[i];
+                }
+            }
+            return sum;
+        });
+        measures.dual_objective = objective_offset_ + sense_ * (column_part + row_part);
+        return measures;
+    }
+
+    double PdhgSolver::weighted_error(const Measures& measures) const
+    {
+        const double gap = measures.primal_objective - measures.dual_objective;
+        return std::sqrt(primal_weight_ * measures.primal_residual * measures.primal_residual +
+                         measures.dual_residual * measures.dual_residual / primal_weight_ + gap * gap);
+    }
+
+    bool PdhgSolver::is_optimal(const Measures& measures) const
+    {
+        const double tolerance = options_.optimality_tolerance;
+        const double gap = std::abs(measures.primal_objective - measures.dual_objective);
+        return measures.primal_residual <= tolerance * (1.0 + bound_norm_) &&
+            measures.dual_residual <= tolerance * (1.0 + cost_norm_) &&
+            gap <= tolerance * (1.0 + std::abs(measures.primal_objective) + std::abs(measures.dual_objective));
+    }
+
+    void PdhgSolver::restart(const Iterate& from)
+    {
+        // The primal weight balances the distances travelled in primal and dual space since the
+        // last restart, smoothed in log space.
+        const double primal_distance = std::sqrt(sum_blocks(num_cols_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t j = begin; j < end; j++)
+            {
+                const double delta = from.x[j] - last_restart_x_[j];
+                sum += delta * delta;
+            }
+            return sum;
+        }));
+        const double dual_distance = std::sqrt(sum_blocks(num_rows_, [&](const int64_t begin, const int64_t end)
+        {
+            double sum = 0.0;
+            for (int64_t i = begin; i < end; i++)
+            {
+                const double delta = from.y[i] - last_restart_y_[i];
+                sum += delta * delta;
+            }
+            return sum;
+        }));
+        if (primal_distance > 1e-10 && dual_distance > 1e-10)
+        {
+            const double theta = options_.primal_weight_smoothing;
+            primal_weight_ = std::exp(theta * std::log(dual_distance / primal_distance) +
+                                      (1.0 - theta) * std::log(primal_weight_));
+        }
+        std::ranges::copy(from.x, last_restart_x_.begin());
+        std::ranges::copy(from.y, last_restart_y_.begin());
+        weight_sum_ = 0.0;
+        std::ranges::fill(sum_.x, 0.0);
+        std::ranges::fill(sum_.y, 0.0);
+        std::ranges::fill(sum_.ax, 0.0);
+        std::ranges::fill(sum_.aty, 0.0);
+    }
+
+    void PdhgSolver::extract_result(const Iterate& iterate, PdhgResult& result) const
+    {
+        const std::span<const double> row_scales = scaling_.row_scales();
+        const std::span<const double> column_scales = scaling_.column_scales();
+        result.iterations = iterations_;
+        result.primal.resize(num_cols_);
+        result.reduced_costs.resize(num_cols_);
+        CompensatedDouble objective(objective_offset_);
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            result.primal[j] = iterate.x[j] * column_scales[j];
+            result.reduced_costs[j] = sense_ * (cost_[j] - iterate.aty[j]) / column_scales[j];
+            objective += sense_ * cost_[j] * iterate.x[j];
+        }
+        result.objective = static_cast<double>(objective);
+        result.row_activity.resize(num_rows_);
+        result.dual.resize(num_rows_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            result.row_activity[i] = iterate.ax[i] / row_scales[i];
+            result.dual[i] = sense_ * iterate.y[i] * row_scales[i];
+        }
+
+        const Measures measures = evaluate(iterate, true);
+        result.primal_infeasibility = measures.primal_residual / (1.0 + bound_norm_);
+        result.dual_infeasibility = measures.dual_residual / (1.0 + cost_norm_);
+        result.relative_gap = std::abs(measures.primal_objective - measures.dual_objective) /
+            (1.0 + std::abs(measures.primal_objective) + std::abs(measures.dual_objective));
+    }
+}
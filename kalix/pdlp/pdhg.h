@@ -0,0 +1,221 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_PDLP_PDHG_H_
+#define KALIX_PDLP_PDHG_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "kalix/base/aligned_allocator.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/lp/matrix_operator.h"
+#include "kalix/lp/scaling.h"
+
+namespace kalix::pdlp
+{
+    /// @brief Options of @ref PdhgSolver.
+    struct PdhgOptions
+    {
+        /// @brief Scheduler used for the matrix-vector products and the vector updates. Runs
+        /// serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Relative tolerance of the primal residual, the dual residual and the duality gap.
+        double optimality_tolerance = 1e-6;
+
+        /// @brief Maximum number of iterations, counting rejected step sizes.
+        int64_t max_iterations = 200000;
+
+        /// @brief Number of iterations between two evaluations of the termination and restart
+        /// criteria. Every evaluation costs about as much as an iteration.
+        int64_t evaluation_frequency = 64;
+
+        /// @brief Whether the program is scaled before solving. The scale factors are the
+        /// diagonal preconditioner of the method.
+        bool scale = true;
+
+        /// @brief Options of the scaling.
+        lp::ScalingOptions scaling;
+
+        /// @brief Weight of the new estimate when the primal weight is updated at a restart.
+        double primal_weight_smoothing = 0.5;
+
+        /// @brief Restart once the error drops below this fraction of the error at the last restart.
+        double sufficient_restart_reduction = 0.2;
+
+        /// @brief Restart once the error is below this fraction of the error at the last restart
+        /// and has started to grow again.
+        double necessary_restart_reduction = 0.8;
+
+        /// @brief Restart once the iterations since the last restart exceed this fraction of all
+        /// iterations.
+        double artificial_restart_fraction = 0.36;
+    };
+
+    /// @brief Termination status of @ref PdhgSolver::solve.
+    enum class PdhgStatus : int8_t
+    {
+        /// @brief All optimality measures are within the tolerance.
+        kOptimal,
+
+        /// @brief The iteration limit was reached. Infeasible and unbounded programs end here.
+        kIterationLimit,
+
+        /// @brief The iterates are no longer finite.
+        kNumericalFailure,
+    };
+
+    /// @brief Solution computed by @ref PdhgSolver.
+    struct PdhgResult
+    {
+        /// @brief Why the solver stopped.
+        PdhgStatus status = PdhgStatus::kIterationLimit;
+
+        /// @brief Number of iterations performed, counting rejected step sizes.
+        int64_t iterations = 0;
+
+        /// @brief Number of restarts.
+        int64_t restarts = 0;
+
+        /// @brief Value of every column.
+        std::vector<double> primal;
+
+        /// @brief Activity @c Ax of every row.
+        std::vector<double> row_activity;
+
+        /// @brief Dual value of every row.
+        std::vector<double> dual;
+
+        /// @brief Reduced cost @c c - A^T y of every column.
+        std::vector<double> reduced_costs;
+
+        /// @brief Objective value of @ref primal, including the offset.
+        double objective = 0.0;
+
+        /// @brief Euclidean norm of the row bound violations, relative to the bounds.
+        double primal_infeasibility = 0.0;
+
+        /// @brief Euclidean norm of the reduced cost sign violations, relative to the cost.
+        double dual_infeasibility = 0.0;
+
+        /// @brief Difference between primal and dual objective, relative to their magnitude.
+        double relative_gap = 0.0;
+    };
+
+    /// @brief Restarted primal-dual hybrid gradient method for linear programs, as in PDLP.
+    ///
+    /// The method needs no factorization: an iteration is one product with @c A and one with
+    /// @c A^T plus a few vector updates, all of which run in parallel through a
+    /// @ref lp::MatrixOperator. Memory stays linear in the size of the program, which makes it
+    /// the method of choice for programs too large to factorize: besides the dense vectors, the
+    /// solver holds only the scaled matrix, once row-wise and once column-wise, in the storage
+    /// described at @ref lp::MatrixOperator.
+    ///
+    /// - Preconditioning: the program is scaled with @ref lp::Scaling.
+    /// - Adaptive steps: the step size is the largest one for which the step does not violate
+    ///   the convergence condition locally, so no estimate of @c ||A|| is needed.
+    /// - Restarts: every @ref PdhgOptions::evaluation_frequency iterations the current and the
+    ///   averaged iterate are compared by their KKT error. The method restarts from the better one
+    ///   once the error has dropped enough since the last restart, and rebalances the primal and
+    ///   dual step sizes at that point.
+    ///
+    /// All dense vectors are cache-line aligned, and all reductions are summed in fixed blocks, so
+    /// the result does not depend on the number of threads.
+    class PdhgSolver
+    {
+    public:
+        /// @brief Prepares the solver. The program is copied.
+        explicit PdhgSolver(const lp::LinearProgram& program, const PdhgOptions& options = {});
+
+        /// @brief Runs the method.
+        [[nodiscard]] PdhgResult solve();
+
+    private:
+        using DenseVector = AlignedVector<double>;
+
+        /// @brief A primal-dual point together with its matrix-vector products.
+        struct Iterate
+        {
+            DenseVector x;
+            DenseVector y;
+            DenseVector ax;
+            DenseVector aty;
+        };
+
+        /// @brief Optimality measures of an iterate.
+        struct Measures
+        {
+            double primal_residual = 0.0;
+            double dual_residual = 0.0;
+            double primal_objective = 0.0;
+            double dual_objective = 0.0;
+        };
+
+        template <typename Body>
+        void for_blocks(int64_t size, Body&& body) const;
+        template <typename Body>
+        [[nodiscard]] double sum_blocks(int64_t size, Body&& body) const;
+
+        void resize(Iterate& iterate) const;
+        [[nodiscard]] bool take_step();
+        void take_evaluation_steps();
+        void add_to_average(double weight);
+        void compute_average();
+        [[nodiscard]] Measures evaluate(const Iterate& iterate, bool unscaled) const;
+        [[nodiscard]] double weighted_error(const Measures& measures) const;
+        [[nodiscard]] bool is_optimal(const Measures& measures) const;
+        void restart(const Iterate& from);
+        void extract_result(const Iterate& iterate, PdhgResult& result) const;
+
+        PdhgOptions options_;
+        double sense_ = 1.0;
+        double objective_offset_ = 0.0;
+        int64_t num_rows_ = 0;
+        int64_t num_cols_ = 0;
+
+        lp::Scaling scaling_;
+        lp::MatrixOperator operator_;
+        DenseVector cost_;
+        DenseVector column_lower_;
+        DenseVector column_upper_;
+        DenseVector row_lower_;
+        DenseVector row_upper_;
+        double bound_norm_ = 0.0;
+        double cost_norm_ = 0.0;
+
+        Iterate current_;
+        Iterate next_;
+        Iterate average_;
+        Iterate sum_;
+        double weight_sum_ = 0.0;
+        DenseVector last_restart_x_;
+        DenseVector last_restart_y_;
+
+        double step_size_ = 1.0;
+        double primal_weight_ = 1.0;
+        int64_t iterations_ = 0;
+        mutable std::vector<double> partial_sums_;
+    };
+}
+
+#endif // KALIX_PDLP_PDHG_H_
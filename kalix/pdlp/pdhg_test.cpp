@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/pdlp/pdhg.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/test_programs.h"
+
+namespace kalix::pdlp
+{
+    namespace
+    {
+        constexpr double kTolerance = 1e-4;
+
+        void expect_optimal(const lp::LinearProgram& program, const PdhgResult& result)
+        {
+            ASSERT_EQ(result.status, PdhgStatus::kOptimal);
+            lp::expect_optimal_primal_dual_pair(program, result, kTolerance);
+        }
+    }
+
+    TEST(PdhgTest, SolvesSmallMinimization)
+    {
+        const lp::LinearProgram program = lp::small_minimization_program();
+        const PdhgResult result = PdhgSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 1.6, kTolerance);
+        EXPECT_NEAR(result.primal[1], 1.2, kTolerance);
+        EXPECT_NEAR(result.objective, -2.8, kTolerance);
+        EXPECT_NEAR(result.dual[0], -0.4, kTolerance);
+        EXPECT_NEAR(result.dual[1], -0.2, kTolerance);
+        EXPECT_LE(result.primal_infeasibility, 1e-6);
+        EXPECT_LE(result.dual_infeasibility, 1e-6);
+        EXPECT_LE(result.relative_gap, 1e-6);
+    }
+
+    TEST(PdhgTest, SolvesMaximizationWithOffset)
+    {
+        const lp::LinearProgram program = lp::small_maximization_program();
+        const PdhgResult result = PdhgSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.objective, 12.8, kTolerance);
+        EXPECT_NEAR(result.dual[0], 0.4, kTolerance);
+        EXPECT_NEAR(result.dual[1], 0.2, kTolerance);
+    }
+
+    TEST(PdhgTest, HandlesEqualityAndRangedRows)
+    {
+        const lp::LinearProgram program = lp::equality_and_ranged_program();
+        const PdhgResult result = PdhgSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 3.0, kTolerance);
+        EXPECT_NEAR(result.primal[1], 2.5, kTolerance);
+        EXPECT_NEAR(result.primal[2], 0.5, kTolerance);
+        EXPECT_NEAR(result.objective, 9.5, kTolerance);
+    }
+
+    TEST(PdhgTest, HandlesFreeAndFixedColumns)
+    {
+        const lp::LinearProgram program = lp::free_and_fixed_program();
+        const PdhgResult result = PdhgSolver(program).solve();
+        expect_optimal(program, result);
+        EXPECT_NEAR(result.primal[0], 1.0, kTolerance);
+        EXPECT_NEAR(result.primal[1], 0.0, kTolerance);
+        EXPECT_EQ(result.primal[2], 2.0);
+    }
+
+    TEST(PdhgTest, DoesNotReportInfeasibleProgramAsOptimal)
+    {
+        const lp::LinearProgram program = lp::infeasible_program();
+        PdhgOptions options;
+        options.max_iterations = 2000;
+        const PdhgResult result = PdhgSolver(program, options).solve();
+        EXPECT_EQ(result.status, PdhgStatus::kIterationLimit);
+        EXPECT_EQ(result.iterations, 2000);
+    }
+
+    TEST(PdhgTest, SolvesRandomPrograms)
+    {
+        std::mt19937 rng(7);
+        for (int trial = 0; trial < 30; trial++)
+        {
+            const lp::LinearProgram program = lp::random_program(rng, 8, 12);
+            const PdhgResult result = PdhgSolver(program).solve();
+            expect_optimal(program, result);
+        }
+    }
+
+    TEST(PdhgTest, SolvesUnscaledProgram)
+    {
+        std::mt19937 rng(5);
+        const lp::LinearProgram program = lp::random_program(rng, 10, 15);
+        PdhgOptions options;
+        options.scale = false;
+        const PdhgResult result = PdhgSolver(program, options).solve();
+        expect_optimal(program, result);
+    }
+
+    class PdhgThreadTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(PdhgThreadTest, MatchesSerialIterates)
+    {
+        std::mt19937 rng(11);
+        const lp::LinearProgram program = lp::random_program(rng, 120, 200);
+        // The residual norms grow with the number of rows; a tighter tolerance keeps every single
+        // row within the tolerance of the test.
+        PdhgOptions options;
+        options.optimality_tolerance = 1e-8;
+        const PdhgResult serial = PdhgSolver(program, options).solve();
+
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        options.scheduler = &scheduler;
+        const PdhgResult parallel = PdhgSolver(program, options).solve();
+        expect_optimal(program, parallel);
+        EXPECT_GT(parallel.restarts, 0);
+        EXPECT_EQ(serial.iterations, parallel.iterations);
+        EXPECT_EQ(serial.primal, parallel.primal);
+        EXPECT_EQ(serial.dual, parallel.dual);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, PdhgThreadTest, ::testing::Values(1, 4));
+}
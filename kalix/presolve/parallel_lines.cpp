@@ -0,0 +1,272 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/parallel_lines.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "absl/hash/hash.h"
+#include "absl/log/check.h"
+#include "kalix/base/compensated_double.h"
+#include "kalix/base/config.h"
+
+namespace kalix::presolve
+{
+    namespace
+    {
+        // Mantissa bits dropped from the normalized values before hashing, so that values that
+        // differ by rounding errors of the normalization still hash equally in most cases.
+        constexpr int kDroppedMantissaBits = 20;
+
+        // Average number of lines per partition of the candidate buckets.
+        constexpr int64_t kLinesPerPartition = 4096;
+
+        KALIX_FORCE_INLINE uint64_t quantize(const double value)
+        {
+            // Adding zero maps -0.0 to 0.0.
+            const auto bits = std::bit_cast<uint64_t>(value + 0.0);
+            return (bits + (uint64_t{1} << (kDroppedMantissaBits - 1))) >> kDroppedMantissaBits;
+        }
+
+        /// @brief A sorted line with its quantized normalized values, hashed with absl.
+        struct NormalizedLine
+        {
+            std::span<const int64_t> indices;
+            std::span<const uint64_t> keys;
+            uint64_t extra_key;
+
+            template <typename H>
+            friend H AbslHashValue(H state, const NormalizedLine& line)
+            {
+                state = H::combine_contiguous(std::move(state), line.indices.data(), line.indices.size());
+                state = H::combine_contiguous(std::move(state), line.keys.data(), line.keys.size());
+                return H::combine(std::move(state), line.extra_key);
+            }
+        };
+
+        /// @brief Sorted copies of all lines with their hashes.
+        class LineTable
+        {
+        public:
+            LineTable(const lp::CscMatrixView& lines, const std::span<const double> extra,
+                      const ParallelLineOptions& options)
+                : lines_(lines), extra_(extra), options_(options)
+            {
+                const int64_t num_non_zeros = lines.num_non_zeros();
+                indices_.resize(num_non_zeros);
+                values_.resize(num_non_zeros);
+                keys_.resize(num_non_zeros);
+                hashes_.resize(lines.num_cols);
+            }
+
+            void build()
+            {
+                parallel_for(options_.scheduler, 0, lines_.num_cols, 0,
+                             [this](const int64_t line) { build_line(line); });
+            }
+
+            [[nodiscard]] int64_t length(const int64_t line) const
+            {
+                return lines_.column_length(line);
+            }
+
+            [[nodiscard]] uint64_t hash(const int64_t line) const
+            {
+                return hashes_[line];
+            }
+
+            /// @brief Returns whether @p line is a multiple of @p representative and sets @p scale.
+            [[nodiscard]] bool parallel(const int64_t representative, const int64_t line, double& scale) const
+            {
+                const int64_t begin = lines_.column_starts[line];
+                const int64_t representative_begin = lines_.column_starts[representative];
+                const int64_t count = length(line);
+                if (count != length(representative) ||
+                    std::memcmp(&indices_[begin], &indices_[representative_begin], count * sizeof(int64_t)) != 0)
+                {
+                    return false;
+                }
+
+                const CompensatedDouble ratio = CompensatedDouble(values_[begin]) / values_[representative_begin];
+                const double tolerance = options_.tolerance;
+                const auto matches = [&ratio, tolerance](const double value, const double reference)
+                {
+                    CompensatedDouble residual = ratio * reference;
+                    residual -= value;
+                    return std::abs(static_cast<double>(residual)) <= tolerance * std::abs(value);
+                };
+                for (int64_t t = 1; t < count; t++)
+                {
+                    if (!matches(values_[begin + t], values_[representative_begin + t]))
+                    {
+                        return false;
+                    }
+                }
+                if (!extra_.empty() && !matches(extra_[line], extra_[representative]))
+                {
+                    return false;
+                }
+                scale = static_cast<double>(ratio);
+                return true;
+            }
+
+        private:
+            void build_line(const int64_t line)
+            {
+                const int64_t begin = lines_.column_starts[line];
+                const int64_t count = length(line);
+                if (count == 0)
+                {
+                    return;
+                }
+                int64_t* indices = &indices_[begin];
+                double* values = &values_[begin];
+                std::copy_n(&lines_.row_indices[begin], count, indices);
+                std::copy_n(&lines_.values[begin], count, values);
+                if (!std::is_sorted(indices, indices + count))
+                {
+                    std::vector<int64_t> order(count);
+                    std::iota(order.begin(), order.end(), 0);
+                    std::ranges::sort(order, {}, [&](const int64_t t) { return lines_.row_indices[begin + t]; });
+                    for (int64_t t = 0; t < count; t++)
+                    {
+                        indices[t] = lines_.row_indices[begin + order[t]];
+                        values[t] = lines_.values[begin + order[t]];
+                    }
+                }
+
+                // A straight loop over contiguous values, which the compiler vectorizes.
+                const double first = values[0];
+                uint64_t* keys = &keys_[begin];
+                for (int64_t t = 0; t < count; t++)
+                {
+                    keys[t] = quantize(values[t] / first);
+                }
+                const uint64_t extra_key = extra_.empty() ? 0 : quantize(extra_[line] / first);
+                hashes_[line] = absl::HashOf(NormalizedLine{
+                    .indices = std::span<const int64_t>(indices, count),
+                    .keys = std::span<const uint64_t>(keys, count),
+                    .extra_key = extra_key,
+                });
+            }
+
+            const lp::CscMatrixView& lines_;
+            std::span<const double> extra_;
+            const ParallelLineOptions& options_;
+            std::vector<int64_t> indices_;
+            std::vector<double> values_;
+            std::vector<uint64_t> keys_;
+            std::vector<uint64_t> hashes_;
+        };
+    }
+
+    std::vector<ParallelLine> find_parallel_lines(const lp::CscMatrixView& lines, const std::span<const double> extra,
+                                                  const ParallelLineOptions& options)
+    {
+        CHECK(extra.empty() || static_cast<int64_t>(extra.size()) == lines.num_cols);
+        LineTable table(lines, extra, options);
+        table.build();
+
+        // Partition the non-empty lines by the top bits of their hash. Equal hashes always share a
+        // partition, so the partitions can be searched independently.
+        const int partition_bits = std::min(
+            static_cast<int>(std::bit_width(static_cast<uint64_t>(lines.num_cols / kLinesPerPartition))), 16);
+        const int64_t num_partitions = int64_t{1} << partition_bits;
+        const auto partition_of = [&](const int64_t line)
+        {
+            return partition_bits == 0 ? 0 : static_cast<int64_t>(table.hash(line) >> (64 - partition_bits));
+        };
+        std::vector<int64_t> partition_starts(num_partitions + 1, 0);
+        for (int64_t line = 0; line < lines.num_cols; line++)
+        {
+            if (table.length(line) > 0)
+            {
+                partition_starts[partition_of(line) + 1]++;
+            }
+        }
+        std::partial_sum(partition_starts.begin(), partition_starts.end(), partition_starts.begin());
+        std::vector<int64_t> order(partition_starts.back());
+        {
+            std::vector<int64_t> next(partition_starts.begin(), partition_starts.end() - 1);
+            for (int64_t line = 0; line < lines.num_cols; line++)
+            {
+                if (table.length(line) > 0)
+                {
+                    order[next[partition_of(line)]++] = line;
+                }
+            }
+        }
+
+        // Within a run of equal hashes, every line is compared with the representatives found so
+        // far in the run and becomes a new representative if none matches.
+        std::vector<std::vector<ParallelLine>> found(num_partitions);
+        parallel_for(options.scheduler, 0, num_partitions, 0, [&](const int64_t partition)
+        {
+            const auto begin = order.begin() + partition_starts[partition];
+            const auto end = order.begin() + partition_starts[partition + 1];
+            std::sort(begin, end, [&table](const int64_t a, const int64_t b)
+            {
+                return table.hash(a) != table.hash(b) ? table.hash(a) < table.hash(b) : a < b;
+            });
+            std::vector<int64_t> representatives;
+            for (auto run = begin; run != end;)
+            {
+                auto run_end = run + 1;
+                while (run_end != end && table.hash(*run_end) == table.hash(*run))
+                {
+                    run_end++;
+                }
+                representatives.clear();
+                for (auto it = run; it != run_end; ++it)
+                {
+                    bool matched = false;
+                    for (const int64_t representative : representatives)
+                    {
+                        double scale;
+                        if (table.parallel(representative, *it, scale))
+                        {
+                            found[partition].push_back({*it, representative, scale});
+                            matched = true;
+                            break;
+                        }
+                    }
+                    if (!matched)
+                    {
+                        representatives.push_back(*it);
+                    }
+                }
+                run = run_end;
+            }
+        });
+
+        std::vector<ParallelLine> result;
+        for (const std::vector<ParallelLine>& partition : found)
+        {
+            result.insert(result.end(), partition.begin(), partition.end());
+        }
+        std::ranges::sort(result, {}, &ParallelLine::line);
+        return result;
+    }
+}
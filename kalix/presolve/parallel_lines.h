@@ -0,0 +1,81 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_PRESOLVE_PARALLEL_LINES_H_
+#define KALIX_PRESOLVE_PARALLEL_LINES_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::presolve
+{
+    /// @brief Options for @ref find_parallel_lines.
+    struct ParallelLineOptions
+    {
+        /// @brief Scheduler used to hash and verify lines in parallel. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Relative tolerance for two entries to count as equal after scaling.
+        double tolerance = 1e-12;
+    };
+
+    /// @brief A line that is a scalar multiple of another line.
+    struct ParallelLine
+    {
+        /// @brief The line that can be removed.
+        int64_t line;
+
+        /// @brief The line it is parallel to. Always smaller than @ref line and never itself the
+        /// @ref line of another result.
+        int64_t representative;
+
+        /// @brief The factor with @c line = scale * representative.
+        double scale;
+    };
+
+    /// @brief Finds all lines of a sparse matrix that are scalar multiples of another line.
+    ///
+    /// Every column of @p lines is one line, so duplicate rows are found by passing a row-wise
+    /// copy of the matrix. Each line is sorted, normalized by its first non-zero and hashed with
+    /// a slightly quantized copy of the normalized values, so that parallel lines land in the same
+    /// bucket regardless of their scale. Buckets are split into independent partitions by the top
+    /// bits of the hash, and every partition is sorted and verified on its own.
+    ///
+    /// Candidates are verified against the exact values: the scale is the compensated ratio of
+    /// the first entries, and every entry must match its scaled counterpart to within
+    /// @ref ParallelLineOptions::tolerance. Lines whose normalized values differ only in the last
+    /// few bits of the mantissa can hash differently and are then not reported.
+    ///
+    /// @param lines The lines, one per column. Empty lines are never reported.
+    /// @param extra Optional per-line value that must scale along with the line, for example
+    /// the cost of a column. Either empty or of size @c lines.num_cols.
+    /// @param options The options.
+    /// @return The parallel lines, sorted by @ref ParallelLine::line.
+    [[nodiscard]] std::vector<ParallelLine> find_parallel_lines(const lp::CscMatrixView& lines,
+                                                                std::span<const double> extra = {},
+                                                                const ParallelLineOptions& options = {});
+}
+
+#endif // KALIX_PRESOLVE_PARALLEL_LINES_H_
@@ -0,0 +1,188 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/parallel_lines.h"
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::presolve
+{
+    namespace
+    {
+        lp::CscMatrix make_lines(const int64_t num_indices, const std::vector<std::vector<std::pair<int64_t, double>>>& lines)
+        {
+            lp::CscMatrix matrix;
+            matrix.num_rows = num_indices;
+            matrix.num_cols = static_cast<int64_t>(lines.size());
+            for (const auto& line : lines)
+            {
+                for (const auto& [index, value] : line)
+                {
+                    matrix.row_indices.push_back(index);
+                    matrix.values.push_back(value);
+                }
+                matrix.column_starts.push_back(static_cast<int64_t>(matrix.row_indices.size()));
+            }
+            return matrix;
+        }
+    }
+
+    TEST(ParallelLinesTest, FindsScaledLinesInAnyOrder)
+    {
+        const lp::CscMatrix matrix = make_lines(4, {
+                                                       {{0, 1.0}, {2, 3.0}},
+                                                       {{1, 1.0}, {2, 1.0}},
+                                                       {{2, -6.0}, {0, -2.0}},
+                                                       {{0, 0.5}, {2, 1.5}},
+                                                       {{1, 1.0}, {2, 1.0}, {3, 1.0}},
+                                                   });
+        const std::vector<ParallelLine> parallel = find_parallel_lines(matrix.view());
+        ASSERT_EQ(parallel.size(), 2u);
+        EXPECT_EQ(parallel[0].line, 2);
+        EXPECT_EQ(parallel[0].representative, 0);
+        EXPECT_EQ(parallel[0].scale, -2.0);
+        EXPECT_EQ(parallel[1].line, 3);
+        EXPECT_EQ(parallel[1].representative, 0);
+        EXPECT_EQ(parallel[1].scale, 0.5);
+    }
+
+    TEST(ParallelLinesTest, ExtraValueMustScale)
+    {
+        const lp::CscMatrix matrix = make_lines(2, {
+                                                       {{0, 1.0}, {1, 2.0}},
+                                                       {{0, 2.0}, {1, 4.0}},
+                                                       {{0, 3.0}, {1, 6.0}},
+                                                   });
+        const std::vector<double> extra = {1.0, 2.0, 1.0};
+        const std::vector<ParallelLine> parallel = find_parallel_lines(matrix.view(), extra);
+        ASSERT_EQ(parallel.size(), 1u);
+        EXPECT_EQ(parallel[0].line, 1);
+        EXPECT_EQ(parallel[0].representative, 0);
+    }
+
+    TEST(ParallelLinesTest, RejectsNearMissesAndEmptyLines)
+    {
+        const lp::CscMatrix matrix = make_lines(3, {
+                                                       {},
+                                                       {{0, 1.0}, {1, 1.0 / 3.0}},
+                                                       {{0, 3.0}, {1, 1.0 + 1e-9}},
+                                                       {},
+                                                       {{0, 3.0}, {2, 1.0}},
+                                                   });
+        EXPECT_TRUE(find_parallel_lines(matrix.view()).empty());
+    }
+
+    TEST(ParallelLinesTest, ToleratesRoundingInScaledCopies)
+    {
+        // 0.1 * 3 is not exactly 0.3, but the lines are parallel to within the tolerance.
+        const lp::CscMatrix matrix = make_lines(2, {
+                                                       {{0, 1.0}, {1, 0.1}},
+                                                       {{0, 3.0}, {1, 0.1 * 3.0}},
+                                                   });
+        const std::vector<ParallelLine> parallel = find_parallel_lines(matrix.view());
+        ASSERT_EQ(parallel.size(), 1u);
+        EXPECT_DOUBLE_EQ(parallel[0].scale, 3.0);
+    }
+
+    class ParallelLinesRandomTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(ParallelLinesRandomTest, FindsPlantedCopies)
+    {
+        // Enough lines for several hash partitions. Copies are scaled by powers of two, so
+        // their normalized values are exact and every copy must be found.
+        constexpr int64_t kNumLines = 20000;
+        constexpr int64_t kNumIndices = 500;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int64_t> index(0, kNumIndices - 1);
+        std::uniform_int_distribution<int> value(1, 9);
+        std::uniform_int_distribution<int> length(1, 6);
+        std::uniform_int_distribution<int> coin(0, 3);
+
+        std::vector<std::vector<std::pair<int64_t, double>>> lines;
+        std::map<int64_t, std::pair<int64_t, double>> expected;
+        while (static_cast<int64_t>(lines.size()) < kNumLines)
+        {
+            if (!lines.empty() && coin(rng) == 0)
+            {
+                const int64_t source = std::uniform_int_distribution<int64_t>(0, lines.size() - 1)(rng);
+                if (expected.contains(source))
+                {
+                    continue;
+                }
+                const double scale = coin(rng) < 2 ? -2.0 : 0.25;
+                auto copy = lines[source];
+                for (auto& [i, v] : copy)
+                {
+                    v *= scale;
+                }
+                std::ranges::reverse(copy);
+                expected[static_cast<int64_t>(lines.size())] = {source, scale};
+                lines.push_back(std::move(copy));
+                continue;
+            }
+            std::map<int64_t, double> line;
+            const int count = length(rng);
+            while (static_cast<int>(line.size()) < count)
+            {
+                line[index(rng)] = value(rng);
+            }
+            lines.emplace_back(line.begin(), line.end());
+        }
+
+        const lp::CscMatrix matrix = make_lines(kNumIndices, lines);
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        ParallelLineOptions options;
+        options.scheduler = GetParam() > 0 ? &scheduler : nullptr;
+        const std::vector<ParallelLine> parallel = find_parallel_lines(matrix.view(), {}, options);
+
+        // Random short lines may also coincide by chance, so check that every reported pair is
+        // genuinely parallel and that every planted copy is reported.
+        std::map<int64_t, ParallelLine> reported;
+        for (const ParallelLine& result : parallel)
+        {
+            ASSERT_LT(result.representative, result.line);
+            auto line = lines[result.line];
+            auto representative = lines[result.representative];
+            std::ranges::sort(line);
+            std::ranges::sort(representative);
+            ASSERT_EQ(line.size(), representative.size());
+            for (size_t t = 0; t < line.size(); t++)
+            {
+                EXPECT_EQ(line[t].first, representative[t].first);
+                EXPECT_DOUBLE_EQ(line[t].second, result.scale * representative[t].second);
+            }
+            reported[result.line] = result;
+        }
+        for (const auto& [line, source] : expected)
+        {
+            EXPECT_TRUE(reported.contains(line)) << line;
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, ParallelLinesRandomTest, ::testing::Values(0, 4));
+}
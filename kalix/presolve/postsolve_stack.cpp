@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/postsolve_stack.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/log/check.h"
+#include "kalix/base/compensated_double.h"
+
+namespace kalix::presolve
+{
+    namespace
+    {
+        /// @brief Returns sum(values[t] * solution[columns[t]]) in compensated arithmetic.
+        double row_activity(const std::span<const double> solution, const int64_t* columns, const double* values,
+                            const int64_t count)
+        {
+            CompensatedDouble activity(0.0);
+            for (int64_t t = 0; t < count; t++)
+            {
+                activity += values[t] * solution[columns[t]];
+            }
+            return static_cast<double>(activity);
+        }
+
+        /// @brief Projects @p value onto [lower, upper], preferring @p lower if the interval is empty.
+        double project(const double value, const double lower, const double upper)
+        {
+            return std::max(lower, std::min(value, upper));
+        }
+    }
+
+    void PostsolveStack::push(const Kind kind, const int64_t column, const std::span<const double> scalars,
+                              const std::span<const int64_t> columns, const std::span<const double> values)
+    {
+        records_.push_back({
+            .kind = kind,
+            .column = column,
+            .index_begin = static_cast<int64_t>(indices_.size()),
+            .index_end = static_cast<int64_t>(indices_.size() + columns.size()),
+            .value_begin = static_cast<int64_t>(values_.size()),
+        });
+        indices_.insert(indices_.end(), columns.begin(), columns.end());
+        values_.insert(values_.end(), scalars.begin(), scalars.end());
+        values_.insert(values_.end(), values.begin(), values.end());
+    }
+
+    void PostsolveStack::fix_column(const int64_t column, const double value)
+    {
+        const double scalars[] = {value};
+        push(Kind::kFixColumn, column, scalars);
+    }
+
+    void PostsolveStack::free_column_singleton(const int64_t column, const double coefficient, const double rhs,
+                                               const std::span<const int64_t> columns,
+                                               const std::span<const double> values)
+    {
+        DCHECK_EQ(columns.size(), values.size());
+        const double scalars[] = {coefficient, rhs};
+        push(Kind::kFreeColumnSingleton, column, scalars, columns, values);
+    }
+
+    void PostsolveStack::slack_column(const int64_t column, const double coefficient, const double row_lower,
+                                      const double row_upper, const double column_lower, const double column_upper,
+                                      const std::span<const int64_t> columns, const std::span<const double> values)
+    {
+        DCHECK_EQ(columns.size(), values.size());
+        const double scalars[] = {coefficient, row_lower, row_upper, column_lower, column_upper};
+        push(Kind::kSlackColumn, column, scalars, columns, values);
+    }
+
+    void PostsolveStack::doubleton_equation(const int64_t column, const double coefficient, const int64_t kept_column,
+                                            const double kept_coefficient, const double rhs)
+    {
+        const double scalars[] = {coefficient, kept_coefficient, rhs};
+        const int64_t kept[] = {kept_column};
+        push(Kind::kDoubletonEquation, column, scalars, kept);
+    }
+
+    void PostsolveStack::duplicate_column(const int64_t column, const int64_t kept_column, const double scale,
+                                          const double column_lower, const double column_upper,
+                                          const double kept_lower, const double kept_upper)
+    {
+        const double scalars[] = {scale, column_lower, column_upper, kept_lower, kept_upper};
+        const int64_t kept[] = {kept_column};
+        push(Kind::kDuplicateColumn, column, scalars, kept);
+    }
+
+    void PostsolveStack::undo(const std::span<double> solution) const
+    {
+        for (auto record = records_.rbegin(); record != records_.rend(); ++record)
+        {
+            const double* scalars = values_.data() + record->value_begin;
+            const int64_t* columns = indices_.data() + record->index_begin;
+            const int64_t count = record->index_end - record->index_begin;
+            double& x = solution[record->column];
+
+            switch (record->kind)
+            {
+            case Kind::kFixColumn:
+                x = scalars[0];
+                break;
+
+            case Kind::kFreeColumnSingleton:
+            {
+                const double coefficient = scalars[0];
+                const double rhs = scalars[1];
+                x = (rhs - row_activity(solution, columns, scalars + 2, count)) / coefficient;
+                break;
+            }
+
+            case Kind::kSlackColumn:
+            {
+                const double coefficient = scalars[0];
+                const double rest = row_activity(solution, columns, scalars + 5, count);
+                // The row requires coefficient * x in [row_lower - rest, row_upper - rest].
+                double lower = (scalars[1] - rest) / coefficient;
+                double upper = (scalars[2] - rest) / coefficient;
+                if (coefficient < 0.0)
+                {
+                    std::swap(lower, upper);
+                }
+                lower = std::max(lower, scalars[3]);
+                upper = std::min(upper, scalars[4]);
+                x = project(0.0, lower, upper);
+                break;
+            }
+
+            case Kind::kDoubletonEquation:
+            {
+                const double coefficient = scalars[0];
+                const double kept_coefficient = scalars[1];
+                const double rhs = scalars[2];
+                x = (rhs - kept_coefficient * solution[columns[0]]) / coefficient;
+                break;
+            }
+
+            case Kind::kDuplicateColumn:
+            {
+                const double scale = scalars[0];
+                const int64_t kept_column = columns[0];
+                const double merged = solution[kept_column];
+                // Keep the removed column as close to zero as its bounds allow and give the rest to
+                // the kept column. If that violates the kept bounds, the merged bounds guarantee
+                // that the overflow fits into the removed column.
+                const double reference = project(0.0, scalars[1], scalars[2]);
+                const double kept = project(merged - scale * reference, scalars[3], scalars[4]);
+                solution[kept_column] = kept;
+                x = (merged - kept) / scale;
+                break;
+            }
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_PRESOLVE_POSTSOLVE_STACK_H_
+#define KALIX_PRESOLVE_POSTSOLVE_STACK_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace kalix::presolve
+{
+    /// @brief Records presolve reductions so that a primal solution of the reduced problem can be
+    /// extended to a solution of the original problem.
+    ///
+    /// Every reduction that removes a column pushes one record. @ref undo replays the records in
+    /// reverse order, so when a record is undone every column it refers to already has its final
+    /// value. Reductions that only remove rows or tighten bounds need no record, since they do not
+    /// change the meaning of the remaining columns.
+    ///
+    /// Column indices always refer to the original problem.
+    class PostsolveStack
+    {
+    public:
+        /// @brief Records that @p column was fixed to @p value.
+        void fix_column(int64_t column, double value);
+
+        /// @brief Records an implied free column singleton eliminated from an equality row.
+        ///
+        /// Postsolve sets @c x[column] = (rhs - sum(values[t] * x[columns[t]])) / coefficient.
+        ///
+        /// @param column The eliminated column.
+        /// @param coefficient Its coefficient in the row.
+        /// @param rhs The right-hand side of the equality row.
+        /// @param columns The other columns of the row.
+        /// @param values Their coefficients.
+        void free_column_singleton(int64_t column, double coefficient, double rhs, std::span<const int64_t> columns,
+                                   std::span<const double> values);
+
+        /// @brief Records a zero-cost column singleton that was absorbed into its row as a slack.
+        ///
+        /// Postsolve chooses @c x[column] within @p column_lower and @p column_upper such that the
+        /// row activity lies in @c [row_lower, row_upper].
+        ///
+        /// @param column The eliminated column.
+        /// @param coefficient Its coefficient in the row.
+        /// @param row_lower The row lower bound before the row was relaxed.
+        /// @param row_upper The row upper bound before the row was relaxed.
+        /// @param column_lower The column lower bound.
+        /// @param column_upper The column upper bound.
+        /// @param columns The other columns of the row.
+        /// @param values Their coefficients.
+        void slack_column(int64_t column, double coefficient, double row_lower, double row_upper, double column_lower,
+                          double column_upper, std::span<const int64_t> columns, std::span<const double> values);
+
+        /// @brief Records that @p column was substituted using a doubleton equation.
+        ///
+        /// Postsolve sets @c x[column] = (rhs - kept_coefficient * x[kept_column]) / coefficient.
+        void doubleton_equation(int64_t column, double coefficient, int64_t kept_column, double kept_coefficient,
+                                double rhs);
+
+        /// @brief Records that @p column was merged into the parallel column @p kept_column.
+        ///
+        /// The kept column stands for @c x[kept_column] + scale * x[column]. Postsolve splits its
+        /// value back while respecting the bounds both columns had before the merge.
+        void duplicate_column(int64_t column, int64_t kept_column, double scale, double column_lower,
+                              double column_upper, double kept_lower, double kept_upper);
+
+        /// @brief Returns the number of records.
+        [[nodiscard]] int64_t size() const
+        {
+            return static_cast<int64_t>(records_.size());
+        }
+
+        /// @brief Extends a solution in place.
+        /// @param solution Values of all original columns. Columns present in the reduced problem
+        ///     must be set on entry; all others are set on return.
+        void undo(std::span<double> solution) const;
+
+    private:
+        enum class Kind : int8_t
+        {
+            kFixColumn,
+            kFreeColumnSingleton,
+            kSlackColumn,
+            kDoubletonEquation,
+            kDuplicateColumn,
+        };
+
+        /// @brief A record refers to a range of @ref indices_ and to its scalars in @ref values_, which
+        /// for row based records are followed by one coefficient per index.
+        struct Record
+        {
+            Kind kind;
+            int64_t column;
+            int64_t index_begin;
+            int64_t index_end;
+            int64_t value_begin;
+        };
+
+        void push(Kind kind, int64_t column, std::span<const double> scalars, std::span<const int64_t> columns = {},
+                  std::span<const double> values = {});
+
+        std::vector<Record> records_;
+        std::vector<int64_t> indices_;
+        std::vector<double> values_;
+    };
+}
+
+#endif // KALIX_PRESOLVE_POSTSOLVE_STACK_H_
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/postsolve_stack.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::presolve
+{
+    TEST(PostsolveStackTest, FixColumn)
+    {
+        PostsolveStack stack;
+        stack.fix_column(1, 2.5);
+        std::vector<double> solution = {7.0, 0.0};
+        stack.undo(solution);
+        EXPECT_EQ(solution[0], 7.0);
+        EXPECT_EQ(solution[1], 2.5);
+        EXPECT_EQ(stack.size(), 1);
+    }
+
+    TEST(PostsolveStackTest, FreeColumnSingleton)
+    {
+        // 2 x0 + x1 - x2 = 4
+        PostsolveStack stack;
+        const std::vector<int64_t> columns = {1, 2};
+        const std::vector<double> values = {1.0, -1.0};
+        stack.free_column_singleton(0, 2.0, 4.0, columns, values);
+        std::vector<double> solution = {0.0, 1.0, 3.0};
+        stack.undo(solution);
+        EXPECT_DOUBLE_EQ(solution[0], 3.0);
+    }
+
+    TEST(PostsolveStackTest, SlackColumnStaysWithinBounds)
+    {
+        // 1 <= x0 + x1 <= 2 with x1 in [0, 5].
+        PostsolveStack stack;
+        const std::vector<int64_t> columns = {0};
+        const std::vector<double> values = {1.0};
+        stack.slack_column(1, 1.0, 1.0, 2.0, 0.0, 5.0, columns, values);
+
+        std::vector<double> inside = {1.5, 0.0};
+        stack.undo(inside);
+        EXPECT_DOUBLE_EQ(inside[1], 0.0);
+
+        std::vector<double> below = {-2.0, 0.0};
+        stack.undo(below);
+        EXPECT_GE(below[0] + below[1], 1.0 - 1e-12);
+        EXPECT_LE(below[0] + below[1], 2.0 + 1e-12);
+        EXPECT_GE(below[1], 0.0);
+        EXPECT_LE(below[1], 5.0);
+    }
+
+    TEST(PostsolveStackTest, DoubletonEquation)
+    {
+        // 2 x0 + 4 x1 = 10, x1 eliminated.
+        PostsolveStack stack;
+        stack.doubleton_equation(1, 4.0, 0, 2.0, 10.0);
+        std::vector<double> solution = {1.0, 0.0};
+        stack.undo(solution);
+        EXPECT_DOUBLE_EQ(solution[1], 2.0);
+    }
+
+    TEST(PostsolveStackTest, DuplicateColumnSplitsMergedValue)
+    {
+        // x0 + 2 x1 was merged into column 0, x0 in [0, 1], x1 in [0, 3].
+        PostsolveStack stack;
+        stack.duplicate_column(1, 0, 2.0, 0.0, 3.0, 0.0, 1.0);
+        for (const double merged : {0.0, 0.5, 1.0, 4.0, 7.0})
+        {
+            std::vector<double> solution = {merged, 0.0};
+            stack.undo(solution);
+            EXPECT_NEAR(solution[0] + 2.0 * solution[1], merged, 1e-12);
+            EXPECT_GE(solution[0], 0.0);
+            EXPECT_LE(solution[0], 1.0);
+            EXPECT_GE(solution[1], 0.0);
+            EXPECT_LE(solution[1], 3.0);
+        }
+    }
+
+    TEST(PostsolveStackTest, UndoRunsInReverseOrder)
+    {
+        // x0 = 6 - x1 was eliminated first, then x1 was fixed.
+        PostsolveStack stack;
+        const std::vector<int64_t> columns = {1};
+        const std::vector<double> values = {1.0};
+        stack.free_column_singleton(0, 1.0, 6.0, columns, values);
+        stack.fix_column(1, 2.0);
+        std::vector<double> solution = {0.0, 0.0};
+        stack.undo(solution);
+        EXPECT_DOUBLE_EQ(solution[0], 4.0);
+        EXPECT_DOUBLE_EQ(solution[1], 2.0);
+    }
+}
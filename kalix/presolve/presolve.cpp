@@ -0,0 +1,943 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/presolve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "kalix/base/compensated_double.h"
+#include "kalix/base/config.h"
+#include "kalix/presolve/parallel_lines.h"
+
+namespace kalix::presolve
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        /// @brief Returns @p bound - @p shift, keeping infinite bounds infinite.
+        KALIX_FORCE_INLINE double shift_bound(const double bound, const double shift)
+        {
+            return std::isinf(bound) ? bound : bound - shift;
+        }
+
+        /// @brief Returns the range of coefficient * x for x in [lower, upper].
+        KALIX_FORCE_INLINE std::pair<double, double> scaled_range(const double coefficient, const double lower,
+                                                                 const double upper)
+        {
+            return coefficient > 0.0 ? std::pair(coefficient * lower, coefficient * upper)
+                                     : std::pair(coefficient * upper, coefficient * lower);
+        }
+
+        /// @brief Returns the range of x with coefficient * x in [lower, upper].
+        KALIX_FORCE_INLINE std::pair<double, double> divided_range(const double coefficient, const double lower,
+                                                                  const double upper)
+        {
+            return coefficient > 0.0 ? std::pair(lower / coefficient, upper / coefficient)
+                                     : std::pair(upper / coefficient, lower / coefficient);
+        }
+    }
+
+    Presolver::Presolver(const lp::LinearProgram& program, const PresolveOptions& options)
+        : options_(options), original_(program)
+    {
+        const int64_t num_rows = program.num_rows();
+        const int64_t num_cols = program.num_cols();
+        const lp::CscMatrix& matrix = program.constraint_matrix;
+
+        sense_ = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+        objective_offset_ = sense_ * program.objective_offset;
+        cost_.resize(num_cols);
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            cost_[j] = sense_ * program.objective[j];
+        }
+        column_lower_ = program.column_lower;
+        column_upper_ = program.column_upper;
+        row_lower_ = program.row_lower;
+        row_upper_ = program.row_upper;
+
+        columns_.resize(num_cols);
+        rows_.resize(num_rows);
+        column_length_.assign(num_cols, 0);
+        row_length_.assign(num_rows, 0);
+        for (int64_t k = 0; k < matrix.num_non_zeros(); k++)
+        {
+            row_length_[matrix.row_indices[k]] += matrix.values[k] != 0.0;
+        }
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            rows_[i].reserve(row_length_[i]);
+        }
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            const auto indices = matrix.column_indices(j);
+            const auto values = matrix.column_values(j);
+            columns_[j].reserve(indices.size());
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                if (values[t] != 0.0)
+                {
+                    columns_[j].push_back({indices[t], values[t]});
+                    rows_[indices[t]].push_back({j, values[t]});
+                }
+            }
+            column_length_[j] = static_cast<int64_t>(columns_[j].size());
+        }
+        column_active_.assign(num_cols, 1);
+        row_active_.assign(num_rows, 1);
+    }
+
+    template <typename Function>
+    void Presolver::for_each_row_entry(const int64_t row, Function&& function) const
+    {
+        for (const Entry& entry : rows_[row])
+        {
+            if (column_active_[entry.index])
+            {
+                function(entry.index, entry.value);
+            }
+        }
+    }
+
+    template <typename Function>
+    void Presolver::for_each_column_entry(const int64_t column, Function&& function) const
+    {
+        for (const Entry& entry : columns_[column])
+        {
+            if (row_active_[entry.index])
+            {
+                function(entry.index, entry.value);
+            }
+        }
+    }
+
+    bool Presolver::exceeds(const double value, const double bound) const
+    {
+        if (std::isinf(bound))
+        {
+            return value > bound;
+        }
+        return value > bound + options_.feasibility_tolerance * (1.0 + std::abs(bound));
+    }
+
+    Presolver::Activity Presolver::compute_activity(const int64_t row, const int64_t excluded_column) const
+    {
+        CompensatedDouble min(0.0);
+        CompensatedDouble max(0.0);
+        Activity activity;
+        for_each_row_entry(row, [&](const int64_t column, const double value)
+        {
+            if (column == excluded_column)
+            {
+                return;
+            }
+            const auto [low, high] = scaled_range(value, column_lower_[column], column_upper_[column]);
+            if (std::isinf(low))
+            {
+                activity.min_infinite++;
+            }
+            else
+            {
+                min += low;
+            }
+            if (std::isinf(high))
+            {
+                activity.max_infinite++;
+            }
+            else
+            {
+                max += high;
+            }
+        });
+        activity.min = activity.min_infinite == 0 ? static_cast<double>(min) : -kInfinity;
+        activity.max = activity.max_infinite == 0 ? static_cast<double>(max) : kInfinity;
+        return activity;
+    }
+
+    void Presolver::collect_row(const int64_t row, const int64_t excluded_column)
+    {
+        scratch_columns_.clear();
+        scratch_values_.clear();
+        for_each_row_entry(row, [&](const int64_t column, const double value)
+        {
+            if (column != excluded_column)
+            {
+                scratch_columns_.push_back(column);
+                scratch_values_.push_back(value);
+            }
+        });
+    }
+
+    void Presolver::compact()
+    {
+        parallel_for(options_.scheduler, 0, static_cast<int64_t>(rows_.size()), 0, [this](const int64_t i)
+        {
+            if (!row_active_[i])
+            {
+                std::vector<Entry>().swap(rows_[i]);
+            }
+            else if (static_cast<int64_t>(rows_[i].size()) > 2 * row_length_[i])
+            {
+                std::erase_if(rows_[i], [this](const Entry& entry) { return !column_active_[entry.index]; });
+            }
+        });
+        parallel_for(options_.scheduler, 0, static_cast<int64_t>(columns_.size()), 0, [this](const int64_t j)
+        {
+            if (!column_active_[j])
+            {
+                std::vector<Entry>().swap(columns_[j]);
+            }
+            else if (static_cast<int64_t>(columns_[j].size()) > 2 * column_length_[j])
+            {
+                std::erase_if(columns_[j], [this](const Entry& entry) { return !row_active_[entry.index]; });
+            }
+        });
+    }
+
+    lp::CscMatrix Presolver::gather_lines(const std::vector<std::vector<Entry>>& lines,
+                                          const std::vector<char>& line_active,
+                                          const std::vector<int64_t>& line_length,
+                                          const std::vector<char>& entry_active,
+                                          std::vector<int64_t>& line_ids) const
+    {
+        line_ids.clear();
+        lp::CscMatrix matrix;
+        for (int64_t k = 0; k < static_cast<int64_t>(lines.size()); k++)
+        {
+            if (line_active[k] && line_length[k] > 0)
+            {
+                line_ids.push_back(k);
+                matrix.column_starts.push_back(matrix.column_starts.back() + line_length[k]);
+            }
+        }
+        const auto num_lines = static_cast<int64_t>(line_ids.size());
+        matrix.num_rows = static_cast<int64_t>(entry_active.size());
+        matrix.num_cols = num_lines;
+        matrix.row_indices.resize(matrix.column_starts.back());
+        matrix.values.resize(matrix.column_starts.back());
+        parallel_for(options_.scheduler, 0, num_lines, 0, [&](const int64_t k)
+        {
+            int64_t position = matrix.column_starts[k];
+            for (const Entry& entry : lines[line_ids[k]])
+            {
+                if (entry_active[entry.index])
+                {
+                    matrix.row_indices[position] = entry.index;
+                    matrix.values[position] = entry.value;
+                    position++;
+                }
+            }
+            DCHECK_EQ(position, matrix.column_starts[k + 1]);
+        });
+        return matrix;
+    }
+
+    void Presolver::remove_row(const int64_t row)
+    {
+        DCHECK(row_active_[row]);
+        row_active_[row] = 0;
+        for_each_row_entry(row, [this](const int64_t column, double) { column_length_[column]--; });
+    }
+
+    void Presolver::remove_column(const int64_t column)
+    {
+        DCHECK(column_active_[column]);
+        column_active_[column] = 0;
+        for_each_column_entry(column, [this](const int64_t row, double) { row_length_[row]--; });
+    }
+
+    void Presolver::fix_column(const int64_t column, const double value)
+    {
+        for_each_column_entry(column, [&](const int64_t row, const double coefficient)
+        {
+            row_lower_[row] = shift_bound(row_lower_[row], coefficient * value);
+            row_upper_[row] = shift_bound(row_upper_[row], coefficient * value);
+        });
+        objective_offset_ += cost_[column] * value;
+        postsolve_stack_.fix_column(column, value);
+        remove_column(column);
+    }
+
+    bool Presolver::tighten_column(const int64_t column, const double lower, const double upper)
+    {
+        double& column_lower = column_lower_[column];
+        double& column_upper = column_upper_[column];
+        column_lower = std::max(column_lower, lower);
+        column_upper = std::min(column_upper, upper);
+        if (exceeds(column_lower, column_upper))
+        {
+            status_ = PresolveStatus::kInfeasible;
+            return false;
+        }
+        if (column_lower > column_upper)
+        {
+            column_lower = column_upper = 0.5 * (column_lower + column_upper);
+        }
+        return true;
+    }
+
+    bool Presolver::tighten_row(const int64_t row, const double lower, const double upper)
+    {
+        double& row_lower = row_lower_[row];
+        double& row_upper = row_upper_[row];
+        row_lower = std::max(row_lower, lower);
+        row_upper = std::min(row_upper, upper);
+        if (exceeds(row_lower, row_upper))
+        {
+            status_ = PresolveStatus::kInfeasible;
+            return false;
+        }
+        if (row_lower > row_upper)
+        {
+            row_lower = row_upper = 0.5 * (row_lower + row_upper);
+        }
+        return true;
+    }
+
+    void Presolver::add_to_coefficient(const int64_t row, const int64_t column, const double delta)
+    {
+        DCHECK(row_active_[row]);
+        DCHECK(column_active_[column]);
+        std::vector<Entry>& row_entries = rows_[row];
+        std::vector<Entry>& column_entries = columns_[column];
+        const auto in_row = std::ranges::find(row_entries, column, &Entry::index);
+        if (in_row == row_entries.end())
+        {
+            if (std::abs(delta) > options_.drop_tolerance)
+            {
+                row_entries.push_back({column, delta});
+                column_entries.push_back({row, delta});
+                row_length_[row]++;
+                column_length_[column]++;
+            }
+            return;
+        }
+
+        const auto in_column = std::ranges::find(column_entries, row, &Entry::index);
+        DCHECK(in_column != column_entries.end());
+        const double value = in_row->value + delta;
+        if (std::abs(value) <= options_.drop_tolerance)
+        {
+            *in_row = row_entries.back();
+            row_entries.pop_back();
+            *in_column = column_entries.back();
+            column_entries.pop_back();
+            row_length_[row]--;
+            column_length_[column]--;
+            return;
+        }
+        in_row->value = value;
+        in_column->value = value;
+    }
+
+    bool Presolver::remove_empty_and_fixed()
+    {
+        bool changed = false;
+        for (int64_t i = 0; i < static_cast<int64_t>(rows_.size()); i++)
+        {
+            if (!row_active_[i])
+            {
+                continue;
+            }
+            if (row_length_[i] == 0)
+            {
+                if (exceeds(0.0, row_upper_[i]) || exceeds(row_lower_[i], 0.0))
+                {
+                    status_ = PresolveStatus::kInfeasible;
+                    return true;
+                }
+                remove_row(i);
+                statistics_.empty_rows++;
+                changed = true;
+            }
+            else if (std::isinf(row_lower_[i]) && std::isinf(row_upper_[i]))
+            {
+                remove_row(i);
+                statistics_.redundant_rows++;
+                changed = true;
+            }
+        }
+
+        for (int64_t j = 0; j < static_cast<int64_t>(columns_.size()); j++)
+        {
+            if (!column_active_[j])
+            {
+                continue;
+            }
+            const double lower = column_lower_[j];
+            const double upper = column_upper_[j];
+            if (exceeds(lower, upper))
+            {
+                status_ = PresolveStatus::kInfeasible;
+                return true;
+            }
+            if (column_length_[j] == 0)
+            {
+                const double cost = cost_[j];
+                if ((cost > 0.0 && std::isinf(lower)) || (cost < 0.0 && std::isinf(upper)))
+                {
+                    status_ = PresolveStatus::kUnboundedOrInfeasible;
+                    return true;
+                }
+                const double value = cost > 0.0 ? lower : cost < 0.0 ? upper : std::max(lower, std::min(0.0, upper));
+                fix_column(j, value);
+                statistics_.empty_columns++;
+                changed = true;
+            }
+            else if (!std::isinf(lower) && upper - lower <= options_.feasibility_tolerance * (1.0 + std::abs(lower)))
+            {
+                fix_column(j, lower == upper ? lower : 0.5 * (lower + upper));
+                statistics_.fixed_columns++;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_singleton_rows()
+    {
+        bool changed = false;
+        for (int64_t i = 0; i < static_cast<int64_t>(rows_.size()); i++)
+        {
+            if (!row_active_[i] || row_length_[i] != 1)
+            {
+                continue;
+            }
+            int64_t column = -1;
+            double coefficient = 0.0;
+            for_each_row_entry(i, [&](const int64_t j, const double value)
+            {
+                column = j;
+                coefficient = value;
+            });
+            const auto [lower, upper] = divided_range(coefficient, row_lower_[i], row_upper_[i]);
+            remove_row(i);
+            statistics_.singleton_rows++;
+            changed = true;
+            if (!tighten_column(column, lower, upper))
+            {
+                return true;
+            }
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_forcing_rows()
+    {
+        bool changed = false;
+        std::vector<Entry> entries;
+        for (int64_t i = 0; i < static_cast<int64_t>(rows_.size()); i++)
+        {
+            if (!row_active_[i] || row_length_[i] == 0)
+            {
+                continue;
+            }
+            const Activity activity = compute_activity(i);
+            const double lower = row_lower_[i];
+            const double upper = row_upper_[i];
+            if (exceeds(activity.min, upper) || exceeds(lower, activity.max))
+            {
+                status_ = PresolveStatus::kInfeasible;
+                return true;
+            }
+
+            const bool lower_redundant = !exceeds(lower, activity.min);
+            const bool upper_redundant = !exceeds(activity.max, upper);
+            if (lower_redundant && upper_redundant)
+            {
+                remove_row(i);
+                statistics_.redundant_rows++;
+                changed = true;
+                continue;
+            }
+
+            // A row is forcing if one of its bounds can only be met with every column at the
+            // bound that minimizes (or maximizes) the activity.
+            const bool at_min = !std::isinf(upper) && !exceeds(upper, activity.min);
+            const bool at_max = !at_min && !std::isinf(lower) && !exceeds(activity.max, lower);
+            if (!at_min && !at_max)
+            {
+                continue;
+            }
+            entries.clear();
+            for_each_row_entry(i, [&](const int64_t j, const double value) { entries.push_back({j, value}); });
+            remove_row(i);
+            for (const auto [column, value] : entries)
+            {
+                const bool to_lower = (value > 0.0) == at_min;
+                fix_column(column, to_lower ? column_lower_[column] : column_upper_[column]);
+            }
+            statistics_.forcing_rows++;
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_singleton_columns()
+    {
+        bool changed = false;
+        for (int64_t j = 0; j < static_cast<int64_t>(columns_.size()); j++)
+        {
+            if (!column_active_[j] || column_length_[j] != 1)
+            {
+                continue;
+            }
+            int64_t row = -1;
+            double coefficient = 0.0;
+            for_each_column_entry(j, [&](const int64_t i, const double value)
+            {
+                row = i;
+                coefficient = value;
+            });
+            const double row_lower = row_lower_[row];
+            const double row_upper = row_upper_[row];
+            const double lower = column_lower_[j];
+            const double upper = column_upper_[j];
+
+            if (row_lower == row_upper)
+            {
+                // coefficient * x = rhs - rest, where rest ranges over the activity of the other columns.
+                const Activity rest = compute_activity(row, j);
+                const auto [implied_lower, implied_upper] =
+                    divided_range(coefficient, row_lower - rest.max, row_upper - rest.min);
+                const bool implied_free = !exceeds(lower, implied_lower) && !exceeds(implied_upper, upper);
+                if (implied_free)
+                {
+                    collect_row(row, j);
+                    postsolve_stack_.free_column_singleton(j, coefficient, row_lower, scratch_columns_,
+                                                           scratch_values_);
+                    const double cost = cost_[j];
+                    if (cost != 0.0)
+                    {
+                        for (size_t t = 0; t < scratch_columns_.size(); t++)
+                        {
+                            cost_[scratch_columns_[t]] -= cost * scratch_values_[t] / coefficient;
+                        }
+                        objective_offset_ += cost * row_lower / coefficient;
+                    }
+                    remove_column(j);
+                    remove_row(row);
+                    statistics_.free_column_singletons++;
+                    changed = true;
+                    continue;
+                }
+            }
+
+            if (cost_[j] == 0.0)
+            {
+                // The column acts as a slack: the rest of the row may take any value that the
+                // column can compensate.
+                const auto [low, high] = scaled_range(coefficient, lower, upper);
+                collect_row(row, j);
+                postsolve_stack_.slack_column(j, coefficient, row_lower, row_upper, lower, upper, scratch_columns_,
+                                              scratch_values_);
+                remove_column(j);
+                row_lower_[row] = std::isinf(high) ? -kInfinity : shift_bound(row_lower, high);
+                row_upper_[row] = std::isinf(low) ? kInfinity : shift_bound(row_upper, low);
+                statistics_.slack_columns++;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_doubleton_equations()
+    {
+        bool changed = false;
+        std::vector<Entry> column_entries;
+        for (int64_t i = 0; i < static_cast<int64_t>(rows_.size()); i++)
+        {
+            if (!row_active_[i] || row_length_[i] != 2 || row_lower_[i] != row_upper_[i])
+            {
+                continue;
+            }
+            Entry pair[2];
+            int count = 0;
+            for_each_row_entry(i, [&](const int64_t j, const double value) { pair[count++] = {j, value}; });
+
+            // Eliminate the shorter column to limit fill-in, unless its coefficient is tiny.
+            if (column_length_[pair[0].index] < column_length_[pair[1].index])
+            {
+                std::swap(pair[0], pair[1]);
+            }
+            if (std::abs(pair[1].value) < 1e-3 * std::abs(pair[0].value))
+            {
+                std::swap(pair[0], pair[1]);
+            }
+            const auto [kept, kept_coefficient] = pair[0];
+            const auto [eliminated, coefficient] = pair[1];
+            const double rhs = row_lower_[i];
+
+            // kept_coefficient * x_kept = rhs - coefficient * x_eliminated moves the bounds of the
+            // eliminated column to the kept one.
+            const auto [low, high] = scaled_range(coefficient, column_lower_[eliminated], column_upper_[eliminated]);
+            const auto [lower, upper] = divided_range(kept_coefficient, rhs - high, rhs - low);
+
+            column_entries.clear();
+            for_each_column_entry(eliminated, [&](const int64_t row, const double value)
+            {
+                if (row != i)
+                {
+                    column_entries.push_back({row, value});
+                }
+            });
+
+            postsolve_stack_.doubleton_equation(eliminated, coefficient, kept, kept_coefficient, rhs);
+            const double cost = cost_[eliminated];
+            cost_[kept] -= cost * kept_coefficient / coefficient;
+            objective_offset_ += cost * rhs / coefficient;
+            remove_row(i);
+            remove_column(eliminated);
+            statistics_.doubleton_equations++;
+            changed = true;
+            if (!tighten_column(kept, lower, upper))
+            {
+                return true;
+            }
+
+            for (const auto [row, value] : column_entries)
+            {
+                const double shift = value * rhs / coefficient;
+                row_lower_[row] = shift_bound(row_lower_[row], shift);
+                row_upper_[row] = shift_bound(row_upper_[row], shift);
+                add_to_coefficient(row, kept, -value * kept_coefficient / coefficient);
+            }
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_dominated_columns()
+    {
+        bool changed = false;
+        for (int64_t j = 0; j < static_cast<int64_t>(columns_.size()); j++)
+        {
+            const double cost = cost_[j];
+            if (!column_active_[j] || cost == 0.0)
+            {
+                continue;
+            }
+
+            // The row bound types fix the sign of the duals: y >= 0 for rows with only a lower
+            // bound, y <= 0 for rows with only an upper bound. If every term a * y of the column
+            // has a known sign, so has the reduced cost c - sum(a * y).
+            bool terms_non_positive = true;
+            bool terms_non_negative = true;
+            for_each_column_entry(j, [&](const int64_t row, const double value)
+            {
+                const bool has_lower = !std::isinf(row_lower_[row]);
+                const bool has_upper = !std::isinf(row_upper_[row]);
+                if (has_lower && has_upper)
+                {
+                    terms_non_positive = terms_non_negative = false;
+                }
+                else if (has_lower || has_upper)
+                {
+                    const bool positive = (value > 0.0) == has_lower;
+                    (positive ? terms_non_positive : terms_non_negative) = false;
+                }
+            });
+
+            if (cost > 0.0 && terms_non_positive)
+            {
+                if (std::isinf(column_lower_[j]))
+                {
+                    status_ = PresolveStatus::kUnboundedOrInfeasible;
+                    return true;
+                }
+                fix_column(j, column_lower_[j]);
+            }
+            else if (cost < 0.0 && terms_non_negative)
+            {
+                if (std::isinf(column_upper_[j]))
+                {
+                    status_ = PresolveStatus::kUnboundedOrInfeasible;
+                    return true;
+                }
+                fix_column(j, column_upper_[j]);
+            }
+            else
+            {
+                continue;
+            }
+            statistics_.dominated_columns++;
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool Presolver::remove_duplicate_rows()
+    {
+        std::vector<int64_t> rows;
+        const lp::CscMatrix lines = gather_lines(rows_, row_active_, row_length_, column_active_, rows);
+        ParallelLineOptions line_options;
+        line_options.scheduler = options_.scheduler;
+        const std::vector<ParallelLine> parallel = find_parallel_lines(lines.view(), {}, line_options);
+
+        for (const auto [line, representative, scale] : parallel)
+        {
+            // row = scale * kept, so the bounds of row restrict kept after division by scale.
+            const int64_t row = rows[line];
+            const int64_t kept = rows[representative];
+            const auto [lower, upper] = divided_range(scale, row_lower_[row], row_upper_[row]);
+            remove_row(row);
+            statistics_.duplicate_rows++;
+            if (!tighten_row(kept, lower, upper))
+            {
+                break;
+            }
+        }
+        return !parallel.empty();
+    }
+
+    bool Presolver::remove_duplicate_columns()
+    {
+        std::vector<int64_t> columns;
+        const lp::CscMatrix lines = gather_lines(columns_, column_active_, column_length_, row_active_, columns);
+        std::vector<double> costs(columns.size());
+        for (size_t k = 0; k < columns.size(); k++)
+        {
+            costs[k] = cost_[columns[k]];
+        }
+        ParallelLineOptions line_options;
+        line_options.scheduler = options_.scheduler;
+        const std::vector<ParallelLine> parallel = find_parallel_lines(lines.view(), costs, line_options);
+
+        for (const auto [line, representative, scale] : parallel)
+        {
+            // column = scale * kept, so x_kept + scale * x_column replaces both columns.
+            const int64_t column = columns[line];
+            const int64_t kept = columns[representative];
+            const double lower = column_lower_[column];
+            const double upper = column_upper_[column];
+            const auto [low, high] = scaled_range(scale, lower, upper);
+            postsolve_stack_.duplicate_column(column, kept, scale, lower, upper, column_lower_[kept],
+                                              column_upper_[kept]);
+            column_lower_[kept] += low;
+            column_upper_[kept] += high;
+            remove_column(column);
+            statistics_.duplicate_columns++;
+        }
+        return !parallel.empty();
+    }
+
+    bool Presolver::tighten_bounds()
+    {
+        const auto num_rows = static_cast<int64_t>(rows_.size());
+        const auto num_cols = static_cast<int64_t>(columns_.size());
+        std::vector<Activity> activities(num_rows);
+        parallel_for(options_.scheduler, 0, num_rows, 0, [&](const int64_t i)
+        {
+            if (row_active_[i])
+            {
+                activities[i] = compute_activity(i);
+            }
+        });
+
+        // The implied bounds are staged and applied afterwards, so every column reads the bounds the
+        // activities were computed with and the columns are independent.
+        std::vector<double> implied_lowers(num_cols, -kInfinity);
+        std::vector<double> implied_uppers(num_cols, kInfinity);
+        parallel_for(options_.scheduler, 0, num_cols, 0, [&](const int64_t j)
+        {
+            const double lower = column_lower_[j];
+            const double upper = column_upper_[j];
+            if (!column_active_[j] || (!std::isinf(lower) && !std::isinf(upper)))
+            {
+                return;
+            }
+            double implied_lower = -kInfinity;
+            double implied_upper = kInfinity;
+            for_each_column_entry(j, [&](const int64_t row, const double value)
+            {
+                const Activity& activity = activities[row];
+                const auto [low, high] = scaled_range(value, lower, upper);
+                // Activity of the rest of the row, excluding this column's contribution.
+                double rest_min = -kInfinity;
+                if (activity.min_infinite == 0)
+                {
+                    rest_min = activity.min - low;
+                }
+                else if (activity.min_infinite == 1 && std::isinf(low))
+                {
+                    rest_min = static_cast<double>(compute_activity(row, j).min);
+                }
+                double rest_max = kInfinity;
+                if (activity.max_infinite == 0)
+                {
+                    rest_max = activity.max - high;
+                }
+                else if (activity.max_infinite == 1 && std::isinf(high))
+                {
+                    rest_max = static_cast<double>(compute_activity(row, j).max);
+                }
+                const auto [row_low, row_high] =
+                    divided_range(value, row_lower_[row] - rest_max, row_upper_[row] - rest_min);
+                implied_lower = std::max(implied_lower, row_low);
+                implied_upper = std::min(implied_upper, row_high);
+            });
+
+            implied_lowers[j] = implied_lower;
+            implied_uppers[j] = implied_upper;
+        });
+
+        int64_t count = 0;
+        const double slack = options_.feasibility_tolerance;
+        for (int64_t j = 0; j < num_cols; j++)
+        {
+            const double implied_lower = implied_lowers[j];
+            const double implied_upper = implied_uppers[j];
+            if (std::isinf(column_lower_[j]) && std::abs(implied_lower) <= options_.max_implied_bound)
+            {
+                column_lower_[j] = implied_lower - slack * (1.0 + std::abs(implied_lower));
+                count++;
+            }
+            if (std::isinf(column_upper_[j]) && std::abs(implied_upper) <= options_.max_implied_bound)
+            {
+                column_upper_[j] = implied_upper + slack * (1.0 + std::abs(implied_upper));
+                count++;
+            }
+        }
+        statistics_.tightened_bounds += count;
+        return count > 0;
+    }
+
+    PresolveStatus Presolver::run()
+    {
+        for (int pass = 0; pass < options_.max_passes && status_ == PresolveStatus::kReduced; pass++)
+        {
+            compact();
+            statistics_.passes++;
+
+            bool changed = remove_empty_and_fixed();
+            const auto apply = [&](const bool enabled, bool (Presolver::*reduction)())
+            {
+                if (enabled && status_ == PresolveStatus::kReduced)
+                {
+                    changed = (this->*reduction)() || changed;
+                }
+            };
+            apply(options_.singleton_rows, &Presolver::remove_singleton_rows);
+            apply(options_.forcing_rows, &Presolver::remove_forcing_rows);
+            apply(options_.singleton_columns, &Presolver::remove_singleton_columns);
+            apply(options_.doubleton_equations, &Presolver::remove_doubleton_equations);
+            apply(options_.dominated_columns, &Presolver::remove_dominated_columns);
+            apply(options_.duplicate_rows, &Presolver::remove_duplicate_rows);
+            apply(options_.duplicate_columns, &Presolver::remove_duplicate_columns);
+            apply(options_.bound_tightening, &Presolver::tighten_bounds);
+            if (!changed)
+            {
+                break;
+            }
+        }
+        return status_;
+    }
+
+    std::vector<int64_t> Presolver::row_mapping() const
+    {
+        std::vector<int64_t> mapping;
+        for (int64_t i = 0; i < static_cast<int64_t>(rows_.size()); i++)
+        {
+            if (row_active_[i])
+            {
+                mapping.push_back(i);
+            }
+        }
+        return mapping;
+    }
+
+    std::vector<int64_t> Presolver::column_mapping() const
+    {
+        std::vector<int64_t> mapping;
+        for (int64_t j = 0; j < static_cast<int64_t>(columns_.size()); j++)
+        {
+            if (column_active_[j])
+            {
+                mapping.push_back(j);
+            }
+        }
+        return mapping;
+    }
+
+    lp::LinearProgram Presolver::reduced_program() const
+    {
+        const std::vector<int64_t> rows = row_mapping();
+        const std::vector<int64_t> columns = column_mapping();
+        std::vector<int64_t> new_row_index(rows_.size(), -1);
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            new_row_index[rows[i]] = static_cast<int64_t>(i);
+        }
+
+        lp::LinearProgram program;
+        program.name = original_.name;
+        program.sense = original_.sense;
+        program.objective_offset = sense_ * objective_offset_;
+
+        lp::CscMatrix& matrix = program.constraint_matrix;
+        matrix.num_rows = static_cast<int64_t>(rows.size());
+        for (const int64_t j : columns)
+        {
+            for_each_column_entry(j, [&](const int64_t row, const double value)
+            {
+                matrix.row_indices.push_back(new_row_index[row]);
+                matrix.values.push_back(value);
+            });
+            matrix.column_starts.push_back(static_cast<int64_t>(matrix.row_indices.size()));
+            matrix.num_cols++;
+
+            program.objective.push_back(sense_ * cost_[j]);
+            program.column_lower.push_back(column_lower_[j]);
+            program.column_upper.push_back(column_upper_[j]);
+            if (!original_.column_names.empty())
+            {
+                program.column_names.push_back(original_.column_names[j]);
+            }
+        }
+        for (const int64_t i : rows)
+        {
+            program.row_lower.push_back(row_lower_[i]);
+            program.row_upper.push_back(row_upper_[i]);
+            if (!original_.row_names.empty())
+            {
+                program.row_names.push_back(original_.row_names[i]);
+            }
+        }
+        return program;
+    }
+
+    std::vector<double> Presolver::postsolve(const std::span<const double> reduced_solution) const
+    {
+        const std::vector<int64_t> columns = column_mapping();
+        CHECK_EQ(reduced_solution.size(), columns.size());
+        std::vector<double> solution(columns_.size(), 0.0);
+        for (size_t k = 0; k < columns.size(); k++)
+        {
+            solution[columns[k]] = reduced_solution[k];
+        }
+        postsolve_stack_.undo(solution);
+        return solution;
+    }
+}
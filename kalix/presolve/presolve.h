@@ -0,0 +1,239 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_PRESOLVE_PRESOLVE_H_
+#define KALIX_PRESOLVE_PRESOLVE_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/lp/sparse_matrix.h"
+#include "kalix/presolve/postsolve_stack.h"
+
+namespace kalix::presolve
+{
+    /// @brief Options of the @ref Presolver.
+    struct PresolveOptions
+    {
+        /// @brief Scheduler for the parallel passes (activities, bound tightening, duplicate
+        /// detection). The passes run serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Maximum number of rounds over all reductions.
+        int max_passes = 20;
+
+        /// @brief Absolute tolerance for bound violations, relative to the magnitude of the bound.
+        double feasibility_tolerance = 1e-9;
+
+        /// @brief Coefficients created by substitution with a smaller magnitude are dropped.
+        double drop_tolerance = 1e-12;
+
+        /// @brief Implied bounds with a larger magnitude are not applied to columns.
+        double max_implied_bound = 1e10;
+
+        /// @brief Turn singleton rows into column bounds.
+        bool singleton_rows = true;
+
+        /// @brief Remove redundant rows and fix the columns of forcing rows.
+        bool forcing_rows = true;
+
+        /// @brief Eliminate implied free column singletons and zero-cost slack columns.
+        bool singleton_columns = true;
+
+        /// @brief Substitute one column of every equation with two entries.
+        bool doubleton_equations = true;
+
+        /// @brief Fix columns whose reduced cost sign is implied by the row bound types.
+        bool dominated_columns = true;
+
+        /// @brief Merge parallel rows.
+        bool duplicate_rows = true;
+
+        /// @brief Merge parallel columns with proportional costs.
+        bool duplicate_columns = true;
+
+        /// @brief Replace infinite column bounds by finite implied bounds.
+        bool bound_tightening = true;
+    };
+
+    /// @brief Outcome of @ref Presolver::run.
+    enum class PresolveStatus : int8_t
+    {
+        /// @brief The reduced problem is equivalent to the original one.
+        kReduced,
+
+        /// @brief The problem has no feasible point.
+        kInfeasible,
+
+        /// @brief The dual problem has no feasible point, so the primal is unbounded or infeasible.
+        kUnboundedOrInfeasible,
+    };
+
+    /// @brief Number of rows and columns removed by every reduction.
+    struct PresolveStatistics
+    {
+        int passes = 0;
+        int64_t empty_rows = 0;
+        int64_t empty_columns = 0;
+        int64_t fixed_columns = 0;
+        int64_t singleton_rows = 0;
+        int64_t redundant_rows = 0;
+        int64_t forcing_rows = 0;
+        int64_t free_column_singletons = 0;
+        int64_t slack_columns = 0;
+        int64_t doubleton_equations = 0;
+        int64_t dominated_columns = 0;
+        int64_t duplicate_rows = 0;
+        int64_t duplicate_columns = 0;
+        int64_t tightened_bounds = 0;
+    };
+
+    /// @brief Reduces a linear program before it is handed to a solver.
+    ///
+    /// The constraint matrix is kept both column-wise and row-wise. Removing a row or a column
+    /// only clears its active flag and decrements the lengths of the crossing lines; stale entries
+    /// stay in the other view and are skipped when it is traversed, and lists are compacted once
+    /// more than half of their entries are stale. Only substitutions (doubleton equations) change
+    /// coefficients, and they update both views.
+    ///
+    /// Reductions are applied in rounds until a round makes no change: empty and fixed columns,
+    /// empty and singleton rows, redundant and forcing rows, free and slack column singletons,
+    /// doubleton equations, dominated columns, parallel rows and columns, and bound tightening.
+    /// Activity computation, bound tightening and the hashing for duplicate detection run on the
+    /// scheduler. Removed columns are recorded on a @ref PostsolveStack, so a primal solution of
+    /// the reduced problem can be turned into one of the original problem.
+    class Presolver
+    {
+    public:
+        /// @brief Copies @p program into the presolve data structures.
+        ///
+        /// The names of @p program are read again by @ref reduced_program, so it must outlive
+        /// the presolver.
+        explicit Presolver(const lp::LinearProgram& program, const PresolveOptions& options = {});
+
+        /// @brief Applies the reductions.
+        PresolveStatus run();
+
+        /// @brief Returns the reduced problem. Its rows and columns keep their original order.
+        [[nodiscard]] lp::LinearProgram reduced_program() const;
+
+        /// @brief Returns the original index of every row of the reduced problem.
+        [[nodiscard]] std::vector<int64_t> row_mapping() const;
+
+        /// @brief Returns the original index of every column of the reduced problem.
+        [[nodiscard]] std::vector<int64_t> column_mapping() const;
+
+        /// @brief Extends a primal solution of the reduced problem to the original problem.
+        [[nodiscard]] std::vector<double> postsolve(std::span<const double> reduced_solution) const;
+
+        /// @brief Returns the number of reductions of every kind.
+        [[nodiscard]] const PresolveStatistics& statistics() const
+        {
+            return statistics_;
+        }
+
+        /// @brief Returns the postsolve records.
+        [[nodiscard]] const PostsolveStack& postsolve_stack() const
+        {
+            return postsolve_stack_;
+        }
+
+    private:
+        struct Entry
+        {
+            int64_t index;
+            double value;
+        };
+
+        /// @brief Minimum and maximum activity of a row over the column bounds. Infinite
+        /// contributions are counted separately so that single ones can be excluded.
+        struct Activity
+        {
+            double min = 0.0;
+            double max = 0.0;
+            int64_t min_infinite = 0;
+            int64_t max_infinite = 0;
+        };
+
+        template <typename Function>
+        void for_each_row_entry(int64_t row, Function&& function) const;
+
+        template <typename Function>
+        void for_each_column_entry(int64_t column, Function&& function) const;
+
+        [[nodiscard]] bool exceeds(double value, double bound) const;
+        [[nodiscard]] Activity compute_activity(int64_t row, int64_t excluded_column = -1) const;
+        void collect_row(int64_t row, int64_t excluded_column);
+        void compact();
+        [[nodiscard]] lp::CscMatrix gather_lines(const std::vector<std::vector<Entry>>& lines,
+                                                 const std::vector<char>& line_active,
+                                                 const std::vector<int64_t>& line_length,
+                                                 const std::vector<char>& entry_active,
+                                                 std::vector<int64_t>& line_ids) const;
+
+        void remove_row(int64_t row);
+        void remove_column(int64_t column);
+        void fix_column(int64_t column, double value);
+        bool tighten_column(int64_t column, double lower, double upper);
+        bool tighten_row(int64_t row, double lower, double upper);
+        void add_to_coefficient(int64_t row, int64_t column, double delta);
+
+        bool remove_empty_and_fixed();
+        bool remove_singleton_rows();
+        bool remove_forcing_rows();
+        bool remove_singleton_columns();
+        bool remove_doubleton_equations();
+        bool remove_dominated_columns();
+        bool remove_duplicate_rows();
+        bool remove_duplicate_columns();
+        bool tighten_bounds();
+
+        PresolveOptions options_;
+        PresolveStatus status_ = PresolveStatus::kReduced;
+        PresolveStatistics statistics_;
+        PostsolveStack postsolve_stack_;
+
+        const lp::LinearProgram& original_;
+        double sense_ = 1.0;
+        double objective_offset_ = 0.0;
+        std::vector<double> cost_;
+        std::vector<double> column_lower_;
+        std::vector<double> column_upper_;
+        std::vector<double> row_lower_;
+        std::vector<double> row_upper_;
+
+        std::vector<std::vector<Entry>> columns_;
+        std::vector<std::vector<Entry>> rows_;
+        std::vector<int64_t> column_length_;
+        std::vector<int64_t> row_length_;
+        std::vector<char> column_active_;
+        std::vector<char> row_active_;
+
+        // Scratch space for copies of a row.
+        std::vector<int64_t> scratch_columns_;
+        std::vector<double> scratch_values_;
+    };
+}
+
+#endif // KALIX_PRESOLVE_PRESOLVE_H_
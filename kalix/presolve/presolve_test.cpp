@@ -0,0 +1,548 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/presolve/presolve.h"
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+
+namespace kalix::presolve
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        constexpr double kTolerance = 1e-6;
+
+        using DenseMatrix = std::vector<std::vector<double>>;
+
+        lp::LinearProgram make_program(const DenseMatrix& rows, const std::vector<double>& objective,
+                                       const std::vector<double>& column_lower,
+                                       const std::vector<double>& column_upper,
+                                       const std::vector<double>& row_lower, const std::vector<double>& row_upper)
+        {
+            lp::LinearProgram program;
+            const auto num_cols = static_cast<int64_t>(objective.size());
+            const auto num_rows = static_cast<int64_t>(rows.size());
+            program.constraint_matrix.num_rows = num_rows;
+            program.constraint_matrix.num_cols = num_cols;
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                for (int64_t i = 0; i < num_rows; i++)
+                {
+                    if (rows[i][j] != 0.0)
+                    {
+                        program.constraint_matrix.row_indices.push_back(i);
+                        program.constraint_matrix.values.push_back(rows[i][j]);
+                    }
+                }
+                program.constraint_matrix.column_starts.push_back(
+                    static_cast<int64_t>(program.constraint_matrix.row_indices.size()));
+            }
+            program.objective = objective;
+            program.column_lower = column_lower;
+            program.column_upper = column_upper;
+            program.row_lower = row_lower;
+            program.row_upper = row_upper;
+            return program;
+        }
+
+        DenseMatrix dense_rows(const lp::LinearProgram& program)
+        {
+            const lp::CscMatrix& matrix = program.constraint_matrix;
+            DenseMatrix rows(program.num_rows(), std::vector<double>(program.num_cols(), 0.0));
+            for (int64_t j = 0; j < program.num_cols(); j++)
+            {
+                for (int64_t k = matrix.column_starts[j]; k < matrix.column_starts[j + 1]; k++)
+                {
+                    rows[matrix.row_indices[k]][j] += matrix.values[k];
+                }
+            }
+            return rows;
+        }
+
+        double objective_value(const lp::LinearProgram& program, const std::vector<double>& x)
+        {
+            double value = program.objective_offset;
+            for (int64_t j = 0; j < program.num_cols(); j++)
+            {
+                value += program.objective[j] * x[j];
+            }
+            return value;
+        }
+
+        bool is_feasible(const lp::LinearProgram& program, const std::vector<double>& x)
+        {
+            const DenseMatrix rows = dense_rows(program);
+            for (int64_t j = 0; j < program.num_cols(); j++)
+            {
+                if (x[j] < program.column_lower[j] - kTolerance || x[j] > program.column_upper[j] + kTolerance)
+                {
+                    return false;
+                }
+            }
+            for (int64_t i = 0; i < program.num_rows(); i++)
+            {
+                double activity = 0.0;
+                for (int64_t j = 0; j < program.num_cols(); j++)
+                {
+                    activity += rows[i][j] * x[j];
+                }
+                if (activity < program.row_lower[i] - kTolerance || activity > program.row_upper[i] + kTolerance)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// Solves the square system in place with partial pivoting. Returns false if it is singular.
+        bool solve_square(DenseMatrix& matrix, std::vector<double>& rhs)
+        {
+            const size_t n = rhs.size();
+            for (size_t k = 0; k < n; k++)
+            {
+                size_t pivot = k;
+                for (size_t i = k + 1; i < n; i++)
+                {
+                    if (std::abs(matrix[i][k]) > std::abs(matrix[pivot][k]))
+                    {
+                        pivot = i;
+                    }
+                }
+                if (std::abs(matrix[pivot][k]) < 1e-9)
+                {
+                    return false;
+                }
+                std::swap(matrix[k], matrix[pivot]);
+                std::swap(rhs[k], rhs[pivot]);
+                for (size_t i = k + 1; i < n; i++)
+                {
+                    const double factor = matrix[i][k] / matrix[k][k];
+                    for (size_t t = k; t < n; t++)
+                    {
+                        matrix[i][t] -= factor * matrix[k][t];
+                    }
+                    rhs[i] -= factor * rhs[k];
+                }
+            }
+            for (size_t k = n; k-- > 0;)
+            {
+                for (size_t t = k + 1; t < n; t++)
+                {
+                    rhs[k] -= matrix[k][t] * rhs[t];
+                }
+                rhs[k] /= matrix[k][k];
+            }
+            return true;
+        }
+
+        /// Solves a small LP with finite column bounds by enumerating all vertices. Returns the
+        /// optimal solution, or nothing if the program is infeasible.
+        std::optional<std::vector<double>> solve_by_enumeration(const lp::LinearProgram& program)
+        {
+            const int64_t n = program.num_cols();
+            const DenseMatrix rows = dense_rows(program);
+
+            // Every bound as an equation g * x = h that can be active at a vertex.
+            DenseMatrix planes;
+            std::vector<double> offsets;
+            for (int64_t j = 0; j < n; j++)
+            {
+                std::vector<double> unit(n, 0.0);
+                unit[j] = 1.0;
+                planes.push_back(unit);
+                offsets.push_back(program.column_lower[j]);
+                planes.push_back(unit);
+                offsets.push_back(program.column_upper[j]);
+            }
+            for (int64_t i = 0; i < program.num_rows(); i++)
+            {
+                for (const double bound : {program.row_lower[i], program.row_upper[i]})
+                {
+                    if (!std::isinf(bound))
+                    {
+                        planes.push_back(rows[i]);
+                        offsets.push_back(bound);
+                    }
+                }
+            }
+
+            const double sense = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+            std::optional<std::vector<double>> best;
+            double best_value = kInfinity;
+            std::vector<size_t> chosen;
+            const auto visit = [&](auto& self, const size_t start) -> void
+            {
+                if (static_cast<int64_t>(chosen.size()) == n)
+                {
+                    DenseMatrix matrix;
+                    std::vector<double> x;
+                    for (const size_t c : chosen)
+                    {
+                        matrix.push_back(planes[c]);
+                        x.push_back(offsets[c]);
+                    }
+                    if (solve_square(matrix, x) && is_feasible(program, x))
+                    {
+                        const double value = sense * objective_value(program, x);
+                        if (value < best_value)
+                        {
+                            best_value = value;
+                            best = x;
+                        }
+                    }
+                    return;
+                }
+                for (size_t c = start; c < planes.size(); c++)
+                {
+                    chosen.push_back(c);
+                    self(self, c + 1);
+                    chosen.pop_back();
+                }
+            };
+            visit(visit, 0);
+            return best;
+        }
+
+        lp::LinearProgram random_program(std::mt19937& rng)
+        {
+            std::uniform_int_distribution<int> size(1, 4);
+            std::uniform_int_distribution<int> coefficient(-3, 3);
+            std::uniform_int_distribution<int> small(-2, 2);
+            std::uniform_int_distribution<int> width(0, 3);
+            std::uniform_int_distribution<int> kind(0, 9);
+
+            const int num_cols = size(rng);
+            const int num_rows = size(rng);
+            std::vector<double> objective(num_cols);
+            std::vector<double> column_lower(num_cols);
+            std::vector<double> column_upper(num_cols);
+            std::vector<double> point(num_cols);
+            for (int j = 0; j < num_cols; j++)
+            {
+                objective[j] = kind(rng) < 3 ? 0.0 : coefficient(rng);
+                if (kind(rng) < 2)
+                {
+                    column_lower[j] = -50.0;
+                    column_upper[j] = 50.0;
+                }
+                else
+                {
+                    column_lower[j] = small(rng);
+                    column_upper[j] = column_lower[j] + width(rng);
+                }
+                point[j] = column_lower[j] + (column_upper[j] - column_lower[j]) * (kind(rng) / 9.0);
+            }
+
+            DenseMatrix rows(num_rows, std::vector<double>(num_cols, 0.0));
+            std::vector<double> row_lower(num_rows);
+            std::vector<double> row_upper(num_rows);
+            for (int i = 0; i < num_rows; i++)
+            {
+                if (i > 0 && kind(rng) < 2)
+                {
+                    // A scaled copy of an earlier row.
+                    const int source = std::uniform_int_distribution<int>(0, i - 1)(rng);
+                    const double scale = kind(rng) < 5 ? -2.0 : 0.5;
+                    for (int j = 0; j < num_cols; j++)
+                    {
+                        rows[i][j] = scale * rows[source][j];
+                    }
+                }
+                else
+                {
+                    for (int j = 0; j < num_cols; j++)
+                    {
+                        rows[i][j] = kind(rng) < 5 ? coefficient(rng) : 0.0;
+                    }
+                }
+                // Most rows are satisfied by the random point, so that many programs are feasible.
+                double activity = 0.0;
+                for (int j = 0; j < num_cols; j++)
+                {
+                    activity += rows[i][j] * point[j];
+                }
+                const int type = kind(rng);
+                const double shift = kind(rng) == 0 ? 3.0 : 0.0;
+                row_lower[i] = type < 3 ? activity + shift : type < 6 ? activity - width(rng) + shift : -kInfinity;
+                row_upper[i] = type < 3 ? activity + shift : type < 6 || type == 9 ? kInfinity : activity + width(rng);
+            }
+
+            if (num_cols > 1 && kind(rng) < 3)
+            {
+                // Make the last column a scaled copy of the first one.
+                const double scale = kind(rng) < 5 ? 2.0 : -1.0;
+                for (int i = 0; i < num_rows; i++)
+                {
+                    rows[i][num_cols - 1] = scale * rows[i][0];
+                }
+                objective[num_cols - 1] = scale * objective[0];
+            }
+
+            lp::LinearProgram program = make_program(rows, objective, column_lower, column_upper, row_lower, row_upper);
+            program.objective_offset = small(rng);
+            if (kind(rng) < 3)
+            {
+                program.sense = lp::ObjectiveSense::kMaximize;
+            }
+            return program;
+        }
+
+        void expect_equivalent(const lp::LinearProgram& program, const PresolveOptions& options)
+        {
+            const std::optional<std::vector<double>> original = solve_by_enumeration(program);
+
+            Presolver presolver(program, options);
+            const PresolveStatus status = presolver.run();
+            if (status != PresolveStatus::kReduced)
+            {
+                EXPECT_FALSE(original.has_value());
+                return;
+            }
+
+            const lp::LinearProgram reduced = presolver.reduced_program();
+            const std::optional<std::vector<double>> reduced_solution = solve_by_enumeration(reduced);
+            ASSERT_EQ(original.has_value(), reduced_solution.has_value());
+            if (!original.has_value())
+            {
+                return;
+            }
+
+            const double optimum = objective_value(program, *original);
+            EXPECT_NEAR(objective_value(reduced, *reduced_solution), optimum, kTolerance);
+
+            const std::vector<double> solution = presolver.postsolve(*reduced_solution);
+            EXPECT_TRUE(is_feasible(program, solution));
+            EXPECT_NEAR(objective_value(program, solution), optimum, kTolerance);
+        }
+    }
+
+    TEST(PresolveTest, RemovesEmptyAndFixedColumns)
+    {
+        // min x0 + 2 x1 - x2  s.t.  x0 + x1 >= 1, x1 fixed at 2, x2 in [0, 4] appears nowhere.
+        const lp::LinearProgram program =
+            make_program({{1.0, 1.0, 0.0}}, {1.0, 2.0, -1.0}, {0.0, 2.0, 0.0}, {5.0, 2.0, 4.0}, {1.0}, {kInfinity});
+        Presolver presolver(program);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_EQ(presolver.statistics().empty_columns, 1);
+        EXPECT_EQ(presolver.statistics().fixed_columns, 1);
+        expect_equivalent(program, {});
+    }
+
+    TEST(PresolveTest, SingletonRowBecomesBound)
+    {
+        // 2 x0 <= 6 bounds x0 by 3.
+        const lp::LinearProgram program = make_program({{2.0, 0.0}, {1.0, 1.0}}, {-1.0, -1.0}, {0.0, 0.0},
+                                                       {10.0, 10.0}, {-kInfinity, -kInfinity}, {6.0, 8.0});
+        PresolveOptions options;
+        options.max_passes = 1;
+        options.forcing_rows = false;
+        options.singleton_columns = false;
+        options.dominated_columns = false;
+        options.duplicate_columns = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_EQ(presolver.statistics().singleton_rows, 1);
+        const lp::LinearProgram reduced = presolver.reduced_program();
+        ASSERT_EQ(reduced.num_rows(), 1);
+        EXPECT_EQ(reduced.column_upper[0], 3.0);
+        expect_equivalent(program, options);
+    }
+
+    TEST(PresolveTest, ForcingRowFixesColumns)
+    {
+        // x0 + x1 <= 0 with both columns non-negative forces both to zero.
+        const lp::LinearProgram program = make_program({{1.0, 1.0}, {1.0, -1.0}}, {-1.0, -2.0}, {0.0, 0.0},
+                                                       {5.0, 5.0}, {-kInfinity, -1.0}, {0.0, 1.0});
+        Presolver presolver(program);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_EQ(presolver.statistics().forcing_rows, 1);
+        EXPECT_EQ(presolver.reduced_program().num_cols(), 0);
+        EXPECT_EQ(presolver.postsolve({}), (std::vector<double>{0.0, 0.0}));
+    }
+
+    TEST(PresolveTest, FreeColumnSingletonIsSubstituted)
+    {
+        // min x0 + x1 + x2  s.t.  x0 + x1 - x2 = 1 (x2 free), x0 + 2 x1 >= 2.
+        const lp::LinearProgram program =
+            make_program({{1.0, 1.0, -1.0}, {1.0, 2.0, 0.0}}, {1.0, 1.0, 1.0}, {0.0, 0.0, -kInfinity},
+                         {4.0, 4.0, kInfinity}, {1.0, 2.0}, {1.0, kInfinity});
+        PresolveOptions options;
+        options.doubleton_equations = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_EQ(presolver.statistics().free_column_singletons, 1);
+
+        const lp::LinearProgram reduced = presolver.reduced_program();
+        const std::optional<std::vector<double>> reduced_solution = solve_by_enumeration(reduced);
+        ASSERT_TRUE(reduced_solution.has_value());
+        const std::vector<double> solution = presolver.postsolve(*reduced_solution);
+        EXPECT_TRUE(is_feasible(program, solution));
+        // The optimum is x = (0, 1, 0) with objective 1.
+        EXPECT_NEAR(objective_value(program, solution), 1.0, kTolerance);
+    }
+
+    TEST(PresolveTest, DoubletonEquationIsEliminated)
+    {
+        // x0 - 2 x1 = 0 substitutes x0 into the second row.
+        const lp::LinearProgram program =
+            make_program({{1.0, -2.0, 0.0}, {1.0, 1.0, 1.0}, {3.0, 0.0, -1.0}}, {-1.0, -1.0, -1.0},
+                         {0.0, 0.0, 0.0}, {6.0, 6.0, 6.0}, {0.0, -kInfinity, -kInfinity}, {0.0, 6.0, 4.0});
+        PresolveOptions options;
+        options.singleton_columns = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_GE(presolver.statistics().doubleton_equations, 1);
+        expect_equivalent(program, options);
+    }
+
+    TEST(PresolveTest, DominatedColumnIsFixed)
+    {
+        // x1 has positive cost and only helps in a <= row, so it sits at its lower bound.
+        const lp::LinearProgram program = make_program({{1.0, 1.0}, {-1.0, 2.0}}, {-1.0, 1.0}, {0.0, 1.0},
+                                                       {5.0, 3.0}, {-kInfinity, -kInfinity}, {4.0, 2.0});
+        PresolveOptions options;
+        options.singleton_columns = false;
+        options.doubleton_equations = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_GE(presolver.statistics().dominated_columns, 1);
+        expect_equivalent(program, options);
+    }
+
+    TEST(PresolveTest, DuplicateRowsAndColumnsAreMerged)
+    {
+        // Row 1 is -2 times row 0, column 2 is twice column 0 with twice its cost.
+        const lp::LinearProgram program = make_program(
+            {{1.0, 1.0, 2.0}, {-2.0, -2.0, -4.0}, {1.0, 3.0, 2.0}}, {-1.0, -1.0, -2.0}, {0.0, 0.0, 0.0},
+            {3.0, 3.0, 1.0}, {-kInfinity, -10.0, 1.0}, {4.0, kInfinity, 8.0});
+        PresolveOptions options;
+        options.forcing_rows = false;
+        options.singleton_columns = false;
+        options.doubleton_equations = false;
+        options.dominated_columns = false;
+        options.bound_tightening = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_EQ(presolver.statistics().duplicate_rows, 1);
+        EXPECT_EQ(presolver.statistics().duplicate_columns, 1);
+        const lp::LinearProgram reduced = presolver.reduced_program();
+        EXPECT_EQ(reduced.num_rows(), 2);
+        EXPECT_EQ(reduced.num_cols(), 2);
+        // The merged row keeps the tighter upper bound 4 and gains no lower bound from 10 / -2.
+        EXPECT_EQ(reduced.row_upper[0], 4.0);
+        expect_equivalent(program, options);
+    }
+
+    TEST(PresolveTest, TightensInfiniteBounds)
+    {
+        // x0 + x1 <= 4 with x1 >= 0 implies x0 <= 4.
+        const lp::LinearProgram program =
+            make_program({{1.0, 1.0}, {1.0, -1.0}}, {0.0, 0.0}, {0.0, 0.0}, {kInfinity, kInfinity},
+                         {-kInfinity, -1.0}, {4.0, 1.0});
+        PresolveOptions options;
+        options.singleton_columns = false;
+        options.doubleton_equations = false;
+        options.dominated_columns = false;
+        options.duplicate_rows = false;
+        options.duplicate_columns = false;
+        options.max_passes = 1;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+        EXPECT_GT(presolver.statistics().tightened_bounds, 0);
+        const lp::LinearProgram reduced = presolver.reduced_program();
+        EXPECT_NEAR(reduced.column_upper[0], 4.0, 1e-6);
+        EXPECT_NEAR(reduced.column_upper[1], 4.0, 1e-6);
+    }
+
+    TEST(PresolveTest, DetectsInfeasibleRow)
+    {
+        // x0 + x1 >= 5 cannot hold with both columns in [0, 2].
+        const lp::LinearProgram program =
+            make_program({{1.0, 1.0}}, {1.0, 1.0}, {0.0, 0.0}, {2.0, 2.0}, {5.0}, {kInfinity});
+        Presolver presolver(program);
+        EXPECT_EQ(presolver.run(), PresolveStatus::kInfeasible);
+    }
+
+    TEST(PresolveTest, DetectsUnboundedEmptyColumn)
+    {
+        const lp::LinearProgram program = make_program({{1.0, 0.0}}, {1.0, -1.0}, {0.0, 0.0}, {1.0, kInfinity},
+                                                       {0.0}, {1.0});
+        Presolver presolver(program);
+        EXPECT_EQ(presolver.run(), PresolveStatus::kUnboundedOrInfeasible);
+    }
+
+    TEST(PresolveTest, ReducedProgramKeepsSenseAndNames)
+    {
+        lp::LinearProgram program = make_program({{1.0, 1.0, 1.0}, {1.0, 2.0, 0.0}}, {1.0, 2.0, 3.0},
+                                                 {0.0, 1.0, 0.0}, {4.0, 1.0, 4.0}, {-kInfinity, 1.0},
+                                                 {5.0, kInfinity});
+        program.sense = lp::ObjectiveSense::kMaximize;
+        program.objective_offset = 2.0;
+        program.row_names = {"r0", "r1"};
+        program.column_names = {"x0", "x1", "x2"};
+        PresolveOptions options;
+        options.max_passes = 1;
+        options.singleton_columns = false;
+        options.dominated_columns = false;
+        options.forcing_rows = false;
+        Presolver presolver(program, options);
+        ASSERT_EQ(presolver.run(), PresolveStatus::kReduced);
+
+        const lp::LinearProgram reduced = presolver.reduced_program();
+        EXPECT_EQ(reduced.sense, lp::ObjectiveSense::kMaximize);
+        EXPECT_EQ(reduced.objective_offset, 4.0);
+        EXPECT_EQ(reduced.column_names, (std::vector<std::string>{"x0", "x2"}));
+        EXPECT_EQ(reduced.objective, (std::vector<double>{1.0, 3.0}));
+        EXPECT_EQ(presolver.column_mapping(), (std::vector<int64_t>{0, 2}));
+        expect_equivalent(program, options);
+    }
+
+    class PresolveRandomTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(PresolveRandomTest, MatchesOriginalOptimum)
+    {
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        PresolveOptions options;
+        options.scheduler = GetParam() > 0 ? &scheduler : nullptr;
+        std::mt19937 rng(20260 + GetParam());
+        for (int trial = 0; trial < 400; trial++)
+        {
+            SCOPED_TRACE(trial);
+            expect_equivalent(random_program(rng), options);
+            if (::testing::Test::HasFailure())
+            {
+                return;
+            }
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, PresolveRandomTest, ::testing::Values(0, 4));
+}
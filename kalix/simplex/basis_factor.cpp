@@ -0,0 +1,539 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/basis_factor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        /// @brief Moves the solution from the packed scratch array into the dense array and
+        /// rebuilds the index list.
+        void finish_solve(Vector<double>& vector)
+        {
+            std::swap(vector.dense_values, vector.packed_values);
+            vector.packed_element_count = 0;
+            vector.should_update_packed_storage = true;
+            vector.packed_storage_is_sorted = false;
+            vector.non_zero_count = -1;
+            vector.rebuild_indices_from_dense();
+        }
+    }
+
+    BasisFactor::BasisFactor(const lp::CscMatrix& matrix, const BasisFactorOptions& options)
+        : matrix_(matrix), options_(options), num_rows_(matrix.num_rows)
+    {
+    }
+
+    void BasisFactor::reset()
+    {
+        pivot_rows_.clear();
+        pivot_positions_.clear();
+        pivots_.clear();
+        lower_starts_.assign(1, 0);
+        lower_rows_.clear();
+        lower_values_.clear();
+        upper_starts_.assign(1, 0);
+        upper_positions_.clear();
+        upper_values_.clear();
+        etas_.clear();
+        eta_positions_.clear();
+        eta_values_.clear();
+    }
+
+    absl::Status BasisFactor::factorize(const std::span<const int64_t> basic_index)
+    {
+        CHECK_EQ(static_cast<int64_t>(basic_index.size()), num_rows_);
+        const int64_t m = num_rows_;
+        reset();
+
+        // The active submatrix by columns, and for every row the columns that have or had an entry
+        // in it. The row lists are not cleaned up, so they can hold inactive or repeated columns.
+        std::vector<std::vector<int64_t>> column_rows(m);
+        std::vector<std::vector<double>> column_values(m);
+        std::vector<std::vector<int64_t>> row_positions(m);
+        for (int64_t p = 0; p < m; p++)
+        {
+            const int64_t variable = basic_index[p];
+            if (variable < matrix_.num_cols)
+            {
+                for (int64_t k = matrix_.column_starts[variable]; k < matrix_.column_starts[variable + 1]; k++)
+                {
+                    if (matrix_.values[k] != 0.0)
+                    {
+                        column_rows[p].push_back(matrix_.row_indices[k]);
+                        column_values[p].push_back(matrix_.values[k]);
+                    }
+                }
+            }
+            else
+            {
+                column_rows[p].push_back(variable - matrix_.num_cols);
+                column_values[p].push_back(-1.0);
+            }
+            for (const int64_t i : column_rows[p])
+            {
+                row_positions[i].push_back(p);
+            }
+        }
+
+        // Active entries per column and row, ordered by count.
+        std::vector<int64_t> column_counts(m);
+        std::vector<int64_t> row_counts(m, 0);
+        std::set<std::pair<int64_t, int64_t>> column_queue;
+        std::set<std::pair<int64_t, int64_t>> row_queue;
+        for (int64_t p = 0; p < m; p++)
+        {
+            column_counts[p] = static_cast<int64_t>(column_rows[p].size());
+            column_queue.emplace(column_counts[p], p);
+            for (const int64_t i : column_rows[p])
+            {
+                row_counts[i]++;
+            }
+        }
+        for (int64_t i = 0; i < m; i++)
+        {
+            row_queue.emplace(row_counts[i], i);
+        }
+        const auto change_column_count = [&](const int64_t p, const int64_t delta)
+        {
+            column_queue.erase({column_counts[p], p});
+            column_counts[p] += delta;
+            column_queue.emplace(column_counts[p], p);
+        };
+        const auto change_row_count = [&](const int64_t i, const int64_t delta)
+        {
+            row_queue.erase({row_counts[i], i});
+            row_counts[i] += delta;
+            row_queue.emplace(row_counts[i], i);
+        };
+        const auto find_entry = [&](const int64_t p, const int64_t i) -> int64_t
+        {
+            for (size_t t = 0; t < column_rows[p].size(); t++)
+            {
+                if (column_rows[p][t] == i)
+                {
+                    return static_cast<int64_t>(t);
+                }
+            }
+            return -1;
+        };
+
+        std::vector<bool> column_active(m, true);
+        std::vector<int64_t> scatter(m, -1);
+        for (int64_t k = 0; k < m; k++)
+        {
+            int64_t pivot_row = -1;
+            int64_t pivot_position = -1;
+            double pivot = 0.0;
+
+            const auto [smallest_column, first_position] = *column_queue.begin();
+            if (smallest_column == 0)
+            {
+                return absl::InvalidArgumentError(
+                    absl::StrCat("Basis is singular: column at position ", first_position, " is dependent"));
+            }
+            if (smallest_column == 1)
+            {
+                // Column singleton: no multipliers, no fill.
+                pivot_position = first_position;
+                pivot_row = column_rows[pivot_position][0];
+                pivot = column_values[pivot_position][0];
+            }
+            else if (row_queue.begin()->first == 1)
+            {
+                // Row singleton: multipliers, but no fill.
+                pivot_row = row_queue.begin()->second;
+                for (const int64_t p : row_positions[pivot_row])
+                {
+                    if (column_active[p])
+                    {
+                        if (const int64_t t = find_entry(p, pivot_row); t != -1)
+                        {
+                            pivot_position = p;
+                            pivot = column_values[p][t];
+                            break;
+                        }
+                    }
+                }
+            }
+            if (std::abs(pivot) <= options_.singular_tolerance)
+            {
+                // Markowitz search over the shortest columns, under the threshold condition.
+                pivot_position = -1;
+                int64_t best_cost = std::numeric_limits<int64_t>::max();
+                int searched = 0;
+                for (auto it = column_queue.begin(); it != column_queue.end() && searched < options_.max_search_columns;
+                     ++it, searched++)
+                {
+                    const auto [count, p] = *it;
+                    double largest = 0.0;
+                    for (const double value : column_values[p])
+                    {
+                        largest = std::max(largest, std::abs(value));
+                    }
+                    for (size_t t = 0; t < column_rows[p].size(); t++)
+                    {
+                        const double value = column_values[p][t];
+                        if (std::abs(value) < options_.pivot_threshold * largest ||
+                            std::abs(value) <= options_.singular_tolerance)
+                        {
+                            continue;
+                        }
+                        const int64_t cost = (row_counts[column_rows[p][t]] - 1) * (count - 1);
+                        if (cost < best_cost || (cost == best_cost && std::abs(value) > std::abs(pivot)))
+                        {
+                            best_cost = cost;
+                            pivot_row = column_rows[p][t];
+                            pivot_position = p;
+                            pivot = value;
+                        }
+                    }
+                }
+            }
+            if (pivot_position == -1 || std::abs(pivot) <= options_.singular_tolerance)
+            {
+                return absl::InvalidArgumentError(
+                    absl::StrCat("Basis is singular: no acceptable pivot in step ", k, " of ", m));
+            }
+
+            pivot_rows_.push_back(pivot_row);
+            pivot_positions_.push_back(pivot_position);
+            pivots_.push_back(pivot);
+            column_queue.erase({column_counts[pivot_position], pivot_position});
+            column_active[pivot_position] = false;
+            row_queue.erase({row_counts[pivot_row], pivot_row});
+
+            // Row of U: the entries of the pivot row in the other active columns, which leave the
+            // active submatrix.
+            const auto upper_begin = static_cast<int64_t>(upper_positions_.size());
+            for (const int64_t p : row_positions[pivot_row])
+            {
+                if (!column_active[p])
+                {
+                    continue;
+                }
+                const int64_t t = find_entry(p, pivot_row);
+                if (t == -1)
+                {
+                    continue;
+                }
+                upper_positions_.push_back(p);
+                upper_values_.push_back(column_values[p][t]);
+                column_rows[p][t] = column_rows[p].back();
+                column_values[p][t] = column_values[p].back();
+                column_rows[p].pop_back();
+                column_values[p].pop_back();
+                change_column_count(p, -1);
+            }
+            upper_starts_.push_back(static_cast<int64_t>(upper_positions_.size()));
+
+            // Column of L: the multipliers of the other rows of the pivot column.
+            const auto lower_begin = static_cast<int64_t>(lower_rows_.size());
+            for (size_t t = 0; t < column_rows[pivot_position].size(); t++)
+            {
+                const int64_t i = column_rows[pivot_position][t];
+                if (i == pivot_row)
+                {
+                    continue;
+                }
+                change_row_count(i, -1);
+                const double multiplier = column_values[pivot_position][t] / pivot;
+                if (std::abs(multiplier) > options_.drop_tolerance)
+                {
+                    lower_rows_.push_back(i);
+                    lower_values_.push_back(multiplier);
+                }
+            }
+            lower_starts_.push_back(static_cast<int64_t>(lower_rows_.size()));
+            std::vector<int64_t>().swap(column_rows[pivot_position]);
+            std::vector<double>().swap(column_values[pivot_position]);
+
+            // Schur complement update of every column in the pivot row.
+            const auto lower_end = static_cast<int64_t>(lower_rows_.size());
+            for (int64_t u = upper_begin; u < upper_starts_.back(); u++)
+            {
+                const int64_t p = upper_positions_[u];
+                const double factor = upper_values_[u];
+                std::vector<int64_t>& rows = column_rows[p];
+                std::vector<double>& values = column_values[p];
+                for (size_t t = 0; t < rows.size(); t++)
+                {
+                    scatter[rows[t]] = static_cast<int64_t>(t);
+                }
+                int64_t fill = 0;
+                for (int64_t l = lower_begin; l < lower_end; l++)
+                {
+                    const int64_t i = lower_rows_[l];
+                    if (scatter[i] != -1)
+                    {
+                        values[scatter[i]] -= lower_values_[l] * factor;
+                    }
+                    else
+                    {
+                        scatter[i] = static_cast<int64_t>(rows.size());
+                        rows.push_back(i);
+                        values.push_back(-lower_values_[l] * factor);
+                        row_positions[i].push_back(p);
+                        change_row_count(i, 1);
+                        fill++;
+                    }
+                }
+                for (const int64_t i : rows)
+                {
+                    scatter[i] = -1;
+                }
+                if (fill > 0)
+                {
+                    change_column_count(p, fill);
+                }
+            }
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status BasisFactor::factorize_triangular(const std::span<const int64_t> basic_index,
+                                                   const std::span<const int64_t> pivot_rows)
+    {
+        CHECK_EQ(static_cast<int64_t>(basic_index.size()), num_rows_);
+        CHECK_EQ(static_cast<int64_t>(pivot_rows.size()), num_rows_);
+        reset();
+
+        // The elimination step of every row.
+        std::vector<int64_t> steps(num_rows_, -1);
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            if (steps[pivot_rows[p]] != -1)
+            {
+                return absl::InvalidArgumentError(absl::StrCat("Row ", pivot_rows[p], " is pivoted twice"));
+            }
+            steps[pivot_rows[p]] = p;
+        }
+
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            const int64_t variable = basic_index[p];
+            const int64_t pivot_row = pivot_rows[p];
+            const int64_t slack_row = variable - matrix_.num_cols;
+            const double slack_value = -1.0;
+            const std::span<const int64_t> rows = variable < matrix_.num_cols
+                ? matrix_.column_indices(variable) : std::span<const int64_t>(&slack_row, 1);
+            const std::span<const double> values = variable < matrix_.num_cols
+                ? matrix_.column_values(variable) : std::span<const double>(&slack_value, 1);
+
+            double pivot = 0.0;
+            for (size_t t = 0; t < rows.size(); t++)
+            {
+                if (rows[t] == pivot_row)
+                {
+                    pivot = values[t];
+                }
+                else if (values[t] != 0.0 && steps[rows[t]] < p)
+                {
+                    return absl::InvalidArgumentError(absl::StrCat("Basis is not lower triangular: position ", p,
+                                                                   " has an entry in row ", rows[t]));
+                }
+            }
+            if (std::abs(pivot) <= options_.singular_tolerance)
+            {
+                return absl::InvalidArgumentError(
+                    absl::StrCat("Basis is singular: pivot ", pivot, " at position ", p));
+            }
+
+            pivot_rows_.push_back(pivot_row);
+            pivot_positions_.push_back(p);
+            pivots_.push_back(pivot);
+            for (size_t t = 0; t < rows.size(); t++)
+            {
+                if (const double multiplier = values[t] / pivot;
+                    rows[t] != pivot_row && std::abs(multiplier) > options_.drop_tolerance)
+                {
+                    lower_rows_.push_back(rows[t]);
+                    lower_values_.push_back(multiplier);
+                }
+            }
+            lower_starts_.push_back(static_cast<int64_t>(lower_rows_.size()));
+            upper_starts_.push_back(0);
+        }
+        return absl::OkStatus();
+    }
+
+    absl::Status BasisFactor::update(const Vector<double>& column, const int64_t position)
+    {
+        DCHECK_GE(position, 0);
+        DCHECK_LT(position, num_rows_);
+        const double pivot = column.dense_values[position];
+        if (std::abs(pivot) <= options_.singular_tolerance)
+        {
+            return absl::InvalidArgumentError(absl::StrCat("Update pivot ", pivot, " at position ", position,
+                                                           " makes the basis singular"));
+        }
+
+        Eta eta;
+        eta.position = position;
+        eta.pivot = pivot;
+        eta.begin = static_cast<int64_t>(eta_positions_.size());
+        const auto add = [&](const int64_t i)
+        {
+            if (const double value = column.dense_values[i]; i != position && std::abs(value) > options_.drop_tolerance)
+            {
+                eta_positions_.push_back(i);
+                eta_values_.push_back(value);
+            }
+        };
+        if (column.non_zero_count < 0)
+        {
+            for (int64_t i = 0; i < num_rows_; i++)
+            {
+                add(i);
+            }
+        }
+        else
+        {
+            for (int64_t t = 0; t < column.non_zero_count; t++)
+            {
+                add(column.non_zero_indices[t]);
+            }
+        }
+        eta.end = static_cast<int64_t>(eta_positions_.size());
+        etas_.push_back(eta);
+        return absl::OkStatus();
+    }
+
+    void BasisFactor::ftran(Vector<double>& rhs) const
+    {
+        DCHECK_EQ(rhs.dimension, num_rows_);
+        std::vector<double>& values = rhs.dense_values;
+        const auto m = static_cast<int64_t>(pivots_.size());
+        for (int64_t k = 0; k < m; k++)
+        {
+            const double value = values[pivot_rows_[k]];
+            if (value == 0.0)
+            {
+                continue;
+            }
+            for (int64_t l = lower_starts_[k]; l < lower_starts_[k + 1]; l++)
+            {
+                values[lower_rows_[l]] -= lower_values_[l] * value;
+            }
+        }
+
+        std::vector<double>& solution = rhs.packed_values;
+        for (int64_t k = m - 1; k >= 0; k--)
+        {
+            double value = values[pivot_rows_[k]];
+            for (int64_t u = upper_starts_[k]; u < upper_starts_[k + 1]; u++)
+            {
+                value -= upper_values_[u] * solution[upper_positions_[u]];
+            }
+            solution[pivot_positions_[k]] = value / pivots_[k];
+        }
+
+        for (const Eta& eta : etas_)
+        {
+            const double value = solution[eta.position] / eta.pivot;
+            solution[eta.position] = value;
+            if (value == 0.0)
+            {
+                continue;
+            }
+            for (int64_t e = eta.begin; e < eta.end; e++)
+            {
+                solution[eta_positions_[e]] -= eta_values_[e] * value;
+            }
+        }
+        finish_solve(rhs);
+    }
+
+    void BasisFactor::btran(Vector<double>& rhs) const
+    {
+        DCHECK_EQ(rhs.dimension, num_rows_);
+        std::vector<double>& values = rhs.dense_values;
+        for (auto eta = etas_.rbegin(); eta != etas_.rend(); ++eta)
+        {
+            double value = values[eta->position];
+            for (int64_t e = eta->begin; e < eta->end; e++)
+            {
+                value -= eta_values_[e] * values[eta_positions_[e]];
+            }
+            values[eta->position] = value / eta->pivot;
+        }
+
+        std::vector<double>& solution = rhs.packed_values;
+        const auto m = static_cast<int64_t>(pivots_.size());
+        for (int64_t k = 0; k < m; k++)
+        {
+            const double value = values[pivot_positions_[k]] / pivots_[k];
+            solution[pivot_rows_[k]] = value;
+            if (value == 0.0)
+            {
+                continue;
+            }
+            for (int64_t u = upper_starts_[k]; u < upper_starts_[k + 1]; u++)
+            {
+                values[upper_positions_[u]] -= upper_values_[u] * value;
+            }
+        }
+
+        for (int64_t k = m - 1; k >= 0; k--)
+        {
+            double value = solution[pivot_rows_[k]];
+            for (int64_t l = lower_starts_[k]; l < lower_starts_[k + 1]; l++)
+            {
+                value -= lower_values_[l] * solution[lower_rows_[l]];
+            }
+            solution[pivot_rows_[k]] = value;
+        }
+        finish_solve(rhs);
+    }
+
+    void BasisFactor::load_column(const int64_t variable, Vector<double>& column) const
+    {
+        DCHECK_EQ(column.dimension, num_rows_);
+        DCHECK_EQ(column.non_zero_count, 0);
+        if (variable < matrix_.num_cols)
+        {
+            for (int64_t k = matrix_.column_starts[variable]; k < matrix_.column_starts[variable + 1]; k++)
+            {
+                if (matrix_.values[k] != 0.0)
+                {
+                    column.dense_values[matrix_.row_indices[k]] = matrix_.values[k];
+                    column.non_zero_indices[column.non_zero_count++] = matrix_.row_indices[k];
+                }
+            }
+        }
+        else
+        {
+            const int64_t row = variable - matrix_.num_cols;
+            column.dense_values[row] = -1.0;
+            column.non_zero_indices[column.non_zero_count++] = row;
+        }
+    }
+}
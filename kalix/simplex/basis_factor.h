@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_BASIS_FACTOR_H_
+#define KALIX_SIMPLEX_BASIS_FACTOR_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "kalix/base/vector.h"
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::simplex
+{
+    /// @brief Options of @ref BasisFactor.
+    struct BasisFactorOptions
+    {
+        /// @brief A pivot must be at least this fraction of the largest entry in its column.
+        double pivot_threshold = 0.1;
+
+        /// @brief Pivots and eta pivots of smaller magnitude make the basis singular.
+        double singular_tolerance = 1e-11;
+
+        /// @brief Computed entries of smaller magnitude are dropped from the factors.
+        double drop_tolerance = 1e-14;
+
+        /// @brief Number of columns the Markowitz search examines before settling for the best pivot.
+        int max_search_columns = 4;
+
+        /// @brief Basis updates after which @ref BasisFactor::needs_refactorization returns true.
+        int64_t max_updates = 100;
+    };
+
+    /// @brief Sparse LU factorization of a simplex basis with product-form updates.
+    ///
+    /// The variables are the columns of the constraint matrix followed by one slack per row, whose
+    /// column is @c -e_i, so that a slack equals the activity of its row. The basis matrix @c B
+    /// consists of the columns of the variables in @c basic_index, in that order; its columns are
+    /// called basis positions.
+    ///
+    /// @ref factorize first peels off column and row singletons, which is all there is for a
+    /// triangular basis such as a slack or crash basis and costs no fill. The remaining nucleus is
+    /// eliminated with Markowitz pivoting under a threshold condition. A basis change is applied as
+    /// an eta matrix, so @c B is only refactorized every @ref BasisFactorOptions::max_updates
+    /// changes.
+    class BasisFactor
+    {
+    public:
+        /// @brief Creates the factorization for bases of @p matrix. The matrix must outlive it.
+        explicit BasisFactor(const lp::CscMatrix& matrix, const BasisFactorOptions& options = {});
+
+        /// @brief Factorizes the basis and discards all updates.
+        ///
+        /// @param basic_index The basic variable of every basis position, one per row.
+        /// @return An error if the basis is singular.
+        absl::Status factorize(std::span<const int64_t> basic_index);
+
+        /// @brief Loads a lower triangular basis without searching for pivots, e.g. the basis of
+        /// @ref crash_basis. Discards all updates.
+        ///
+        /// Position @c p is eliminated in step @c p and pivots on row @c pivot_rows[p], so that the
+        /// factorization consists of the multipliers of every column and costs one pass over the
+        /// non-zeros of the basis.
+        ///
+        /// @param basic_index The basic variable of every basis position, one per row.
+        /// @param pivot_rows The pivot row of every basis position, a permutation of the rows.
+        /// @return An error if a column has an entry in the pivot row of an earlier position, or if
+        /// a pivot is too small.
+        absl::Status factorize_triangular(std::span<const int64_t> basic_index, std::span<const int64_t> pivot_rows);
+
+        /// @brief Replaces the variable at basis position @p position.
+        ///
+        /// @param column The entering column after @ref ftran, indexed by basis position.
+        /// @param position The basis position of the leaving variable.
+        /// @return An error if the new basis is singular, in which case nothing is changed.
+        absl::Status update(const Vector<double>& column, int64_t position);
+
+        /// @brief Solves @c B*x = rhs in place. @p rhs is indexed by row, the result by basis
+        /// position. The result is stored densely and its indices are rebuilt.
+        void ftran(Vector<double>& rhs) const;
+
+        /// @brief Solves @c B^T*y = rhs in place. @p rhs is indexed by basis position, the result
+        /// by row. The result is stored densely and its indices are rebuilt.
+        void btran(Vector<double>& rhs) const;
+
+        /// @brief Stores the column of @p variable in @p column, which must have dimension
+        /// @c num_rows and be cleared.
+        void load_column(int64_t variable, Vector<double>& column) const;
+
+        /// @brief Returns the number of basis updates since the last factorization.
+        [[nodiscard]] int64_t num_updates() const
+        {
+            return static_cast<int64_t>(etas_.size());
+        }
+
+        /// @brief Returns whether enough updates accumulated for a refactorization to pay off.
+        [[nodiscard]] bool needs_refactorization() const
+        {
+            return num_updates() >= options_.max_updates;
+        }
+
+        /// @brief Returns the number of non-zeros of @c L and @c U, including the diagonal.
+        [[nodiscard]] int64_t factor_non_zeros() const
+        {
+            return static_cast<int64_t>(lower_rows_.size() + upper_positions_.size()) + num_rows_;
+        }
+
+    private:
+        /// @brief A product-form update: the inverse of the identity with column @ref position
+        /// replaced by the entering column.
+        struct Eta
+        {
+            int64_t position = 0;
+            double pivot = 0.0;
+            int64_t begin = 0;
+            int64_t end = 0;
+        };
+
+        void reset();
+
+        const lp::CscMatrix& matrix_;
+        BasisFactorOptions options_;
+        int64_t num_rows_ = 0;
+
+        // Pivot k eliminates row pivot_rows_[k] with basis position pivot_positions_[k].
+        std::vector<int64_t> pivot_rows_;
+        std::vector<int64_t> pivot_positions_;
+        std::vector<double> pivots_;
+
+        // Column k of L: the multipliers of the rows eliminated by pivot k.
+        std::vector<int64_t> lower_starts_;
+        std::vector<int64_t> lower_rows_;
+        std::vector<double> lower_values_;
+
+        // Row k of U without the diagonal: entries of later pivot positions.
+        std::vector<int64_t> upper_starts_;
+        std::vector<int64_t> upper_positions_;
+        std::vector<double> upper_values_;
+
+        std::vector<Eta> etas_;
+        std::vector<int64_t> eta_positions_;
+        std::vector<double> eta_values_;
+    };
+}
+
+#endif // KALIX_SIMPLEX_BASIS_FACTOR_H_
@@ -0,0 +1,363 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/basis_factor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        using DenseMatrix = std::vector<std::vector<double>>;
+
+        lp::CscMatrix random_matrix(std::mt19937& rng, const int64_t num_rows, const int64_t num_cols,
+                                    const double density)
+        {
+            std::uniform_real_distribution<double> value(-2.0, 2.0);
+            std::bernoulli_distribution keep(density);
+            lp::CscMatrix matrix;
+            matrix.num_rows = num_rows;
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                std::vector<int64_t> indices;
+                std::vector<double> values;
+                for (int64_t i = 0; i < num_rows; i++)
+                {
+                    if (keep(rng))
+                    {
+                        indices.push_back(i);
+                        values.push_back(value(rng));
+                    }
+                }
+                matrix.append_column(indices, values);
+            }
+            return matrix;
+        }
+
+        /// The basis matrix as dense rows.
+        DenseMatrix dense_basis(const lp::CscMatrix& matrix, const std::vector<int64_t>& basic_index)
+        {
+            const int64_t m = matrix.num_rows;
+            DenseMatrix basis(m, std::vector<double>(m, 0.0));
+            for (int64_t p = 0; p < m; p++)
+            {
+                const int64_t variable = basic_index[p];
+                if (variable < matrix.num_cols)
+                {
+                    for (int64_t k = matrix.column_starts[variable]; k < matrix.column_starts[variable + 1]; k++)
+                    {
+                        basis[matrix.row_indices[k]][p] += matrix.values[k];
+                    }
+                }
+                else
+                {
+                    basis[variable - matrix.num_cols][p] = -1.0;
+                }
+            }
+            return basis;
+        }
+
+        /// Whether Gaussian elimination with partial pivoting finds no pivot below @p tolerance.
+        bool is_well_conditioned(DenseMatrix matrix, const double tolerance)
+        {
+            const auto m = static_cast<int64_t>(matrix.size());
+            for (int64_t k = 0; k < m; k++)
+            {
+                int64_t pivot = k;
+                for (int64_t i = k + 1; i < m; i++)
+                {
+                    if (std::abs(matrix[i][k]) > std::abs(matrix[pivot][k]))
+                    {
+                        pivot = i;
+                    }
+                }
+                if (std::abs(matrix[pivot][k]) < tolerance)
+                {
+                    return false;
+                }
+                std::swap(matrix[k], matrix[pivot]);
+                for (int64_t i = k + 1; i < m; i++)
+                {
+                    const double factor = matrix[i][k] / matrix[k][k];
+                    for (int64_t j = k; j < m; j++)
+                    {
+                        matrix[i][j] -= factor * matrix[k][j];
+                    }
+                }
+            }
+            return true;
+        }
+
+        Vector<double> random_vector(std::mt19937& rng, const int64_t dimension)
+        {
+            std::uniform_real_distribution<double> value(-1.0, 1.0);
+            Vector<double> vector;
+            vector.setup(dimension);
+            for (int64_t i = 0; i < dimension; i++)
+            {
+                vector.dense_values[i] = value(rng);
+                vector.non_zero_indices[i] = i;
+            }
+            vector.non_zero_count = dimension;
+            return vector;
+        }
+
+        void expect_ftran(const BasisFactor& factor, const DenseMatrix& basis, std::mt19937& rng)
+        {
+            const auto m = static_cast<int64_t>(basis.size());
+            const Vector<double> rhs = random_vector(rng, m);
+            Vector<double> solution = rhs;
+            factor.ftran(solution);
+            for (int64_t i = 0; i < m; i++)
+            {
+                double product = 0.0;
+                for (int64_t p = 0; p < m; p++)
+                {
+                    product += basis[i][p] * solution.dense_values[p];
+                }
+                EXPECT_NEAR(product, rhs.dense_values[i], 1e-9);
+            }
+        }
+
+        void expect_btran(const BasisFactor& factor, const DenseMatrix& basis, std::mt19937& rng)
+        {
+            const auto m = static_cast<int64_t>(basis.size());
+            const Vector<double> rhs = random_vector(rng, m);
+            Vector<double> solution = rhs;
+            factor.btran(solution);
+            for (int64_t p = 0; p < m; p++)
+            {
+                double product = 0.0;
+                for (int64_t i = 0; i < m; i++)
+                {
+                    product += basis[i][p] * solution.dense_values[i];
+                }
+                EXPECT_NEAR(product, rhs.dense_values[p], 1e-9);
+            }
+        }
+    }
+
+    TEST(BasisFactorTest, SolvesWithSlackBasis)
+    {
+        std::mt19937 rng(1);
+        const lp::CscMatrix matrix = random_matrix(rng, 5, 3, 0.5);
+        const std::vector<int64_t> basic_index = {5, 3, 7, 4, 6};
+        BasisFactor factor(matrix);
+        ASSERT_TRUE(factor.factorize(basic_index).ok());
+        EXPECT_EQ(factor.factor_non_zeros(), 5);
+
+        Vector<double> rhs;
+        rhs.setup(5);
+        rhs.dense_values = {1.0, 2.0, 0.0, 4.0, 5.0};
+        factor.ftran(rhs);
+        EXPECT_EQ(rhs.dense_values, (std::vector<double>{0.0, -1.0, -5.0, -2.0, -4.0}));
+        EXPECT_EQ(rhs.non_zero_count, 4);
+        factor.btran(rhs);
+        EXPECT_EQ(rhs.dense_values, (std::vector<double>{1.0, 2.0, 0.0, 4.0, 5.0}));
+    }
+
+    TEST(BasisFactorTest, SolvesAcrossReshapes)
+    {
+        // Solves swap the packed scratch array into the dense array, so both must keep the size
+        // of the current dimension.
+        std::mt19937 rng(3);
+        const lp::CscMatrix large_matrix = random_matrix(rng, 1000, 1, 0.0);
+        const lp::CscMatrix small_matrix = random_matrix(rng, 100, 1, 0.0);
+        std::vector<int64_t> large_basis(1000);
+        std::vector<int64_t> small_basis(100);
+        std::iota(large_basis.begin(), large_basis.end(), 1);
+        std::iota(small_basis.begin(), small_basis.end(), 1);
+        BasisFactor large_factor(large_matrix);
+        BasisFactor small_factor(small_matrix);
+        ASSERT_TRUE(large_factor.factorize(large_basis).ok());
+        ASSERT_TRUE(small_factor.factorize(small_basis).ok());
+
+        Vector<double> rhs = random_vector(rng, 1000);
+        large_factor.ftran(rhs);
+        rhs.reshape(100);
+        rhs.dense_values[7] = 2.0;
+        rhs.non_zero_indices[0] = 7;
+        rhs.non_zero_count = 1;
+        small_factor.ftran(rhs);
+        EXPECT_EQ(rhs.dense_values.size(), 100u);
+        EXPECT_EQ(rhs.non_zero_count, 1);
+        EXPECT_DOUBLE_EQ(rhs.dense_values[7], -2.0);
+
+        rhs.reshape(1000);
+        Vector<double> fresh;
+        fresh.setup(1000);
+        EXPECT_EQ(rhs, fresh);
+        for (int64_t i = 0; i < 1000; i++)
+        {
+            ASSERT_DOUBLE_EQ(rhs.dense_values[i], 0.0);
+        }
+    }
+
+    TEST(BasisFactorTest, SolvesRandomBases)
+    {
+        std::mt19937 rng(2);
+        int factorized = 0;
+        for (int trial = 0; trial < 100; trial++)
+        {
+            const int64_t m = std::uniform_int_distribution<int64_t>(1, 40)(rng);
+            const int64_t n = 2 * m;
+            const lp::CscMatrix matrix = random_matrix(rng, m, n, 0.3);
+            std::vector<int64_t> variables(n + m);
+            std::iota(variables.begin(), variables.end(), 0);
+            std::ranges::shuffle(variables, rng);
+            const std::vector<int64_t> basic_index(variables.begin(), variables.begin() + m);
+
+            const DenseMatrix basis = dense_basis(matrix, basic_index);
+            BasisFactor factor(matrix);
+            if (!factor.factorize(basic_index).ok())
+            {
+                EXPECT_FALSE(is_well_conditioned(basis, 1e-6));
+                continue;
+            }
+            factorized++;
+            expect_ftran(factor, basis, rng);
+            expect_btran(factor, basis, rng);
+        }
+        EXPECT_GT(factorized, 30);
+    }
+
+    TEST(BasisFactorTest, UpdatesMatchNewBasis)
+    {
+        std::mt19937 rng(3);
+        constexpr int64_t m = 30;
+        const lp::CscMatrix matrix = random_matrix(rng, m, 60, 0.2);
+        std::vector<int64_t> basic_index(m);
+        std::iota(basic_index.begin(), basic_index.end(), 60);
+        BasisFactor factor(matrix);
+        ASSERT_TRUE(factor.factorize(basic_index).ok());
+
+        Vector<double> column;
+        column.setup(m);
+        int updates = 0;
+        for (int64_t variable = 0; variable < 60 && updates < 20; variable++)
+        {
+            column.clear();
+            factor.load_column(variable, column);
+            factor.ftran(column);
+            // Replace the position with the largest entry that still holds a slack.
+            int64_t position = -1;
+            for (int64_t p = 0; p < m; p++)
+            {
+                if (basic_index[p] >= 60 &&
+                    (position == -1 || std::abs(column.dense_values[p]) > std::abs(column.dense_values[position])))
+                {
+                    position = p;
+                }
+            }
+            if (position == -1 || std::abs(column.dense_values[position]) < 0.1)
+            {
+                continue;
+            }
+            ASSERT_TRUE(factor.update(column, position).ok());
+            basic_index[position] = variable;
+            updates++;
+        }
+        EXPECT_EQ(factor.num_updates(), updates);
+        EXPECT_GT(updates, 10);
+
+        const DenseMatrix basis = dense_basis(matrix, basic_index);
+        expect_ftran(factor, basis, rng);
+        expect_btran(factor, basis, rng);
+        ASSERT_TRUE(factor.factorize(basic_index).ok());
+        EXPECT_EQ(factor.num_updates(), 0);
+        expect_ftran(factor, basis, rng);
+    }
+
+    TEST(BasisFactorTest, DetectsSingularBasis)
+    {
+        lp::CscMatrix matrix;
+        matrix.num_rows = 2;
+        matrix.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{1.0, 2.0});
+        matrix.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{2.0, 4.0});
+        matrix.append_column(std::vector<int64_t>{}, std::vector<double>{});
+        BasisFactor factor(matrix);
+        EXPECT_FALSE(factor.factorize(std::vector<int64_t>{0, 1}).ok());
+        EXPECT_FALSE(factor.factorize(std::vector<int64_t>{2, 3}).ok());
+        EXPECT_FALSE(factor.factorize(std::vector<int64_t>{3, 3}).ok());
+
+        ASSERT_TRUE(factor.factorize(std::vector<int64_t>{0, 3}).ok());
+        // Column 1 is parallel to column 0, so it cannot replace the slack.
+        Vector<double> column;
+        column.setup(2);
+        factor.load_column(1, column);
+        factor.ftran(column);
+        EXPECT_FALSE(factor.update(column, 1).ok());
+        EXPECT_EQ(factor.num_updates(), 0);
+        EXPECT_TRUE(factor.update(column, 0).ok());
+    }
+
+    TEST(BasisFactorTest, LoadsStructuralAndSlackColumns)
+    {
+        lp::CscMatrix matrix;
+        matrix.num_rows = 3;
+        matrix.append_column(std::vector<int64_t>{2, 0}, std::vector<double>{5.0, 3.0});
+        BasisFactor factor(matrix);
+        Vector<double> column;
+        column.setup(3);
+        factor.load_column(0, column);
+        EXPECT_EQ(column.non_zero_count, 2);
+        EXPECT_EQ(column.dense_values, (std::vector<double>{3.0, 0.0, 5.0}));
+        column.clear();
+        factor.load_column(2, column);
+        EXPECT_EQ(column.non_zero_count, 1);
+        EXPECT_EQ(column.dense_values, (std::vector<double>{0.0, -1.0, 0.0}));
+    }
+
+    TEST(BasisFactorTest, LoadsTriangularBasis)
+    {
+        // Position p pivots on row 3 - p: column 1 also has entries in rows 1 and 0, which are pivoted
+        // later, and the slack of row 0 comes last.
+        lp::CscMatrix matrix;
+        matrix.num_rows = 4;
+        matrix.append_column(std::vector<int64_t>{3, 1}, std::vector<double>{2.0, 1.0});
+        matrix.append_column(std::vector<int64_t>{2, 1, 0}, std::vector<double>{-4.0, 3.0, 1.0});
+        matrix.append_column(std::vector<int64_t>{1}, std::vector<double>{0.5});
+        const std::vector<int64_t> basic_index = {0, 1, 2, 3};
+        const std::vector<int64_t> pivot_rows = {3, 2, 1, 0};
+        BasisFactor factor(matrix);
+        ASSERT_TRUE(factor.factorize_triangular(basic_index, pivot_rows).ok());
+        EXPECT_EQ(factor.factor_non_zeros(), 7);
+
+        std::mt19937 rng(6);
+        const DenseMatrix basis = dense_basis(matrix, basic_index);
+        expect_ftran(factor, basis, rng);
+        expect_btran(factor, basis, rng);
+
+        // Column 0 has an entry in row 1, which is pivoted before it.
+        EXPECT_FALSE(
+            factor.factorize_triangular(std::vector<int64_t>{2, 0, 1, 3}, std::vector<int64_t>{1, 3, 2, 0}).ok());
+        EXPECT_FALSE(factor.factorize_triangular(basic_index, std::vector<int64_t>{3, 2, 2, 0}).ok());
+        EXPECT_FALSE(factor.factorize_triangular(std::vector<int64_t>{0, 1, 5, 3}, pivot_rows).ok());
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/bound_flipping_ratio.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "kalix/base/compensated_double.h"
+
+namespace kalix::simplex
+{
+    BoundFlippingRatioTestStatus BoundFlippingRatioTest::select(const double initial_slope,
+                                                                const std::span<const double> bound_range)
+    {
+        DCHECK_GE(initial_slope, 0.0);
+
+        entering_index_ = -1;
+        entering_alpha_ = 0.0;
+        step_ = 0.0;
+        flipped_count_ = 0;
+        group_count_ = 0;
+
+        int64_t* indices = candidate_indices_.data();
+        double* alphas = candidate_alphas_.data();
+        double* duals = candidate_duals_.data();
+        const auto candidate_count = static_cast<int64_t>(candidate_indices_.size());
+        const double tolerance = options_.dual_feasibility_tolerance;
+
+        CompensatedDouble slope(initial_slope);
+        int64_t group_begin = 0;
+        while (group_begin < candidate_count)
+        {
+            group_count_++;
+
+            // Pass 1: relaxed (Harris) bound on the step over all remaining breakpoints.
+            double harris_bound = std::numeric_limits<double>::infinity();
+            for (int64_t i = group_begin; i < candidate_count; i++)
+            {
+                harris_bound = std::min(harris_bound, (duals[i] + tolerance) / alphas[i]);
+            }
+
+            // Pass 2: move every breakpoint within the bound to the front and sum its slope change.
+            int64_t group_end = group_begin;
+            CompensatedDouble slope_change(0.0);
+            bool has_unbounded_range = false;
+            for (int64_t i = group_begin; i < candidate_count; i++)
+            {
+                if (duals[i] > harris_bound * alphas[i])
+                {
+                    continue;
+                }
+
+                std::swap(indices[i], indices[group_end]);
+                std::swap(alphas[i], alphas[group_end]);
+                std::swap(duals[i], duals[group_end]);
+
+                const double range = bound_range[indices[group_end]];
+                if (KALIX_UNLIKELY(std::isinf(range)))
+                {
+                    has_unbounded_range = true;
+                }
+                else
+                {
+                    slope_change += alphas[group_end] * range;
+                }
+                group_end++;
+            }
+
+            if (has_unbounded_range || static_cast<double>(slope - slope_change) <= 0.0)
+            {
+                // The slope turns non-positive inside this group: pick the most stable pivot.
+                int64_t best = group_begin;
+                for (int64_t i = group_begin + 1; i < group_end; i++)
+                {
+                    if (alphas[i] > alphas[best])
+                    {
+                        best = i;
+                    }
+                }
+
+                entering_index_ = indices[best];
+                entering_alpha_ = alphas[best];
+                step_ = std::max(0.0, duals[best] / alphas[best]);
+                remaining_slope_ = static_cast<double>(slope);
+                flipped_count_ = group_begin;
+                return BoundFlippingRatioTestStatus::kEntering;
+            }
+
+            slope -= slope_change;
+            group_begin = group_end;
+        }
+
+        remaining_slope_ = static_cast<double>(slope);
+        flipped_count_ = candidate_count;
+        return BoundFlippingRatioTestStatus::kDualUnbounded;
+    }
+}
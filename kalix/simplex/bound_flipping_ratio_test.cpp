@@ -0,0 +1,208 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "kalix/base/sparse_vector_sum.h"
+#include "kalix/base/vector.h"
+#include "kalix/simplex/bound_flipping_ratio.h"
+
+namespace
+{
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+}
+
+class BoundFlippingRatioTestTest : public ::testing::Test
+{
+protected:
+    static constexpr int64_t kColumns = 6;
+
+    kalix::Vector<double> row;
+    std::vector<double> reduced_costs;
+    std::vector<int8_t> nonbasic_move;
+    std::vector<double> bound_range;
+
+    void SetUp() override
+    {
+        row.setup(kColumns);
+        reduced_costs.assign(kColumns, 0.0);
+        nonbasic_move.assign(kColumns, 1);
+        bound_range.assign(kColumns, kInf);
+    }
+
+    void set_entry(const int64_t column, const double alpha, const double reduced_cost, const double range)
+    {
+        row.dense_values[column] = alpha;
+        row.non_zero_indices[row.non_zero_count++] = column;
+        reduced_costs[column] = reduced_cost;
+        bound_range[column] = range;
+    }
+};
+
+TEST_F(BoundFlippingRatioTestTest, StandardRatioTestWithoutBoxedColumns)
+{
+    // Ratios 2.0, 1.0 and 3.0, no column can flip.
+    set_entry(0, 1.0, 2.0, kInf);
+    set_entry(1, 2.0, 2.0, kInf);
+    set_entry(2, 1.0, 3.0, kInf);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    const auto status = bfrt.run(row, 1.0, 10.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(status, kalix::simplex::BoundFlippingRatioTestStatus::kEntering);
+    EXPECT_EQ(bfrt.entering_index(), 1);
+    EXPECT_DOUBLE_EQ(bfrt.step(), 1.0);
+    EXPECT_TRUE(bfrt.flipped_indices().empty());
+}
+
+TEST_F(BoundFlippingRatioTestTest, PassesBoxedBreakpointsWhileSlopeIsPositive)
+{
+    // Slope 10: passing column 1 costs 2 * 1 = 2, passing column 0 costs 1 * 3 = 3.
+    // Column 2 stops the ray because its range is unbounded.
+    set_entry(0, 1.0, 2.0, 3.0);
+    set_entry(1, 2.0, 2.0, 1.0);
+    set_entry(2, 1.0, 3.0, kInf);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    const auto status = bfrt.run(row, 1.0, 10.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(status, kalix::simplex::BoundFlippingRatioTestStatus::kEntering);
+    EXPECT_EQ(bfrt.entering_index(), 2);
+    EXPECT_DOUBLE_EQ(bfrt.step(), 3.0);
+    EXPECT_DOUBLE_EQ(bfrt.remaining_slope(), 5.0);
+
+    std::vector<int64_t> flipped(bfrt.flipped_indices().begin(), bfrt.flipped_indices().end());
+    std::ranges::sort(flipped);
+    EXPECT_EQ(flipped, (std::vector<int64_t>{0, 1}));
+    EXPECT_EQ(bfrt.group_count(), 3);
+}
+
+TEST_F(BoundFlippingRatioTestTest, StopsWhenSlopeTurnsNonPositive)
+{
+    // Passing column 1 would consume 2 * 6 = 12 > 10 units of slope.
+    set_entry(1, 2.0, 2.0, 6.0);
+    set_entry(2, 1.0, 3.0, kInf);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    bfrt.run(row, 1.0, 10.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(bfrt.entering_index(), 1);
+    EXPECT_TRUE(bfrt.flipped_indices().empty());
+}
+
+TEST_F(BoundFlippingRatioTestTest, RespectsNonbasicMoveAndDirection)
+{
+    // Column 0 sits at its upper bound, so it is eligible for negative oriented alphas only.
+    set_entry(0, -1.0, -1.0, kInf);
+    set_entry(1, -1.0, 5.0, kInf);
+    nonbasic_move[0] = -1;
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    bfrt.run(row, 1.0, 1.0, reduced_costs, nonbasic_move, bound_range);
+    EXPECT_EQ(bfrt.entering_index(), 0);
+    EXPECT_DOUBLE_EQ(bfrt.step(), 1.0);
+
+    // With the opposite direction only column 1 at its lower bound is eligible.
+    bfrt.run(row, -1.0, 1.0, reduced_costs, nonbasic_move, bound_range);
+    EXPECT_EQ(bfrt.entering_index(), 1);
+    EXPECT_DOUBLE_EQ(bfrt.step(), 5.0);
+}
+
+TEST_F(BoundFlippingRatioTestTest, SkipsFixedAndTinyEntries)
+{
+    set_entry(0, 1.0, 0.0, 0.0);
+    nonbasic_move[0] = 0;
+    set_entry(1, 1e-12, 0.0, kInf);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    const auto status = bfrt.run(row, 1.0, 1.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(status, kalix::simplex::BoundFlippingRatioTestStatus::kDualUnbounded);
+    EXPECT_EQ(bfrt.entering_index(), -1);
+}
+
+TEST_F(BoundFlippingRatioTestTest, ReportsDualUnboundedWhenAllBreakpointsFlip)
+{
+    set_entry(0, 1.0, 1.0, 1.0);
+    set_entry(1, 1.0, 2.0, 1.0);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    const auto status = bfrt.run(row, 1.0, 10.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(status, kalix::simplex::BoundFlippingRatioTestStatus::kDualUnbounded);
+    EXPECT_EQ(bfrt.flipped_indices().size(), 2u);
+    EXPECT_DOUBLE_EQ(bfrt.remaining_slope(), 8.0);
+}
+
+TEST_F(BoundFlippingRatioTestTest, HarrisGroupPrefersLargestPivot)
+{
+    // Both ratios lie within the dual feasibility tolerance of each other.
+    set_entry(0, 0.01, 0.01 * 1.0, kInf);
+    set_entry(1, 5.0, 5.0 * (1.0 + 1e-9), kInf);
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    bfrt.run(row, 1.0, 1.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(bfrt.entering_index(), 1);
+    EXPECT_DOUBLE_EQ(bfrt.entering_alpha(), 5.0);
+}
+
+TEST_F(BoundFlippingRatioTestTest, ManySmallSlopeChangesAreAccumulated)
+{
+    // Many small slope changes that together nearly cancel the initial slope.
+    constexpr int64_t kCount = 1000;
+    kalix::Vector<double> long_row;
+    long_row.setup(kCount);
+    std::vector<double> costs(kCount);
+    std::vector<int8_t> moves(kCount, 1);
+    std::vector<double> ranges(kCount, 1e-3);
+    for (int64_t j = 0; j < kCount; j++)
+    {
+        long_row.dense_values[j] = 1.0;
+        long_row.non_zero_indices[long_row.non_zero_count++] = j;
+        costs[j] = static_cast<double>(j);
+    }
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    bfrt.run(long_row, 1.0, 0.5 + 1e-12, costs, moves, ranges);
+
+    // 500 breakpoints consume exactly 0.5; the next one must enter.
+    EXPECT_EQ(bfrt.entering_index(), 500);
+    EXPECT_EQ(bfrt.flipped_indices().size(), 500u);
+}
+
+TEST_F(BoundFlippingRatioTestTest, AcceptsSparseVectorSumPivotRow)
+{
+    kalix::SparseVectorSum sum(kColumns);
+    sum.add(3, 4.0);
+    sum.add(4, 1.0);
+    reduced_costs[3] = 4.0;
+    reduced_costs[4] = 2.0;
+
+    kalix::simplex::BoundFlippingRatioTest bfrt;
+    bfrt.run(sum, 1.0, 1.0, reduced_costs, nonbasic_move, bound_range);
+
+    EXPECT_EQ(bfrt.entering_index(), 3);
+    EXPECT_DOUBLE_EQ(bfrt.step(), 1.0);
+}
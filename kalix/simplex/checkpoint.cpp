@@ -0,0 +1,362 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/checkpoint.h"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "kalix/io/section_file.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        constexpr io::SectionFileMagic kMagic = {'K', 'A', 'L', 'I', 'X', 'C', 'K', 'P'};
+
+        enum SectionId : uint32_t
+        {
+            kMetadata = 1,
+            kVariableStatus = 2,
+            kBasicIndex = 3,
+            kEdgeWeights = 4,
+            kPrimalValues = 5,
+            kPrimalIndices = 6,
+            kDualValues = 7,
+            kDualIndices = 8,
+        };
+
+        struct Metadata
+        {
+            int64_t num_rows;
+            int64_t num_variables;
+            int64_t iteration_count;
+            int64_t primal_non_zero_count;
+            int64_t dual_non_zero_count;
+            int8_t phase;
+            uint8_t has_basis;
+            uint8_t factor_ready;
+            uint8_t edge_weights_ready;
+            uint32_t reserved;
+        };
+
+        /// @brief Spans over the arrays of one state, in the layout they are written.
+        struct StateImage
+        {
+            Metadata metadata;
+            std::span<const VariableStatus> variable_status;
+            std::span<const int64_t> basic_index;
+            std::span<const double> edge_weights;
+            std::span<const double> primal_values;
+            std::span<const int64_t> primal_indices;
+            std::span<const double> dual_values;
+            std::span<const int64_t> dual_indices;
+        };
+
+        Metadata metadata_of(const SolverState& state)
+        {
+            return {
+                .num_rows = state.num_rows,
+                .num_variables = state.num_variables,
+                .iteration_count = state.iteration_count,
+                .primal_non_zero_count = state.primal_values.non_zero_count,
+                .dual_non_zero_count = state.dual_values.non_zero_count,
+                .phase = static_cast<int8_t>(state.phase),
+                .has_basis = state.has_basis,
+                .factor_ready = state.factor_ready,
+                .edge_weights_ready = state.edge_weights_ready,
+                .reserved = 0,
+            };
+        }
+
+        /// @brief Returns the dense values of @p vector. Vectors that were never set up are empty.
+        std::span<const double> values_of(const Vector<double>& vector)
+        {
+            return {vector.dense_values.data(), static_cast<size_t>(vector.dimension)};
+        }
+
+        /// @brief Returns the index list of @p vector, which is empty if the vector is in dense mode.
+        std::span<const int64_t> indices_of(const Vector<double>& vector)
+        {
+            if (vector.non_zero_count <= 0)
+            {
+                return {};
+            }
+            return {vector.non_zero_indices.data(), static_cast<size_t>(vector.non_zero_count)};
+        }
+
+        StateImage image_of(const SolverState& state)
+        {
+            return {
+                .metadata = metadata_of(state),
+                .variable_status = state.variable_status,
+                .basic_index = state.basic_index,
+                .edge_weights = state.edge_weights,
+                .primal_values = values_of(state.primal_values),
+                .primal_indices = indices_of(state.primal_values),
+                .dual_values = values_of(state.dual_values),
+                .dual_indices = indices_of(state.dual_values),
+            };
+        }
+
+        absl::Status write_image(const StateImage& image, const std::string& path, const CheckpointOptions& options)
+        {
+            io::SectionFileWriter writer(kMagic, kCheckpointVersion);
+            writer.add_array(kMetadata, std::span<const Metadata>(&image.metadata, 1));
+            writer.add_array(kVariableStatus, image.variable_status);
+            writer.add_array(kBasicIndex, image.basic_index);
+            writer.add_array(kEdgeWeights, image.edge_weights);
+            writer.add_array(kPrimalValues, image.primal_values);
+            writer.add_array(kPrimalIndices, image.primal_indices);
+            writer.add_array(kDualValues, image.dual_values);
+            writer.add_array(kDualIndices, image.dual_indices);
+            return writer.write(path, options.checksum);
+        }
+
+        /// @brief Restores a vector from its dense values and, unless it was in dense mode, its index list.
+        bool restore_vector(const io::SectionFile& file, const uint32_t values_id, const uint32_t indices_id,
+                            const int64_t dimension, const int64_t non_zero_count, Vector<double>& vector)
+        {
+            if (non_zero_count > dimension)
+            {
+                return false;
+            }
+            const auto values = file.array<double>(values_id, dimension);
+            const auto indices = file.array<int64_t>(indices_id, std::max<int64_t>(non_zero_count, 0));
+            if (!values || !indices)
+            {
+                return false;
+            }
+
+            vector.setup(dimension);
+            std::ranges::copy(*values, vector.dense_values.begin());
+            for (const int64_t index : *indices)
+            {
+                if (index < 0 || index >= dimension)
+                {
+                    return false;
+                }
+            }
+            std::ranges::copy(*indices, vector.non_zero_indices.begin());
+            vector.non_zero_count = non_zero_count;
+            return true;
+        }
+
+        bool is_consistent_basis(const SolverState& state)
+        {
+            std::vector<char> seen(state.num_variables, 0);
+            for (const int64_t variable : state.basic_index)
+            {
+                if (variable < 0 || variable >= state.num_variables || seen[variable] ||
+                    state.variable_status[variable] != VariableStatus::kBasic)
+                {
+                    return false;
+                }
+                seen[variable] = 1;
+            }
+            int64_t basic_count = 0;
+            for (const VariableStatus status : state.variable_status)
+            {
+                basic_count += status == VariableStatus::kBasic;
+            }
+            return basic_count == state.num_rows;
+        }
+    }
+
+    absl::Status write_checkpoint(const SolverState& state, const std::string& path, const CheckpointOptions& options)
+    {
+        return write_image(image_of(state), path, options);
+    }
+
+    absl::StatusOr<SolverState> read_checkpoint(const std::string& path, const CheckpointOptions& options)
+    {
+        absl::StatusOr<io::SectionFile> file = io::SectionFile::open(path, kMagic, kCheckpointVersion, options.checksum);
+        if (!file.ok())
+        {
+            return file.status();
+        }
+
+        const auto corrupt = [&path](const std::string_view reason)
+        {
+            return absl::DataLossError(absl::StrCat("Checkpoint '", path, "' is corrupt: ", reason));
+        };
+
+        Metadata metadata;
+        if (!file->read_value(kMetadata, metadata) || metadata.num_rows < 0 || metadata.num_variables < 0 ||
+            metadata.phase < static_cast<int8_t>(SimplexPhase::kCrash) ||
+            metadata.phase > static_cast<int8_t>(SimplexPhase::kOptimal))
+        {
+            return corrupt("bad metadata");
+        }
+
+        const auto variable_status = file->array<VariableStatus>(kVariableStatus, metadata.num_variables);
+        const auto basic_index = file->array<int64_t>(kBasicIndex, metadata.num_rows);
+        const auto edge_weights = file->array<double>(kEdgeWeights, metadata.num_rows);
+        if (!variable_status || !basic_index || !edge_weights)
+        {
+            return corrupt("missing or mis-sized basis section");
+        }
+
+        SolverState state;
+        state.num_rows = metadata.num_rows;
+        state.num_variables = metadata.num_variables;
+        state.iteration_count = metadata.iteration_count;
+        state.phase = static_cast<SimplexPhase>(metadata.phase);
+        state.has_basis = metadata.has_basis != 0;
+        state.factor_ready = metadata.factor_ready != 0;
+        state.edge_weights_ready = metadata.edge_weights_ready != 0;
+        state.variable_status.assign(variable_status->begin(), variable_status->end());
+        state.basic_index.assign(basic_index->begin(), basic_index->end());
+        state.edge_weights.assign(edge_weights->begin(), edge_weights->end());
+
+        for (const VariableStatus status : state.variable_status)
+        {
+            if (status < VariableStatus::kBasic || status > VariableStatus::kFree)
+            {
+                return corrupt("bad variable status");
+            }
+        }
+        if (state.has_basis && !is_consistent_basis(state))
+        {
+            return corrupt("inconsistent basis");
+        }
+
+        if (!restore_vector(*file, kPrimalValues, kPrimalIndices, metadata.num_rows, metadata.primal_non_zero_count,
+                            state.primal_values) ||
+            !restore_vector(*file, kDualValues, kDualIndices, metadata.num_variables, metadata.dual_non_zero_count,
+                            state.dual_values))
+        {
+            return corrupt("bad vector section");
+        }
+        return state;
+    }
+
+    /// @brief An owned copy of a state, reused across submissions to avoid reallocations.
+    struct CheckpointWriter::Snapshot
+    {
+        Metadata metadata{};
+        std::vector<VariableStatus> variable_status;
+        std::vector<int64_t> basic_index;
+        std::vector<double> edge_weights;
+        std::vector<double> primal_values;
+        std::vector<int64_t> primal_indices;
+        std::vector<double> dual_values;
+        std::vector<int64_t> dual_indices;
+
+        void assign(const SolverState& state)
+        {
+            const StateImage image = image_of(state);
+            metadata = image.metadata;
+            variable_status.assign(image.variable_status.begin(), image.variable_status.end());
+            basic_index.assign(image.basic_index.begin(), image.basic_index.end());
+            edge_weights.assign(image.edge_weights.begin(), image.edge_weights.end());
+            primal_values.assign(image.primal_values.begin(), image.primal_values.end());
+            primal_indices.assign(image.primal_indices.begin(), image.primal_indices.end());
+            dual_values.assign(image.dual_values.begin(), image.dual_values.end());
+            dual_indices.assign(image.dual_indices.begin(), image.dual_indices.end());
+        }
+
+        [[nodiscard]] StateImage image() const
+        {
+            return {metadata, variable_status, basic_index, edge_weights,
+                    primal_values, primal_indices, dual_values, dual_indices};
+        }
+    };
+
+    CheckpointWriter::CheckpointWriter(std::string path, const CheckpointOptions& options)
+        : path_(std::move(path)),
+          options_(options),
+          pending_(std::make_unique<Snapshot>()),
+          writing_(std::make_unique<Snapshot>()),
+          thread_([this] { run(); })
+    {
+    }
+
+    CheckpointWriter::~CheckpointWriter()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    void CheckpointWriter::submit(const SolverState& state)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            pending_->assign(state);
+            has_pending_ = true;
+        }
+        wake_.notify_one();
+    }
+
+    void CheckpointWriter::flush()
+    {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return !has_pending_ && !busy_; });
+    }
+
+    absl::Status CheckpointWriter::status() const
+    {
+        std::lock_guard lock(mutex_);
+        return status_;
+    }
+
+    int64_t CheckpointWriter::written_count() const
+    {
+        std::lock_guard lock(mutex_);
+        return written_count_;
+    }
+
+    void CheckpointWriter::run()
+    {
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this] { return stop_ || has_pending_; });
+            if (!has_pending_)
+            {
+                break;
+            }
+
+            // Writing happens outside the lock, so the solver can stage the next state meanwhile.
+            std::swap(pending_, writing_);
+            has_pending_ = false;
+            busy_ = true;
+            lock.unlock();
+            absl::Status status = write_image(writing_->image(), path_, options_);
+            lock.lock();
+
+            if (status.ok())
+            {
+                written_count_++;
+            }
+            status_ = std::move(status);
+            busy_ = false;
+            idle_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_CHECKPOINT_H_
+#define KALIX_SIMPLEX_CHECKPOINT_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "kalix/simplex/solver_state.h"
+
+namespace kalix::simplex
+{
+    /// @brief Version of the checkpoint format written by @ref write_checkpoint.
+    inline constexpr uint32_t kCheckpointVersion = 1;
+
+    /// @brief Options for checkpoint files.
+    struct CheckpointOptions
+    {
+        /// @brief Whether to store section checksums when writing and verify them when reading.
+        bool checksum = true;
+    };
+
+    /// @brief Writes @p state to @p path.
+    ///
+    /// The checkpoint is a section file (see @ref io::SectionFileWriter) holding the basis, the
+    /// flags, the edge weights and the primal and dual vectors. The file is replaced atomically,
+    /// so an interrupted write leaves the previous checkpoint intact.
+    ///
+    /// @param state The state to save.
+    /// @param path The destination file.
+    /// @param options The checkpoint options.
+    /// @return An error status if the file cannot be written.
+    absl::Status write_checkpoint(const SolverState& state, const std::string& path,
+                                  const CheckpointOptions& options = {});
+
+    /// @brief Reads a checkpoint written by @ref write_checkpoint.
+    ///
+    /// Besides the file structure, the basis is checked for consistency: every row has a distinct
+    /// basic variable whose status is @ref VariableStatus::kBasic.
+    ///
+    /// @param path The checkpoint file.
+    /// @param options The checkpoint options.
+    /// @return The restored state, or an error status if the file is missing or corrupt.
+    absl::StatusOr<SolverState> read_checkpoint(const std::string& path, const CheckpointOptions& options = {});
+
+    /// @brief Writes checkpoints from a background thread.
+    ///
+    /// @ref submit only copies the state into a staging buffer and returns, so the solver does not
+    /// wait for the disk. If a new state is submitted while the previous one is still pending, the
+    /// older one is dropped: only the most recent checkpoint matters for a restart.
+    class CheckpointWriter
+    {
+    public:
+        /// @brief Starts the background thread.
+        /// @param path The checkpoint file, rewritten on every write.
+        /// @param options The checkpoint options.
+        explicit CheckpointWriter(std::string path, const CheckpointOptions& options = {});
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+        /// @brief Writes the pending checkpoint, if any, and stops the background thread.
+        ~CheckpointWriter();
+
+        /// @brief Schedules @p state to be written.
+        void submit(const SolverState& state);
+
+        /// @brief Blocks until every submitted state has been written or dropped.
+        void flush();
+
+        /// @brief Returns the status of the most recent write.
+        [[nodiscard]] absl::Status status() const;
+
+        /// @brief Returns the number of checkpoints written so far.
+        [[nodiscard]] int64_t written_count() const;
+
+    private:
+        struct Snapshot;
+
+        void run();
+
+        const std::string path_;
+        const CheckpointOptions options_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        std::unique_ptr<Snapshot> pending_;
+        std::unique_ptr<Snapshot> writing_;
+        bool has_pending_ = false;
+        bool busy_ = false;
+        bool stop_ = false;
+        absl::Status status_;
+        int64_t written_count_ = 0;
+
+        std::thread thread_;
+    };
+}
+
+#endif // KALIX_SIMPLEX_CHECKPOINT_H_
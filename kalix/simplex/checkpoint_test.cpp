@@ -0,0 +1,177 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/checkpoint.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        std::string temp_path(const std::string& name)
+        {
+            return ::testing::TempDir() + "/" + name;
+        }
+
+        // Two rows, four variables; variables 1 and 3 are basic.
+        SolverState make_state()
+        {
+            SolverState state;
+            state.setup(2, 4);
+            state.iteration_count = 17;
+            state.phase = SimplexPhase::kPhaseTwo;
+            state.has_basis = true;
+            state.factor_ready = true;
+            state.edge_weights_ready = true;
+            state.variable_status = {VariableStatus::kAtLower, VariableStatus::kBasic, VariableStatus::kAtUpper,
+                                     VariableStatus::kBasic};
+            state.basic_index = {3, 1};
+            state.edge_weights = {1.5, 2.5};
+
+            state.primal_values[1] = 4.0;
+            state.primal_values.non_zero_indices[0] = 1;
+            state.primal_values.non_zero_count = 1;
+
+            state.dual_values[0] = -1.0;
+            state.dual_values[2] = 3.0;
+            state.dual_values.non_zero_count = -1;
+            return state;
+        }
+
+        void expect_same_state(const SolverState& actual, const SolverState& expected)
+        {
+            EXPECT_EQ(actual.num_rows, expected.num_rows);
+            EXPECT_EQ(actual.num_variables, expected.num_variables);
+            EXPECT_EQ(actual.iteration_count, expected.iteration_count);
+            EXPECT_EQ(actual.phase, expected.phase);
+            EXPECT_EQ(actual.has_basis, expected.has_basis);
+            EXPECT_EQ(actual.factor_ready, expected.factor_ready);
+            EXPECT_EQ(actual.edge_weights_ready, expected.edge_weights_ready);
+            EXPECT_EQ(actual.variable_status, expected.variable_status);
+            EXPECT_EQ(actual.basic_index, expected.basic_index);
+            EXPECT_EQ(actual.edge_weights, expected.edge_weights);
+            EXPECT_EQ(actual.primal_values, expected.primal_values);
+            EXPECT_EQ(actual.dual_values.non_zero_count, expected.dual_values.non_zero_count);
+            EXPECT_EQ(actual.dual_values.dense_values, expected.dual_values.dense_values);
+        }
+    }
+
+    TEST(CheckpointTest, RoundTrip)
+    {
+        const std::string path = temp_path("kalix_checkpoint_roundtrip");
+        const SolverState state = make_state();
+        ASSERT_TRUE(write_checkpoint(state, path).ok());
+
+        const absl::StatusOr<SolverState> restored = read_checkpoint(path);
+        ASSERT_TRUE(restored.ok()) << restored.status();
+        expect_same_state(*restored, state);
+
+        const WarmStartPlan plan = plan_warm_start(*restored);
+        EXPECT_FALSE(plan.run_crash);
+        EXPECT_FALSE(plan.run_phase_one);
+        std::remove(path.c_str());
+    }
+
+    TEST(CheckpointTest, RoundTripWithoutBasis)
+    {
+        const std::string path = temp_path("kalix_checkpoint_empty");
+        SolverState state;
+        state.setup(3, 6);
+        ASSERT_TRUE(write_checkpoint(state, path, {.checksum = false}).ok());
+
+        const absl::StatusOr<SolverState> restored = read_checkpoint(path);
+        ASSERT_TRUE(restored.ok()) << restored.status();
+        expect_same_state(*restored, state);
+        EXPECT_TRUE(plan_warm_start(*restored).run_crash);
+        std::remove(path.c_str());
+    }
+
+    TEST(CheckpointTest, RejectsInconsistentBasis)
+    {
+        const std::string path = temp_path("kalix_checkpoint_inconsistent");
+        SolverState state = make_state();
+        state.basic_index = {1, 1};
+        ASSERT_TRUE(write_checkpoint(state, path).ok());
+        EXPECT_EQ(read_checkpoint(path).status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+
+        EXPECT_FALSE(read_checkpoint(path).ok());
+    }
+
+    TEST(CheckpointTest, DetectsCorruption)
+    {
+        const std::string path = temp_path("kalix_checkpoint_corrupt");
+        ASSERT_TRUE(write_checkpoint(make_state(), path).ok());
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::ate);
+            const std::streamoff size = file.tellg();
+            file.seekp(size - 64);
+            file.put('\x7f');
+        }
+        EXPECT_EQ(read_checkpoint(path).status().code(), absl::StatusCode::kDataLoss);
+        std::remove(path.c_str());
+    }
+
+    TEST(CheckpointTest, BackgroundWriterKeepsLatestState)
+    {
+        const std::string path = temp_path("kalix_checkpoint_async");
+        SolverState state = make_state();
+        {
+            CheckpointWriter writer(path);
+            for (int i = 0; i < 50; i++)
+            {
+                state.iteration_count = i;
+                writer.submit(state);
+            }
+            writer.flush();
+            EXPECT_TRUE(writer.status().ok());
+            EXPECT_GE(writer.written_count(), 1);
+            EXPECT_LE(writer.written_count(), 50);
+
+            const absl::StatusOr<SolverState> restored = read_checkpoint(path);
+            ASSERT_TRUE(restored.ok()) << restored.status();
+            expect_same_state(*restored, state);
+
+            state.iteration_count = 1000;
+            writer.submit(state);
+        }
+
+        // The destructor writes the pending checkpoint.
+        const absl::StatusOr<SolverState> restored = read_checkpoint(path);
+        ASSERT_TRUE(restored.ok()) << restored.status();
+        EXPECT_EQ(restored->iteration_count, 1000);
+        std::remove(path.c_str());
+    }
+
+    TEST(CheckpointTest, BackgroundWriterReportsErrors)
+    {
+        CheckpointWriter writer(temp_path("no_such_directory/checkpoint"));
+        writer.submit(make_state());
+        writer.flush();
+        EXPECT_FALSE(writer.status().ok());
+        EXPECT_EQ(writer.written_count(), 0);
+    }
+}
@@ -0,0 +1,261 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/crash_basis.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "absl/log/check.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        /// @brief Items keyed by small non-negative integers, with constant time updates.
+        ///
+        /// Every key has a doubly linked list of its items. Keys of the crash only decrease, so the
+        /// scan for the smallest non-empty bucket moves forward in amortized constant time.
+        class BucketQueue
+        {
+        public:
+            BucketQueue(const int64_t num_items, const int64_t max_key)
+                : heads_(max_key + 1, -1), next_(num_items, -1), previous_(num_items, -1), keys_(num_items, -1)
+            {
+            }
+
+            [[nodiscard]] bool contains(const int64_t item) const
+            {
+                return keys_[item] >= 0;
+            }
+
+            void insert(const int64_t item, const int64_t key)
+            {
+                DCHECK(!contains(item));
+                keys_[item] = key;
+                previous_[item] = -1;
+                next_[item] = heads_[key];
+                if (heads_[key] != -1)
+                {
+                    previous_[heads_[key]] = item;
+                }
+                heads_[key] = item;
+                minimum_ = std::min(minimum_, key);
+            }
+
+            void remove(const int64_t item)
+            {
+                DCHECK(contains(item));
+                if (previous_[item] != -1)
+                {
+                    next_[previous_[item]] = next_[item];
+                }
+                else
+                {
+                    heads_[keys_[item]] = next_[item];
+                }
+                if (next_[item] != -1)
+                {
+                    previous_[next_[item]] = previous_[item];
+                }
+                keys_[item] = -1;
+            }
+
+            /// @brief Returns an item of the smallest key, or -1 if the queue is empty.
+            [[nodiscard]] int64_t top()
+            {
+                const auto num_keys = static_cast<int64_t>(heads_.size());
+                while (minimum_ < num_keys && heads_[minimum_] == -1)
+                {
+                    minimum_++;
+                }
+                return minimum_ < num_keys ? heads_[minimum_] : -1;
+            }
+
+        private:
+            std::vector<int64_t> heads_;
+            std::vector<int64_t> next_;
+            std::vector<int64_t> previous_;
+            std::vector<int64_t> keys_;
+            int64_t minimum_ = 0;
+        };
+    }
+
+    CrashBasis crash_basis(const lp::CscMatrix& matrix, const std::span<const int64_t> candidates,
+                           const CrashOptions& options)
+    {
+        const int64_t num_rows = matrix.num_rows;
+        const int64_t num_cols = matrix.num_cols;
+        const auto num_candidates = static_cast<int64_t>(candidates.size());
+
+        // The candidate columns without explicit zeros, and their largest magnitudes.
+        std::vector<int64_t> starts = {0};
+        std::vector<int64_t> rows;
+        std::vector<double> values;
+        std::vector<double> largest(num_candidates, 0.0);
+        std::vector<int64_t> row_counts(num_rows, 0);
+        for (int64_t q = 0; q < num_candidates; q++)
+        {
+            const int64_t variable = candidates[q];
+            DCHECK_GE(variable, 0);
+            DCHECK_LT(variable, num_cols + num_rows);
+            if (variable < num_cols)
+            {
+                for (int64_t k = matrix.column_starts[variable]; k < matrix.column_starts[variable + 1]; k++)
+                {
+                    if (matrix.values[k] != 0.0)
+                    {
+                        rows.push_back(matrix.row_indices[k]);
+                        values.push_back(matrix.values[k]);
+                    }
+                }
+            }
+            else
+            {
+                rows.push_back(variable - num_cols);
+                values.push_back(-1.0);
+            }
+            for (auto t = starts.back(); t < static_cast<int64_t>(rows.size()); t++)
+            {
+                largest[q] = std::max(largest[q], std::abs(values[t]));
+                row_counts[rows[t]]++;
+            }
+            starts.push_back(static_cast<int64_t>(rows.size()));
+        }
+
+        // The same entries by row, as candidate and value.
+        std::vector<int64_t> row_starts(num_rows + 1, 0);
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            row_starts[i + 1] = row_starts[i] + row_counts[i];
+        }
+        std::vector<int64_t> row_candidates(rows.size());
+        std::vector<double> row_values(rows.size());
+        std::vector<int64_t> fill(row_starts.begin(), row_starts.end() - 1);
+        for (int64_t q = 0; q < num_candidates; q++)
+        {
+            for (int64_t t = starts[q]; t < starts[q + 1]; t++)
+            {
+                const int64_t slot = fill[rows[t]]++;
+                row_candidates[slot] = q;
+                row_values[slot] = values[t];
+            }
+        }
+
+        const int64_t max_count = num_rows > 0 ? *std::ranges::max_element(row_counts) : 0;
+        BucketQueue queue(num_rows, max_count);
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            if (row_counts[i] > 0)
+            {
+                queue.insert(i, row_counts[i]);
+            }
+        }
+
+        CrashBasis basis;
+        basis.basic_index.reserve(num_rows);
+        basis.pivot_rows.reserve(num_rows);
+        std::vector<char> active(num_candidates, 1);
+        std::vector<char> accepted(num_candidates, 0);
+        std::vector<char> covered(num_rows, 0);
+        for (int64_t row = queue.top(); row != -1; row = queue.top())
+        {
+            queue.remove(row);
+
+            // The shortest acceptable column, the most stable pivot among equally short ones.
+            int64_t best = -1;
+            double best_ratio = 0.0;
+            for (int64_t t = row_starts[row]; t < row_starts[row + 1]; t++)
+            {
+                const int64_t q = row_candidates[t];
+                const double magnitude = std::abs(row_values[t]);
+                if (active[q] == 0 || magnitude <= options.pivot_tolerance ||
+                    magnitude < options.relative_pivot_tolerance * largest[q])
+                {
+                    continue;
+                }
+                const double ratio = magnitude / largest[q];
+                const int64_t length = starts[q + 1] - starts[q];
+                if (best == -1 || length < starts[best + 1] - starts[best] ||
+                    (length == starts[best + 1] - starts[best] && ratio > best_ratio))
+                {
+                    best = q;
+                    best_ratio = ratio;
+                }
+            }
+            if (best == -1)
+            {
+                // The row keeps its slack. Its candidates stay active for their other rows.
+                continue;
+            }
+
+            accepted[best] = 1;
+            covered[row] = 1;
+            basis.basic_index.push_back(candidates[best]);
+            basis.pivot_rows.push_back(row);
+
+            // Every other candidate in the row would break triangularity, so all of them leave the
+            // active submatrix together with the pivot column.
+            for (int64_t t = row_starts[row]; t < row_starts[row + 1]; t++)
+            {
+                const int64_t q = row_candidates[t];
+                if (active[q] == 0)
+                {
+                    continue;
+                }
+                active[q] = 0;
+                for (int64_t s = starts[q]; s < starts[q + 1]; s++)
+                {
+                    const int64_t i = rows[s];
+                    if (queue.contains(i))
+                    {
+                        queue.remove(i);
+                        if (--row_counts[i] > 0)
+                        {
+                            queue.insert(i, row_counts[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+        basis.num_candidates = static_cast<int64_t>(basis.basic_index.size());
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            if (covered[i] == 0)
+            {
+                basis.basic_index.push_back(num_cols + i);
+                basis.pivot_rows.push_back(i);
+            }
+        }
+        for (int64_t q = 0; q < num_candidates; q++)
+        {
+            // A candidate slack of a row without pivot is basic anyway.
+            const int64_t variable = candidates[q];
+            const bool filler = variable >= num_cols && covered[variable - num_cols] == 0;
+            if (accepted[q] == 0 && !filler)
+            {
+                basis.rejected.push_back(variable);
+            }
+        }
+        return basis;
+    }
+}
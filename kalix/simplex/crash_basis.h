@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_CRASH_BASIS_H_
+#define KALIX_SIMPLEX_CRASH_BASIS_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/lp/sparse_matrix.h"
+
+namespace kalix::simplex
+{
+    /// @brief Options of @ref crash_basis.
+    struct CrashOptions
+    {
+        /// @brief Pivots of at most this magnitude are rejected.
+        double pivot_tolerance = 1e-7;
+
+        /// @brief A pivot must be at least this fraction of the largest entry in its column, which
+        /// bounds the multipliers of the triangular factor.
+        double relative_pivot_tolerance = 0.01;
+    };
+
+    /// @brief A lower triangular basis found by @ref crash_basis.
+    struct CrashBasis
+    {
+        /// @brief The basic variable of every basis position: the accepted candidates in pivot order,
+        /// followed by the slacks of the remaining rows.
+        std::vector<int64_t> basic_index;
+
+        /// @brief The row pivoted by every basis position. With the rows and positions in this
+        /// order, the basis matrix is lower triangular, so it can be loaded with
+        /// @ref BasisFactor::factorize_triangular.
+        std::vector<int64_t> pivot_rows;
+
+        /// @brief The candidates that did not enter the basis, in the order they were given.
+        std::vector<int64_t> rejected;
+
+        /// @brief Number of candidates in the basis. They take the first positions.
+        int64_t num_candidates = 0;
+    };
+
+    /// @brief Builds a large triangular basis from @p candidates with the LTSF heuristic (lower
+    /// triangular, sparse first).
+    ///
+    /// The variables are the columns of @p matrix followed by one slack per row, whose column is
+    /// @c -e_i, as in @ref BasisFactor. Every step takes the uncovered row with the fewest entries in
+    /// active candidate columns, pivots it on the shortest of these columns whose entry passes the
+    /// pivot tolerances, and deactivates every other candidate with an entry in the row. Since all
+    /// remaining candidates are zero in the rows already pivoted, the basis is lower triangular.
+    /// Taking the row of fewest entries first loses the fewest candidates per pivot. The rows sit
+    /// in a bucket queue keyed by their count, so the crash runs in time linear in the number of
+    /// non-zeros of the candidate columns. Rows without an acceptable pivot keep their slack.
+    ///
+    /// @param matrix The constraint matrix.
+    /// @param candidates Variables that may enter the basis. Slacks of rows are allowed.
+    /// @param options Pivot tolerances.
+    /// @return The basis, with one position per row.
+    [[nodiscard]] CrashBasis crash_basis(const lp::CscMatrix& matrix, std::span<const int64_t> candidates,
+                                         const CrashOptions& options = {});
+}
+
+#endif // KALIX_SIMPLEX_CRASH_BASIS_H_
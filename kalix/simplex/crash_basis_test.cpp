@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/crash_basis.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kalix/base/vector.h"
+#include "kalix/simplex/basis_factor.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        /// Checks that @p basis is a permutation of the rows that loads as a triangular factor
+        /// and solves with its basis matrix.
+        void expect_loadable(const lp::CscMatrix& matrix, const CrashBasis& basis)
+        {
+            const int64_t m = matrix.num_rows;
+            ASSERT_EQ(static_cast<int64_t>(basis.basic_index.size()), m);
+            std::vector<int64_t> rows = basis.pivot_rows;
+            std::ranges::sort(rows);
+            std::vector<int64_t> expected(m);
+            std::iota(expected.begin(), expected.end(), 0);
+            EXPECT_EQ(rows, expected);
+
+            BasisFactor factor(matrix);
+            ASSERT_TRUE(factor.factorize_triangular(basis.basic_index, basis.pivot_rows).ok());
+            Vector<double> rhs;
+            rhs.setup(m);
+            for (int64_t i = 0; i < m; i++)
+            {
+                rhs.dense_values[i] = static_cast<double>(i % 7) - 3.0;
+                rhs.non_zero_indices[i] = i;
+            }
+            rhs.non_zero_count = m;
+            const std::vector<double> original = rhs.dense_values;
+            factor.ftran(rhs);
+
+            // B*x accumulated column by column.
+            std::vector<double> product(m, 0.0);
+            for (int64_t p = 0; p < m; p++)
+            {
+                const int64_t variable = basis.basic_index[p];
+                if (variable >= matrix.num_cols)
+                {
+                    product[variable - matrix.num_cols] -= rhs.dense_values[p];
+                    continue;
+                }
+                for (int64_t k = matrix.column_starts[variable]; k < matrix.column_starts[variable + 1]; k++)
+                {
+                    product[matrix.row_indices[k]] += matrix.values[k] * rhs.dense_values[p];
+                }
+            }
+            for (int64_t i = 0; i < m; i++)
+            {
+                EXPECT_NEAR(product[i], original[i], 1e-9);
+            }
+        }
+    }
+
+    TEST(CrashBasisTest, FindsPermutedTriangularBasis)
+    {
+        // A lower triangular matrix with shuffled rows and columns.
+        std::mt19937 rng(1);
+        constexpr int64_t m = 60;
+        std::vector<int64_t> row_order(m);
+        std::iota(row_order.begin(), row_order.end(), 0);
+        std::ranges::shuffle(row_order, rng);
+        std::vector<int64_t> column_order = row_order;
+        std::ranges::shuffle(column_order, rng);
+
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+        std::bernoulli_distribution keep(0.1);
+        std::vector<std::vector<int64_t>> indices(m);
+        std::vector<std::vector<double>> values(m);
+        for (int64_t k = 0; k < m; k++)
+        {
+            const int64_t column = column_order[k];
+            indices[column].push_back(row_order[k]);
+            values[column].push_back(2.0 + value(rng));
+            for (int64_t l = k + 1; l < m; l++)
+            {
+                if (keep(rng))
+                {
+                    indices[column].push_back(row_order[l]);
+                    values[column].push_back(value(rng));
+                }
+            }
+        }
+        lp::CscMatrix matrix;
+        matrix.num_rows = m;
+        for (int64_t j = 0; j < m; j++)
+        {
+            matrix.append_column(indices[j], values[j]);
+        }
+
+        std::vector<int64_t> candidates(m);
+        std::iota(candidates.begin(), candidates.end(), 0);
+        std::ranges::shuffle(candidates, rng);
+        const CrashBasis basis = crash_basis(matrix, candidates);
+        EXPECT_EQ(basis.num_candidates, m);
+        EXPECT_TRUE(basis.rejected.empty());
+        expect_loadable(matrix, basis);
+    }
+
+    TEST(CrashBasisTest, CoversSetPartitioningRows)
+    {
+        // Every column covers a few rows with coefficient one.
+        std::mt19937 rng(2);
+        constexpr int64_t m = 80;
+        constexpr int64_t n = 400;
+        std::uniform_int_distribution<int64_t> row(0, m - 1);
+        std::uniform_int_distribution<int64_t> size(1, 6);
+        lp::CscMatrix matrix;
+        matrix.num_rows = m;
+        for (int64_t j = 0; j < n; j++)
+        {
+            std::vector<int64_t> indices;
+            for (int64_t t = size(rng); t > 0; t--)
+            {
+                indices.push_back(row(rng));
+            }
+            std::ranges::sort(indices);
+            indices.erase(std::ranges::unique(indices).begin(), indices.end());
+            matrix.append_column(indices, std::vector<double>(indices.size(), 1.0));
+        }
+
+        std::vector<int64_t> candidates(n);
+        std::iota(candidates.begin(), candidates.end(), 0);
+        const CrashBasis basis = crash_basis(matrix, candidates);
+        EXPECT_EQ(basis.num_candidates + static_cast<int64_t>(basis.rejected.size()), n);
+        EXPECT_GT(basis.num_candidates, m / 2);
+        for (int64_t p = 0; p < basis.num_candidates; p++)
+        {
+            EXPECT_LT(basis.basic_index[p], n);
+        }
+        for (int64_t p = basis.num_candidates; p < m; p++)
+        {
+            EXPECT_EQ(basis.basic_index[p], n + basis.pivot_rows[p]);
+        }
+        expect_loadable(matrix, basis);
+    }
+
+    TEST(CrashBasisTest, RejectsSmallPivots)
+    {
+        lp::CscMatrix matrix;
+        matrix.num_rows = 2;
+        matrix.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{0.001, 1.0});
+        const CrashBasis basis = crash_basis(matrix, std::vector<int64_t>{0});
+        EXPECT_EQ(basis.basic_index, (std::vector<int64_t>{0, 1}));
+        EXPECT_EQ(basis.pivot_rows, (std::vector<int64_t>{1, 0}));
+        expect_loadable(matrix, basis);
+
+        // Without a relative tolerance the entry of row 0 is acceptable too.
+        const CrashBasis loose = crash_basis(matrix, std::vector<int64_t>{0}, {.relative_pivot_tolerance = 0.0});
+        EXPECT_EQ(loose.num_candidates, 1);
+        const CrashBasis strict = crash_basis(matrix, std::vector<int64_t>{0}, {.pivot_tolerance = 2.0});
+        EXPECT_EQ(strict.num_candidates, 0);
+        EXPECT_EQ(strict.rejected, (std::vector<int64_t>{0}));
+        EXPECT_EQ(strict.basic_index, (std::vector<int64_t>{1, 2}));
+    }
+
+    TEST(CrashBasisTest, HandlesSlackCandidates)
+    {
+        lp::CscMatrix matrix;
+        matrix.num_rows = 2;
+        matrix.append_column(std::vector<int64_t>{0}, std::vector<double>{2.0});
+
+        // The structural takes row 0 first, so the slack of row 0 loses; the slack of row 1 enters.
+        const CrashBasis basis = crash_basis(matrix, std::vector<int64_t>{0, 1, 2});
+        EXPECT_EQ(basis.num_candidates, 2);
+        EXPECT_EQ(basis.rejected, (std::vector<int64_t>{1}));
+        expect_loadable(matrix, basis);
+
+        const CrashBasis empty = crash_basis(lp::CscMatrix(), std::vector<int64_t>{});
+        EXPECT_TRUE(empty.basic_index.empty());
+    }
+}
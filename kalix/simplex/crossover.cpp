@@ -0,0 +1,676 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/crossover.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "absl/log/check.h"
+#include "kalix/base/compensated_double.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        /// @brief Returns the tolerance for a value at @p bound, relative to its magnitude.
+        double relative_tolerance(const double tolerance, const double bound)
+        {
+            return tolerance * (1.0 + std::abs(bound));
+        }
+    }
+
+    Crossover::Crossover(const lp::LinearProgram& program, const CrossoverOptions& options)
+        : program_(program), options_(options), num_rows_(program.num_rows()), num_cols_(program.num_cols()),
+          num_variables_(program.num_rows() + program.num_cols()),
+          factor_(program.constraint_matrix, options.factor),
+          row_matrix_(program.constraint_matrix, {.scheduler = options.scheduler})
+    {
+        sense_ = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+        cost_.assign(num_variables_, 0.0);
+        lower_.resize(num_variables_);
+        upper_.resize(num_variables_);
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            cost_[j] = sense_ * program.objective[j];
+            lower_[j] = program.column_lower[j];
+            upper_[j] = program.column_upper[j];
+        }
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            lower_[num_cols_ + i] = program.row_lower[i];
+            upper_[num_cols_ + i] = program.row_upper[i];
+        }
+        column_.setup(num_rows_);
+        row_duals_.setup(num_rows_);
+        row_ep_.setup(num_rows_);
+        pivot_row_.setup(num_cols_);
+    }
+
+    CrossoverResult Crossover::run(const std::span<const double> primal, const std::span<const double> dual)
+    {
+        CHECK_EQ(static_cast<int64_t>(primal.size()), num_cols_);
+        CHECK_EQ(static_cast<int64_t>(dual.size()), num_rows_);
+        CrossoverResult result;
+        iterations_ = 0;
+
+        dual_push(primal, dual);
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            if (status_[j] == VariableStatus::kAtLower || status_[j] == VariableStatus::kAtUpper)
+            {
+                result.dual_pushes++;
+            }
+        }
+
+        const CrashBasis basis = crash();
+        if (!factor_.factorize_triangular(basis.basic_index, basis.pivot_rows).ok())
+        {
+            result.status = CrossoverStatus::kSingularBasis;
+            extract_result(result);
+            return result;
+        }
+        compute_basic_values();
+
+        for (const int64_t variable : basis.rejected)
+        {
+            if (iterations_ >= options_.max_iterations)
+            {
+                result.status = CrossoverStatus::kIterationLimit;
+                extract_result(result);
+                return result;
+            }
+            if (const CrossoverStatus status = primal_push(variable); status != CrossoverStatus::kOptimal)
+            {
+                result.status = status;
+                extract_result(result);
+                return result;
+            }
+            result.primal_pushes++;
+            iterations_++;
+        }
+
+        result.status = primal_simplex(result);
+        if (result.status == CrossoverStatus::kOptimal && !refactorize())
+        {
+            result.status = CrossoverStatus::kSingularBasis;
+        }
+        phase_one_ = false;
+        if (result.status != CrossoverStatus::kSingularBasis)
+        {
+            compute_basic_values();
+            compute_reduced_costs();
+        }
+        extract_result(result);
+        return result;
+    }
+
+    void Crossover::dual_push(const std::span<const double> primal, const std::span<const double> dual)
+    {
+        const lp::CscMatrix& matrix = program_.constraint_matrix;
+        values_.assign(num_variables_, 0.0);
+        status_.assign(num_variables_, VariableStatus::kFree);
+        superbasic_.assign(num_variables_, 0);
+        reduced_costs_.assign(num_variables_, 0.0);
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            values_[j] = std::clamp(primal[j], lower_[j], std::max(lower_[j], upper_[j]));
+        }
+        // Row activities: accumulated column by column, which is how the matrix is stored.
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            const double value = values_[j];
+            if (value == 0.0)
+            {
+                continue;
+            }
+            const auto indices = matrix.column_indices(j);
+            const auto values = matrix.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                values_[num_cols_ + indices[t]] += values[t] * value;
+            }
+        }
+
+        // Every decision only reads the variable's own value and reduced cost, so all variables are
+        // pushed independently.
+        parallel_for(options_.scheduler, 0, num_variables_, 0, [&](const int64_t j)
+        {
+            double reduced_cost;
+            if (j < num_cols_)
+            {
+                CompensatedDouble sum(cost_[j]);
+                const auto indices = matrix.column_indices(j);
+                const auto values = matrix.column_values(j);
+                for (size_t t = 0; t < indices.size(); t++)
+                {
+                    sum += -values[t] * sense_ * dual[indices[t]];
+                }
+                reduced_cost = static_cast<double>(sum);
+            }
+            else
+            {
+                reduced_cost = sense_ * dual[j - num_cols_];
+            }
+            reduced_costs_[j] = reduced_cost;
+
+            const double lower = lower_[j];
+            const double upper = upper_[j];
+            const double value = values_[j];
+            if (lower == upper)
+            {
+                status_[j] = VariableStatus::kFixed;
+                values_[j] = lower;
+                return;
+            }
+            // Near an interior point optimum the gap to an active bound goes to zero while its dual
+            // slack stays positive, and the other way round for an inactive bound, so a bound is
+            // taken as active once the dual slack exceeds the gap (the Mehrotra-Ye indicator).
+            const double lower_gap = value - lower;
+            const double upper_gap = upper - value;
+            const bool at_lower = lower > -kInfinity &&
+                (lower_gap <= relative_tolerance(options_.primal_feasibility_tolerance, lower) ||
+                 reduced_cost > lower_gap);
+            const bool at_upper = upper < kInfinity &&
+                (upper_gap <= relative_tolerance(options_.primal_feasibility_tolerance, upper) ||
+                 -reduced_cost > upper_gap);
+            if (at_lower && (!at_upper || reduced_cost >= 0.0))
+            {
+                status_[j] = VariableStatus::kAtLower;
+                values_[j] = lower;
+            }
+            else if (at_upper)
+            {
+                status_[j] = VariableStatus::kAtUpper;
+                values_[j] = upper;
+            }
+            else
+            {
+                superbasic_[j] = 1;
+            }
+        });
+    }
+
+    CrashBasis Crossover::crash()
+    {
+        std::vector<int64_t> candidates;
+        for (int64_t j = 0; j < num_variables_; j++)
+        {
+            if (superbasic_[j] != 0)
+            {
+                candidates.push_back(j);
+            }
+        }
+        CrashBasis basis = crash_basis(program_.constraint_matrix, candidates, options_.crash);
+
+        basic_index_ = basis.basic_index;
+        position_.assign(num_variables_, -1);
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            const int64_t j = basic_index_[p];
+            status_[j] = VariableStatus::kBasic;
+            superbasic_[j] = 0;
+            position_[j] = p;
+        }
+        row_matrix_.build(status_);
+        reduced_costs_valid_ = false;
+        return basis;
+    }
+
+    bool Crossover::refactorize()
+    {
+        return factor_.factorize(basic_index_).ok();
+    }
+
+    void Crossover::compute_basic_values()
+    {
+        // B x_B = -N x_N, where the slack columns are -e_i.
+        const lp::CscMatrix& matrix = program_.constraint_matrix;
+        column_.clear();
+        column_.non_zero_count = -1;
+        std::vector<double>& rhs = column_.dense_values;
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            if (status_[j] == VariableStatus::kBasic || values_[j] == 0.0)
+            {
+                continue;
+            }
+            const auto indices = matrix.column_indices(j);
+            const auto values = matrix.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                rhs[indices[t]] -= values[t] * values_[j];
+            }
+        }
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            if (status_[num_cols_ + i] != VariableStatus::kBasic)
+            {
+                rhs[i] += values_[num_cols_ + i];
+            }
+        }
+        factor_.ftran(column_);
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            values_[basic_index_[p]] = column_.dense_values[p];
+        }
+    }
+
+    void Crossover::compute_reduced_costs()
+    {
+        row_duals_.clear();
+        row_duals_.non_zero_count = -1;
+        const double tolerance = options_.primal_feasibility_tolerance;
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            const int64_t variable = basic_index_[p];
+            if (!phase_one_)
+            {
+                row_duals_.dense_values[p] = cost_[variable];
+            }
+            else if (values_[variable] < lower_[variable] - relative_tolerance(tolerance, lower_[variable]))
+            {
+                row_duals_.dense_values[p] = -1.0;
+            }
+            else if (values_[variable] > upper_[variable] + relative_tolerance(tolerance, upper_[variable]))
+            {
+                row_duals_.dense_values[p] = 1.0;
+            }
+        }
+        factor_.btran(row_duals_);
+
+        // Pricing is a dot product per nonbasic column and dominates the iteration for wide programs.
+        const lp::CscMatrix& matrix = program_.constraint_matrix;
+        const std::vector<double>& y = row_duals_.dense_values;
+        parallel_for(options_.scheduler, 0, num_variables_, 0, [&](const int64_t j)
+        {
+            if (status_[j] == VariableStatus::kBasic)
+            {
+                reduced_costs_[j] = 0.0;
+                return;
+            }
+            if (j >= num_cols_)
+            {
+                reduced_costs_[j] = y[j - num_cols_];
+                return;
+            }
+            double reduced_cost = phase_one_ ? 0.0 : cost_[j];
+            const auto indices = matrix.column_indices(j);
+            const auto values = matrix.column_values(j);
+            for (size_t t = 0; t < indices.size(); t++)
+            {
+                reduced_cost -= values[t] * y[indices[t]];
+            }
+            reduced_costs_[j] = reduced_cost;
+        });
+        reduced_costs_valid_ = !phase_one_;
+        reduced_cost_updates_ = 0;
+    }
+
+    void Crossover::update_reduced_costs(const int64_t entering, const int64_t leaving_position, const double pivot)
+    {
+        // The duals move by theta times row r of the basis inverse, so every reduced cost moves by
+        // theta times its entry in the pivot row, which zeroes the one of the entering variable.
+        const double theta = reduced_costs_[entering] / pivot;
+        row_ep_.clear();
+        row_ep_.dense_values[leaving_position] = 1.0;
+        row_ep_.non_zero_indices[0] = leaving_position;
+        row_ep_.non_zero_count = 1;
+        factor_.btran(row_ep_);
+
+        pivot_row_.clear();
+        row_matrix_.price(row_ep_, pivot_row_);
+        for (int64_t t = 0; t < pivot_row_.non_zero_count; t++)
+        {
+            const int64_t j = pivot_row_.non_zero_indices[t];
+            reduced_costs_[j] -= theta * pivot_row_.dense_values[j];
+        }
+        row_ep_.for_each_index([&](const int64_t i)
+        {
+            // The slack column is -e_i, so its pivot row entry is the negated entry of row_ep.
+            if (const int64_t j = num_cols_ + i; status_[j] != VariableStatus::kBasic)
+            {
+                reduced_costs_[j] += theta * row_ep_.dense_values[i];
+            }
+        });
+        reduced_costs_[basic_index_[leaving_position]] = -theta;
+        reduced_costs_[entering] = 0.0;
+        reduced_cost_updates_++;
+    }
+
+    bool Crossover::is_primal_feasible() const
+    {
+        const double tolerance = options_.primal_feasibility_tolerance;
+        for (const int64_t j : basic_index_)
+        {
+            if (values_[j] < lower_[j] - relative_tolerance(tolerance, lower_[j]) ||
+                values_[j] > upper_[j] + relative_tolerance(tolerance, upper_[j]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Crossover::Step Crossover::move(const int64_t entering, const double direction)
+    {
+        column_.clear();
+        factor_.load_column(entering, column_);
+        factor_.ftran(column_);
+        const std::vector<double>& alpha = column_.dense_values;
+
+        // A basic variable blocks at the bound it moves towards. One that already violates a bound
+        // blocks when it becomes feasible, and never while moving further away, so the sum of
+        // infeasibilities does not grow.
+        const auto blocking_bound = [&](const int64_t p)
+        {
+            const int64_t variable = basic_index_[p];
+            const double value = values_[variable];
+            const double lower = lower_[variable];
+            const double upper = upper_[variable];
+            const double tolerance = options_.primal_feasibility_tolerance;
+            if (-direction * alpha[p] < 0.0)
+            {
+                if (value < lower - relative_tolerance(tolerance, lower))
+                {
+                    return -kInfinity;
+                }
+                return value > upper + relative_tolerance(tolerance, upper) ? upper : lower;
+            }
+            if (value > upper + relative_tolerance(tolerance, upper))
+            {
+                return kInfinity;
+            }
+            return value < lower - relative_tolerance(tolerance, lower) ? lower : upper;
+        };
+
+        // Harris ratio test. The first pass finds the largest step for which every basic variable
+        // stays within its blocking bound relaxed by the tolerance, the second pass picks among the
+        // variables blocking before that step the one with the largest pivot.
+        const auto ratio = [&](const int64_t p, const double bound, const double slack)
+        {
+            const double rate = -direction * alpha[p];
+            const double value = values_[basic_index_[p]];
+            return rate < 0.0 ? (value - bound + slack) / -rate : (bound - value + slack) / rate;
+        };
+        double relaxed_step = kInfinity;
+        column_.for_each_index([&](const int64_t p)
+        {
+            if (std::abs(alpha[p]) > options_.pivot_tolerance)
+            {
+                const double bound = blocking_bound(p);
+                relaxed_step = std::min(
+                    relaxed_step, ratio(p, bound, relative_tolerance(options_.primal_feasibility_tolerance, bound)));
+            }
+        });
+
+        const double own_step = direction > 0.0 ? upper_[entering] - values_[entering] : values_[entering] - lower_[entering];
+        if (own_step == kInfinity && relaxed_step == kInfinity)
+        {
+            return Step::kUnblocked;
+        }
+
+        const auto shift_basics = [&](const double step)
+        {
+            if (step == 0.0)
+            {
+                return;
+            }
+            column_.for_each_index([&](const int64_t p)
+            {
+                values_[basic_index_[p]] -= direction * step * alpha[p];
+            });
+        };
+        if (own_step <= relaxed_step)
+        {
+            shift_basics(own_step);
+            const bool to_upper = direction > 0.0;
+            values_[entering] = to_upper ? upper_[entering] : lower_[entering];
+            status_[entering] = to_upper ? VariableStatus::kAtUpper : VariableStatus::kAtLower;
+            superbasic_[entering] = 0;
+            return Step::kBoundFlip;
+        }
+
+        int64_t leaving_position = -1;
+        double largest = 0.0;
+        column_.for_each_index([&](const int64_t p)
+        {
+            if (std::abs(alpha[p]) > largest && std::abs(alpha[p]) > options_.pivot_tolerance &&
+                ratio(p, blocking_bound(p), 0.0) <= relaxed_step)
+            {
+                largest = std::abs(alpha[p]);
+                leaving_position = p;
+            }
+        });
+        DCHECK_GE(leaving_position, 0);
+        const double leaving_bound = blocking_bound(leaving_position);
+        const double step = std::max(0.0, ratio(leaving_position, leaving_bound, 0.0));
+        shift_basics(step);
+        values_[entering] += direction * step;
+
+        if (reduced_costs_valid_)
+        {
+            update_reduced_costs(entering, leaving_position, alpha[leaving_position]);
+        }
+
+        const int64_t leaving = basic_index_[leaving_position];
+        const bool to_lower = leaving_bound == lower_[leaving];
+        values_[leaving] = leaving_bound;
+        if (lower_[leaving] == upper_[leaving])
+        {
+            status_[leaving] = VariableStatus::kFixed;
+        }
+        else
+        {
+            status_[leaving] = to_lower ? VariableStatus::kAtLower : VariableStatus::kAtUpper;
+        }
+        position_[leaving] = -1;
+        basic_index_[leaving_position] = entering;
+        position_[entering] = leaving_position;
+        status_[entering] = VariableStatus::kBasic;
+        superbasic_[entering] = 0;
+        if (entering < num_cols_)
+        {
+            row_matrix_.set_basic(entering);
+        }
+        if (leaving < num_cols_)
+        {
+            row_matrix_.set_nonbasic(leaving);
+        }
+
+        if (!factor_.update(column_, leaving_position).ok() || factor_.needs_refactorization())
+        {
+            if (!refactorize())
+            {
+                return Step::kSingular;
+            }
+            compute_basic_values();
+            // Start again from exact reduced costs, so that updates do not drift across factorizations.
+            reduced_costs_valid_ = false;
+        }
+        return Step::kPivot;
+    }
+
+    CrossoverStatus Crossover::primal_push(const int64_t variable)
+    {
+        // Returns kOptimal once the variable is no longer superbasic.
+        if (!reduced_costs_valid_ || phase_one_)
+        {
+            compute_reduced_costs();
+        }
+        const double reduced_cost = reduced_costs_[variable];
+        const double tolerance = options_.dual_feasibility_tolerance;
+        double direction;
+        if (std::abs(reduced_cost) > tolerance)
+        {
+            direction = reduced_cost < 0.0 ? 1.0 : -1.0;
+        }
+        else
+        {
+            // Without an objective preference, head for the nearer bound.
+            direction = upper_[variable] - values_[variable] < values_[variable] - lower_[variable] ? 1.0 : -1.0;
+        }
+
+        Step step = move(variable, direction);
+        if (step == Step::kUnblocked && std::abs(reduced_cost) <= tolerance)
+        {
+            step = move(variable, -direction);
+        }
+        switch (step)
+        {
+        case Step::kUnblocked:
+            {
+                if (std::abs(reduced_cost) > tolerance)
+                {
+                    return CrossoverStatus::kUnbounded;
+                }
+                // A free variable whose column does not touch the basic variables: it is nonbasic at
+                // zero, and the basic values absorb the change.
+                values_[variable] = 0.0;
+                status_[variable] = VariableStatus::kFree;
+                superbasic_[variable] = 0;
+                compute_basic_values();
+                return CrossoverStatus::kOptimal;
+            }
+
+        case Step::kSingular:
+            {
+                return CrossoverStatus::kSingularBasis;
+            }
+
+        case Step::kBoundFlip:
+        case Step::kPivot:
+            {
+                return CrossoverStatus::kOptimal;
+            }
+        }
+        return CrossoverStatus::kOptimal;
+    }
+
+    CrossoverStatus Crossover::primal_simplex(CrossoverResult& result)
+    {
+        const double tolerance = options_.dual_feasibility_tolerance;
+        while (true)
+        {
+            // Phase one minimizes the sum of infeasibilities of the basic variables.
+            phase_one_ = !is_primal_feasible();
+            if (!reduced_costs_valid_ || phase_one_)
+            {
+                compute_reduced_costs();
+            }
+            int64_t entering = -1;
+            double direction = 0.0;
+            double best = tolerance;
+            for (int64_t j = 0; j < num_variables_; j++)
+            {
+                const double reduced_cost = reduced_costs_[j];
+                const VariableStatus status = status_[j];
+                const bool can_increase = status == VariableStatus::kAtLower || status == VariableStatus::kFree;
+                const bool can_decrease = status == VariableStatus::kAtUpper || status == VariableStatus::kFree;
+                if (can_increase && -reduced_cost > best)
+                {
+                    best = -reduced_cost;
+                    entering = j;
+                    direction = 1.0;
+                }
+                else if (can_decrease && reduced_cost > best)
+                {
+                    best = reduced_cost;
+                    entering = j;
+                    direction = -1.0;
+                }
+            }
+            if (entering == -1 && reduced_cost_updates_ > 0)
+            {
+                // Updated reduced costs can hide a candidate, so optimality is confirmed from scratch.
+                compute_reduced_costs();
+                continue;
+            }
+            if (entering == -1)
+            {
+                return phase_one_ ? CrossoverStatus::kPrimalInfeasible : CrossoverStatus::kOptimal;
+            }
+            if (iterations_ >= options_.max_iterations)
+            {
+                return CrossoverStatus::kIterationLimit;
+            }
+
+            const Step step = move(entering, direction);
+            if (step == Step::kUnblocked)
+            {
+                return CrossoverStatus::kUnbounded;
+            }
+            if (step == Step::kSingular)
+            {
+                return CrossoverStatus::kSingularBasis;
+            }
+            result.simplex_iterations++;
+            iterations_++;
+        }
+    }
+
+    void Crossover::extract_result(CrossoverResult& result) const
+    {
+        result.primal.assign(values_.begin(), values_.begin() + num_cols_);
+        result.row_activity.assign(values_.begin() + num_cols_, values_.end());
+        result.dual.resize(num_rows_);
+        for (int64_t i = 0; i < num_rows_; i++)
+        {
+            result.dual[i] = sense_ * row_duals_.dense_values[i];
+        }
+        result.reduced_costs.resize(num_cols_);
+        CompensatedDouble objective(program_.objective_offset);
+        for (int64_t j = 0; j < num_cols_; j++)
+        {
+            result.reduced_costs[j] = sense_ * reduced_costs_[j];
+            objective += program_.objective[j] * values_[j];
+        }
+        result.objective = static_cast<double>(objective);
+
+        SolverState& state = result.state;
+        state.setup(num_rows_, num_variables_);
+        state.iteration_count = iterations_;
+        state.has_basis = true;
+        state.factor_ready = result.status != CrossoverStatus::kSingularBasis;
+        if (result.status == CrossoverStatus::kOptimal)
+        {
+            state.phase = SimplexPhase::kOptimal;
+        }
+        else
+        {
+            state.phase = is_primal_feasible() ? SimplexPhase::kPhaseTwo : SimplexPhase::kPhaseOne;
+        }
+        state.variable_status = status_;
+        state.basic_index = basic_index_;
+        state.primal_values.non_zero_count = -1;
+        for (int64_t p = 0; p < num_rows_; p++)
+        {
+            state.primal_values.dense_values[p] = values_[basic_index_[p]];
+        }
+        state.primal_values.rebuild_indices_from_dense();
+        state.dual_values.non_zero_count = -1;
+        state.dual_values.dense_values = reduced_costs_;
+        state.dual_values.rebuild_indices_from_dense();
+    }
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_CROSSOVER_H_
+#define KALIX_SIMPLEX_CROSSOVER_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/lp/linear_program.h"
+#include "kalix/simplex/basis_factor.h"
+#include "kalix/simplex/crash_basis.h"
+#include "kalix/simplex/row_matrix.h"
+#include "kalix/simplex/solver_state.h"
+
+namespace kalix::simplex
+{
+    /// @brief Options of @ref Crossover.
+    struct CrossoverOptions
+    {
+        /// @brief Scheduler used for the dual push and for pricing. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Values within this distance of a bound count as being at the bound, and basic
+        /// variables may violate their bounds by this much.
+        double primal_feasibility_tolerance = 1e-7;
+
+        /// @brief Reduced costs of at most this magnitude count as zero.
+        double dual_feasibility_tolerance = 1e-7;
+
+        /// @brief Entries of the entering column of smaller magnitude never block a step.
+        double pivot_tolerance = 1e-7;
+
+        /// @brief Options of the crash basis.
+        CrashOptions crash;
+
+        /// @brief Maximum number of primal pushes plus simplex iterations.
+        int64_t max_iterations = 100000;
+
+        /// @brief Options of the basis factorization.
+        BasisFactorOptions factor;
+    };
+
+    /// @brief Termination status of @ref Crossover::run.
+    enum class CrossoverStatus : int8_t
+    {
+        /// @brief An optimal basis was found.
+        kOptimal,
+
+        /// @brief The iteration limit was reached.
+        kIterationLimit,
+
+        /// @brief Phase one found no basis whose basic solution satisfies the bounds.
+        kPrimalInfeasible,
+
+        /// @brief The simplex method found an unbounded ray.
+        kUnbounded,
+
+        /// @brief The basis could not be factorized.
+        kSingularBasis,
+    };
+
+    /// @brief Vertex solution computed by @ref Crossover.
+    struct CrossoverResult
+    {
+        /// @brief Termination status.
+        CrossoverStatus status = CrossoverStatus::kIterationLimit;
+
+        /// @brief The basis, for warm starting the simplex method. Variables are the columns
+        /// followed by the slacks; a slack equals the activity of its row.
+        SolverState state;
+
+        /// @brief Column values.
+        std::vector<double> primal;
+
+        /// @brief Row activities.
+        std::vector<double> row_activity;
+
+        /// @brief Row duals, for the objective sense of the program.
+        std::vector<double> dual;
+
+        /// @brief Column reduced costs, for the objective sense of the program.
+        std::vector<double> reduced_costs;
+
+        /// @brief Objective value, including the offset.
+        double objective = 0.0;
+
+        /// @brief Number of variables moved onto a bound by the dual push.
+        int64_t dual_pushes = 0;
+
+        /// @brief Number of superbasic variables removed by primal pushes.
+        int64_t primal_pushes = 0;
+
+        /// @brief Number of simplex iterations after the pushes.
+        int64_t simplex_iterations = 0;
+    };
+
+    /// @brief Turns an interior point solution into an optimal basic solution.
+    ///
+    /// The crossover runs in three phases:
+    /// - Dual push: every variable at a bound, or with a reduced cost that complementarity ties to
+    ///   a bound, is made nonbasic at that bound. The decisions are independent and run in parallel.
+    /// - Crash: a triangular basis is built from the remaining superbasic variables by
+    ///   @ref crash_basis, completed with slacks. Its pivot sequence is loaded into the
+    ///   factorization as it is, without a pivot search.
+    /// - Primal push: every superbasic variable that did not make it into the basis is moved to a
+    ///   bound along its edge, entering the basis if a basic variable blocks first.
+    ///
+    /// Interior point solutions are only approximately feasible, and pushing variables onto their
+    /// bounds moves the basic variables by about as much, so the basis may violate some bounds
+    /// slightly. Primal simplex iterations first minimize the sum of these infeasibilities and then
+    /// remove the remaining dual infeasibilities. All linear algebra runs on @ref Vector through @ref BasisFactor.
+    /// In phase two, every pivot updates the reduced costs with the pivot row, priced row-wise on a
+    /// @ref RowMatrix that follows the basis, instead of pricing every column again.
+    class Crossover
+    {
+    public:
+        /// @brief Prepares the crossover for @p program, which must outlive it.
+        explicit Crossover(const lp::LinearProgram& program, const CrossoverOptions& options = {});
+
+        /// @brief Runs the crossover.
+        ///
+        /// @param primal The column values of the interior point solution.
+        /// @param dual The row duals of the interior point solution, for the objective sense of
+        /// the program.
+        /// @return The basic solution.
+        [[nodiscard]] CrossoverResult run(std::span<const double> primal, std::span<const double> dual);
+
+    private:
+        /// @brief Outcome of moving a nonbasic variable along its edge.
+        enum class Step : int8_t
+        {
+            kUnblocked,
+            kBoundFlip,
+            kPivot,
+            kSingular,
+        };
+
+        void dual_push(std::span<const double> primal, std::span<const double> dual);
+        [[nodiscard]] CrashBasis crash();
+        [[nodiscard]] bool refactorize();
+        void compute_basic_values();
+        void compute_reduced_costs();
+        void update_reduced_costs(int64_t entering, int64_t leaving_position, double pivot);
+        [[nodiscard]] bool is_primal_feasible() const;
+        [[nodiscard]] CrossoverStatus primal_push(int64_t variable);
+        [[nodiscard]] CrossoverStatus primal_simplex(CrossoverResult& result);
+        [[nodiscard]] Step move(int64_t entering, double direction);
+        void extract_result(CrossoverResult& result) const;
+
+        const lp::LinearProgram& program_;
+        CrossoverOptions options_;
+        double sense_ = 1.0;
+        int64_t num_rows_ = 0;
+        int64_t num_cols_ = 0;
+        int64_t num_variables_ = 0;
+
+        // Costs and bounds of the columns followed by the slacks, for minimization.
+        std::vector<double> cost_;
+        std::vector<double> lower_;
+        std::vector<double> upper_;
+
+        std::vector<double> values_;
+        std::vector<VariableStatus> status_;
+        std::vector<char> superbasic_;
+        std::vector<int64_t> basic_index_;
+        std::vector<int64_t> position_;
+
+        BasisFactor factor_;
+        RowMatrix row_matrix_;
+        Vector<double> column_;
+        Vector<double> row_duals_;
+        Vector<double> row_ep_;
+        Vector<double> pivot_row_;
+        std::vector<double> reduced_costs_;
+        bool phase_one_ = false;
+
+        // Whether reduced_costs_ hold the phase two reduced costs of the current basis, and how many
+        // pivots updated them since they were last computed from scratch.
+        bool reduced_costs_valid_ = false;
+        int64_t reduced_cost_updates_ = 0;
+        int64_t iterations_ = 0;
+    };
+}
+
+#endif // KALIX_SIMPLEX_CROSSOVER_H_
@@ -0,0 +1,247 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/crossover.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kalix/base/task_scheduler.h"
+#include "kalix/ipm/interior_point.h"
+#include "kalix/lp/test_programs.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+        constexpr double kTolerance = 1e-6;
+
+        /// Checks that the result is an optimal basic solution: one basic variable per row,
+        /// nonbasic variables at a bound with a reduced cost of the right sign, and a feasible
+        /// primal that satisfies A*x = activity.
+        void expect_optimal_basis(const lp::LinearProgram& program, const CrossoverResult& result)
+        {
+            ASSERT_EQ(result.status, CrossoverStatus::kOptimal);
+            const SolverState& state = result.state;
+            const int64_t num_cols = program.num_cols();
+            ASSERT_EQ(state.num_rows, program.num_rows());
+            ASSERT_EQ(state.num_variables, num_cols + program.num_rows());
+            EXPECT_TRUE(state.has_basis);
+            EXPECT_TRUE(state.factor_ready);
+            EXPECT_EQ(state.phase, SimplexPhase::kOptimal);
+
+            int64_t num_basic = 0;
+            for (int64_t j = 0; j < state.num_variables; j++)
+            {
+                const bool is_column = j < num_cols;
+                const double value = is_column ? result.primal[j] : result.row_activity[j - num_cols];
+                const double lower = is_column ? program.column_lower[j] : program.row_lower[j - num_cols];
+                const double upper = is_column ? program.column_upper[j] : program.row_upper[j - num_cols];
+                // Reduced cost of the minimization form; a slack's reduced cost is its row dual.
+                const double sense = program.sense == lp::ObjectiveSense::kMaximize ? -1.0 : 1.0;
+                const double reduced_cost = sense * (is_column ? result.reduced_costs[j] : result.dual[j - num_cols]);
+                EXPECT_GE(value, lower - kTolerance);
+                EXPECT_LE(value, upper + kTolerance);
+                switch (state.variable_status[j])
+                {
+                case VariableStatus::kBasic:
+                    {
+                        num_basic++;
+                        EXPECT_NEAR(reduced_cost, 0.0, kTolerance);
+                        break;
+                    }
+
+                case VariableStatus::kAtLower:
+                    {
+                        EXPECT_EQ(value, lower);
+                        EXPECT_GE(reduced_cost, -kTolerance);
+                        break;
+                    }
+
+                case VariableStatus::kAtUpper:
+                    {
+                        EXPECT_EQ(value, upper);
+                        EXPECT_LE(reduced_cost, kTolerance);
+                        break;
+                    }
+
+                case VariableStatus::kFixed:
+                    {
+                        EXPECT_EQ(value, lower);
+                        break;
+                    }
+
+                case VariableStatus::kFree:
+                    {
+                        EXPECT_EQ(value, 0.0);
+                        EXPECT_NEAR(reduced_cost, 0.0, kTolerance);
+                        break;
+                    }
+                }
+            }
+            EXPECT_EQ(num_basic, program.num_rows());
+            for (int64_t p = 0; p < state.num_rows; p++)
+            {
+                EXPECT_EQ(state.variable_status[state.basic_index[p]], VariableStatus::kBasic);
+            }
+
+            std::vector<double> activity(program.num_rows(), 0.0);
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                const auto indices = program.constraint_matrix.column_indices(j);
+                const auto values = program.constraint_matrix.column_values(j);
+                for (size_t t = 0; t < indices.size(); t++)
+                {
+                    activity[indices[t]] += values[t] * result.primal[j];
+                }
+            }
+            for (int64_t i = 0; i < program.num_rows(); i++)
+            {
+                EXPECT_NEAR(activity[i], result.row_activity[i], kTolerance);
+            }
+        }
+    }
+
+    TEST(CrossoverTest, FindsVertexOfSmallMinimization)
+    {
+        const lp::LinearProgram program = lp::small_minimization_program();
+        const ipm::InteriorPointResult interior = ipm::InteriorPointSolver(program).solve();
+        ASSERT_EQ(interior.status, ipm::InteriorPointStatus::kOptimal);
+        const CrossoverResult result = Crossover(program).run(interior.primal, interior.dual);
+        expect_optimal_basis(program, result);
+        EXPECT_NEAR(result.primal[0], 1.6, 1e-9);
+        EXPECT_NEAR(result.primal[1], 1.2, 1e-9);
+        EXPECT_NEAR(result.dual[0], -0.4, 1e-9);
+        EXPECT_NEAR(result.dual[1], -0.2, 1e-9);
+        EXPECT_NEAR(result.objective, -2.8, 1e-9);
+    }
+
+    TEST(CrossoverTest, PushesCentralSolutionOfDegenerateProgramToVertex)
+    {
+        // max x + y  s.t.  x + y <= 1, 0 <= x, y <= 1. Every point of the face x + y = 1 is
+        // optimal, and the interior point method ends near its center (1/2, 1/2).
+        lp::LinearProgram program = lp::make_program({{1.0, 1.0}}, {1.0, 1.0}, {0.0, 0.0}, {1.0, 1.0},
+                                                     {-kInfinity}, {1.0});
+        program.sense = lp::ObjectiveSense::kMaximize;
+        const ipm::InteriorPointResult interior = ipm::InteriorPointSolver(program).solve();
+        ASSERT_EQ(interior.status, ipm::InteriorPointStatus::kOptimal);
+        EXPECT_NEAR(interior.primal[0], 0.5, 1e-3);
+
+        const CrossoverResult result = Crossover(program).run(interior.primal, interior.dual);
+        expect_optimal_basis(program, result);
+        EXPECT_NEAR(result.objective, 1.0, 1e-9);
+        EXPECT_EQ(result.primal_pushes, 1);
+        // One column is basic at one, the other nonbasic at zero.
+        EXPECT_NEAR(result.primal[0] * result.primal[1], 0.0, 1e-12);
+    }
+
+    TEST(CrossoverTest, RunsSimplexFromSuboptimalFeasiblePoint)
+    {
+        // The origin is a feasible vertex, but far from optimal.
+        const lp::LinearProgram program = lp::small_minimization_program();
+        const CrossoverResult result = Crossover(program).run(std::vector<double>{0.0, 0.0},
+                                                              std::vector<double>{0.0, 0.0});
+        expect_optimal_basis(program, result);
+        EXPECT_GT(result.simplex_iterations, 0);
+        EXPECT_NEAR(result.objective, -2.8, 1e-9);
+    }
+
+    TEST(CrossoverTest, HandlesFreeAndFixedColumns)
+    {
+        // min x + y + z  s.t.  x - y = 0, x + z >= 2, x free, y >= 1, z fixed at 0.5. Optimum x = y = 1.5.
+        const lp::LinearProgram program = lp::make_program({{1.0, -1.0, 0.0}, {1.0, 0.0, 1.0}},
+                                                           {1.0, 1.0, 1.0}, {-kInfinity, 1.0, 0.5},
+                                                           {kInfinity, kInfinity, 0.5}, {0.0, 2.0},
+                                                           {0.0, kInfinity});
+        const ipm::InteriorPointResult interior = ipm::InteriorPointSolver(program).solve();
+        ASSERT_EQ(interior.status, ipm::InteriorPointStatus::kOptimal);
+        const CrossoverResult result = Crossover(program).run(interior.primal, interior.dual);
+        expect_optimal_basis(program, result);
+        EXPECT_NEAR(result.primal[0], 1.5, 1e-9);
+        EXPECT_NEAR(result.primal[1], 1.5, 1e-9);
+        EXPECT_EQ(result.state.variable_status[2], VariableStatus::kFixed);
+    }
+
+    TEST(CrossoverTest, DetectsUnboundedRay)
+    {
+        // min -x  s.t.  x - y <= 1, x, y >= 0. Along x = y + 1 the objective decreases forever.
+        const lp::LinearProgram program = lp::make_program({{1.0, -1.0}}, {-1.0, 0.0}, {0.0, 0.0},
+                                                           {kInfinity, kInfinity}, {-kInfinity}, {1.0});
+        const CrossoverResult result = Crossover(program).run(std::vector<double>{0.0, 0.0},
+                                                              std::vector<double>{0.0});
+        EXPECT_EQ(result.status, CrossoverStatus::kUnbounded);
+    }
+
+    TEST(CrossoverTest, DetectsInfeasibleProgram)
+    {
+        // x + y >= 3 with 0 <= x, y <= 1 has no solution; phase one gets stuck at x = y = 1.
+        const lp::LinearProgram program = lp::make_program({{1.0, 1.0}}, {1.0, 1.0}, {0.0, 0.0}, {1.0, 1.0},
+                                                           {3.0}, {kInfinity});
+        const CrossoverResult result = Crossover(program).run(std::vector<double>{0.5, 0.5},
+                                                              std::vector<double>{0.0});
+        EXPECT_EQ(result.status, CrossoverStatus::kPrimalInfeasible);
+        EXPECT_EQ(result.state.phase, SimplexPhase::kPhaseOne);
+        EXPECT_EQ(result.primal[0], 1.0);
+        EXPECT_EQ(result.primal[1], 1.0);
+    }
+
+    TEST(CrossoverTest, MatchesInteriorPointObjectiveOnRandomPrograms)
+    {
+        std::mt19937 rng(7);
+        for (int trial = 0; trial < 20; trial++)
+        {
+            const lp::LinearProgram program = lp::random_program(rng, 15, 25);
+            const ipm::InteriorPointResult interior = ipm::InteriorPointSolver(program).solve();
+            ASSERT_EQ(interior.status, ipm::InteriorPointStatus::kOptimal);
+            const CrossoverResult result = Crossover(program).run(interior.primal, interior.dual);
+            expect_optimal_basis(program, result);
+            EXPECT_NEAR(result.objective, interior.objective, kTolerance * (1.0 + std::abs(interior.objective)));
+        }
+    }
+
+    class CrossoverParallelTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(CrossoverParallelTest, MatchesSerialCrossover)
+    {
+        std::mt19937 rng(11);
+        const lp::LinearProgram program = lp::random_program(rng, 60, 120);
+        const ipm::InteriorPointResult interior = ipm::InteriorPointSolver(program).solve();
+        ASSERT_EQ(interior.status, ipm::InteriorPointStatus::kOptimal);
+
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        CrossoverOptions options;
+        options.scheduler = &scheduler;
+        const CrossoverResult parallel = Crossover(program, options).run(interior.primal, interior.dual);
+        const CrossoverResult serial = Crossover(program).run(interior.primal, interior.dual);
+        expect_optimal_basis(program, parallel);
+        EXPECT_EQ(parallel.state.basic_index, serial.state.basic_index);
+        EXPECT_EQ(parallel.primal, serial.primal);
+        EXPECT_EQ(parallel.dual, serial.dual);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, CrossoverParallelTest, ::testing::Values(1, 4));
+}
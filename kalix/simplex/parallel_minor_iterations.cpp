@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/parallel_minor_iterations.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "kalix/base/constants.h"
+
+namespace kalix::simplex
+{
+    ParallelMinorIterations::ParallelMinorIterations(const int64_t num_rows,
+                                                     const int64_t num_variables,
+                                                     const ParallelMinorIterationsOptions& options)
+        : options_(options),
+          num_variables_(num_variables),
+          price_workspaces_([num_rows, num_variables](PriceWorkspace& workspace)
+          {
+              workspace.row_ep.setup(num_rows);
+              workspace.row_accumulator.set_dimension(num_variables);
+          }),
+          ratio_test_(options.ratio_test)
+    {
+        CHECK_GT(options_.max_candidates, 0);
+
+        const int64_t max_candidates = options_.max_candidates;
+        candidate_rows_.resize(max_candidates);
+        candidate_values_.resize(max_candidates);
+        candidate_lower_.resize(max_candidates);
+        candidate_upper_.resize(max_candidates);
+        candidate_weights_.resize(max_candidates);
+        active_.resize(max_candidates);
+        pivot_rows_.resize(max_candidates);
+        for (auto& row : pivot_rows_)
+        {
+            row.setup(num_variables);
+        }
+        minor_iterations_.reserve(max_candidates);
+    }
+
+    int64_t ParallelMinorIterations::choose_candidates(const std::span<const double> basic_values,
+                                                       const std::span<const double> basic_lower,
+                                                       const std::span<const double> basic_upper,
+                                                       const std::span<const double> edge_weights)
+    {
+        DCHECK_EQ(basic_values.size(), basic_lower.size());
+        DCHECK_EQ(basic_values.size(), basic_upper.size());
+        DCHECK_EQ(basic_values.size(), edge_weights.size());
+
+        const double tolerance = options_.primal_feasibility_tolerance;
+        merits_.clear();
+        for (size_t row = 0; row < basic_values.size(); row++)
+        {
+            double violation = 0.0;
+            if (basic_values[row] < basic_lower[row] - tolerance)
+            {
+                violation = basic_lower[row] - basic_values[row];
+            }
+            else if (basic_values[row] > basic_upper[row] + tolerance)
+            {
+                violation = basic_values[row] - basic_upper[row];
+            }
+
+            if (violation > 0.0)
+            {
+                merits_.emplace_back(violation * violation / edge_weights[row], static_cast<int64_t>(row));
+            }
+        }
+
+        candidate_count_ = std::min(options_.max_candidates, static_cast<int64_t>(merits_.size()));
+        std::nth_element(merits_.begin(), merits_.begin() + candidate_count_, merits_.end(), std::greater<>());
+
+        for (int64_t slot = 0; slot < candidate_count_; slot++)
+        {
+            const int64_t row = merits_[slot].second;
+            candidate_rows_[slot] = row;
+            candidate_values_[slot] = basic_values[row];
+            candidate_lower_[slot] = basic_lower[row];
+            candidate_upper_[slot] = basic_upper[row];
+            candidate_weights_[slot] = edge_weights[row];
+        }
+        return candidate_count_;
+    }
+
+    double ParallelMinorIterations::infeasibility(const int64_t slot) const
+    {
+        const double value = candidate_values_[slot];
+        if (value < candidate_lower_[slot])
+        {
+            return value - candidate_lower_[slot];
+        }
+        if (value > candidate_upper_[slot])
+        {
+            return value - candidate_upper_[slot];
+        }
+        return 0.0;
+    }
+
+    int64_t ParallelMinorIterations::perform_minor_iterations(const std::span<const int64_t> basic_index,
+                                                              const std::span<double> reduced_costs,
+                                                              const std::span<int8_t> nonbasic_move,
+                                                              const std::span<const double> bound_range)
+    {
+        DCHECK_EQ(static_cast<int64_t>(reduced_costs.size()), num_variables_);
+
+        minor_iterations_.clear();
+        flipped_variables_.clear();
+        dual_unbounded_row_ = -1;
+        std::fill_n(active_.begin(), candidate_count_, 1);
+
+        const double tolerance = options_.primal_feasibility_tolerance;
+        while (true)
+        {
+            // CHUZR among the remaining candidates with their updated values.
+            int64_t pivot_slot = -1;
+            double best_merit = 0.0;
+            for (int64_t slot = 0; slot < candidate_count_; slot++)
+            {
+                if (!active_[slot])
+                {
+                    continue;
+                }
+                const double delta = infeasibility(slot);
+                if (std::abs(delta) <= tolerance)
+                {
+                    continue;
+                }
+                if (const double merit = delta * delta / candidate_weights_[slot]; merit > best_merit)
+                {
+                    best_merit = merit;
+                    pivot_slot = slot;
+                }
+            }
+            if (pivot_slot < 0)
+            {
+                break;
+            }
+            active_[pivot_slot] = 0;
+
+            const Vector<double>& pivot_row = pivot_rows_[pivot_slot];
+            const int64_t row = candidate_rows_[pivot_slot];
+            const double delta = infeasibility(pivot_slot);
+            const double direction = delta < 0.0 ? -1.0 : 1.0;
+
+            const BoundFlippingRatioTestStatus status = ratio_test_.run(
+                pivot_row, direction, std::abs(delta), reduced_costs, nonbasic_move, bound_range);
+            if (status != BoundFlippingRatioTestStatus::kEntering)
+            {
+                dual_unbounded_row_ = row;
+                break;
+            }
+
+            // Bound flips move the flipped variables across their range and shift every candidate.
+            for (const int64_t variable : ratio_test_.flipped_indices())
+            {
+                const double change = nonbasic_move[variable] * bound_range[variable];
+                nonbasic_move[variable] = static_cast<int8_t>(-nonbasic_move[variable]);
+                flipped_variables_.push_back(variable);
+                for (int64_t slot = 0; slot < candidate_count_; slot++)
+                {
+                    candidate_values_[slot] -= pivot_rows_[slot].dense_values[variable] * change;
+                }
+            }
+
+            const int64_t entering = ratio_test_.entering_index();
+            const int64_t leaving = basic_index[row];
+            const double pivot = pivot_row.dense_values[entering];
+            const double dual_step = direction * ratio_test_.step();
+            const double primal_step = infeasibility(pivot_slot) / pivot;
+
+            // Dual update along the pivotal row.
+            pivot_row.for_each_index([&](const int64_t variable)
+            {
+                reduced_costs[variable] -= dual_step * pivot_row.dense_values[variable];
+            });
+            reduced_costs[entering] = 0.0;
+            reduced_costs[leaving] = -dual_step;
+            nonbasic_move[entering] = 0;
+            nonbasic_move[leaving] = static_cast<int8_t>(direction > 0.0 ? -1 : 1);
+
+            // Primal and tableau update of the remaining candidates.
+            for (int64_t slot = 0; slot < candidate_count_; slot++)
+            {
+                if (!active_[slot])
+                {
+                    continue;
+                }
+
+                Vector<double>& row_vector = pivot_rows_[slot];
+                const double entering_entry = row_vector.dense_values[entering];
+                if (entering_entry == 0.0)
+                {
+                    continue;
+                }
+
+                candidate_values_[slot] -= primal_step * entering_entry;
+
+                const double ratio = entering_entry / pivot;
+                row_vector.saxpy(-ratio, &pivot_row);
+                row_vector.dense_values[entering] = kZero;
+                row_vector.dense_values[leaving] = -ratio;
+                if (row_vector.representation() != VectorRepresentation::kDense)
+                {
+                    row_vector.non_zero_indices[row_vector.non_zero_count++] = leaving;
+                }
+            }
+            candidate_values_[pivot_slot] = delta < 0.0 ? candidate_lower_[pivot_slot] : candidate_upper_[pivot_slot];
+
+            minor_iterations_.push_back({
+                .row = row,
+                .leaving_variable = leaving,
+                .entering_variable = entering,
+                .primal_step = primal_step,
+                .dual_step = dual_step,
+                .pivot = pivot,
+            });
+        }
+
+        return static_cast<int64_t>(minor_iterations_.size());
+    }
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_PARALLEL_MINOR_ITERATIONS_H_
+#define KALIX_SIMPLEX_PARALLEL_MINOR_ITERATIONS_H_
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "kalix/base/config.h"
+#include "kalix/base/sparse_vector_sum.h"
+#include "kalix/base/vector.h"
+#include "kalix/base/workspace_pool.h"
+#include "kalix/simplex/bound_flipping_ratio.h"
+
+namespace kalix::simplex
+{
+    /// @brief An executor able to run the iterations of a loop concurrently.
+    ///
+    /// @c parallel_for(begin, end, grain, body) must call @c body(i) exactly once for every
+    /// @c i in @c [begin, end) and return only after all calls have finished.
+    template <typename Executor>
+    concept ParallelForExecutor = requires(Executor& executor, void (*body)(int64_t))
+    {
+        executor.parallel_for(int64_t{}, int64_t{}, int64_t{}, body);
+    };
+
+    /// @brief Executor running every loop iteration on the calling thread.
+    struct SerialExecutor
+    {
+        template <typename Body>
+        KALIX_FORCE_INLINE void parallel_for(const int64_t begin, const int64_t end, int64_t, Body&& body)
+        {
+            for (int64_t i = begin; i < end; i++)
+            {
+                body(i);
+            }
+        }
+    };
+
+    /// @brief Per-task scratch space for computing one candidate pivot row.
+    struct PriceWorkspace
+    {
+        /// @brief Row of the basis inverse (BTRAN result), indexed by row.
+        Vector<double> row_ep;
+
+        /// @brief High-precision accumulator for the pivot row, indexed by variable.
+        SparseVectorSum row_accumulator;
+    };
+
+    /// @brief Options of the parallel minor iteration mode.
+    struct ParallelMinorIterationsOptions
+    {
+        /// @brief Maximum number of leaving row candidates per major iteration.
+        int64_t max_candidates = 8;
+
+        /// @brief Basic variables violating a bound by less than this are considered feasible.
+        double primal_feasibility_tolerance = 1e-7;
+
+        /// @brief Tolerances of the ratio test used by every minor iteration.
+        BoundFlippingRatioTestOptions ratio_test;
+    };
+
+    /// @brief Basis change performed by one minor iteration.
+    struct MinorIteration
+    {
+        /// @brief The row of the leaving variable.
+        int64_t row = -1;
+
+        /// @brief The variable leaving the basis.
+        int64_t leaving_variable = -1;
+
+        /// @brief The variable entering the basis.
+        int64_t entering_variable = -1;
+
+        /// @brief Change of the entering variable.
+        double primal_step = 0.0;
+
+        /// @brief Signed dual step applied to the reduced costs.
+        double dual_step = 0.0;
+
+        /// @brief The pivot element of the (updated) tableau row.
+        double pivot = 0.0;
+    };
+
+    /// @brief Multi-iteration parallelism (PAMI) for the dual simplex method.
+    ///
+    /// A major iteration chooses several attractive leaving rows at once (@ref choose_candidates),
+    /// computes their tableau rows concurrently on an executor (@ref compute_pivot_rows) and then
+    /// performs up to one minor iteration per candidate (@ref perform_minor_iterations). Minor
+    /// iterations only touch the candidate rows: after each basis change the remaining rows are
+    /// updated with the pivotal row by a sparse saxpy, which keeps them exact tableau rows of the
+    /// new basis. The caller applies the recorded basis changes and bound flips to the factorization
+    /// and to the full primal vector afterwards, where the FTRANs of the entering columns are again
+    /// independent and can run concurrently.
+    ///
+    /// Tableau rows are stored over the variable index space (structurals and slacks) and exclude
+    /// the unit entry of the candidate's own basic variable.
+    class ParallelMinorIterations
+    {
+    public:
+        /// @brief Constructs the mode for a problem of the given size.
+        /// @param num_rows Number of constraints (basis dimension).
+        /// @param num_variables Number of structural plus slack variables.
+        /// @param options The options to use.
+        ParallelMinorIterations(int64_t num_rows, int64_t num_variables,
+                                const ParallelMinorIterationsOptions& options = {});
+
+        /// @brief Selects up to @c max_candidates infeasible rows with the best DSE merit.
+        ///
+        /// The merit of a row is its squared primal infeasibility divided by its edge weight.
+        /// Only a partial selection is performed, the candidates are not sorted.
+        ///
+        /// @param basic_values Values of the basic variables, indexed by row.
+        /// @param basic_lower Lower bounds of the basic variables, indexed by row.
+        /// @param basic_upper Upper bounds of the basic variables, indexed by row.
+        /// @param edge_weights Dual steepest-edge weights, indexed by row.
+        /// @return The number of candidates chosen.
+        int64_t choose_candidates(std::span<const double> basic_values,
+                                  std::span<const double> basic_lower,
+                                  std::span<const double> basic_upper,
+                                  std::span<const double> edge_weights);
+
+        /// @brief Computes the tableau rows of all candidates concurrently.
+        ///
+        /// @p compute_row is invoked as @c compute_row(row, pivot_row, workspace) for every
+        /// candidate. @c pivot_row is cleared beforehand and must receive the tableau row of
+        /// @c row over all nonbasic variables. @c workspace is leased from an internal pool for
+        /// the duration of the call and is exclusive to the executing thread.
+        ///
+        /// @param executor The executor running the candidates.
+        /// @param compute_row Callable performing BTRAN and PRICE for one row.
+        template <ParallelForExecutor Executor, typename ComputeRow>
+            requires std::invocable<ComputeRow&, int64_t, Vector<double>&, PriceWorkspace&>
+        void compute_pivot_rows(Executor& executor, ComputeRow&& compute_row)
+        {
+            executor.parallel_for(0, candidate_count_, 1, [&](const int64_t slot)
+            {
+                Vector<double>& pivot_row = pivot_rows_[slot];
+                pivot_row.clear();
+                const auto workspace = price_workspaces_.acquire();
+                compute_row(candidate_rows_[slot], pivot_row, *workspace);
+            });
+        }
+
+        /// @brief Performs minor iterations on the candidate rows until none is infeasible.
+        ///
+        /// Updates @p reduced_costs and @p nonbasic_move for every basis change and bound flip.
+        /// The leaving variable becomes nonbasic at the violated bound, the entering variable
+        /// gets move 0.
+        ///
+        /// @param basic_index Basic variable of every row.
+        /// @param reduced_costs Reduced costs of all variables.
+        /// @param nonbasic_move Nonbasic move of all variables (see @ref BoundFlippingRatioTest).
+        /// @param bound_range Upper minus lower bound of all variables.
+        /// @return The number of minor iterations performed.
+        int64_t perform_minor_iterations(std::span<const int64_t> basic_index,
+                                         std::span<double> reduced_costs,
+                                         std::span<int8_t> nonbasic_move,
+                                         std::span<const double> bound_range);
+
+        /// @brief The rows chosen by the last call to @ref choose_candidates.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const int64_t> candidate_rows() const
+        {
+            return {candidate_rows_.data(), static_cast<size_t>(candidate_count_)};
+        }
+
+        /// @brief The tableau row of candidate @p slot.
+        [[nodiscard]] KALIX_FORCE_INLINE const Vector<double>& pivot_row(const int64_t slot) const
+        {
+            DCHECK_GE(slot, 0);
+            DCHECK_LT(slot, candidate_count_);
+            return pivot_rows_[slot];
+        }
+
+        /// @brief The current value of the basic variable of candidate @p slot.
+        [[nodiscard]] KALIX_FORCE_INLINE double candidate_value(const int64_t slot) const
+        {
+            DCHECK_GE(slot, 0);
+            DCHECK_LT(slot, candidate_count_);
+            return candidate_values_[slot];
+        }
+
+        /// @brief The basis changes of the last call to @ref perform_minor_iterations, in order.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const MinorIteration> minor_iterations() const
+        {
+            return minor_iterations_;
+        }
+
+        /// @brief Variables flipped to their opposite bound by the last minor iterations.
+        [[nodiscard]] KALIX_FORCE_INLINE std::span<const int64_t> flipped_variables() const
+        {
+            return flipped_variables_;
+        }
+
+        /// @brief The row that proved dual unboundedness, or -1.
+        [[nodiscard]] KALIX_FORCE_INLINE int64_t dual_unbounded_row() const
+        {
+            return dual_unbounded_row_;
+        }
+
+    private:
+        [[nodiscard]] double infeasibility(int64_t slot) const;
+
+        ParallelMinorIterationsOptions options_;
+        int64_t num_variables_ = 0;
+
+        int64_t candidate_count_ = 0;
+        std::vector<int64_t> candidate_rows_;
+        std::vector<double> candidate_values_;
+        std::vector<double> candidate_lower_;
+        std::vector<double> candidate_upper_;
+        std::vector<double> candidate_weights_;
+        std::vector<Vector<double>> pivot_rows_;
+
+        WorkspacePool<PriceWorkspace> price_workspaces_;
+        BoundFlippingRatioTest ratio_test_;
+
+        std::vector<std::pair<double, int64_t>> merits_;
+        std::vector<char> active_;
+        std::vector<MinorIteration> minor_iterations_;
+        std::vector<int64_t> flipped_variables_;
+        int64_t dual_unbounded_row_ = -1;
+    };
+}
+
+#endif // KALIX_SIMPLEX_PARALLEL_MINOR_ITERATIONS_H_
@@ -0,0 +1,200 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/simplex/parallel_minor_iterations.h"
+
+namespace
+{
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+
+    // Tableau of x4 = -2 + x0 - 0.5 x1 and x5 = -3 - x0 + x1 for the objective x0 + 4 x1, with
+    // x0, x1 nonbasic at their lower bound 0 and both basic variables bounded below by 0.
+    class ParallelMinorIterationsTest : public ::testing::Test
+    {
+    protected:
+        static constexpr int64_t kRows = 2;
+        static constexpr int64_t kVariables = 6;
+
+        std::vector<double> basic_values{-2.0, -3.0};
+        std::vector<double> basic_lower{0.0, 0.0};
+        std::vector<double> basic_upper{kInf, kInf};
+        std::vector<double> edge_weights{1.0, 1.0};
+        std::vector<int64_t> basic_index{4, 5};
+
+        std::vector<double> reduced_costs{1.0, 4.0, 0.0, 0.0, 0.0, 0.0};
+        std::vector<int8_t> nonbasic_move{1, 1, 0, 0, 0, 0};
+        std::vector<double> bound_range{kInf, kInf, 0.0, 0.0, kInf, kInf};
+
+        static void compute_row(const int64_t row, kalix::Vector<double>& pivot_row, kalix::simplex::PriceWorkspace&)
+        {
+            // Tableau entries follow x_B = beta - alpha x_N.
+            const double alpha_0 = row == 0 ? -1.0 : 1.0;
+            const double alpha_1 = row == 0 ? 0.5 : -1.0;
+            pivot_row.dense_values[0] = alpha_0;
+            pivot_row.dense_values[1] = alpha_1;
+            pivot_row.non_zero_indices[0] = 0;
+            pivot_row.non_zero_indices[1] = 1;
+            pivot_row.non_zero_count = 2;
+        }
+    };
+
+    struct CountingExecutor
+    {
+        int64_t calls = 0;
+
+        template <typename Body>
+        void parallel_for(const int64_t begin, const int64_t end, int64_t, Body&& body)
+        {
+            calls++;
+            for (int64_t i = end - 1; i >= begin; i--)
+            {
+                body(i);
+            }
+        }
+    };
+}
+
+TEST_F(ParallelMinorIterationsTest, ChoosesCandidatesByMerit)
+{
+    kalix::simplex::ParallelMinorIterationsOptions options;
+    options.max_candidates = 1;
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables, options);
+
+    EXPECT_EQ(pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights), 1);
+    EXPECT_EQ(pami.candidate_rows()[0], 1);
+
+    edge_weights[1] = 4.0;
+    pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights);
+    EXPECT_EQ(pami.candidate_rows()[0], 0);
+}
+
+TEST_F(ParallelMinorIterationsTest, SkipsFeasibleRows)
+{
+    basic_values = {0.0, 1.0};
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables);
+
+    EXPECT_EQ(pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights), 0);
+}
+
+TEST_F(ParallelMinorIterationsTest, ComputesRowsThroughExecutor)
+{
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables);
+    pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights);
+
+    CountingExecutor executor;
+    std::atomic<int64_t> rows_computed{0};
+    pami.compute_pivot_rows(executor, [&](const int64_t row, kalix::Vector<double>& pivot_row,
+                                          kalix::simplex::PriceWorkspace& workspace)
+    {
+        EXPECT_EQ(workspace.row_ep.dimension, kRows);
+        compute_row(row, pivot_row, workspace);
+        rows_computed++;
+    });
+
+    EXPECT_EQ(executor.calls, 1);
+    EXPECT_EQ(rows_computed.load(), 2);
+}
+
+TEST_F(ParallelMinorIterationsTest, ComputesRowsOnTaskScheduler)
+{
+    kalix::TaskScheduler scheduler({.num_threads = 2});
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables);
+    pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights);
+    pami.compute_pivot_rows(scheduler, compute_row);
+
+    ASSERT_EQ(pami.perform_minor_iterations(basic_index, reduced_costs, nonbasic_move, bound_range), 2);
+    EXPECT_EQ(pami.minor_iterations()[1].entering_variable, 0);
+}
+
+TEST_F(ParallelMinorIterationsTest, PerformsMinorIterationsOnUpdatedRows)
+{
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables);
+    pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights);
+
+    kalix::simplex::SerialExecutor executor;
+    pami.compute_pivot_rows(executor, compute_row);
+
+    ASSERT_EQ(pami.perform_minor_iterations(basic_index, reduced_costs, nonbasic_move, bound_range), 2);
+    const auto iterations = pami.minor_iterations();
+
+    // Row 1 is the most infeasible; only x1 can enter it.
+    EXPECT_EQ(iterations[0].row, 1);
+    EXPECT_EQ(iterations[0].leaving_variable, 5);
+    EXPECT_EQ(iterations[0].entering_variable, 1);
+    EXPECT_DOUBLE_EQ(iterations[0].primal_step, 3.0);
+    EXPECT_DOUBLE_EQ(iterations[0].dual_step, -4.0);
+
+    // Row 0 was updated to x4 = -3.5 + 0.5 x0 - 0.5 x5 and is still infeasible.
+    EXPECT_EQ(iterations[1].row, 0);
+    EXPECT_EQ(iterations[1].leaving_variable, 4);
+    EXPECT_EQ(iterations[1].entering_variable, 0);
+    EXPECT_DOUBLE_EQ(iterations[1].pivot, -0.5);
+    EXPECT_DOUBLE_EQ(iterations[1].primal_step, 7.0);
+
+    // The objective in the final basis is 47 + 10 x4 + 9 x5.
+    EXPECT_DOUBLE_EQ(reduced_costs[0], 0.0);
+    EXPECT_NEAR(reduced_costs[1], 0.0, 1e-12);
+    EXPECT_DOUBLE_EQ(reduced_costs[4], 10.0);
+    EXPECT_DOUBLE_EQ(reduced_costs[5], 9.0);
+    EXPECT_EQ(nonbasic_move[0], 0);
+    EXPECT_EQ(nonbasic_move[4], 1);
+    EXPECT_EQ(nonbasic_move[5], 1);
+    EXPECT_TRUE(pami.flipped_variables().empty());
+    EXPECT_EQ(pami.dual_unbounded_row(), -1);
+}
+
+TEST_F(ParallelMinorIterationsTest, AppliesBoundFlipsToCandidates)
+{
+    // x1 is boxed with range 1: passing its breakpoint costs 1 of the 3 units of slope in row 1.
+    bound_range[1] = 1.0;
+    reduced_costs[0] = 10.0;
+    basic_values[0] = 0.0;
+
+    kalix::simplex::ParallelMinorIterationsOptions options;
+    options.max_candidates = 1;
+    kalix::simplex::ParallelMinorIterations pami(kRows, kVariables, options);
+    pami.choose_candidates(basic_values, basic_lower, basic_upper, edge_weights);
+    kalix::simplex::SerialExecutor executor;
+    pami.compute_pivot_rows(executor, [](int64_t, kalix::Vector<double>& pivot_row, kalix::simplex::PriceWorkspace&)
+    {
+        // x5 = -3 + x0 + x1.
+        pivot_row.dense_values[0] = -1.0;
+        pivot_row.dense_values[1] = -1.0;
+        pivot_row.non_zero_indices[0] = 0;
+        pivot_row.non_zero_indices[1] = 1;
+        pivot_row.non_zero_count = 2;
+    });
+
+    ASSERT_EQ(pami.perform_minor_iterations(basic_index, reduced_costs, nonbasic_move, bound_range), 1);
+    EXPECT_EQ(pami.minor_iterations()[0].entering_variable, 0);
+    ASSERT_EQ(pami.flipped_variables().size(), 1u);
+    EXPECT_EQ(pami.flipped_variables()[0], 1);
+    EXPECT_EQ(nonbasic_move[1], -1);
+    // Flipping x1 to 1 leaves x5 = -2, which x0 repairs with a step of 2.
+    EXPECT_DOUBLE_EQ(pami.minor_iterations()[0].primal_step, 2.0);
+}
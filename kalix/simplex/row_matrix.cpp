@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/row_matrix.h"
+
+#include <cmath>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "kalix/base/constants.h"
+
+namespace kalix::simplex
+{
+    RowMatrix::RowMatrix(const lp::CscMatrix& matrix, const RowMatrixOptions& options)
+        : matrix_(matrix), options_(options)
+    {
+        const int64_t num_rows = matrix.num_rows;
+        const int64_t non_zeros = matrix.num_non_zeros();
+        row_starts_.assign(num_rows + 1, 0);
+        for (int64_t k = 0; k < non_zeros; k++)
+        {
+            row_starts_[matrix.row_indices[k] + 1]++;
+        }
+        for (int64_t i = 0; i < num_rows; i++)
+        {
+            row_starts_[i + 1] += row_starts_[i];
+        }
+
+        columns_.resize(non_zeros);
+        values_.resize(non_zeros);
+        entries_.resize(non_zeros);
+        positions_.resize(non_zeros);
+        nonbasic_ends_.assign(row_starts_.begin() + 1, row_starts_.end());
+        std::vector<int64_t> next(row_starts_.begin(), row_starts_.end() - 1);
+        for (int64_t j = 0; j < matrix.num_cols; j++)
+        {
+            for (int64_t k = matrix.column_starts[j]; k < matrix.column_starts[j + 1]; k++)
+            {
+                const int64_t position = next[matrix.row_indices[k]]++;
+                columns_[position] = j;
+                values_[position] = matrix.values[k];
+                entries_[position] = k;
+                positions_[k] = position;
+            }
+        }
+        basic_.assign(matrix.num_cols, 0);
+    }
+
+    void RowMatrix::swap_entries(const int64_t first, const int64_t second)
+    {
+        std::swap(columns_[first], columns_[second]);
+        std::swap(values_[first], values_[second]);
+        std::swap(entries_[first], entries_[second]);
+        positions_[entries_[first]] = first;
+        positions_[entries_[second]] = second;
+    }
+
+    void RowMatrix::build(const std::span<const VariableStatus> status)
+    {
+        CHECK_GE(static_cast<int64_t>(status.size()), num_cols());
+        for (int64_t j = 0; j < num_cols(); j++)
+        {
+            basic_[j] = status[j] == VariableStatus::kBasic ? 1 : 0;
+        }
+
+        // Every row is a counting sort with two keys, done in place by swapping basic entries to
+        // the back. Rows share no entries, so they are partitioned independently.
+        const auto partition = [this](const int64_t row)
+        {
+            int64_t front = row_starts_[row];
+            int64_t back = row_starts_[row + 1] - 1;
+            while (front <= back)
+            {
+                if (basic_[columns_[front]] == 0)
+                {
+                    front++;
+                }
+                else
+                {
+                    std::swap(columns_[front], columns_[back]);
+                    std::swap(values_[front], values_[back]);
+                    std::swap(entries_[front], entries_[back]);
+                    back--;
+                }
+            }
+            nonbasic_ends_[row] = front;
+            for (int64_t t = row_starts_[row]; t < row_starts_[row + 1]; t++)
+            {
+                positions_[entries_[t]] = t;
+            }
+        };
+
+        TaskScheduler* scheduler =
+            matrix_.num_non_zeros() >= options_.min_parallel_non_zeros ? options_.scheduler : nullptr;
+        parallel_for(scheduler, 0, num_rows(), 0, partition);
+    }
+
+    void RowMatrix::set_basic(const int64_t column)
+    {
+        DCHECK_EQ(basic_[column], 0);
+        basic_[column] = 1;
+        for (int64_t k = matrix_.column_starts[column]; k < matrix_.column_starts[column + 1]; k++)
+        {
+            const int64_t row = matrix_.row_indices[k];
+            swap_entries(positions_[k], --nonbasic_ends_[row]);
+        }
+    }
+
+    void RowMatrix::set_nonbasic(const int64_t column)
+    {
+        DCHECK_EQ(basic_[column], 1);
+        basic_[column] = 0;
+        for (int64_t k = matrix_.column_starts[column]; k < matrix_.column_starts[column + 1]; k++)
+        {
+            const int64_t row = matrix_.row_indices[k];
+            swap_entries(positions_[k], nonbasic_ends_[row]++);
+        }
+    }
+
+    void RowMatrix::price(const Vector<double>& y, Vector<double>& result) const
+    {
+        DCHECK_EQ(y.dimension, num_rows());
+        DCHECK_EQ(result.dimension, num_cols());
+        std::vector<double>& values = result.dense_values;
+        const auto add_row = [&](const int64_t row)
+        {
+            const double multiplier = y.dense_values[row];
+            if (multiplier == 0.0)
+            {
+                return;
+            }
+            for (int64_t t = row_starts_[row]; t < nonbasic_ends_[row]; t++)
+            {
+                const int64_t j = columns_[t];
+                const double original = values[j];
+                if (original == 0.0)
+                {
+                    result.non_zero_indices[result.non_zero_count++] = j;
+                }
+                const double value = original + multiplier * values_[t];
+                values[j] = std::abs(value) < kTiny ? kZero : value;
+            }
+        };
+
+        if (y.non_zero_count < 0)
+        {
+            for (int64_t i = 0; i < num_rows(); i++)
+            {
+                add_row(i);
+            }
+            return;
+        }
+        for (int64_t t = 0; t < y.non_zero_count; t++)
+        {
+            add_row(y.non_zero_indices[t]);
+        }
+    }
+}
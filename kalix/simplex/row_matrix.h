@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_ROW_MATRIX_H_
+#define KALIX_SIMPLEX_ROW_MATRIX_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "kalix/base/task_scheduler.h"
+#include "kalix/base/vector.h"
+#include "kalix/lp/sparse_matrix.h"
+#include "kalix/simplex/solver_state.h"
+
+namespace kalix::simplex
+{
+    /// @brief Options of @ref RowMatrix.
+    struct RowMatrixOptions
+    {
+        /// @brief Scheduler used by @ref RowMatrix::build. Runs serially if null.
+        TaskScheduler* scheduler = nullptr;
+
+        /// @brief Matrices with fewer non-zeros are rebuilt serially.
+        int64_t min_parallel_non_zeros = int64_t{1} << 15;
+    };
+
+    /// @brief Row-wise copy of the structural columns, with every row split into the entries of
+    /// nonbasic and of basic columns.
+    ///
+    /// Row-wise PRICE computes the pivot row @c y^T*A_N from a hyper-sparse @c y by running over the
+    /// rows of the non-zeros of @c y, and must only see nonbasic columns. The nonbasic entries of row
+    /// @c i come first in the row, followed by the basic ones. When a column enters or leaves the
+    /// basis, each of its entries is swapped with the entry at the boundary of its row, and the
+    /// boundary moves by one, so a basis change costs the length of the column instead of a rebuild.
+    /// Every entry remembers its position in the column-wise matrix and the other way round, which
+    /// makes finding an entry constant time.
+    ///
+    /// The sparsity pattern never changes, so the transpose is computed once by a counting sort when
+    /// the copy is created. @ref build repartitions every row from scratch, which is needed after the
+    /// basis was replaced as a whole. The rows are independent and are partitioned in parallel.
+    class RowMatrix
+    {
+    public:
+        /// @brief Builds the row-wise copy of @p matrix, which must outlive it, with all columns
+        /// nonbasic.
+        explicit RowMatrix(const lp::CscMatrix& matrix, const RowMatrixOptions& options = {});
+
+        /// @brief Returns the number of rows.
+        [[nodiscard]] int64_t num_rows() const
+        {
+            return matrix_.num_rows;
+        }
+
+        /// @brief Returns the number of structural columns.
+        [[nodiscard]] int64_t num_cols() const
+        {
+            return matrix_.num_cols;
+        }
+
+        /// @brief Repartitions all rows.
+        /// @param status The status of every variable. Only the first @ref num_cols entries are read.
+        void build(std::span<const VariableStatus> status);
+
+        /// @brief Moves the entries of structural @p column into the basic segments of their rows.
+        void set_basic(int64_t column);
+
+        /// @brief Moves the entries of structural @p column into the nonbasic segments of their rows.
+        void set_nonbasic(int64_t column);
+
+        /// @brief Returns whether structural @p column is basic.
+        [[nodiscard]] bool is_basic(const int64_t column) const
+        {
+            return basic_[column] != 0;
+        }
+
+        /// @brief Returns the nonbasic columns with an entry in @p row, in no particular order.
+        [[nodiscard]] std::span<const int64_t> nonbasic_columns(const int64_t row) const
+        {
+            return {columns_.data() + row_starts_[row], static_cast<size_t>(nonbasic_ends_[row] - row_starts_[row])};
+        }
+
+        /// @brief Returns the values matching @ref nonbasic_columns.
+        [[nodiscard]] std::span<const double> nonbasic_values(const int64_t row) const
+        {
+            return {values_.data() + row_starts_[row], static_cast<size_t>(nonbasic_ends_[row] - row_starts_[row])};
+        }
+
+        /// @brief Computes the structural part of the pivot row, @c result = y^T*A_N.
+        ///
+        /// Runs over the non-zeros of @p y only, or over all rows if its count is negative.
+        /// Basic columns are zero in the result.
+        ///
+        /// @param y The row vector, indexed by row.
+        /// @param result Cleared vector of dimension @ref num_cols. Cancelled entries keep their
+        /// index and hold @ref kZero.
+        void price(const Vector<double>& y, Vector<double>& result) const;
+
+    private:
+        void swap_entries(int64_t first, int64_t second);
+
+        const lp::CscMatrix& matrix_;
+        RowMatrixOptions options_;
+
+        // Row i occupies [row_starts_[i], row_starts_[i + 1]), its nonbasic entries come before
+        // nonbasic_ends_[i].
+        std::vector<int64_t> row_starts_;
+        std::vector<int64_t> nonbasic_ends_;
+        std::vector<int64_t> columns_;
+        std::vector<double> values_;
+
+        // The column-wise position of every row-wise entry, and the other way round.
+        std::vector<int64_t> entries_;
+        std::vector<int64_t> positions_;
+        std::vector<char> basic_;
+    };
+}
+
+#endif // KALIX_SIMPLEX_ROW_MATRIX_H_
@@ -0,0 +1,222 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/row_matrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace kalix::simplex
+{
+    namespace
+    {
+        lp::CscMatrix random_matrix(std::mt19937& rng, const int64_t num_rows, const int64_t num_cols)
+        {
+            std::uniform_real_distribution<double> value(-2.0, 2.0);
+            std::bernoulli_distribution keep(0.15);
+            lp::CscMatrix matrix;
+            matrix.num_rows = num_rows;
+            for (int64_t j = 0; j < num_cols; j++)
+            {
+                std::vector<int64_t> indices;
+                std::vector<double> values;
+                for (int64_t i = 0; i < num_rows; i++)
+                {
+                    if (keep(rng))
+                    {
+                        indices.push_back(i);
+                        values.push_back(value(rng));
+                    }
+                }
+                matrix.append_column(indices, values);
+            }
+            return matrix;
+        }
+
+        std::vector<VariableStatus> random_status(std::mt19937& rng, const int64_t num_cols)
+        {
+            std::bernoulli_distribution basic(0.3);
+            std::vector<VariableStatus> status(num_cols);
+            for (VariableStatus& s : status)
+            {
+                s = basic(rng) ? VariableStatus::kBasic : VariableStatus::kAtLower;
+            }
+            return status;
+        }
+
+        /// Checks that every row holds exactly the nonbasic columns of @p status, with their values.
+        void expect_partition(const lp::CscMatrix& matrix, const RowMatrix& rows,
+                              const std::vector<VariableStatus>& status)
+        {
+            for (int64_t i = 0; i < matrix.num_rows; i++)
+            {
+                std::vector<std::pair<int64_t, double>> expected;
+                for (int64_t j = 0; j < matrix.num_cols; j++)
+                {
+                    EXPECT_EQ(rows.is_basic(j), status[j] == VariableStatus::kBasic);
+                    const auto indices = matrix.column_indices(j);
+                    for (size_t t = 0; t < indices.size(); t++)
+                    {
+                        if (indices[t] == i && status[j] != VariableStatus::kBasic)
+                        {
+                            expected.emplace_back(j, matrix.column_values(j)[t]);
+                        }
+                    }
+                }
+                std::vector<std::pair<int64_t, double>> actual;
+                for (size_t t = 0; t < rows.nonbasic_columns(i).size(); t++)
+                {
+                    actual.emplace_back(rows.nonbasic_columns(i)[t], rows.nonbasic_values(i)[t]);
+                }
+                std::ranges::sort(actual);
+                EXPECT_EQ(actual, expected);
+            }
+        }
+
+        Vector<double> sparse_vector(const int64_t dimension, const std::vector<std::pair<int64_t, double>>& entries)
+        {
+            Vector<double> vector;
+            vector.setup(dimension);
+            for (const auto& [index, value] : entries)
+            {
+                vector.dense_values[index] = value;
+                vector.non_zero_indices[vector.non_zero_count++] = index;
+            }
+            return vector;
+        }
+    }
+
+    TEST(RowMatrixTest, PricesNonbasicColumns)
+    {
+        std::mt19937 rng(1);
+        const lp::CscMatrix matrix = random_matrix(rng, 30, 50);
+        const std::vector<VariableStatus> status = random_status(rng, 50);
+        RowMatrix rows(matrix);
+        rows.build(status);
+        expect_partition(matrix, rows, status);
+
+        Vector<double> y = sparse_vector(30, {{3, 1.5}, {17, -2.0}, {29, 0.25}});
+        Vector<double> result;
+        result.setup(50);
+        rows.price(y, result);
+        for (int64_t j = 0; j < 50; j++)
+        {
+            double expected = 0.0;
+            if (status[j] != VariableStatus::kBasic)
+            {
+                const auto indices = matrix.column_indices(j);
+                for (size_t t = 0; t < indices.size(); t++)
+                {
+                    expected += matrix.column_values(j)[t] * y.dense_values[indices[t]];
+                }
+            }
+            EXPECT_NEAR(result.dense_values[j], expected, 1e-12);
+        }
+        for (int64_t t = 0; t < result.non_zero_count; t++)
+        {
+            EXPECT_NE(result.dense_values[result.non_zero_indices[t]], 0.0);
+        }
+
+        // Scanning all rows of a dense vector gives the same result.
+        Vector<double> dense_result;
+        dense_result.setup(50);
+        y.non_zero_count = -1;
+        rows.price(y, dense_result);
+        EXPECT_EQ(dense_result.dense_values, result.dense_values);
+    }
+
+    TEST(RowMatrixTest, CancelledEntriesKeepTheirIndex)
+    {
+        lp::CscMatrix matrix;
+        matrix.num_rows = 2;
+        matrix.append_column(std::vector<int64_t>{0, 1}, std::vector<double>{1.0, 1.0});
+        RowMatrix rows(matrix);
+        Vector<double> result;
+        result.setup(1);
+        rows.price(sparse_vector(2, {{0, 1.0}, {1, -1.0}}), result);
+        EXPECT_EQ(result.non_zero_count, 1);
+        EXPECT_EQ(result.dense_values[0], kZero);
+    }
+
+    TEST(RowMatrixTest, BasisChangesMatchRebuild)
+    {
+        std::mt19937 rng(2);
+        const lp::CscMatrix matrix = random_matrix(rng, 25, 40);
+        std::vector<VariableStatus> status = random_status(rng, 40);
+        RowMatrix rows(matrix);
+        rows.build(status);
+
+        std::uniform_int_distribution<int64_t> column(0, 39);
+        for (int step = 0; step < 200; step++)
+        {
+            const int64_t j = column(rng);
+            if (status[j] == VariableStatus::kBasic)
+            {
+                rows.set_nonbasic(j);
+                status[j] = VariableStatus::kAtUpper;
+            }
+            else
+            {
+                rows.set_basic(j);
+                status[j] = VariableStatus::kBasic;
+            }
+        }
+        expect_partition(matrix, rows, status);
+
+        RowMatrix rebuilt(matrix);
+        rebuilt.build(status);
+        const Vector<double> y = sparse_vector(25, {{0, 1.0}, {5, -3.0}, {11, 0.5}, {24, 2.0}});
+        Vector<double> updated_result;
+        Vector<double> rebuilt_result;
+        updated_result.setup(40);
+        rebuilt_result.setup(40);
+        rows.price(y, updated_result);
+        rebuilt.price(y, rebuilt_result);
+        for (int64_t j = 0; j < 40; j++)
+        {
+            EXPECT_NEAR(updated_result.dense_values[j], rebuilt_result.dense_values[j], 1e-12);
+        }
+    }
+
+    class RowMatrixThreadTest : public ::testing::TestWithParam<int>
+    {
+    };
+
+    TEST_P(RowMatrixThreadTest, ParallelBuildPartitionsEveryRow)
+    {
+        std::mt19937 rng(3);
+        const lp::CscMatrix matrix = random_matrix(rng, 200, 300);
+        TaskScheduler scheduler({.num_threads = GetParam()});
+        RowMatrix rows(matrix, {.scheduler = &scheduler, .min_parallel_non_zeros = 0});
+        for (int round = 0; round < 3; round++)
+        {
+            const std::vector<VariableStatus> status = random_status(rng, 300);
+            rows.build(status);
+            expect_partition(matrix, rows, status);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, RowMatrixThreadTest, ::testing::Values(1, 4));
+}
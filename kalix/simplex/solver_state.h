@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef KALIX_SIMPLEX_SOLVER_STATE_H_
+#define KALIX_SIMPLEX_SOLVER_STATE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "kalix/base/vector.h"
+
+namespace kalix::simplex
+{
+    /// @brief Status of a variable with respect to the current basis.
+    enum class VariableStatus : int8_t
+    {
+        kBasic,
+        kAtLower,
+        kAtUpper,
+        kFixed,
+        kFree,
+    };
+
+    /// @brief Stage the simplex solver has reached.
+    enum class SimplexPhase : int8_t
+    {
+        kCrash,
+        kPhaseOne,
+        kPhaseTwo,
+        kOptimal,
+    };
+
+    /// @brief The part of the simplex state that is needed to resume a solve.
+    ///
+    /// Variables are indexed over structurals followed by slacks. The LU factors themselves are
+    /// not part of the state; @ref factor_ready records that the basis was factorized without
+    /// singularities, so a resumed solve can refactorize it directly without basis repair.
+    struct SolverState
+    {
+        /// @brief Number of rows, which is also the number of basic variables.
+        int64_t num_rows = 0;
+
+        /// @brief Number of structural plus slack variables.
+        int64_t num_variables = 0;
+
+        /// @brief Number of simplex iterations performed so far.
+        int64_t iteration_count = 0;
+
+        /// @brief Stage of the solve.
+        SimplexPhase phase = SimplexPhase::kCrash;
+
+        /// @brief Whether @ref variable_status and @ref basic_index describe a complete basis.
+        bool has_basis = false;
+
+        /// @brief Whether the basis was factorized without singularities.
+        bool factor_ready = false;
+
+        /// @brief Whether @ref edge_weights hold valid dual steepest-edge weights.
+        bool edge_weights_ready = false;
+
+        /// @brief Status of every variable.
+        std::vector<VariableStatus> variable_status;
+
+        /// @brief The variable that is basic in every row.
+        std::vector<int64_t> basic_index;
+
+        /// @brief Dual steepest-edge weight of every row.
+        std::vector<double> edge_weights;
+
+        /// @brief Values of the basic variables, indexed by row.
+        Vector<double> primal_values;
+
+        /// @brief Reduced costs, indexed by variable.
+        Vector<double> dual_values;
+
+        /// @brief Sizes the state for a problem of the given size, reusing existing storage, and
+        /// resets all flags.
+        void setup(const int64_t new_num_rows, const int64_t new_num_variables)
+        {
+            num_rows = new_num_rows;
+            num_variables = new_num_variables;
+            iteration_count = 0;
+            phase = SimplexPhase::kCrash;
+            has_basis = false;
+            factor_ready = false;
+            edge_weights_ready = false;
+            variable_status.assign(new_num_variables, VariableStatus::kAtLower);
+            basic_index.assign(new_num_rows, -1);
+            edge_weights.assign(new_num_rows, 1.0);
+            primal_values.reshape(new_num_rows);
+            dual_values.reshape(new_num_variables);
+        }
+    };
+
+    /// @brief Work a resumed solve can skip, derived from a restored @ref SolverState.
+    struct WarmStartPlan
+    {
+        /// @brief Whether a crash basis has to be constructed.
+        bool run_crash = true;
+
+        /// @brief Whether phase one has to be run.
+        bool run_phase_one = true;
+
+        /// @brief Whether the dual steepest-edge weights have to be reinitialized.
+        bool reset_edge_weights = true;
+    };
+
+    /// @brief Decides which stages a solve resumed from @p state can skip.
+    ///
+    /// The basis is only trusted if it was complete and factorized at checkpoint time. Phase one
+    /// is skipped once the checkpoint was taken in phase two or later, since feasibility is a
+    /// property of the basis and survives the restart.
+    inline WarmStartPlan plan_warm_start(const SolverState& state)
+    {
+        WarmStartPlan plan;
+        if (!state.has_basis || !state.factor_ready)
+        {
+            return plan;
+        }
+        plan.run_crash = false;
+        plan.run_phase_one = state.phase == SimplexPhase::kCrash || state.phase == SimplexPhase::kPhaseOne;
+        plan.reset_edge_weights = !state.edge_weights_ready;
+        return plan;
+    }
+}
+
+#endif // KALIX_SIMPLEX_SOLVER_STATE_H_
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Felix Kahle.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "kalix/simplex/solver_state.h"
+
+#include "gtest/gtest.h"
+
+namespace kalix::simplex
+{
+    TEST(SolverStateTest, SetupResetsState)
+    {
+        SolverState state;
+        state.has_basis = true;
+        state.setup(3, 5);
+        EXPECT_FALSE(state.has_basis);
+        EXPECT_EQ(state.variable_status.size(), 5u);
+        EXPECT_EQ(state.basic_index.size(), 3u);
+        EXPECT_EQ(state.primal_values.dimension, 3);
+        EXPECT_EQ(state.dual_values.dimension, 5);
+    }
+
+    TEST(SolverStateTest, ColdStartWithoutFactorizedBasis)
+    {
+        SolverState state;
+        state.setup(2, 4);
+        state.phase = SimplexPhase::kPhaseTwo;
+        state.has_basis = true;
+
+        const WarmStartPlan plan = plan_warm_start(state);
+        EXPECT_TRUE(plan.run_crash);
+        EXPECT_TRUE(plan.run_phase_one);
+        EXPECT_TRUE(plan.reset_edge_weights);
+    }
+
+    TEST(SolverStateTest, WarmStartSkipsCompletedStages)
+    {
+        SolverState state;
+        state.setup(2, 4);
+        state.has_basis = true;
+        state.factor_ready = true;
+
+        state.phase = SimplexPhase::kPhaseOne;
+        WarmStartPlan plan = plan_warm_start(state);
+        EXPECT_FALSE(plan.run_crash);
+        EXPECT_TRUE(plan.run_phase_one);
+        EXPECT_TRUE(plan.reset_edge_weights);
+
+        state.phase = SimplexPhase::kPhaseTwo;
+        state.edge_weights_ready = true;
+        plan = plan_warm_start(state);
+        EXPECT_FALSE(plan.run_crash);
+        EXPECT_FALSE(plan.run_phase_one);
+        EXPECT_FALSE(plan.reset_edge_weights);
+    }
+}